@@ -0,0 +1,449 @@
+/**
+ * @brief	Ficheiro com as funes para aplicar alteraes em lote s execues e operaes
+ * @file	batch.c
+ * @author	Vnia Pereira
+ * @email	a19264@alunos.ipca.pt
+ * @date	2022
+ * @Disciplina Estruturas de Dados Avanadas
+ *
+ * -----------------
+ *
+ * As alteraes s execues so agrupadas pela posio da tabela hash (ordenao por contagem, estvel).
+ * Para cada posio  criado um ndice chave -> execuo, uma s vez, e todas as alteraes dessa posio
+ * so aplicadas com procuras em tempo constante. As execues de cada operao ficam tambm encadeadas entre si,
+ * para que remover todas as execues de uma operao s percorra as dessa operao (e no a posio inteira).
+ * A lista da posio  reconstruda no fim, numa s passagem.
+ * As alteraes so aplicadas pela ordem em que aparecem no lote (por exemplo, remover e depois inserir a mesma execuo).
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "header.h"
+
+
+#pragma region alteraes em lote s execues
+
+/**
+* @brief	Estado das execues de uma posio da tabela durante a aplicao de um lote
+*/
+typedef struct BatchBucket
+{
+	Execution** executions; // execues da posio, seguidas das inseridas pelo lote
+	bool* deleted;
+	int* sameOperation; // posio seguinte com uma execuo da mesma operao (-1 se for a ltima)
+	int count;
+	KeySet* positions; // EXECUTION_KEY -> posio em executions
+	KeySet* operations; // identificador da operao -> primeira posio com uma execuo da operao
+} BatchBucket;
+
+
+/**
+* @brief	Acrescentar uma execuo ao estado da posio, nos dois ndices (pela chave e pela operao)
+*/
+static void addBucketExecution(BatchBucket* bucket, Execution* execution)
+{
+	int position = bucket->count++;
+
+	bucket->executions[position] = execution;
+	bucket->sameOperation[position] = getKeyValue(bucket->operations, execution->operationID);
+	insertKey(bucket->positions, EXECUTION_KEY(execution->operationID, execution->machineID), position);
+	setKeyValue(bucket->operations, execution->operationID, position);
+}
+
+
+/**
+* @brief	Libertar os arrays e os ndices do estado de uma posio (as execues no so libertadas)
+*/
+static void freeBatchBucket(BatchBucket* bucket)
+{
+	free(bucket->executions);
+	free(bucket->deleted);
+	free(bucket->sameOperation);
+	freeKeySet(bucket->positions);
+	freeKeySet(bucket->operations);
+}
+
+
+/**
+* @brief	Aplicar a uma posio da tabela as alteraes do lote que lhe pertencem
+* @param	node		Posio da tabela
+* @param	changes		Todas as alteraes do lote
+* @param	order		ndices das alteraes desta posio, pela ordem do lote
+* @param	count		Quantidade de alteraes desta posio
+* @param	result		Contagens do resultado do lote (atualizadas)
+* @return	Booleano para o resultado da funo (falso se no houver memria)
+*/
+static bool applyBucketChanges(ExecutionNode* node, ExecutionChange changes[], int order[], int count, ExecutionBatchResult* result)
+{
+	BatchBucket bucket;
+	int capacity = count; // espao reservado para as execues da posio e todas as inseres do lote
+
+	for (Execution* aux = node->start; aux != NULL; aux = aux->next)
+	{
+		capacity++;
+	}
+
+	bucket.executions = (Execution**)malloc(capacity * sizeof(Execution*));
+	bucket.deleted = (bool*)calloc(capacity, sizeof(bool));
+	bucket.sameOperation = (int*)malloc(capacity * sizeof(int));
+	bucket.positions = createKeySet(capacity);
+	bucket.operations = createKeySet(capacity);
+	bucket.count = 0;
+
+	if (bucket.executions == NULL || bucket.deleted == NULL || bucket.sameOperation == NULL || bucket.positions == NULL || bucket.operations == NULL)
+	{
+		freeBatchBucket(&bucket);
+		return false;
+	}
+
+	for (Execution* aux = node->start; aux != NULL; aux = aux->next)
+	{
+		addBucketExecution(&bucket, aux);
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		ExecutionChange* change = &changes[order[i]];
+		int position = getKeyValue(bucket.positions, EXECUTION_KEY(change->operationID, change->machineID));
+		bool exists = position >= 0 && !bucket.deleted[position];
+
+		bumpOperationVersion(change->operationID); // mesmo que a alterao falhe, s obriga a recalcular
+
+		switch (change->type)
+		{
+		case CHANGE_INSERT:
+			if (exists)
+			{
+				result->failed++;
+			}
+			else if (position >= 0) // removida antes no mesmo lote, a execuo  reaproveitada
+			{
+				bucket.deleted[position] = false;
+				bucket.executions[position]->runtime = change->runtime;
+				result->inserted++;
+			}
+			else
+			{
+				Execution* new = newExecution(change->operationID, change->machineID, change->runtime);
+				if (new == NULL)
+				{
+					result->failed++;
+					break;
+				}
+
+				addBucketExecution(&bucket, new);
+				result->inserted++;
+			}
+			break;
+
+		case CHANGE_UPDATE:
+			if (exists)
+			{
+				bucket.executions[position]->runtime = change->runtime;
+				result->updated++;
+			}
+			else
+			{
+				result->failed++;
+			}
+			break;
+
+		case CHANGE_DELETE:
+			if (exists)
+			{
+				bucket.deleted[position] = true;
+				result->deleted++;
+			}
+			else
+			{
+				result->failed++;
+			}
+			break;
+
+		case CHANGE_DELETE_OPERATION: // todas as execues da operao (machineID  ignorado)
+		{
+			bool deletedAny = false;
+
+			// s as execues da operao, pela lista das suas posies (incluindo as inseridas antes no mesmo lote)
+			for (int k = getKeyValue(bucket.operations, change->operationID); k >= 0; k = bucket.sameOperation[k])
+			{
+				if (!bucket.deleted[k])
+				{
+					bucket.deleted[k] = true;
+					deletedAny = true;
+					result->deleted++;
+				}
+			}
+
+			if (!deletedAny)
+			{
+				result->failed++;
+			}
+			break;
+		}
+
+		default:
+			result->failed++;
+			break;
+		}
+	}
+
+	// reconstruir a lista da posio numa s passagem, libertando as execues removidas
+	Execution* start = NULL;
+	int numberOfExecutions = 0;
+
+	for (int k = bucket.count - 1; k >= 0; k--)
+	{
+		if (bucket.deleted[k])
+		{
+			free(bucket.executions[k]);
+		}
+		else
+		{
+			bucket.executions[k]->next = start;
+			start = bucket.executions[k];
+			numberOfExecutions++;
+		}
+	}
+
+	node->start = start;
+	node->numberOfExecutions = numberOfExecutions;
+
+	freeBatchBucket(&bucket);
+
+	return true;
+}
+
+
+/**
+* @brief	Aplicar um lote de inseres, atualizaes e remoes de execues  tabela hash.
+*			Cada posio da tabela  percorrida uma s vez, qualquer que seja o tamanho do lote
+* @param	table		Tabela hash das execues
+* @param	changes		Alteraes, aplicadas pela ordem do array
+* @param	count		Quantidade de alteraes
+* @param	result		Apontador para as contagens do resultado (inseridas, atualizadas, removidas e falhadas)
+* @return	Booleano para o resultado da funo (falso se no houver memria; as posies j alteradas mantm-se)
+*/
+bool applyExecutionChanges_AtTable(ExecutionNode* table[], ExecutionChange changes[], int count, ExecutionBatchResult* result)
+{
+	if (table == NULL || changes == NULL || result == NULL || count < 0)
+	{
+		return false;
+	}
+
+	result->inserted = 0;
+	result->updated = 0;
+	result->deleted = 0;
+	result->failed = 0;
+
+	// agrupar as alteraes pela posio da tabela (ordenao por contagem, mantendo a ordem do lote)
+	int starts[HASH_TABLE_SIZE + 1] = { 0 };
+	int* order = (int*)malloc((count > 0 ? count : 1) * sizeof(int));
+	int* hashes = (int*)malloc((count > 0 ? count : 1) * sizeof(int));
+
+	if (order == NULL || hashes == NULL) // se no houver memria para alocar
+	{
+		free(order);
+		free(hashes);
+		return false;
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		hashes[i] = generateHash_AtTable(table, changes[i].operationID);
+
+		if (hashes[i] < 0 || hashes[i] >= HASH_TABLE_SIZE) // identificadores negativos no tm posio na tabela
+		{
+			result->failed++;
+			continue;
+		}
+
+		starts[hashes[i] + 1]++;
+	}
+
+	for (int i = 0; i < HASH_TABLE_SIZE; i++)
+	{
+		starts[i + 1] += starts[i];
+	}
+
+	int next[HASH_TABLE_SIZE];
+	for (int i = 0; i < HASH_TABLE_SIZE; i++)
+	{
+		next[i] = starts[i];
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		if (hashes[i] >= 0 && hashes[i] < HASH_TABLE_SIZE)
+		{
+			order[next[hashes[i]]++] = i;
+		}
+	}
+
+	bool applied = true;
+
+	for (int i = 0; i < HASH_TABLE_SIZE && applied; i++)
+	{
+		if (starts[i + 1] > starts[i])
+		{
+			applied = applyBucketChanges(table[i], changes, &order[starts[i]], starts[i + 1] - starts[i], result);
+		}
+	}
+
+	free(order);
+	free(hashes);
+
+	return applied;
+}
+
+
+/**
+* @brief	Atualizar em lote os tempos de vrias execues
+* @param	table		Tabela hash das execues
+* @param	records		Execues com os novos tempos
+* @param	count		Quantidade de execues
+* @return	Quantidade de execues atualizadas (ou -1 se falhou)
+*/
+int updateRuntimes_Batch_AtTable(ExecutionNode* table[], FileExecution records[], int count)
+{
+	ExecutionChange* changes = (ExecutionChange*)malloc((count > 0 ? count : 1) * sizeof(ExecutionChange));
+	if (changes == NULL) // se no houver memria para alocar
+	{
+		return -1;
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		changes[i].type = CHANGE_UPDATE;
+		changes[i].operationID = records[i].operationID;
+		changes[i].machineID = records[i].machineID;
+		changes[i].runtime = records[i].runtime;
+	}
+
+	ExecutionBatchResult result;
+	bool applied = applyExecutionChanges_AtTable(table, changes, count, &result);
+
+	free(changes);
+
+	return applied ? result.updated : -1;
+}
+
+#pragma endregion
+
+
+#pragma region alteraes em lote s operaes
+
+/**
+* @brief	Inserir em lote vrias operaes no incio da lista, ignorando as que j existem
+* @param	head			Apontador para a lista de operaes
+* @param	operations		Operaes a inserir
+* @param	count			Quantidade de operaes
+* @return	Quantidade de operaes inseridas (ou -1 se falhou)
+*/
+int insertOperations_Batch(Operation** head, FileOperation operations[], int count)
+{
+	if (head == NULL || operations == NULL)
+	{
+		return -1;
+	}
+
+	// ndice das operaes existentes, criado numa s passagem pela lista
+	int length = 0;
+	for (Operation* aux = *head; aux != NULL; aux = aux->next)
+	{
+		length++;
+	}
+
+	KeySet* existing = createKeySet(length + count);
+	if (existing == NULL) // se no houver memria para alocar
+	{
+		return -1;
+	}
+
+	for (Operation* aux = *head; aux != NULL; aux = aux->next)
+	{
+		insertKey(existing, aux->id, 0);
+	}
+
+	int inserted = 0;
+
+	for (int i = 0; i < count; i++)
+	{
+		if (!insertKey(existing, operations[i].id, 0)) // j existe (na lista ou antes no lote)
+		{
+			continue;
+		}
+
+		Operation* new = newOperation(operations[i].id, operations[i].jobID);
+		if (new == NULL)
+		{
+			break;
+		}
+
+		new->next = *head;
+		*head = new;
+		inserted++;
+
+		bumpOperationVersion(new->id);
+		bumpJobVersion(new->jobID);
+	}
+
+	freeKeySet(existing);
+
+	return inserted;
+}
+
+
+/**
+* @brief	Remover em lote vrias operaes da lista, numa s passagem
+* @param	head			Apontador para a lista de operaes
+* @param	operationIDs	Identificadores das operaes a remover
+* @param	count			Quantidade de identificadores
+* @return	Quantidade de operaes removidas (ou -1 se falhou)
+*/
+int deleteOperations_Batch(Operation** head, int operationIDs[], int count)
+{
+	if (head == NULL || operationIDs == NULL)
+	{
+		return -1;
+	}
+
+	KeySet* toDelete = createKeySet(count);
+	if (toDelete == NULL) // se no houver memria para alocar
+	{
+		return -1;
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		insertKey(toDelete, operationIDs[i], 0);
+	}
+
+	int deleted = 0;
+	Operation** link = head;
+
+	while (*link != NULL)
+	{
+		Operation* current = *link;
+
+		if (searchKey(toDelete, current->id))
+		{
+			*link = current->next;
+			bumpOperationVersion(current->id);
+			bumpJobVersion(current->jobID);
+			free(current);
+			deleted++;
+		}
+		else
+		{
+			link = &current->next;
+		}
+	}
+
+	freeKeySet(toDelete);
+
+	return deleted;
+}
+
+#pragma endregion
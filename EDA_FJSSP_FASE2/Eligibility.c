@@ -0,0 +1,569 @@
+/**
+ * @brief	Ficheiro com as funes dos conjuntos de mquinas elegveis de cada operao
+ * @file	eligibility.c
+ * @author	Vnia Pereira
+ * @email	a19264@alunos.ipca.pt
+ * @date	2022
+ * @Disciplina Estruturas de Dados Avanadas
+ *
+ * -----------------
+ *
+ * Cada mquina recebe uma posio (0, 1, 2, ...) quando a tabela  construda, por isso a quantidade de mquinas
+ * no est limitada por NUMBER_MACHINES. Cada operao tem um conjunto de bits (um bit por posio de mquina)
+ * e os tempos das suas execues ficam num array denso, pela ordem dos bits: o tempo da mquina na posio p
+ * est no ndice igual  quantidade de bits a 1 antes de p.
+ *
+ * A tabela  construda a partir das listas carregadas; depois de acrescentar ou remover execues deve ser construda de novo.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+#include "header.h"
+
+
+#pragma region operaes sobre bits
+
+/**
+* @brief	Contar os bits a 1 de uma palavra
+* @param	word	Palavra de 64 bits
+* @return	Quantidade de bits a 1
+*/
+static int countBits(unsigned long long word)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+	return (int)__popcnt64(word);
+#elif defined(__GNUC__)
+	return __builtin_popcountll(word);
+#else
+	word = word - ((word >> 1) & 0x5555555555555555ull);
+	word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+	word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+	return (int)((word * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+
+/**
+* @brief	Obter o conjunto de bits de uma operao, pela sua posio
+*/
+static unsigned long long* getOperationBits(EligibilityTable* table, int operation)
+{
+	return &table->bits[(size_t)operation * table->numberOfWords];
+}
+
+
+/**
+* @brief	Guardar num array os identificadores das mquinas com bit a 1 num conjunto
+* @param	table		Tabela de elegibilidade
+* @param	bits		Conjunto de bits
+* @param	machineIDs	Array onde so guardados os identificadores das mquinas
+* @param	capacity	Tamanho do array
+* @return	Quantidade de mquinas no conjunto (pode ser maior que capacity)
+*/
+static int getMachinesFromBits(EligibilityTable* table, unsigned long long* bits, int machineIDs[], int capacity)
+{
+	int count = 0;
+
+	for (int word = 0; word < table->numberOfWords; word++)
+	{
+		unsigned long long remaining = bits[word];
+
+		while (remaining != 0)
+		{
+			int bit = countBits((remaining & (~remaining + 1)) - 1); // posio do bit a 1 menos significativo
+
+			if (count < capacity)
+			{
+				machineIDs[count] = table->machineIDs[word * 64 + bit];
+			}
+			count++;
+
+			remaining &= remaining - 1;
+		}
+	}
+
+	return count;
+}
+
+#pragma endregion
+
+
+#pragma region construir tabela de elegibilidade
+
+/**
+* @brief	Obter a posio de uma mquina, acrescentando-a se ainda no existir
+* @param	table		Tabela de elegibilidade
+* @param	machineID	Identificador da mquina
+* @param	capacity	Apontador para o tamanho atual do array de mquinas
+* @return	Posio da mquina (ou -1 se no houver memria)
+*/
+static int addMachinePosition(EligibilityTable* table, int machineID, int* capacity)
+{
+	int position = getKeyValue(table->machinePositions, machineID);
+	if (position >= 0)
+	{
+		return position;
+	}
+
+	if (table->numberOfMachines == *capacity)
+	{
+		int* machineIDs = (int*)realloc(table->machineIDs, *capacity * 2 * sizeof(int));
+		if (machineIDs == NULL)
+		{
+			return -1;
+		}
+
+		table->machineIDs = machineIDs;
+		*capacity *= 2;
+	}
+
+	position = table->numberOfMachines++;
+	table->machineIDs[position] = machineID;
+	insertKey(table->machinePositions, machineID, position);
+
+	return position;
+}
+
+
+/**
+* @brief	Construir a tabela de elegibilidade a partir das operaes, mquinas e execues carregadas.
+*			As mquinas que s aparecem nas execues tambm recebem uma posio
+* @param	operations		Lista de operaes
+* @param	machines		Lista de mquinas
+* @param	executions		Tabela hash das execues
+* @return	Tabela construda (ou NULL se no houver memria)
+*/
+EligibilityTable* buildEligibilityTable(Operation* operations, Machine* machines, ExecutionNode* executions[])
+{
+	EligibilityTable* table = (EligibilityTable*)calloc(1, sizeof(EligibilityTable));
+	if (table == NULL) // se no houver memria para alocar
+	{
+		return NULL;
+	}
+
+	int machineCapacity = NUMBER_MACHINES;
+	int operationCapacity = 16;
+
+	table->machineIDs = (int*)malloc(machineCapacity * sizeof(int));
+	table->operationIDs = (int*)malloc(operationCapacity * sizeof(int));
+	table->machinePositions = createKeySet(machineCapacity);
+	table->operationPositions = createKeySet(operationCapacity);
+
+	if (table->machineIDs == NULL || table->operationIDs == NULL || table->machinePositions == NULL || table->operationPositions == NULL)
+	{
+		freeEligibilityTable(table);
+		return NULL;
+	}
+
+	// 1 passagem: atribuir posies s mquinas e s operaes
+	for (Machine* aux = machines; aux != NULL; aux = aux->next)
+	{
+		if (addMachinePosition(table, aux->id, &machineCapacity) < 0)
+		{
+			freeEligibilityTable(table);
+			return NULL;
+		}
+	}
+
+	for (Operation* aux = operations; aux != NULL; aux = aux->next)
+	{
+		if (getKeyValue(table->operationPositions, aux->id) >= 0) // ignorar operaes repetidas
+		{
+			continue;
+		}
+
+		if (table->numberOfOperations == operationCapacity)
+		{
+			int* operationIDs = (int*)realloc(table->operationIDs, operationCapacity * 2 * sizeof(int));
+			if (operationIDs == NULL)
+			{
+				freeEligibilityTable(table);
+				return NULL;
+			}
+
+			table->operationIDs = operationIDs;
+			operationCapacity *= 2;
+		}
+
+		table->operationIDs[table->numberOfOperations] = aux->id;
+		insertKey(table->operationPositions, aux->id, table->numberOfOperations);
+		table->numberOfOperations++;
+	}
+
+	for (int i = 0; i < HASH_TABLE_SIZE; i++)
+	{
+		for (Execution* aux = executions[i]->start; aux != NULL; aux = aux->next)
+		{
+			if (addMachinePosition(table, aux->machineID, &machineCapacity) < 0)
+			{
+				freeEligibilityTable(table);
+				return NULL;
+			}
+		}
+	}
+
+	// 2 passagem: marcar os bits (execues de operaes desconhecidas so ignoradas)
+	table->numberOfWords = (table->numberOfMachines + 63) / 64;
+	if (table->numberOfWords == 0)
+	{
+		table->numberOfWords = 1;
+	}
+
+	table->bits = (unsigned long long*)calloc((size_t)table->numberOfOperations * table->numberOfWords + 1, sizeof(unsigned long long));
+	table->runtimeStarts = (int*)calloc(table->numberOfOperations + 1, sizeof(int));
+
+	if (table->bits == NULL || table->runtimeStarts == NULL)
+	{
+		freeEligibilityTable(table);
+		return NULL;
+	}
+
+	for (int i = 0; i < HASH_TABLE_SIZE; i++)
+	{
+		for (Execution* aux = executions[i]->start; aux != NULL; aux = aux->next)
+		{
+			int operation = getKeyValue(table->operationPositions, aux->operationID);
+			if (operation < 0)
+			{
+				continue;
+			}
+
+			int machine = getKeyValue(table->machinePositions, aux->machineID);
+			getOperationBits(table, operation)[machine / 64] |= 1ull << (machine % 64);
+		}
+	}
+
+	// incio dos tempos de cada operao no array denso
+	for (int operation = 0; operation < table->numberOfOperations; operation++)
+	{
+		unsigned long long* bits = getOperationBits(table, operation);
+		int count = 0;
+
+		for (int word = 0; word < table->numberOfWords; word++)
+		{
+			count += countBits(bits[word]);
+		}
+
+		table->runtimeStarts[operation + 1] = table->runtimeStarts[operation] + count;
+	}
+
+	table->runtimes = (int*)malloc((table->runtimeStarts[table->numberOfOperations] + 1) * sizeof(int));
+	if (table->runtimes == NULL)
+	{
+		freeEligibilityTable(table);
+		return NULL;
+	}
+
+	// 3 passagem: guardar cada tempo na posio dada pela ordem do bit
+	for (int i = 0; i < HASH_TABLE_SIZE; i++)
+	{
+		for (Execution* aux = executions[i]->start; aux != NULL; aux = aux->next)
+		{
+			int operation = getKeyValue(table->operationPositions, aux->operationID);
+			if (operation >= 0)
+			{
+				table->runtimes[getRuntimeIndex(table, operation, getKeyValue(table->machinePositions, aux->machineID))] = aux->runtime;
+			}
+		}
+	}
+
+	return table;
+}
+
+
+/**
+* @brief	Libertar a tabela de elegibilidade da memria
+* @param	table	Tabela de elegibilidade
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool freeEligibilityTable(EligibilityTable* table)
+{
+	if (table == NULL)
+	{
+		return false;
+	}
+
+	free(table->machineIDs);
+	free(table->operationIDs);
+	free(table->bits);
+	free(table->runtimeStarts);
+	free(table->runtimes);
+	freeKeySet(table->machinePositions);
+	freeKeySet(table->operationPositions);
+	free(table);
+
+	return true;
+}
+
+#pragma endregion
+
+
+#pragma region consultar tabela de elegibilidade
+
+/**
+* @brief	Obter o ndice do tempo de uma operao numa mquina no array denso de tempos
+* @param	table		Tabela de elegibilidade
+* @param	operation	Posio da operao
+* @param	machine		Posio da mquina
+* @return	ndice no array de tempos (ou -1 se a mquina no for elegvel)
+*/
+int getRuntimeIndex(EligibilityTable* table, int operation, int machine)
+{
+	if (operation < 0 || machine < 0)
+	{
+		return -1;
+	}
+
+	unsigned long long* bits = getOperationBits(table, operation);
+	int word = machine / 64;
+	unsigned long long bit = 1ull << (machine % 64);
+
+	if ((bits[word] & bit) == 0)
+	{
+		return -1;
+	}
+
+	// quantidade de bits a 1 antes da mquina
+	int rank = countBits(bits[word] & (bit - 1));
+	for (int i = 0; i < word; i++)
+	{
+		rank += countBits(bits[i]);
+	}
+
+	return table->runtimeStarts[operation] + rank;
+}
+
+
+/**
+* @brief	Verificar se uma mquina pode executar uma operao
+* @param	table			Tabela de elegibilidade
+* @param	operationID		Identificador da operao
+* @param	machineID		Identificador da mquina
+* @return	Booleano para o resultado da funo (se pode ou no)
+*/
+bool isMachineEligible(EligibilityTable* table, int operationID, int machineID)
+{
+	if (table == NULL)
+	{
+		return false;
+	}
+
+	int operation = getKeyValue(table->operationPositions, operationID);
+	int machine = getKeyValue(table->machinePositions, machineID);
+
+	if (operation < 0 || machine < 0)
+	{
+		return false;
+	}
+
+	return (getOperationBits(table, operation)[machine / 64] >> (machine % 64)) & 1;
+}
+
+
+/**
+* @brief	Obter o tempo de uma operao numa mquina
+* @param	table			Tabela de elegibilidade
+* @param	operationID		Identificador da operao
+* @param	machineID		Identificador da mquina
+* @return	Unidades de tempo (ou -1 se a mquina no puder executar a operao)
+*/
+int getRuntime_AtEligibilityTable(EligibilityTable* table, int operationID, int machineID)
+{
+	if (table == NULL)
+	{
+		return -1;
+	}
+
+	int index = getRuntimeIndex(table, getKeyValue(table->operationPositions, operationID), getKeyValue(table->machinePositions, machineID));
+
+	return index < 0 ? -1 : table->runtimes[index];
+}
+
+
+/**
+* @brief	Alterar o tempo de uma operao numa mquina j elegvel
+* @param	table			Tabela de elegibilidade
+* @param	operationID		Identificador da operao
+* @param	machineID		Identificador da mquina
+* @param	runtime			Unidades de tempo
+* @return	Booleano para o resultado da funo (falso se a mquina no puder executar a operao)
+*/
+bool updateRuntime_AtEligibilityTable(EligibilityTable* table, int operationID, int machineID, int runtime)
+{
+	if (table == NULL)
+	{
+		return false;
+	}
+
+	int index = getRuntimeIndex(table, getKeyValue(table->operationPositions, operationID), getKeyValue(table->machinePositions, machineID));
+	if (index < 0)
+	{
+		return false;
+	}
+
+	table->runtimes[index] = runtime;
+
+	return true;
+}
+
+
+/**
+* @brief	Obter a quantidade de mquinas que podem executar uma operao (flexibilidade da operao)
+* @param	table			Tabela de elegibilidade
+* @param	operationID		Identificador da operao
+* @return	Quantidade de mquinas (ou -1 se a operao no existir)
+*/
+int countEligibleMachines(EligibilityTable* table, int operationID)
+{
+	if (table == NULL)
+	{
+		return -1;
+	}
+
+	int operation = getKeyValue(table->operationPositions, operationID);
+	if (operation < 0)
+	{
+		return -1;
+	}
+
+	return table->runtimeStarts[operation + 1] - table->runtimeStarts[operation];
+}
+
+
+/**
+* @brief	Obter as mquinas que podem executar uma operao
+* @param	table			Tabela de elegibilidade
+* @param	operationID		Identificador da operao
+* @param	machineIDs		Array onde so guardados os identificadores das mquinas
+* @param	capacity		Tamanho do array
+* @return	Quantidade de mquinas (ou -1 se a operao no existir). Se for maior que capacity, s as primeiras so guardadas
+*/
+int getEligibleMachines(EligibilityTable* table, int operationID, int machineIDs[], int capacity)
+{
+	if (table == NULL)
+	{
+		return -1;
+	}
+
+	int operation = getKeyValue(table->operationPositions, operationID);
+	if (operation < 0)
+	{
+		return -1;
+	}
+
+	return getMachinesFromBits(table, getOperationBits(table, operation), machineIDs, capacity);
+}
+
+
+/**
+* @brief	Obter as operaes que podem ser executadas em todas as mquinas indicadas (por exemplo, nas mquinas 3 e 7)
+* @param	table				Tabela de elegibilidade
+* @param	machineIDs			Identificadores das mquinas
+* @param	numberOfMachines	Quantidade de mquinas
+* @param	operationIDs		Array onde so guardados os identificadores das operaes
+* @param	capacity			Tamanho do array
+* @return	Quantidade de operaes (ou -1 se falhou). Se for maior que capacity, s as primeiras so guardadas
+*/
+int getOperations_EligibleOnAllMachines(EligibilityTable* table, int machineIDs[], int numberOfMachines, int operationIDs[], int capacity)
+{
+	if (table == NULL)
+	{
+		return -1;
+	}
+
+	unsigned long long* mask = (unsigned long long*)calloc(table->numberOfWords, sizeof(unsigned long long));
+	if (mask == NULL) // se no houver memria para alocar
+	{
+		return -1;
+	}
+
+	for (int i = 0; i < numberOfMachines; i++)
+	{
+		int machine = getKeyValue(table->machinePositions, machineIDs[i]);
+		if (machine < 0) // nenhuma operao pode ser executada numa mquina desconhecida
+		{
+			free(mask);
+			return 0;
+		}
+
+		mask[machine / 64] |= 1ull << (machine % 64);
+	}
+
+	int count = 0;
+
+	for (int operation = 0; operation < table->numberOfOperations; operation++)
+	{
+		unsigned long long* bits = getOperationBits(table, operation);
+		bool eligible = true;
+
+		for (int word = 0; word < table->numberOfWords && eligible; word++)
+		{
+			eligible = (bits[word] & mask[word]) == mask[word];
+		}
+
+		if (eligible)
+		{
+			if (count < capacity)
+			{
+				operationIDs[count] = table->operationIDs[operation];
+			}
+			count++;
+		}
+	}
+
+	free(mask);
+
+	return count;
+}
+
+
+/**
+* @brief	Obter as mquinas que podem executar pelo menos uma das operaes indicadas (por exemplo, as operaes pendentes)
+* @param	table				Tabela de elegibilidade
+* @param	operationIDs		Identificadores das operaes
+* @param	numberOfOperations	Quantidade de operaes
+* @param	machineIDs			Array onde so guardados os identificadores das mquinas
+* @param	capacity			Tamanho do array
+* @return	Quantidade de mquinas (ou -1 se falhou). Se for maior que capacity, s as primeiras so guardadas
+*/
+int getMachines_ForAnyOperation(EligibilityTable* table, int operationIDs[], int numberOfOperations, int machineIDs[], int capacity)
+{
+	if (table == NULL)
+	{
+		return -1;
+	}
+
+	unsigned long long* any = (unsigned long long*)calloc(table->numberOfWords, sizeof(unsigned long long));
+	if (any == NULL) // se no houver memria para alocar
+	{
+		return -1;
+	}
+
+	for (int i = 0; i < numberOfOperations; i++)
+	{
+		int operation = getKeyValue(table->operationPositions, operationIDs[i]);
+		if (operation < 0)
+		{
+			continue;
+		}
+
+		unsigned long long* bits = getOperationBits(table, operation);
+		for (int word = 0; word < table->numberOfWords; word++)
+		{
+			any[word] |= bits[word];
+		}
+	}
+
+	int count = getMachinesFromBits(table, any, machineIDs, capacity);
+
+	free(any);
+
+	return count;
+}
+
+#pragma endregion
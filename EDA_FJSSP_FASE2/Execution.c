@@ -107,6 +107,8 @@ Execution* insertExecutionByOperation(Execution* head, Execution* new)
 		}
 	}
 
+	bumpOperationVersion(new->operationID);
+
 	return head;
 }
 
@@ -138,6 +140,7 @@ bool updateRuntime(Execution** head, int operationID, int machineID, int runtime
 		if (aux->operationID == operationID && aux->machineID == machineID)
 		{
 			aux->runtime = runtime;
+			bumpOperationVersion(operationID);
 			return true;
 		}
 		aux = aux->next;
@@ -166,6 +169,7 @@ bool deleteExecutionByOperation(Execution** head, int operationID)
 	if (aux != NULL && aux->operationID == operationID) { // se o elemento que ser apagado  o primeiro da lista
 		*head = aux->next;
 		free(aux);
+		bumpOperationVersion(operationID);
 		return true;
 	}
 
@@ -182,6 +186,7 @@ bool deleteExecutionByOperation(Execution** head, int operationID)
 
 	auxAnt->next = aux->next; // desassociar o elemento da lista
 	free(aux);
+	bumpOperationVersion(operationID);
 
 	return true;
 }
@@ -246,7 +251,13 @@ Execution* readExecutions(char fileName[])
 	while (fread(&currentInFile, sizeof(FileExecution), 1, file)) // l todos os registos do ficheiro e guarda na lista
 	{
 		current = newExecution(currentInFile.operationID, currentInFile.machineID, currentInFile.runtime);
-		head = insertExecutionAtStart(head, current);
+		Execution* inserted = insertExecutionAtStart(head, current);
+		if (inserted == NULL) // registo repetido, a lista no  alterada
+		{
+			free(current);
+			continue;
+		}
+		head = inserted;
 	}
 
 	fclose(file);
@@ -337,9 +348,10 @@ Execution* searchExecutionByOperation(Execution* head, int operationID)
 
 
 /**
-* @brief	Ordenar lista de execues por ordem crescente do identificador da operao
+* @brief	Ordenar lista de execues por ordem crescente do identificador da operao (e depois da mquina).
+*			A lista original no  alterada,  devolvida uma cpia ordenada
 * @param	head			Lista de execues
-* @return	Booleano para o resultado da funo (se funcionou ou no)
+* @return	Nova lista de execues ordenada
 */
 Execution* sortExecutionsByOperation(Execution* head)
 {
@@ -348,18 +360,114 @@ Execution* sortExecutionsByOperation(Execution* head)
 		return NULL;
 	}
 
-	Execution* aux = head;
-	Execution* sorted = NULL;
-	Execution* new = NULL;
+	return mergeSortExecutions(copyExecutions(head));
+}
 
-	while (aux != NULL)
+
+/**
+* @brief	Verificar se uma execuo deve ficar antes de outra na ordenao por operao e mquina
+*/
+static bool isExecutionBefore(Execution* a, Execution* b)
+{
+	if (a->operationID != b->operationID)
 	{
-		new = newExecution(aux->operationID, aux->machineID, aux->runtime);
-		sorted = insertExecutionByOperation(sorted, new);
-		aux = aux->next;
+		return a->operationID < b->operationID;
 	}
 
-	return sorted;
+	return a->machineID <= b->machineID;
+}
+
+
+/**
+* @brief	Ordenar a prpria lista de execues por operao e depois por mquina (merge sort, sem alocar memria).
+*			As execues no so copiadas, apenas ligadas por outra ordem
+* @param	head			Lista de execues
+* @return	Incio da lista ordenada
+*/
+Execution* mergeSortExecutions(Execution* head)
+{
+	if (head == NULL || head->next == NULL)
+	{
+		return head;
+	}
+
+	int length = 0;
+	for (Execution* aux = head; aux != NULL; aux = aux->next)
+	{
+		length++;
+	}
+
+	// juntar sublistas ordenadas de tamanho 1, 2, 4, ... at cobrir a lista toda
+	for (int size = 1; size < length; size *= 2)
+	{
+		Execution* remaining = head;
+		Execution* last = NULL;
+
+		head = NULL;
+
+		while (remaining != NULL)
+		{
+			// separar as duas sublistas seguintes
+			Execution* left = remaining;
+			Execution* right = left;
+
+			for (int i = 1; i < size && right->next != NULL; i++)
+			{
+				right = right->next;
+			}
+
+			Execution* aux = right;
+			right = right->next;
+			aux->next = NULL;
+
+			aux = right;
+			for (int i = 1; i < size && aux != NULL; i++)
+			{
+				aux = aux->next;
+			}
+
+			if (aux != NULL)
+			{
+				remaining = aux->next;
+				aux->next = NULL;
+			}
+			else
+			{
+				remaining = NULL;
+			}
+
+			// juntar as duas sublistas no fim da lista ordenada
+			while (left != NULL || right != NULL)
+			{
+				Execution* next;
+
+				if (right == NULL || (left != NULL && isExecutionBefore(left, right)))
+				{
+					next = left;
+					left = left->next;
+				}
+				else
+				{
+					next = right;
+					right = right->next;
+				}
+
+				if (last == NULL)
+				{
+					head = next;
+				}
+				else
+				{
+					last->next = next;
+				}
+				last = next;
+			}
+		}
+
+		last->next = NULL;
+	}
+
+	return head;
 }
 
 
@@ -386,6 +494,60 @@ Execution* getLastExecution(Execution* head)
 }
 
 
+/**
+* @brief	Copiar a lista de execues, mantendo a mesma ordem
+* @param	head	Lista de execues
+* @return	Nova lista de execues
+*/
+Execution* copyExecutions(Execution* head)
+{
+	Execution* copy = NULL;
+	Execution* last = NULL;
+
+	for (Execution* aux = head; aux != NULL; aux = aux->next)
+	{
+		Execution* new = newExecution(aux->operationID, aux->machineID, aux->runtime);
+		if (new == NULL) // se no houver memria para alocar
+		{
+			freeExecutions(copy);
+			return NULL;
+		}
+
+		if (last == NULL) // inserir no fim, sem procurar duplicados porque a lista original j no os tem
+		{
+			copy = new;
+		}
+		else
+		{
+			last->next = new;
+		}
+		last = new;
+	}
+
+	return copy;
+}
+
+
+/**
+* @brief	Libertar a lista de execues da memria
+* @param	head	Lista de execues
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool freeExecutions(Execution* head)
+{
+	Execution* aux = head;
+
+	while (aux != NULL)
+	{
+		Execution* next = aux->next;
+		free(aux);
+		aux = next;
+	}
+
+	return true;
+}
+
+
 
 #pragma endregion
 
@@ -0,0 +1,629 @@
+/**
+ * @brief	Ficheiro com as funes para armazenar as execues num ficheiro binrio comprimido, organizado por colunas
+ * @file	executions_columnar.c
+ * @author	Vnia Pereira
+ * @email	a19264@alunos.ipca.pt
+ * @date	2022
+ * @Disciplina Estruturas de Dados Avanadas
+ *
+ * -----------------
+ *
+ * Formato do ficheiro (todos os inteiros em little-endian):
+ *	- cabealho: magic, verso, quantidade de execues, quantidade de blocos, posio do ndice
+ *	- blocos de at COLUMNAR_BLOCK_SIZE execues, ordenadas pelo identificador da operao e da mquina:
+ *		- cabealho do bloco: quantidade, bits por mquina, bits por tempo, primeira operao, menor mquina, menor tempo,
+ *		  bytes das operaes
+ *		- operaes: diferena para a operao anterior (zigzag + varint)
+ *		- mquinas: diferena para a menor mquina do bloco, com machineBits bits cada (bit-packing)
+ *		- tempos: diferena para o menor tempo do bloco (frame of reference), com runtimeBits bits cada
+ *	- ndice: para cada bloco, a posio no ficheiro, a primeira operao e a quantidade de execues
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "header.h"
+
+
+#define COLUMNAR_HEADER_SIZE 32
+#define COLUMNAR_BLOCK_HEADER_SIZE 20
+#define COLUMNAR_INDEX_ENTRY_SIZE 16
+#define COLUMNAR_PADDING 8 // bytes extra no fim dos buffers, para ler sempre 8 bytes de uma vez ao descodificar
+
+
+#pragma region leitura e escrita de bytes
+
+static void storeU16(uint8_t* bytes, uint32_t value)
+{
+	bytes[0] = (uint8_t)value;
+	bytes[1] = (uint8_t)(value >> 8);
+}
+
+static void storeU32(uint8_t* bytes, uint32_t value)
+{
+	for (int i = 0; i < 4; i++)
+	{
+		bytes[i] = (uint8_t)(value >> (8 * i));
+	}
+}
+
+static void storeU64(uint8_t* bytes, uint64_t value)
+{
+	for (int i = 0; i < 8; i++)
+	{
+		bytes[i] = (uint8_t)(value >> (8 * i));
+	}
+}
+
+static uint32_t loadU16(const uint8_t* bytes)
+{
+	return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8);
+}
+
+static uint32_t loadU32(const uint8_t* bytes)
+{
+	return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+static uint64_t loadU64(const uint8_t* bytes)
+{
+	uint64_t value = 0;
+
+	for (int i = 7; i >= 0; i--)
+	{
+		value = (value << 8) | bytes[i];
+	}
+
+	return value;
+}
+
+
+/**
+* @brief	Calcular a quantidade de bits necessria para representar um valor
+* @param	value	Valor
+* @return	Quantidade de bits (0 para o valor 0)
+*/
+static int getBitsNeeded(uint32_t value)
+{
+	int bits = 0;
+
+	while (value != 0)
+	{
+		bits++;
+		value >>= 1;
+	}
+
+	return bits;
+}
+
+
+/**
+* @brief	Escrever valores com uma quantidade fixa de bits cada, seguidos uns aos outros
+* @param	bytes	Onde os valores so escritos (com pelo menos (count * bits + 7) / 8 bytes a zero)
+* @param	values	Valores a escrever
+* @param	count	Quantidade de valores
+* @param	bits	Bits por valor
+* @return	Quantidade de bytes escritos
+*/
+static int packBits(uint8_t* bytes, const uint32_t* values, int count, int bits)
+{
+	uint64_t position = 0;
+
+	for (int i = 0; i < count && bits > 0; i++, position += bits)
+	{
+		uint64_t value = (uint64_t)values[i] << (position & 7);
+
+		for (int b = 0; value != 0; b++) // cada valor ocupa no mximo 5 bytes (32 bits + 7 de deslocamento)
+		{
+			bytes[(position >> 3) + b] |= (uint8_t)value;
+			value >>= 8;
+		}
+	}
+
+	return (int)((count * (uint64_t)bits + 7) / 8);
+}
+
+
+/**
+* @brief	Ler valores escritos com packBits, somando a cada um o valor base.
+*			Cada valor  obtido com uma nica leitura de 8 bytes (o buffer tem COLUMNAR_PADDING bytes extra)
+* @param	bytes	Bytes com os valores
+* @param	count	Quantidade de valores
+* @param	bits	Bits por valor
+* @param	base	Valor somado a cada valor lido
+* @param	values	Onde os valores lidos so guardados
+*/
+static void unpackBits(const uint8_t* bytes, int count, int bits, int base, int* values)
+{
+	if (bits == 0) // todos os valores so iguais ao valor base
+	{
+		for (int i = 0; i < count; i++)
+		{
+			values[i] = base;
+		}
+		return;
+	}
+
+	uint64_t mask = (bits == 32) ? 0xFFFFFFFFull : ((1ull << bits) - 1);
+	uint64_t position = 0;
+
+	for (int i = 0; i < count; i++, position += bits)
+	{
+		uint64_t word = loadU64(bytes + (position >> 3));
+		values[i] = (int)((uint32_t)base + (uint32_t)((word >> (position & 7)) & mask));
+	}
+}
+
+#pragma endregion
+
+
+#pragma region escrita do ficheiro por colunas
+
+/**
+* @brief	Codificar um bloco de execues
+* @param	records		Execues do bloco (ordenadas)
+* @param	count		Quantidade de execues
+* @param	bytes		Onde o bloco  escrito (a zero, com espao para o pior caso)
+* @param	values		Array auxiliar com espao para count valores
+* @return	Quantidade de bytes do bloco
+*/
+static int encodeExecutionBlock(const FileExecution* records, int count, uint8_t* bytes, uint32_t* values)
+{
+	int minMachine = records[0].machineID;
+	int maxMachine = records[0].machineID;
+	int minRuntime = records[0].runtime;
+	int maxRuntime = records[0].runtime;
+
+	for (int i = 1; i < count; i++)
+	{
+		if (records[i].machineID < minMachine) minMachine = records[i].machineID;
+		if (records[i].machineID > maxMachine) maxMachine = records[i].machineID;
+		if (records[i].runtime < minRuntime) minRuntime = records[i].runtime;
+		if (records[i].runtime > maxRuntime) maxRuntime = records[i].runtime;
+	}
+
+	int machineBits = getBitsNeeded((uint32_t)maxMachine - (uint32_t)minMachine);
+	int runtimeBits = getBitsNeeded((uint32_t)maxRuntime - (uint32_t)minRuntime);
+	int size = COLUMNAR_BLOCK_HEADER_SIZE;
+
+	// operaes: diferena para a anterior, em zigzag (para aceitar diferenas negativas) e varint
+	int previous = records[0].operationID;
+	for (int i = 0; i < count; i++)
+	{
+		int64_t delta = (int64_t)records[i].operationID - previous;
+		uint64_t zigzag = delta >= 0 ? (uint64_t)delta << 1 : (((uint64_t)(-delta)) << 1) - 1;
+
+		while (zigzag >= 0x80)
+		{
+			bytes[size++] = (uint8_t)(zigzag | 0x80);
+			zigzag >>= 7;
+		}
+		bytes[size++] = (uint8_t)zigzag;
+
+		previous = records[i].operationID;
+	}
+
+	storeU16(bytes, (uint32_t)count);
+	bytes[2] = (uint8_t)machineBits;
+	bytes[3] = (uint8_t)runtimeBits;
+	storeU32(bytes + 4, (uint32_t)records[0].operationID);
+	storeU32(bytes + 8, (uint32_t)minMachine);
+	storeU32(bytes + 12, (uint32_t)minRuntime);
+	storeU32(bytes + 16, (uint32_t)(size - COLUMNAR_BLOCK_HEADER_SIZE));
+
+	for (int i = 0; i < count; i++)
+	{
+		values[i] = (uint32_t)records[i].machineID - (uint32_t)minMachine;
+	}
+	size += packBits(bytes + size, values, count, machineBits);
+
+	for (int i = 0; i < count; i++)
+	{
+		values[i] = (uint32_t)records[i].runtime - (uint32_t)minRuntime;
+	}
+	size += packBits(bytes + size, values, count, runtimeBits);
+
+	return size;
+}
+
+
+/**
+* @brief	Armazenar todas as execues da tabela hash num ficheiro binrio comprimido, organizado por colunas
+* @param	fileName	Nome do ficheiro
+* @param	table		Tabela hash das execues
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool writeExecutions_Columnar(char fileName[], ExecutionNode* table[])
+{
+	if (table == NULL)
+	{
+		return false;
+	}
+
+	// o tamanho  contado nas listas, e no com numberOfExecutions, para o array nunca ser mais pequeno do que as listas
+	int count = 0;
+	for (int i = 0; i < HASH_TABLE_SIZE; i++)
+	{
+		for (Execution* aux = table[i]->start; aux != NULL; aux = aux->next)
+		{
+			count++;
+		}
+	}
+
+	FileExecution* records = (FileExecution*)malloc((count > 0 ? count : 1) * sizeof(FileExecution));
+	if (records == NULL) // se no houver memria para alocar
+	{
+		return false;
+	}
+
+	int capacity = count;
+	count = 0;
+	for (int i = 0; i < HASH_TABLE_SIZE; i++)
+	{
+		for (Execution* aux = table[i]->start; aux != NULL && count < capacity; aux = aux->next)
+		{
+			records[count].operationID = aux->operationID;
+			records[count].machineID = aux->machineID;
+			records[count].runtime = aux->runtime;
+			count++;
+		}
+	}
+
+	// ordenar por operao torna as diferenas entre operaes seguidas pequenas
+	if (!radixSortExecutions(records, count))
+	{
+		free(records);
+		return false;
+	}
+
+	bool written = writeFileExecutions_Columnar(fileName, records, count);
+
+	free(records);
+
+	return written;
+}
+
+
+/**
+* @brief	Armazenar um array de execues num ficheiro binrio comprimido, organizado por colunas.
+*			As execues devem estar ordenadas pelo identificador da operao para a melhor compresso
+* @param	fileName	Nome do ficheiro
+* @param	records		Array de execues
+* @param	count		Quantidade de execues
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool writeFileExecutions_Columnar(char fileName[], FileExecution* records, int count)
+{
+	FILE* file = NULL;
+
+	if ((file = fopen(fileName, "wb")) == NULL) // se no foi possvel abrir o ficheiro
+	{
+		return false;
+	}
+
+	int numberOfBlocks = (count + COLUMNAR_BLOCK_SIZE - 1) / COLUMNAR_BLOCK_SIZE;
+
+	// pior caso de um bloco: 10 bytes de varint, 4 de mquina e 4 de tempo por execuo
+	uint8_t* block = (uint8_t*)malloc(COLUMNAR_BLOCK_HEADER_SIZE + COLUMNAR_BLOCK_SIZE * 18 + COLUMNAR_PADDING);
+	uint32_t* values = (uint32_t*)malloc(COLUMNAR_BLOCK_SIZE * sizeof(uint32_t));
+	uint8_t* index = (uint8_t*)malloc((numberOfBlocks > 0 ? numberOfBlocks : 1) * COLUMNAR_INDEX_ENTRY_SIZE);
+	uint8_t header[COLUMNAR_HEADER_SIZE] = { 0 };
+
+	if (block == NULL || values == NULL || index == NULL)
+	{
+		free(block);
+		free(values);
+		free(index);
+		fclose(file);
+		return false;
+	}
+
+	fwrite(header, COLUMNAR_HEADER_SIZE, 1, file); // o cabealho  escrito no fim, quando a posio do ndice for conhecida
+
+	uint64_t offset = COLUMNAR_HEADER_SIZE;
+
+	for (int b = 0; b < numberOfBlocks; b++)
+	{
+		int first = b * COLUMNAR_BLOCK_SIZE;
+		int blockCount = count - first < COLUMNAR_BLOCK_SIZE ? count - first : COLUMNAR_BLOCK_SIZE;
+
+		memset(block, 0, COLUMNAR_BLOCK_HEADER_SIZE + COLUMNAR_BLOCK_SIZE * 18);
+		int size = encodeExecutionBlock(records + first, blockCount, block, values);
+
+		storeU64(index + b * COLUMNAR_INDEX_ENTRY_SIZE, offset);
+		storeU32(index + b * COLUMNAR_INDEX_ENTRY_SIZE + 8, (uint32_t)records[first].operationID);
+		storeU32(index + b * COLUMNAR_INDEX_ENTRY_SIZE + 12, (uint32_t)blockCount);
+
+		fwrite(block, size, 1, file);
+		offset += size;
+	}
+
+	fwrite(index, COLUMNAR_INDEX_ENTRY_SIZE, numberOfBlocks, file);
+
+	storeU32(header, COLUMNAR_MAGIC);
+	storeU32(header + 4, COLUMNAR_VERSION);
+	storeU32(header + 8, (uint32_t)count);
+	storeU32(header + 12, (uint32_t)numberOfBlocks);
+	storeU64(header + 16, offset);
+
+	fseek(file, 0, SEEK_SET);
+	fwrite(header, COLUMNAR_HEADER_SIZE, 1, file);
+
+	bool written = !ferror(file);
+
+	fclose(file);
+	free(block);
+	free(values);
+	free(index);
+
+	return written;
+}
+
+#pragma endregion
+
+
+#pragma region leitura do ficheiro por colunas
+
+/**
+* @brief	Descodificar um bloco de execues
+* @param	bytes		Bytes do bloco (com COLUMNAR_PADDING bytes extra no fim do ficheiro)
+* @param	size		Bytes disponveis a partir do incio do bloco
+* @param	records		Onde as execues so guardadas
+* @param	capacity	Quantidade de execues que cabem em records
+* @param	columns		Array auxiliar com espao para COLUMNAR_BLOCK_SIZE valores
+* @return	Quantidade de execues descodificadas (ou -1 se o bloco estiver corrompido ou no couber em records)
+*/
+static int decodeExecutionBlock(const uint8_t* bytes, uint64_t size, FileExecution* records, int capacity, int* columns)
+{
+	if (size < COLUMNAR_BLOCK_HEADER_SIZE)
+	{
+		return -1;
+	}
+
+	int count = (int)loadU16(bytes);
+	int machineBits = bytes[2];
+	int runtimeBits = bytes[3];
+	int operationID = (int)loadU32(bytes + 4);
+	int minMachine = (int)loadU32(bytes + 8);
+	int minRuntime = (int)loadU32(bytes + 12);
+	uint64_t operationBytes = loadU32(bytes + 16);
+	uint64_t machineBytes = (count * (uint64_t)machineBits + 7) / 8;
+	uint64_t runtimeBytes = (count * (uint64_t)runtimeBits + 7) / 8;
+
+	if (count > COLUMNAR_BLOCK_SIZE || count > capacity || machineBits > 32 || runtimeBits > 32
+		|| COLUMNAR_BLOCK_HEADER_SIZE + operationBytes + machineBytes + runtimeBytes > size)
+	{
+		return -1;
+	}
+
+	const uint8_t* position = bytes + COLUMNAR_BLOCK_HEADER_SIZE;
+	const uint8_t* end = position + operationBytes;
+
+	for (int i = 0; i < count; i++)
+	{
+		uint64_t zigzag = 0;
+		int shift = 0;
+
+		do
+		{
+			if (position >= end || shift > 63)
+			{
+				return -1;
+			}
+			zigzag |= (uint64_t)(*position & 0x7F) << shift;
+			shift += 7;
+		} while (*position++ & 0x80);
+
+		int64_t delta = (zigzag & 1) ? -(int64_t)(zigzag >> 1) - 1 : (int64_t)(zigzag >> 1);
+		operationID = (int)(operationID + delta);
+		records[i].operationID = operationID;
+	}
+
+	unpackBits(end, count, machineBits, minMachine, columns);
+	for (int i = 0; i < count; i++)
+	{
+		records[i].machineID = columns[i];
+	}
+
+	unpackBits(end + machineBytes, count, runtimeBits, minRuntime, columns);
+	for (int i = 0; i < count; i++)
+	{
+		records[i].runtime = columns[i];
+	}
+
+	return count;
+}
+
+
+/**
+* @brief	Ler um ficheiro por colunas para memria e validar o cabealho
+* @param	fileName		Nome do ficheiro
+* @param	size			Apontador para o tamanho do ficheiro
+* @param	numberOfBlocks	Apontador para a quantidade de blocos
+* @param	total			Apontador para a quantidade de execues indicada no cabealho
+* @return	Bytes do ficheiro com COLUMNAR_PADDING bytes a zero no fim (ou NULL se falhou)
+*/
+static uint8_t* loadColumnarFile(char fileName[], uint64_t* size, int* numberOfBlocks, int* total)
+{
+	long long fileSize = getFileSize(fileName);
+	if (fileSize < COLUMNAR_HEADER_SIZE)
+	{
+		return NULL;
+	}
+
+	FILE* file = NULL;
+
+	if ((file = fopen(fileName, "rb")) == NULL) // se no foi possvel abrir o ficheiro
+	{
+		return NULL;
+	}
+
+	uint8_t* bytes = (uint8_t*)calloc((size_t)fileSize + COLUMNAR_PADDING, 1);
+	bool loaded = bytes != NULL && fread(bytes, 1, (size_t)fileSize, file) == (size_t)fileSize;
+
+	fclose(file);
+
+	if (loaded)
+	{
+		uint64_t blocks = loadU32(bytes + 12);
+		uint64_t executions = loadU32(bytes + 8);
+		uint64_t indexOffset = loadU64(bytes + 16);
+
+		// o cabealho no  de confiana: cada bloco ocupa pelo menos o seu cabealho e tem no mximo COLUMNAR_BLOCK_SIZE execues
+		loaded = loadU32(bytes) == COLUMNAR_MAGIC && loadU32(bytes + 4) == COLUMNAR_VERSION
+			&& blocks * COLUMNAR_BLOCK_HEADER_SIZE <= (uint64_t)fileSize
+			&& executions <= blocks * COLUMNAR_BLOCK_SIZE && executions <= (uint64_t)fileSize && executions <= INT32_MAX
+			&& indexOffset <= (uint64_t)fileSize
+			&& blocks * COLUMNAR_INDEX_ENTRY_SIZE <= (uint64_t)fileSize - indexOffset;
+
+		*numberOfBlocks = (int)blocks;
+		*total = (int)executions;
+	}
+
+	if (!loaded)
+	{
+		free(bytes);
+		return NULL;
+	}
+
+	*size = (uint64_t)fileSize;
+
+	return bytes;
+}
+
+
+/**
+* @brief	Ler todas as execues de um ficheiro por colunas para um array
+* @param	fileName	Nome do ficheiro
+* @param	count		Apontador para a quantidade de execues lidas
+* @return	Array de execues, ordenado pelo identificador da operao (ou NULL se falhou)
+*/
+FileExecution* readFileExecutions_Columnar(char fileName[], int* count)
+{
+	uint64_t size = 0;
+	int numberOfBlocks = 0;
+	int total = 0;
+
+	*count = 0;
+
+	uint8_t* bytes = loadColumnarFile(fileName, &size, &numberOfBlocks, &total);
+	if (bytes == NULL)
+	{
+		return NULL;
+	}
+
+	FileExecution* records = (FileExecution*)malloc(((size_t)total > 0 ? (size_t)total : 1) * sizeof(FileExecution));
+	int* columns = (int*)malloc(COLUMNAR_BLOCK_SIZE * sizeof(int));
+	const uint8_t* index = bytes + loadU64(bytes + 16);
+	bool failed = records == NULL || columns == NULL;
+
+	for (int b = 0; b < numberOfBlocks && !failed; b++)
+	{
+		uint64_t offset = loadU64(index + b * COLUMNAR_INDEX_ENTRY_SIZE);
+		// cada bloco s pode ocupar o que falta at  quantidade do cabealho
+		int decoded = offset < size ? decodeExecutionBlock(bytes + offset, size - offset, records + *count, total - *count, columns) : -1;
+
+		failed = decoded < 0;
+		*count += failed ? 0 : decoded;
+	}
+
+	failed = failed || *count != total; // blocos com menos execues do que o cabealho indica
+
+	free(columns);
+	free(bytes);
+
+	if (failed)
+	{
+		free(records);
+		*count = 0;
+		return NULL;
+	}
+
+	return records;
+}
+
+
+/**
+* @brief	Ler de um ficheiro por colunas os registos de todas as execues para a tabela hash.
+*			Cada bloco  descodificado para um buffer e as execues so ligadas diretamente s posies da tabela
+* @param	fileName	Nome do ficheiro
+* @param	table		Tabela hash das execues (pode j ter execues)
+* @return	Quantidade de execues inseridas na tabela (ou -1 se falhou)
+*/
+int readExecutions_Columnar_AtTable(char fileName[], ExecutionNode* table[])
+{
+	uint64_t size = 0;
+	int numberOfBlocks = 0;
+	int total = 0;
+
+	uint8_t* bytes = loadColumnarFile(fileName, &size, &numberOfBlocks, &total);
+	if (bytes == NULL)
+	{
+		return -1;
+	}
+
+	int read = 0;
+	FileExecution* records = (FileExecution*)malloc(COLUMNAR_BLOCK_SIZE * sizeof(FileExecution));
+	int* columns = (int*)malloc(COLUMNAR_BLOCK_SIZE * sizeof(int));
+	KeySet* keys = createKeySet(total); // j validada com o tamanho do ficheiro (o conjunto cresce se for preciso)
+	const uint8_t* index = bytes + loadU64(bytes + 16);
+	bool failed = records == NULL || columns == NULL || keys == NULL;
+	int inserted = 0;
+
+	// as execues que j estavam na tabela contam para os duplicados
+	for (int b = 0; b < HASH_TABLE_SIZE && !failed; b++)
+	{
+		for (Execution* aux = table[b]->start; aux != NULL; aux = aux->next)
+		{
+			insertKey(keys, EXECUTION_KEY(aux->operationID, aux->machineID), b);
+		}
+	}
+
+	for (int b = 0; b < numberOfBlocks && !failed; b++)
+	{
+		uint64_t offset = loadU64(index + b * COLUMNAR_INDEX_ENTRY_SIZE);
+		int decoded = offset < size ? decodeExecutionBlock(bytes + offset, size - offset, records, total - read < COLUMNAR_BLOCK_SIZE ? total - read : COLUMNAR_BLOCK_SIZE, columns) : -1;
+
+		failed = decoded < 0;
+		read += failed ? 0 : decoded;
+
+		for (int i = 0; i < decoded; i++)
+		{
+			if (records[i].operationID < 0) // a posio na tabela hash no aceita negativos
+			{
+				failed = true;
+				break;
+			}
+
+			int position = generateHash_AtTable(table, records[i].operationID);
+
+			if (insertKey(keys, EXECUTION_KEY(records[i].operationID, records[i].machineID), position))
+			{
+				Execution* new = newExecution(records[i].operationID, records[i].machineID, records[i].runtime);
+				if (new == NULL) // se no houver memria para alocar
+				{
+					failed = true;
+					break;
+				}
+
+				new->next = table[position]->start;
+				table[position]->start = new;
+				table[position]->numberOfExecutions++;
+				inserted++;
+			}
+		}
+	}
+
+	failed = failed || read != total;
+
+	freeKeySet(keys);
+	free(columns);
+	free(records);
+	free(bytes);
+
+	return failed ? -1 : inserted;
+}
+
+#pragma endregion
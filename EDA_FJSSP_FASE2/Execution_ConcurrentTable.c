@@ -0,0 +1,320 @@
+/**
+ * @brief	Ficheiro com as funes da tabela hash de execues para acesso concorrente (vrias threads em simultneo)
+ * @file	executions_concurrenttable.c
+ * @author	Vnia Pereira
+ * @email	a19264@alunos.ipca.pt
+ * @date	2022
+ * @Disciplina Estruturas de Dados Avanadas
+ *
+ * -----------------
+ *
+ * Cada posio da tabela  protegida por um dos CONCURRENT_TABLE_STRIPES mutexes (lock striping).
+ * Todas as execues de uma operao ficam na mesma posio, por isso cada insero, atualizao ou
+ * remoo bloqueia apenas um mutex e  atmica para as restantes threads.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "header.h"
+
+
+#pragma region trabalhar com tabela hash concorrente
+
+/**
+* @brief	Criar tabela hash concorrente das execues vazia
+* @param	expectedExecutions	Quantidade de execues prevista, para dimensionar a tabela
+* @return	Tabela hash concorrente criada (ou NULL se no houver memria)
+*/
+ConcurrentExecutionsTable* createConcurrentExecutionsTable(int expectedExecutions)
+{
+	ConcurrentExecutionsTable* table = (ConcurrentExecutionsTable*)malloc(sizeof(ConcurrentExecutionsTable));
+	if (table == NULL) // se no houver memria para alocar
+	{
+		return NULL;
+	}
+
+	// potncia de 2 com, no mximo, 2 execues por posio e nunca menos posies que mutexes
+	int size = CONCURRENT_TABLE_STRIPES;
+	while (size < expectedExecutions / 2)
+	{
+		size *= 2;
+	}
+
+	table->buckets = (ExecutionNode*)calloc(size, sizeof(ExecutionNode));
+	if (table->buckets == NULL)
+	{
+		free(table);
+		return NULL;
+	}
+
+	table->numberOfBuckets = size;
+	table->numberOfExecutions = 0;
+
+	for (int i = 0; i < CONCURRENT_TABLE_STRIPES; i++)
+	{
+		initMutex(&table->locks[i].mutex);
+	}
+
+	return table;
+}
+
+
+/**
+* @brief	Obter a posio de uma operao na tabela hash concorrente
+* @param	table			Tabela hash concorrente das execues
+* @param	operationID		Identificador da operao
+* @return	Posio na tabela
+*/
+static int getConcurrentBucket(ConcurrentExecutionsTable* table, int operationID)
+{
+	unsigned int hash = (unsigned int)operationID * 0x9E3779B1u;
+	hash ^= hash >> 16;
+
+	return (int)(hash & (unsigned int)(table->numberOfBuckets - 1));
+}
+
+
+/**
+* @brief	Obter o mutex que protege uma posio da tabela hash concorrente
+* @param	table	Tabela hash concorrente das execues
+* @param	index	Posio na tabela
+* @return	Apontador para o mutex
+*/
+static Mutex* getConcurrentLock(ConcurrentExecutionsTable* table, int index)
+{
+	// o nmero de posies  mltiplo do nmero de mutexes, por isso cada posio usa sempre o mesmo
+	return &table->locks[index & (CONCURRENT_TABLE_STRIPES - 1)].mutex;
+}
+
+
+/**
+* @brief	Inserir nova execuo na tabela hash concorrente
+* @param	table	Tabela hash concorrente das execues
+* @param	new		Nova execuo (fica a pertencer  tabela se for inserida)
+* @return	Booleano para o resultado da funo (falso se j existir a execuo)
+*/
+bool insertExecution_AtConcurrentTable(ConcurrentExecutionsTable* table, Execution* new)
+{
+	if (table == NULL || new == NULL)
+	{
+		return false;
+	}
+
+	int index = getConcurrentBucket(table, new->operationID);
+	Mutex* lock = getConcurrentLock(table, index);
+
+	lockMutex(lock);
+
+	Execution* start = insertExecutionAtStart(table->buckets[index].start, new);
+	if (start != NULL)
+	{
+		table->buckets[index].start = start;
+		table->buckets[index].numberOfExecutions++;
+	}
+
+	unlockMutex(lock);
+
+	if (start == NULL) // se j existir a execuo
+	{
+		return false;
+	}
+
+	atomicAdd(&table->numberOfExecutions, 1);
+	bumpOperationVersion(new->operationID);
+
+	return true;
+}
+
+
+/**
+* @brief	Atualizar as unidades de tempo de uma execuo na tabela hash concorrente
+* @param	table			Tabela hash concorrente das execues
+* @param	operationID		Identificador da operao
+* @param	machineID		Identificador da mquina
+* @param	runtime			Unidades de tempo
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool updateRuntime_AtConcurrentTable(ConcurrentExecutionsTable* table, int operationID, int machineID, int runtime)
+{
+	if (table == NULL)
+	{
+		return false;
+	}
+
+	int index = getConcurrentBucket(table, operationID);
+	Mutex* lock = getConcurrentLock(table, index);
+
+	lockMutex(lock);
+	bool updated = updateRuntime(&table->buckets[index].start, operationID, machineID, runtime);
+	unlockMutex(lock);
+
+	return updated;
+}
+
+
+/**
+* @brief	Remover todas as execues de uma operao da tabela hash concorrente, de uma s vez
+* @param	table			Tabela hash concorrente das execues
+* @param	operationID		Identificador da operao
+* @return	Quantidade de execues removidas
+*/
+int deleteExecutions_ByOperation_AtConcurrentTable(ConcurrentExecutionsTable* table, int operationID)
+{
+	if (table == NULL)
+	{
+		return 0;
+	}
+
+	int index = getConcurrentBucket(table, operationID);
+	Mutex* lock = getConcurrentLock(table, index);
+	int deleted = 0;
+
+	lockMutex(lock);
+
+	Execution** aux = &table->buckets[index].start;
+
+	while (*aux != NULL) // percorrer a lista uma s vez, desassociando as execues da operao
+	{
+		if ((*aux)->operationID == operationID)
+		{
+			Execution* removed = *aux;
+			*aux = removed->next;
+			free(removed);
+			deleted++;
+		}
+		else
+		{
+			aux = &(*aux)->next;
+		}
+	}
+
+	table->buckets[index].numberOfExecutions -= deleted;
+
+	unlockMutex(lock);
+
+	atomicAdd(&table->numberOfExecutions, -deleted);
+
+	if (deleted > 0)
+	{
+		bumpOperationVersion(operationID);
+	}
+
+	return deleted;
+}
+
+
+/**
+* @brief	Procurar por uma execuo na tabela hash concorrente.
+*			 devolvida uma cpia, porque a execuo pode ser alterada ou removida por outra thread depois da pesquisa
+* @param	table			Tabela hash concorrente das execues
+* @param	operationID		Identificador da operao
+* @param	machineID		Identificador da mquina
+* @param	result			Apontador para a cpia da execuo encontrada
+* @return	Booleano para o resultado da funo (se encontrou ou no)
+*/
+bool searchExecution_AtConcurrentTable(ConcurrentExecutionsTable* table, int operationID, int machineID, Execution* result)
+{
+	if (table == NULL || result == NULL)
+	{
+		return false;
+	}
+
+	int index = getConcurrentBucket(table, operationID);
+	Mutex* lock = getConcurrentLock(table, index);
+
+	lockMutex(lock);
+
+	Execution* search = searchExecution(table->buckets[index].start, operationID, machineID);
+	if (search != NULL)
+	{
+		*result = *search;
+		result->next = NULL;
+	}
+
+	unlockMutex(lock);
+
+	return search != NULL;
+}
+
+
+/**
+* @brief	Mover todas as execues da tabela hash concorrente para a tabela hash das execues.
+*			Deve ser chamada quando j no houver threads a usar a tabela concorrente, que fica vazia
+* @param	concurrent	Tabela hash concorrente das execues
+* @param	table		Tabela hash das execues
+* @return	Quantidade de execues movidas
+*/
+int moveExecutions_ToTable(ConcurrentExecutionsTable* concurrent, ExecutionNode* table[])
+{
+	if (concurrent == NULL || table == NULL)
+	{
+		return 0;
+	}
+
+	int moved = 0;
+
+	for (int i = 0; i < concurrent->numberOfBuckets; i++)
+	{
+		Execution* aux = concurrent->buckets[i].start;
+
+		while (aux != NULL)
+		{
+			Execution* next = aux->next;
+			aux->next = NULL;
+
+			int index = generateHash_AtTable(table, aux->operationID);
+			if (searchExecution(table[index]->start, aux->operationID, aux->machineID)) // j existe na tabela de destino
+			{
+				free(aux);
+			}
+			else
+			{
+				aux->next = table[index]->start;
+				table[index]->start = aux;
+				table[index]->numberOfExecutions++;
+				moved++;
+			}
+
+			aux = next;
+		}
+
+		concurrent->buckets[i].start = NULL;
+		concurrent->buckets[i].numberOfExecutions = 0;
+	}
+
+	concurrent->numberOfExecutions = 0;
+
+	return moved;
+}
+
+
+/**
+* @brief	Libertar a tabela hash concorrente das execues da memria
+* @param	table	Tabela hash concorrente das execues
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool freeConcurrentExecutionsTable(ConcurrentExecutionsTable* table)
+{
+	if (table == NULL)
+	{
+		return false;
+	}
+
+	for (int i = 0; i < table->numberOfBuckets; i++)
+	{
+		freeExecutions(table->buckets[i].start);
+	}
+
+	for (int i = 0; i < CONCURRENT_TABLE_STRIPES; i++)
+	{
+		destroyMutex(&table->locks[i].mutex);
+	}
+
+	free(table->buckets);
+	free(table);
+
+	return true;
+}
+
+#pragma endregion
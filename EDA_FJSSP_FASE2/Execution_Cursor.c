@@ -0,0 +1,351 @@
+/**
+ * @brief	Ficheiro com as funes para percorrer as execues de um ficheiro binrio sem as carregar todas em memria
+ * @file	executions_cursor.c
+ * @author	Vnia Pereira
+ * @email	a19264@alunos.ipca.pt
+ * @date	2022
+ * @Disciplina Estruturas de Dados Avanadas
+ *
+ * -----------------
+ *
+ * O cursor l o ficheiro em blocos de tamanho fixo e aplica o filtro logo na leitura,
+ * por isso a memria usada no depende do tamanho do ficheiro.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "header.h"
+
+
+#pragma region cursor sobre execues em ficheiro
+
+/**
+* @brief	Abrir um cursor sobre as execues de um ficheiro binrio
+* @param	fileName	Nome do ficheiro
+* @param	filter		Filtro a aplicar (FILTER_NONE, FILTER_BY_OPERATION ou FILTER_BY_MACHINE)
+* @param	filterID	Identificador da operao ou mquina do filtro
+* @param	batchSize	Quantidade de registos lidos de cada vez (0 para CURSOR_BATCH_SIZE)
+* @return	Cursor aberto (ou NULL se no foi possvel abrir o ficheiro)
+*/
+ExecutionCursor* openExecutionCursor(char fileName[], ExecutionFilter filter, int filterID, int batchSize)
+{
+	ExecutionCursor* cursor = (ExecutionCursor*)malloc(sizeof(ExecutionCursor));
+	if (cursor == NULL) // se no houver memria para alocar
+	{
+		return NULL;
+	}
+
+	cursor->batchSize = batchSize > 0 ? batchSize : CURSOR_BATCH_SIZE;
+	cursor->batch = (FileExecution*)malloc(cursor->batchSize * sizeof(FileExecution));
+	cursor->file = fopen(fileName, "rb");
+
+	if (cursor->batch == NULL || cursor->file == NULL)
+	{
+		if (cursor->file != NULL)
+		{
+			fclose(cursor->file);
+		}
+		free(cursor->batch);
+		free(cursor);
+		return NULL;
+	}
+
+	cursor->filter = filter;
+	cursor->filterID = filterID;
+	cursor->count = 0;
+	cursor->position = 0;
+	cursor->finished = false;
+
+	return cursor;
+}
+
+
+/**
+* @brief	Verificar se um registo passa no filtro do cursor
+* @param	cursor	Cursor
+* @param	record	Registo
+* @return	Booleano para o resultado da funo (se passa ou no)
+*/
+static bool matchesFilter(ExecutionCursor* cursor, FileExecution* record)
+{
+	switch (cursor->filter)
+	{
+	case FILTER_BY_OPERATION:
+		return record->operationID == cursor->filterID;
+	case FILTER_BY_MACHINE:
+		return record->machineID == cursor->filterID;
+	default:
+		return true;
+	}
+}
+
+
+/**
+* @brief	Obter o prximo bloco de execues que passam no filtro.
+*			Os registos devolvidos pertencem ao cursor e s so vlidos at  prxima leitura
+* @param	cursor	Cursor
+* @param	records	Apontador para os registos do bloco
+* @return	Quantidade de registos no bloco (0 quando o ficheiro terminar)
+*/
+int nextExecutionBatch(ExecutionCursor* cursor, FileExecution** records)
+{
+	if (cursor == NULL)
+	{
+		return 0;
+	}
+
+	// continuar a ler enquanto os blocos lidos no tiverem nenhum registo que passe no filtro
+	while (!cursor->finished)
+	{
+		int read = (int)fread(cursor->batch, sizeof(FileExecution), cursor->batchSize, cursor->file);
+		int count = 0;
+
+		if (read < cursor->batchSize)
+		{
+			cursor->finished = true;
+		}
+
+		if (cursor->filter == FILTER_NONE)
+		{
+			count = read;
+		}
+		else // compactar o bloco, mantendo apenas os registos que passam no filtro
+		{
+			for (int i = 0; i < read; i++)
+			{
+				if (matchesFilter(cursor, &cursor->batch[i]))
+				{
+					cursor->batch[count++] = cursor->batch[i];
+				}
+			}
+		}
+
+		if (count > 0)
+		{
+			cursor->count = 0; // o bloco  entregue todo de uma vez
+			cursor->position = 0;
+			*records = cursor->batch;
+			return count;
+		}
+	}
+
+	return 0;
+}
+
+
+/**
+* @brief	Obter a prxima execuo que passa no filtro
+* @param	cursor	Cursor
+* @param	record	Apontador para a execuo lida
+* @return	Booleano para o resultado da funo (falso quando o ficheiro terminar)
+*/
+bool nextExecution(ExecutionCursor* cursor, FileExecution* record)
+{
+	if (cursor == NULL || record == NULL)
+	{
+		return false;
+	}
+
+	if (cursor->position >= cursor->count)
+	{
+		FileExecution* records = NULL;
+
+		cursor->count = nextExecutionBatch(cursor, &records);
+		cursor->position = 0;
+
+		if (cursor->count == 0)
+		{
+			return false;
+		}
+	}
+
+	*record = cursor->batch[cursor->position++];
+
+	return true;
+}
+
+
+/**
+* @brief	Fechar um cursor e libert-lo da memria
+* @param	cursor	Cursor
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool closeExecutionCursor(ExecutionCursor* cursor)
+{
+	if (cursor == NULL)
+	{
+		return false;
+	}
+
+	fclose(cursor->file);
+	free(cursor->batch);
+	free(cursor);
+
+	return true;
+}
+
+#pragma endregion
+
+
+#pragma region agregaes numa s passagem
+
+/**
+* @brief	Iniciar um agregado vazio
+* @param	aggregate	Agregado
+*/
+static void initAggregate(ExecutionAggregate* aggregate)
+{
+	aggregate->count = 0;
+	aggregate->sum = 0;
+	aggregate->min = 0;
+	aggregate->max = 0;
+}
+
+
+/**
+* @brief	Acrescentar um tempo de execuo a um agregado
+* @param	aggregate	Agregado
+* @param	runtime		Unidades de tempo
+*/
+static void addToAggregate(ExecutionAggregate* aggregate, int runtime)
+{
+	if (aggregate->count == 0 || runtime < aggregate->min)
+	{
+		aggregate->min = runtime;
+	}
+	if (aggregate->count == 0 || runtime > aggregate->max)
+	{
+		aggregate->max = runtime;
+	}
+
+	aggregate->sum += runtime;
+	aggregate->count++;
+}
+
+
+/**
+* @brief	Calcular a quantidade, soma, mnimo e mximo dos tempos das execues de um ficheiro que passam num filtro,
+*			numa s passagem e com memria constante
+* @param	fileName	Nome do ficheiro
+* @param	filter		Filtro a aplicar
+* @param	filterID	Identificador da operao ou mquina do filtro
+* @param	aggregate	Apontador para o agregado calculado
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool aggregateExecutions_File(char fileName[], ExecutionFilter filter, int filterID, ExecutionAggregate* aggregate)
+{
+	ExecutionCursor* cursor = openExecutionCursor(fileName, filter, filterID, 0);
+	if (cursor == NULL || aggregate == NULL)
+	{
+		closeExecutionCursor(cursor);
+		return false;
+	}
+
+	FileExecution* records = NULL;
+	int count = 0;
+
+	initAggregate(aggregate);
+
+	while ((count = nextExecutionBatch(cursor, &records)) > 0)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			addToAggregate(aggregate, records[i].runtime);
+		}
+	}
+
+	closeExecutionCursor(cursor);
+
+	return true;
+}
+
+
+/**
+* @brief	Calcular os agregados dos tempos das execues de um ficheiro, agrupados por operao ou por mquina, numa s passagem.
+*			A memria usada depende apenas da quantidade de grupos (no mximo capacity), no da quantidade de registos
+* @param	fileName	Nome do ficheiro
+* @param	groupBy		FILTER_BY_OPERATION para agrupar por operao, FILTER_BY_MACHINE para agrupar por mquina
+* @param	ids			Array onde  guardado o identificador de cada grupo
+* @param	aggregates	Array onde  guardado o agregado de cada grupo
+* @param	capacity	Tamanho dos arrays
+* @return	Quantidade de grupos (ou -1 se falhou ou existirem mais grupos que capacity)
+*/
+int aggregateExecutions_ByGroup_File(char fileName[], ExecutionFilter groupBy, int ids[], ExecutionAggregate aggregates[], int capacity)
+{
+	if (groupBy == FILTER_NONE || ids == NULL || aggregates == NULL)
+	{
+		return -1;
+	}
+
+	ExecutionCursor* cursor = openExecutionCursor(fileName, FILTER_NONE, 0, 0);
+	KeySet* groups = createKeySet(capacity);
+
+	if (cursor == NULL || groups == NULL)
+	{
+		closeExecutionCursor(cursor);
+		freeKeySet(groups);
+		return -1;
+	}
+
+	FileExecution* records = NULL;
+	int numberOfGroups = 0;
+	int count = 0;
+	bool overflow = false;
+
+	while (!overflow && (count = nextExecutionBatch(cursor, &records)) > 0)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			int id = groupBy == FILTER_BY_OPERATION ? records[i].operationID : records[i].machineID;
+			int group = getKeyValue(groups, id);
+
+			if (group < 0) // primeiro registo deste grupo
+			{
+				if (numberOfGroups == capacity)
+				{
+					overflow = true;
+					break;
+				}
+
+				group = numberOfGroups++;
+				insertKey(groups, id, group);
+				ids[group] = id;
+				initAggregate(&aggregates[group]);
+			}
+
+			addToAggregate(&aggregates[group], records[i].runtime);
+		}
+	}
+
+	closeExecutionCursor(cursor);
+	freeKeySet(groups);
+
+	return overflow ? -1 : numberOfGroups;
+}
+
+
+/**
+* @brief	Obter a mdia de tempo necessrio para completar uma operao, lendo as execues diretamente do ficheiro
+* @param	fileName		Nome do ficheiro
+* @param	operationID		Identificador da operao
+* @return	Valor da mdia de tempo (ou -1 se no foi possvel ler o ficheiro)
+*/
+float getAverageTimeToCompleteOperation_File(char fileName[], int operationID)
+{
+	ExecutionAggregate aggregate;
+
+	if (!aggregateExecutions_File(fileName, FILTER_BY_OPERATION, operationID, &aggregate))
+	{
+		return -1.0f;
+	}
+
+	if (aggregate.count == 0) // para no permitir diviso por 0
+	{
+		return 0.0f;
+	}
+
+	return (float)aggregate.sum / aggregate.count;
+}
+
+#pragma endregion
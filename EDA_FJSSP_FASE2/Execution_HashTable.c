@@ -3,6 +3,7 @@
 #include <stdbool.h>
 #include "header.h"
 
+
 #pragma region trabalhar com tabela hash
 
 /**
@@ -31,6 +32,7 @@ ExecutionNode* createExecutionNode()
 
 	node->start = NULL;
 	node->numberOfExecutions = 0;
+	node->hashSeed = 0; // 0 corresponde ao resto da diviso original
 
 	return node;
 }
@@ -39,28 +41,74 @@ ExecutionNode* createExecutionNode()
 /**
 * @brief	Gerar hash atravs de uma funo.
 *			A funo  representada pelo resto da diviso do identificador da operao pelo tamanho da tabela
+*			( a funo das tabelas que nunca foram redistribudas; para uma tabela concreta usar generateHash_AtTable)
 * @param	operationID		Identificador da operao
 * @return	Valor calculado pela funo hash
 */
 int generateHash(int operationID)   //funo de hash
 {
-	return operationID % HASH_TABLE_SIZE;     //para ver qual o valor onde vai entrar a chave, temos que dividir o id pelo tamanho da tabale hash 13 
+	return generateHash_WithSeed(operationID, 0);
+}
+
+
+/**
+* @brief	Gerar hash com uma semente especfica.
+*			Com semente 0  usado o resto da diviso original, caso contrrio os bits do identificador so misturados
+*			(hash multiplicativo) antes do resto da diviso, para espalhar identificadores com padres regulares
+* @param	operationID		Identificador da operao
+* @param	seed			Semente da funo de hash
+* @return	Valor calculado pela funo hash
+*/
+int generateHash_WithSeed(int operationID, unsigned int seed)
+{
+	if (seed == 0)
+	{
+		return operationID % HASH_TABLE_SIZE;     //para ver qual o valor onde vai entrar a chave, temos que dividir o id pelo tamanho da tabale hash 13 
+	}
+
+	unsigned int hash = (unsigned int)operationID ^ seed;
+	hash *= 0x9E3779B1u; // constante de Knuth (razo de ouro)
+	hash ^= hash >> 16;
 
-	//exemplo uma chave de 50, vai entrar na posio 80000
+	return (int)(hash % HASH_TABLE_SIZE);
 }
 
 
 /**
-* @brief	Inserir nova execuo na tabela hash das execues, numa determinada posio
+* @brief	Gerar hash com a semente de uma tabela hash das execues.
+*			Cada tabela tem a sua semente, por isso redistribuir uma tabela no altera as posies das outras
+* @param	table			Tabela hash das execues
+* @param	operationID		Identificador da operao
+* @return	Posio da operao na tabela
+*/
+int generateHash_AtTable(ExecutionNode* table[], int operationID)
+{
+	return generateHash_WithSeed(operationID, table[0]->hashSeed);
+}
+
+
+/**
+* @brief	Inserir nova execuo na tabela hash das execues, numa determinada posio.
+*			A tabela fica com a execuo: se j existir uma com a mesma operao e mquina, a nova  libertada
 * @param	table	Tabela hash das execues
+* @param	new		Nova execuo
 * @return	Tabela hash das execues atualizada
 */
 ExecutionNode** insertExecution_AtTable(ExecutionNode* table[], Execution* new)
 {
-	int index = generateHash(new->operationID);
+	int index = generateHash_AtTable(table, new->operationID);
 
-	table[index]->start = insertExecutionAtStart(table[index]->start, new);
-	table[index]->numberOfExecutions++;
+	Execution* start = insertExecutionAtStart(table[index]->start, new);
+	if (start != NULL)
+	{
+		table[index]->start = start;
+		table[index]->numberOfExecutions++;
+		bumpOperationVersion(new->operationID);
+	}
+	else // se j existir a execuo, a lista da posio no  alterada
+	{
+		free(new);
+	}
 
 	return *table;
 }
@@ -78,7 +126,7 @@ bool updateRuntime_ByOperation_AtTable(ExecutionNode** table[], int operationID,
 {
 	ExecutionNode** current = table;
 
-	int index = generateHash(operationID);
+	int index = generateHash_AtTable(current, operationID);
 	bool updated = updateRuntime(&current[index]->start, operationID, machineID, runtime);
 
 	return updated;
@@ -95,13 +143,14 @@ bool deleteExecutions_ByOperation_AtTable(ExecutionNode** table[], int operation
 {
 	ExecutionNode** current = table;
 
-	int index = generateHash(operationID);
+	int index = generateHash_AtTable(current, operationID);
 	if (index <= -1)
 	{
 		return false;
 	}
 
 	bool deleted = false;
+	bool deletedAny = false;
 
 	do
 	{
@@ -111,10 +160,11 @@ bool deleteExecutions_ByOperation_AtTable(ExecutionNode** table[], int operation
 		if (deleted)
 		{
 			current[index]->numberOfExecutions--;
+			deletedAny = true;
 		}
 	} while (deleted == true);
 
-	return deleted;
+	return deletedAny;
 }
 
 
@@ -131,27 +181,30 @@ bool writeExecutions_AtTable(char fileName[], ExecutionNode* table[])
 		return false;
 	}
 
-	Execution* allList = NULL;
-	Execution* last = NULL;
+	FILE* file = NULL;
+
+	if ((file = fopen(fileName, "wb")) == NULL) // se no foi possvel abrir o ficheiro
+	{
+		return false;
+	}
 
-	bool written = false;
+	FileExecution currentInFile; //  a mesma estrutura mas sem o campo *next, uma vez que esse campo no  armazenado no ficheiro
 
+	// cada lista  gravada diretamente, sem ligar as listas umas s outras (a tabela no  alterada)
 	for (int i = 0; i < HASH_TABLE_SIZE; i++)
 	{
-		if (i == 0)
-		{
-			allList = table[0]->start;
-		}
-		else
+		for (Execution* current = table[i]->start; current != NULL; current = current->next)
 		{
-			last = getLastExecution(allList);
-			last->next = table[i]->start;
+			currentInFile.operationID = current->operationID;
+			currentInFile.machineID = current->machineID;
+			currentInFile.runtime = current->runtime;
+			fwrite(&currentInFile, sizeof(FileExecution), 1, file); // guarda cada registo da lista no ficheiro
 		}
 	}
 
-	written = writeExecutions(fileName, allList);
+	fclose(file);
 
-	return written;
+	return true;
 }
 
 
@@ -228,7 +281,7 @@ Execution* searchExecution_AtTable(ExecutionNode* table[], int operationID, int
 		return NULL;
 	}
 
-	int index = generateHash(operationID);
+	int index = generateHash_AtTable(table, operationID);
 	Execution* search = searchExecution(table[index]->start, operationID, machineID);
 
 	if (search == NULL) // se a lista estiver vazia
@@ -241,10 +294,292 @@ Execution* searchExecution_AtTable(ExecutionNode* table[], int operationID, int
 
 /**
 * @brief	Libertar a tabela hash de execues da memria
-* @param	head	Lista de execues
-* @return	Tabela hash libertada da memria
+* @param	table	Tabela hash das execues
+* @return	Booleano para o resultado da funo (se funcionou ou no)
 */
+bool freeExecutionsTable(ExecutionNode* table[])
+{
+	if (table == NULL)
+	{
+		return false;
+	}
+
+	for (int i = 0; i < HASH_TABLE_SIZE; i++)
+	{
+		freeExecutions(table[i]->start);
+		free(table[i]);
+		table[i] = NULL;
+	}
+
+	return true;
+}
+
+
+/**
+* @brief	Copiar a tabela hash das execues para outra tabela, com cpias de todas as listas
+* @param	source		Tabela hash das execues a copiar
+* @param	destination	Tabela hash que recebe a cpia (as posies so criadas)
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool copyExecutionsTable(ExecutionNode* source[], ExecutionNode* destination[])
+{
+	if (source == NULL || destination == NULL)
+	{
+		return false;
+	}
+
+	for (int i = 0; i < HASH_TABLE_SIZE; i++)
+	{
+		destination[i] = createExecutionNode();
+		destination[i]->start = copyExecutions(source[i]->start);
+		destination[i]->numberOfExecutions = source[i]->numberOfExecutions;
+		destination[i]->hashSeed = source[i]->hashSeed;
+	}
+
+	return true;
+}
+
+#pragma endregion
+
+
+#pragma region estatsticas da tabela hash
+
+/**
+* @brief	Obter as estatsticas de ocupao da tabela hash das execues.
+*			O tamanho real de cada lista  contado, e o campo numberOfExecutions de cada posio  corrigido se estiver diferente
+* @param	table	Tabela hash das execues
+* @param	stats	Apontador para as estatsticas a ser devolvidas
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool getExecutionsTableStats(ExecutionNode* table[], ExecutionsTableStats* stats)
+{
+	if (table == NULL || stats == NULL)
+	{
+		return false;
+	}
+
+	int sumOfSquares = 0; // soma dos quadrados dos tamanhos, para o custo das pesquisas com sucesso
+
+	stats->numberOfBuckets = HASH_TABLE_SIZE;
+	stats->numberOfExecutions = 0;
+	stats->emptyBuckets = 0;
+	stats->maxChainLength = 0;
+	stats->driftedBuckets = 0;
+	stats->rehashed = false;
+
+	for (int i = 0; i < HASH_TABLE_HISTOGRAM_SIZE; i++)
+	{
+		stats->histogram[i] = 0;
+	}
+
+	for (int i = 0; i < HASH_TABLE_SIZE; i++)
+	{
+		int length = 0;
+		Execution* aux = table[i]->start;
+
+		while (aux != NULL)
+		{
+			length++;
+			aux = aux->next;
+		}
+
+		if (table[i]->numberOfExecutions != length) // contador desatualizado,  reposto com o valor real
+		{
+			table[i]->numberOfExecutions = length;
+			stats->driftedBuckets++;
+		}
+
+		if (length == 0)
+		{
+			stats->emptyBuckets++;
+		}
+
+		if (length > stats->maxChainLength)
+		{
+			stats->maxChainLength = length;
+		}
 
+		// a ltima classe do histograma agrupa todas as listas com esse tamanho ou superior
+		stats->histogram[length < HASH_TABLE_HISTOGRAM_SIZE ? length : HASH_TABLE_HISTOGRAM_SIZE - 1]++;
 
+		stats->numberOfExecutions += length;
+		sumOfSquares += length * length;
+	}
+
+	int usedBuckets = HASH_TABLE_SIZE - stats->emptyBuckets;
+
+	stats->loadFactor = (float)stats->numberOfExecutions / HASH_TABLE_SIZE;
+	stats->meanChainLength = usedBuckets > 0 ? (float)stats->numberOfExecutions / usedBuckets : 0.0f;
+
+	// pesquisa com sucesso: em mdia percorre metade da lista onde o elemento est, ponderado pelo tamanho de cada lista
+	stats->successfulLookupCost = stats->numberOfExecutions > 0
+		? (float)(sumOfSquares + stats->numberOfExecutions) / (2.0f * stats->numberOfExecutions)
+		: 0.0f;
+
+	// pesquisa sem sucesso: percorre a lista inteira de uma posio qualquer
+	stats->unsuccessfulLookupCost = stats->loadFactor;
+
+	return true;
+}
+
+
+/**
+* @brief	Mostrar as estatsticas da tabela hash das execues na consola
+* @param	stats	Estatsticas da tabela hash
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool displayExecutionsTableStats(ExecutionsTableStats* stats)
+{
+	if (stats == NULL)
+	{
+		return false;
+	}
+
+	printf("Posies: %d, Execues: %d, Fator de carga: %.2f\n", stats->numberOfBuckets, stats->numberOfExecutions, stats->loadFactor);
+	printf("Maior lista: %d, Mdia das listas ocupadas: %.2f, Posies vazias: %d\n", stats->maxChainLength, stats->meanChainLength, stats->emptyBuckets);
+	printf("Custo estimado de pesquisa: %.2f (com sucesso), %.2f (sem sucesso)\n", stats->successfulLookupCost, stats->unsuccessfulLookupCost);
+
+	for (int i = 0; i < HASH_TABLE_HISTOGRAM_SIZE; i++)
+	{
+		printf("Listas com %d%s elementos: %d\n", i, i == HASH_TABLE_HISTOGRAM_SIZE - 1 ? " ou mais" : "", stats->histogram[i]);
+	}
+
+	return true;
+}
+
+
+/**
+* @brief	Calcular o tamanho da maior lista que a tabela teria com uma determinada semente, sem mover as execues
+* @param	table	Tabela hash das execues
+* @param	seed	Semente da funo de hash
+* @return	Tamanho da maior lista
+*/
+static int getMaxChainLength_WithSeed(ExecutionNode* table[], unsigned int seed)
+{
+	int lengths[HASH_TABLE_SIZE] = { 0 };
+	int max = 0;
+
+	for (int i = 0; i < HASH_TABLE_SIZE; i++)
+	{
+		for (Execution* aux = table[i]->start; aux != NULL; aux = aux->next)
+		{
+			int index = generateHash_WithSeed(aux->operationID, seed);
+
+			if (++lengths[index] > max)
+			{
+				max = lengths[index];
+			}
+		}
+	}
+
+	return max;
+}
+
+
+/**
+* @brief	Redistribuir as execues da tabela hash com uma nova semente da funo de hash.
+*			Os ns existentes so reaproveitados, apenas mudam de posio
+* @param	table	Tabela hash das execues
+* @param	seed	Nova semente da funo de hash
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool rehashExecutionsTable(ExecutionNode* table[], unsigned int seed)
+{
+	if (table == NULL)
+	{
+		return false;
+	}
+
+	Execution* all = NULL;
+
+	// desassociar todas as execues das posies da tabela para uma nica lista
+	for (int i = 0; i < HASH_TABLE_SIZE; i++)
+	{
+		Execution* aux = table[i]->start;
+
+		while (aux != NULL)
+		{
+			Execution* next = aux->next;
+			aux->next = all;
+			all = aux;
+			aux = next;
+		}
+
+		table[i]->start = NULL;
+		table[i]->numberOfExecutions = 0;
+		table[i]->hashSeed = seed;
+	}
+
+	// voltar a inserir com a nova funo de hash, sem verificar duplicados porque as execues j eram nicas
+	while (all != NULL)
+	{
+		Execution* next = all->next;
+		int index = generateHash_WithSeed(all->operationID, seed);
+
+		all->next = table[index]->start;
+		table[index]->start = all;
+		table[index]->numberOfExecutions++;
+
+		all = next;
+	}
+
+	return true;
+}
+
+
+/**
+* @brief	Verificar o estado da tabela hash e redistribuir as execues se os limites forem ultrapassados.
+*			Como o nmero de posies  fixo (HASH_TABLE_SIZE), um fator de carga elevado  apenas reportado,
+*			mas listas desproporcionais (identificadores enviesados) so corrigidas escolhendo outra semente
+* @param	table			Tabela hash das execues
+* @param	maxChainRatio	Razo mxima permitida entre a maior lista e o fator de carga
+* @param	stats			Apontador para as estatsticas a ser devolvidas (depois da eventual redistribuio)
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool checkExecutionsTable(ExecutionNode* table[], float maxChainRatio, ExecutionsTableStats* stats)
+{
+	if (!getExecutionsTableStats(table, stats))
+	{
+		return false;
+	}
+
+	// uma lista s  considerada degenerada se for maior que o esperado e que o mnimo de HASH_TABLE_MIN_CHAIN elementos
+	float limit = maxChainRatio * (stats->loadFactor > 1.0f ? stats->loadFactor : 1.0f);
+	if (stats->maxChainLength <= HASH_TABLE_MIN_CHAIN || stats->maxChainLength <= limit)
+	{
+		return true;
+	}
+
+	unsigned int currentSeed = table[0]->hashSeed;
+	unsigned int bestSeed = currentSeed;
+	int bestMax = stats->maxChainLength;
+	unsigned int candidate = currentSeed != 0 ? currentSeed : 0x2545F491u;
+
+	// experimentar algumas sementes (xorshift) e escolher a que produz a menor lista mxima
+	for (int i = 0; i < HASH_TABLE_REHASH_ATTEMPTS; i++)
+	{
+		candidate ^= candidate << 13;
+		candidate ^= candidate >> 17;
+		candidate ^= candidate << 5;
+
+		int max = getMaxChainLength_WithSeed(table, candidate);
+		if (max < bestMax)
+		{
+			bestMax = max;
+			bestSeed = candidate;
+		}
+	}
+
+	if (bestSeed == currentSeed) // nenhuma semente melhora a distribuio
+	{
+		return true;
+	}
+
+	rehashExecutionsTable(table, bestSeed);
+	getExecutionsTableStats(table, stats);
+	stats->rehashed = true;
+
+	return true;
+}
 
 #pragma endregion
@@ -0,0 +1,494 @@
+/**
+ * @brief	Ficheiro com as funes do ndice de execues por mquina
+ * @file	executions_machineindex.c
+ * @author	Vnia Pereira
+ * @email	a19264@alunos.ipca.pt
+ * @date	2022
+ * @Disciplina Estruturas de Dados Avanadas
+ *
+ * -----------------
+ *
+ * Para cada mquina  guardado um array contguo com as alternativas (operao, tempo) que pode executar,
+ * ordenado pelo tempo. A alternativa mais rpida de cada mquina  sempre a primeira do array.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "header.h"
+
+
+#pragma region trabalhar com ndice por mquina
+
+/**
+* @brief	Criar ndice de execues por mquina vazio
+* @return	ndice criado (ou NULL se no houver memria)
+*/
+MachineIndex* createMachineIndex()
+{
+	MachineIndex* index = (MachineIndex*)malloc(sizeof(MachineIndex));
+	if (index == NULL) // se no houver memria para alocar
+	{
+		return NULL;
+	}
+
+	index->capacity = NUMBER_MACHINES;
+	index->numberOfMachines = 0;
+	index->machines = (MachineAlternatives*)malloc(index->capacity * sizeof(MachineAlternatives));
+	index->slots = createKeySet(NUMBER_MACHINES);
+
+	if (index->machines == NULL || index->slots == NULL)
+	{
+		free(index->machines);
+		freeKeySet(index->slots);
+		free(index);
+		return NULL;
+	}
+
+	return index;
+}
+
+
+/**
+* @brief	Comparar duas alternativas pelo tempo e depois pela operao
+* @return	Negativo, zero ou positivo (como em qsort)
+*/
+static int compareAlternatives(const void* a, const void* b)
+{
+	const MachineAlternative* x = (const MachineAlternative*)a;
+	const MachineAlternative* y = (const MachineAlternative*)b;
+
+	if (x->runtime != y->runtime)
+	{
+		return x->runtime < y->runtime ? -1 : 1;
+	}
+	if (x->operationID != y->operationID)
+	{
+		return x->operationID < y->operationID ? -1 : 1;
+	}
+
+	return 0;
+}
+
+
+/**
+* @brief	Obter as alternativas de uma mquina, criando-as se a mquina ainda no existir no ndice
+* @param	index		ndice por mquina
+* @param	machineID	Identificador da mquina
+* @param	create		Se a mquina deve ser criada quando no existir
+* @return	Alternativas da mquina (ou NULL se no existir)
+*/
+static MachineAlternatives* getMachineAlternatives(MachineIndex* index, int machineID, bool create)
+{
+	int slot = getKeyValue(index->slots, machineID);
+
+	if (slot >= 0)
+	{
+		return &index->machines[slot];
+	}
+
+	if (!create)
+	{
+		return NULL;
+	}
+
+	if (index->numberOfMachines == index->capacity) // duplicar o array de mquinas
+	{
+		MachineAlternatives* machines = (MachineAlternatives*)realloc(index->machines, index->capacity * 2 * sizeof(MachineAlternatives));
+		if (machines == NULL)
+		{
+			return NULL;
+		}
+
+		index->machines = machines;
+		index->capacity *= 2;
+	}
+
+	slot = index->numberOfMachines++;
+	insertKey(index->slots, machineID, slot);
+
+	index->machines[slot].machineID = machineID;
+	index->machines[slot].alternatives = NULL;
+	index->machines[slot].count = 0;
+	index->machines[slot].capacity = 0;
+
+	return &index->machines[slot];
+}
+
+
+/**
+* @brief	Garantir espao para mais uma alternativa numa mquina
+* @param	machine		Alternativas da mquina
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+static bool reserveAlternative(MachineAlternatives* machine)
+{
+	if (machine->count < machine->capacity)
+	{
+		return true;
+	}
+
+	int capacity = machine->capacity > 0 ? machine->capacity * 2 : 8;
+	MachineAlternative* alternatives = (MachineAlternative*)realloc(machine->alternatives, capacity * sizeof(MachineAlternative));
+	if (alternatives == NULL)
+	{
+		return false;
+	}
+
+	machine->alternatives = alternatives;
+	machine->capacity = capacity;
+
+	return true;
+}
+
+
+/**
+* @brief	Construir o ndice por mquina a partir de todas as execues da tabela hash
+* @param	table	Tabela hash das execues
+* @return	ndice criado (ou NULL se falhou)
+*/
+MachineIndex* buildMachineIndex(ExecutionNode* table[])
+{
+	MachineIndex* index = createMachineIndex();
+	if (index == NULL || table == NULL)
+	{
+		freeMachineIndex(index);
+		return NULL;
+	}
+
+	// acrescentar todas as alternativas e s no fim ordenar cada mquina
+	for (int i = 0; i < HASH_TABLE_SIZE; i++)
+	{
+		for (Execution* aux = table[i]->start; aux != NULL; aux = aux->next)
+		{
+			MachineAlternatives* machine = getMachineAlternatives(index, aux->machineID, true);
+			if (machine == NULL || !reserveAlternative(machine))
+			{
+				freeMachineIndex(index);
+				return NULL;
+			}
+
+			machine->alternatives[machine->count].operationID = aux->operationID;
+			machine->alternatives[machine->count].runtime = aux->runtime;
+			machine->count++;
+		}
+	}
+
+	for (int i = 0; i < index->numberOfMachines; i++)
+	{
+		qsort(index->machines[i].alternatives, index->machines[i].count, sizeof(MachineAlternative), compareAlternatives);
+	}
+
+	return index;
+}
+
+
+/**
+* @brief	Inserir uma alternativa no ndice por mquina, na posio ordenada pelo tempo
+* @param	index			ndice por mquina
+* @param	operationID		Identificador da operao
+* @param	machineID		Identificador da mquina
+* @param	runtime			Unidades de tempo
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool insertExecution_AtMachineIndex(MachineIndex* index, int operationID, int machineID, int runtime)
+{
+	if (index == NULL)
+	{
+		return false;
+	}
+
+	MachineAlternatives* machine = getMachineAlternatives(index, machineID, true);
+	if (machine == NULL || !reserveAlternative(machine))
+	{
+		return false;
+	}
+
+	MachineAlternative new = { operationID, runtime };
+
+	// pesquisa binria pela primeira alternativa maior que a nova
+	int low = 0;
+	int high = machine->count;
+
+	while (low < high)
+	{
+		int middle = (low + high) / 2;
+
+		if (compareAlternatives(&machine->alternatives[middle], &new) <= 0)
+		{
+			low = middle + 1;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+
+	memmove(&machine->alternatives[low + 1], &machine->alternatives[low], (machine->count - low) * sizeof(MachineAlternative));
+	machine->alternatives[low] = new;
+	machine->count++;
+
+	return true;
+}
+
+
+/**
+* @brief	Remover a alternativa de uma operao numa mquina do ndice
+* @param	index			ndice por mquina
+* @param	operationID		Identificador da operao
+* @param	machineID		Identificador da mquina
+* @return	Booleano para o resultado da funo (se removeu ou no)
+*/
+bool deleteExecution_AtMachineIndex(MachineIndex* index, int operationID, int machineID)
+{
+	if (index == NULL)
+	{
+		return false;
+	}
+
+	MachineAlternatives* machine = getMachineAlternatives(index, machineID, false);
+	if (machine == NULL)
+	{
+		return false;
+	}
+
+	for (int i = 0; i < machine->count; i++)
+	{
+		if (machine->alternatives[i].operationID == operationID)
+		{
+			memmove(&machine->alternatives[i], &machine->alternatives[i + 1], (machine->count - i - 1) * sizeof(MachineAlternative));
+			machine->count--;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+/**
+* @brief	Atualizar o tempo de uma alternativa no ndice, mantendo a mquina ordenada
+* @param	index			ndice por mquina
+* @param	operationID		Identificador da operao
+* @param	machineID		Identificador da mquina
+* @param	runtime			Unidades de tempo
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool updateRuntime_AtMachineIndex(MachineIndex* index, int operationID, int machineID, int runtime)
+{
+	if (!deleteExecution_AtMachineIndex(index, operationID, machineID))
+	{
+		return false;
+	}
+
+	return insertExecution_AtMachineIndex(index, operationID, machineID, runtime);
+}
+
+
+/**
+* @brief	Obter todas as alternativas de uma mquina, ordenadas pelo tempo
+* @param	index		ndice por mquina
+* @param	machineID	Identificador da mquina
+* @param	count		Apontador para a quantidade de alternativas
+* @return	Array contguo de alternativas (ou NULL se a mquina no existir)
+*/
+MachineAlternative* getAlternatives_ByMachine(MachineIndex* index, int machineID, int* count)
+{
+	*count = 0;
+
+	if (index == NULL)
+	{
+		return NULL;
+	}
+
+	MachineAlternatives* machine = getMachineAlternatives(index, machineID, false);
+	if (machine == NULL)
+	{
+		return NULL;
+	}
+
+	*count = machine->count;
+
+	return machine->alternatives;
+}
+
+
+/**
+* @brief	Obter a operao mais rpida de uma mquina (tempo constante)
+* @param	index		ndice por mquina
+* @param	machineID	Identificador da mquina
+* @param	result		Apontador para a alternativa mais rpida
+* @return	Booleano para o resultado da funo (falso se a mquina no tiver alternativas)
+*/
+bool getFastestOperation_ByMachine(MachineIndex* index, int machineID, MachineAlternative* result)
+{
+	int count = 0;
+	MachineAlternative* alternatives = getAlternatives_ByMachine(index, machineID, &count);
+
+	if (count == 0 || result == NULL)
+	{
+		return false;
+	}
+
+	*result = alternatives[0];
+
+	return true;
+}
+
+
+/**
+* @brief	Obter a operao mais rpida de uma mquina entre as operaes elegveis (por exemplo, as pendentes).
+*			As alternativas so percorridas por ordem de tempo, parando na primeira elegvel: o custo  proporcional
+*			 quantidade de alternativas mais rpidas que no so elegveis (tempo constante se a mais rpida for elegvel,
+*			linear na mquina no pior caso). O tempo constante garantido s existe sem filtro, em getFastestOperation_ByMachine,
+*			porque o conjunto de elegveis  dado por quem chama e pode mudar entre chamadas
+* @param	index			ndice por mquina
+* @param	machineID		Identificador da mquina
+* @param	eligible		Conjunto com os identificadores das operaes elegveis
+* @param	result			Apontador para a alternativa escolhida
+* @return	Booleano para o resultado da funo (falso se nenhuma operao for elegvel)
+*/
+bool getFastestEligibleOperation_ByMachine(MachineIndex* index, int machineID, KeySet* eligible, MachineAlternative* result)
+{
+	int count = 0;
+	MachineAlternative* alternatives = getAlternatives_ByMachine(index, machineID, &count);
+
+	for (int i = 0; i < count; i++)
+	{
+		if (searchKey(eligible, alternatives[i].operationID))
+		{
+			*result = alternatives[i];
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+/**
+* @brief	Libertar o ndice por mquina da memria
+* @param	index	ndice por mquina
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool freeMachineIndex(MachineIndex* index)
+{
+	if (index == NULL)
+	{
+		return false;
+	}
+
+	for (int i = 0; i < index->numberOfMachines; i++)
+	{
+		free(index->machines[i].alternatives);
+	}
+
+	free(index->machines);
+	freeKeySet(index->slots);
+	free(index);
+
+	return true;
+}
+
+#pragma endregion
+
+
+#pragma region alteraes na tabela e no ndice em conjunto
+
+/**
+* @brief	Retirar uma execuo da lista da sua posio na tabela hash, sem a libertar
+* @param	table	Tabela hash das execues
+* @param	old		Execuo a retirar
+*/
+static void unlinkExecution_AtTable(ExecutionNode* table[], Execution* old)
+{
+	int position = generateHash_AtTable(table, old->operationID);
+
+	for (Execution** link = &table[position]->start; *link != NULL; link = &(*link)->next)
+	{
+		if (*link == old)
+		{
+			*link = old->next;
+			old->next = NULL;
+			table[position]->numberOfExecutions--;
+			bumpOperationVersion(old->operationID);
+			return;
+		}
+	}
+}
+
+
+/**
+* @brief	Inserir nova execuo na tabela hash e no ndice por mquina
+* @param	table	Tabela hash das execues
+* @param	index	ndice por mquina
+* @param	new		Nova execuo (se a funo falhar, no fica na tabela e continua a ser de quem chama)
+* @return	Booleano para o resultado da funo (falso se a execuo j existir ou no houver memria para o ndice)
+*/
+bool insertExecution_Indexed(ExecutionNode* table[], MachineIndex* index, Execution* new)
+{
+	if (table == NULL || new == NULL || searchExecution_AtTable(table, new->operationID, new->machineID) != NULL)
+	{
+		return false;
+	}
+
+	insertExecution_AtTable(table, new);
+
+	if (!insertExecution_AtMachineIndex(index, new->operationID, new->machineID, new->runtime))
+	{
+		unlinkExecution_AtTable(table, new); // a tabela e o ndice continuam iguais
+		return false;
+	}
+
+	return true;
+}
+
+
+/**
+* @brief	Atualizar o tempo de uma execuo na tabela hash e no ndice por mquina
+* @param	table			Tabela hash das execues
+* @param	index			ndice por mquina
+* @param	operationID		Identificador da operao
+* @param	machineID		Identificador da mquina
+* @param	runtime			Unidades de tempo
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool updateRuntime_Indexed(ExecutionNode* table[], MachineIndex* index, int operationID, int machineID, int runtime)
+{
+	if (!updateRuntime_ByOperation_AtTable((ExecutionNode***)table, operationID, machineID, runtime))
+	{
+		return false;
+	}
+
+	return updateRuntime_AtMachineIndex(index, operationID, machineID, runtime);
+}
+
+
+/**
+* @brief	Remover todas as execues de uma operao da tabela hash e do ndice por mquina
+* @param	table			Tabela hash das execues
+* @param	index			ndice por mquina
+* @param	operationID		Identificador da operao
+* @return	Booleano para o resultado da funo (se removeu alguma ou no)
+*/
+bool deleteExecutions_ByOperation_Indexed(ExecutionNode* table[], MachineIndex* index, int operationID)
+{
+	if (table == NULL)
+	{
+		return false;
+	}
+
+	// as mquinas da operao so conhecidas pela posio da tabela, antes de remover
+	for (Execution* aux = table[generateHash_AtTable(table, operationID)]->start; aux != NULL; aux = aux->next)
+	{
+		if (aux->operationID == operationID)
+		{
+			deleteExecution_AtMachineIndex(index, operationID, aux->machineID);
+		}
+	}
+
+	return deleteExecutions_ByOperation_AtTable((ExecutionNode***)table, operationID);
+}
+
+#pragma endregion
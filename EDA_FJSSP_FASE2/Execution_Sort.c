@@ -0,0 +1,290 @@
+/**
+ * @brief	Ficheiro com as funes de ordenao de execues em arrays contguos
+ * @file	executions_sort.c
+ * @author	Vnia Pereira
+ * @email	a19264@alunos.ipca.pt
+ * @date	2022
+ * @Disciplina Estruturas de Dados Avanadas
+ *
+ * -----------------
+ *
+ * As execues so ordenadas por (operao, mquina) com radix sort LSD, um byte de cada vez, do menos para o mais significativo.
+ * Cada passagem  estvel, por isso no fim o array fica ordenado pela chave completa em tempo linear.
+ * As passagens em que todas as execues tm o mesmo byte so ignoradas (com identificadores pequenos, a maioria delas).
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "header.h"
+
+#define RADIX_BITS 8
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+#define RADIX_PASSES (64 / RADIX_BITS)
+
+
+#pragma region radix sort
+
+/**
+* @brief	Obter a chave de ordenao de uma execuo. O bit de sinal  invertido para os identificadores negativos ficarem primeiro
+* @param	record	Execuo
+* @return	Chave de 64 bits (operao nos 32 bits mais significativos, mquina nos restantes)
+*/
+static uint64_t getSortKey(const FileExecution* record)
+{
+	return ((uint64_t)((uint32_t)record->operationID ^ 0x80000000u) << 32) | (uint32_t)((uint32_t)record->machineID ^ 0x80000000u);
+}
+
+
+/**
+* @brief	Obter o byte de uma passagem da chave de ordenao de uma execuo
+* @param	record	Execuo
+* @param	pass	Passagem (0 para o byte menos significativo)
+* @return	Byte da chave
+*/
+static int getSortDigit(const FileExecution* record, int pass)
+{
+	return (int)((getSortKey(record) >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1));
+}
+
+
+/**
+* @brief	Ordenar um array de execues por operao e depois por mquina (radix sort, tempo linear)
+* @param	records		Array de execues
+* @param	count		Quantidade de execues
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool radixSortExecutions(FileExecution* records, int count)
+{
+	if (records == NULL || count < 0)
+	{
+		return false;
+	}
+
+	if (count < 2)
+	{
+		return true;
+	}
+
+	FileExecution* buffer = (FileExecution*)malloc(count * sizeof(FileExecution));
+	int (*histograms)[RADIX_BUCKETS] = calloc(RADIX_PASSES, sizeof(*histograms));
+
+	if (buffer == NULL || histograms == NULL) // se no houver memria para alocar
+	{
+		free(buffer);
+		free(histograms);
+		return false;
+	}
+
+	// os histogramas de todas as passagens so calculados numa s leitura do array
+	for (int i = 0; i < count; i++)
+	{
+		uint64_t key = getSortKey(&records[i]);
+
+		for (int pass = 0; pass < RADIX_PASSES; pass++)
+		{
+			histograms[pass][(key >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+		}
+	}
+
+	FileExecution* source = records;
+	FileExecution* destination = buffer;
+
+	for (int pass = 0; pass < RADIX_PASSES; pass++)
+	{
+		int* histogram = histograms[pass];
+
+		if (histogram[getSortDigit(&source[0], pass)] == count) // todas as execues tm o mesmo byte
+		{
+			continue;
+		}
+
+		// transformar as contagens na posio inicial de cada byte
+		int offset = 0;
+		for (int digit = 0; digit < RADIX_BUCKETS; digit++)
+		{
+			int size = histogram[digit];
+			histogram[digit] = offset;
+			offset += size;
+		}
+
+		for (int i = 0; i < count; i++)
+		{
+			destination[histogram[getSortDigit(&source[i], pass)]++] = source[i];
+		}
+
+		FileExecution* swap = source;
+		source = destination;
+		destination = swap;
+	}
+
+	if (source != records) // o resultado ficou no array auxiliar
+	{
+		memcpy(records, source, count * sizeof(FileExecution));
+	}
+
+	free(buffer);
+	free(histograms);
+
+	return true;
+}
+
+#pragma endregion
+
+
+#pragma region radix sort em paralelo
+
+/**
+ * @brief	Estado partilhado de uma passagem do radix sort em paralelo.
+ *			O array  dividido em partes com o mesmo tamanho e cada parte tem o seu histograma
+ */
+typedef struct RadixSortPass
+{
+	FileExecution* source;
+	FileExecution* destination;
+	int count;
+	int numberOfChunks;
+	int pass;
+	int (*histograms)[RADIX_BUCKETS]; // um histograma por parte, depois transformado nas posies de escrita
+} RadixSortPass;
+
+
+/**
+* @brief	Obter o incio de uma parte do array
+*/
+static int getChunkStart(RadixSortPass* sort, int chunk)
+{
+	return (int)((long long)sort->count * chunk / sort->numberOfChunks);
+}
+
+
+/**
+* @brief	Calcular o histograma de cada parte de um intervalo de partes
+* @param	first		Primeira parte
+* @param	last		Parte a seguir  ltima
+* @param	argument	Estado da passagem
+*/
+static void countRadixChunks(int first, int last, void* argument)
+{
+	RadixSortPass* sort = (RadixSortPass*)argument;
+
+	for (int chunk = first; chunk < last; chunk++)
+	{
+		int* histogram = sort->histograms[chunk];
+		int end = getChunkStart(sort, chunk + 1);
+
+		memset(histogram, 0, RADIX_BUCKETS * sizeof(int));
+
+		for (int i = getChunkStart(sort, chunk); i < end; i++)
+		{
+			histogram[getSortDigit(&sort->source[i], sort->pass)]++;
+		}
+	}
+}
+
+
+/**
+* @brief	Escrever as execues de cada parte de um intervalo de partes nas suas posies finais da passagem
+* @param	first		Primeira parte
+* @param	last		Parte a seguir  ltima
+* @param	argument	Estado da passagem
+*/
+static void scatterRadixChunks(int first, int last, void* argument)
+{
+	RadixSortPass* sort = (RadixSortPass*)argument;
+
+	for (int chunk = first; chunk < last; chunk++)
+	{
+		int* offsets = sort->histograms[chunk];
+		int end = getChunkStart(sort, chunk + 1);
+
+		for (int i = getChunkStart(sort, chunk); i < end; i++)
+		{
+			sort->destination[offsets[getSortDigit(&sort->source[i], sort->pass)]++] = sort->source[i];
+		}
+	}
+}
+
+
+/**
+* @brief	Ordenar um array de execues por operao e depois por mquina, com as passagens do radix sort divididas pelas threads.
+*			Em cada passagem, cada parte conta os seus bytes, as posies de escrita so calculadas em srie
+*			(por byte e depois por parte, o que mantm a ordenao estvel) e cada parte escreve as suas execues
+* @param	pool		Conjunto de threads (NULL para ordenar na thread atual)
+* @param	records		Array de execues
+* @param	count		Quantidade de execues
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool radixSortExecutions_Parallel(TaskPool* pool, FileExecution* records, int count)
+{
+	if (pool == NULL || count < RADIX_SORT_PARALLEL_MIN_RECORDS)
+	{
+		return radixSortExecutions(records, count);
+	}
+
+	RadixSortPass sort;
+
+	sort.count = count;
+	sort.numberOfChunks = (pool->numberOfWorkers + 1) * 4;
+	sort.histograms = calloc(sort.numberOfChunks, sizeof(*sort.histograms));
+
+	FileExecution* buffer = (FileExecution*)malloc(count * sizeof(FileExecution));
+
+	if (buffer == NULL || sort.histograms == NULL) // se no houver memria para alocar
+	{
+		free(buffer);
+		free(sort.histograms);
+		return false;
+	}
+
+	sort.source = records;
+	sort.destination = buffer;
+
+	for (sort.pass = 0; sort.pass < RADIX_PASSES; sort.pass++)
+	{
+		parallelFor(pool, 0, sort.numberOfChunks, 1, countRadixChunks, &sort);
+
+		// posio inicial de cada byte em cada parte: bytes menores de todas as partes, mais o mesmo byte das partes anteriores
+		int offset = 0;
+		bool skip = false;
+
+		for (int digit = 0; digit < RADIX_BUCKETS && !skip; digit++)
+		{
+			int start = offset;
+
+			for (int chunk = 0; chunk < sort.numberOfChunks; chunk++)
+			{
+				int size = sort.histograms[chunk][digit];
+				sort.histograms[chunk][digit] = offset;
+				offset += size;
+			}
+
+			skip = (offset - start) == count; // todas as execues tm o mesmo byte
+		}
+
+		if (skip)
+		{
+			continue;
+		}
+
+		parallelFor(pool, 0, sort.numberOfChunks, 1, scatterRadixChunks, &sort);
+
+		FileExecution* swap = sort.source;
+		sort.source = sort.destination;
+		sort.destination = swap;
+	}
+
+	if (sort.source != records) // o resultado ficou no array auxiliar
+	{
+		memcpy(records, sort.source, count * sizeof(FileExecution));
+	}
+
+	free(buffer);
+	free(sort.histograms);
+
+	return true;
+}
+
+#pragma endregion
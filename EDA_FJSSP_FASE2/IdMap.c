@@ -0,0 +1,575 @@
+/**
+ * @brief	Ficheiro com as funes de mapeamento entre identificadores externos e ndices internos densos
+ * @file	idmap.c
+ * @author	Vnia Pereira
+ * @email	a19264@alunos.ipca.pt
+ * @date	2022
+ * @Disciplina Estruturas de Dados Avanadas
+ *
+ * -----------------
+ *
+ * Os identificadores dos ficheiros podem ser quaisquer valores de 32 bits. Ao carregar, cada identificador recebe
+ * um ndice denso (0, 1, 2, ... pela ordem em que aparece), que passa a ser o identificador usado nas listas e na tabela,
+ * por isso pode ser usado diretamente como ndice de arrays. Ao gravar, os ndices voltam a ser os identificadores originais.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "header.h"
+
+
+#pragma region trabalhar com mapeamento de identificadores
+
+/**
+* @brief	Criar mapeamento de identificadores vazio
+* @param	expectedIds		Quantidade de identificadores prevista (o mapeamento cresce se for ultrapassada)
+* @return	Mapeamento criado (ou NULL se no houver memria)
+*/
+IdMap* createIdMap(int expectedIds)
+{
+	IdMap* map = (IdMap*)malloc(sizeof(IdMap));
+	if (map == NULL) // se no houver memria para alocar
+	{
+		return NULL;
+	}
+
+	map->capacity = expectedIds > 16 ? expectedIds : 16;
+	map->numberOfIds = 0;
+	map->externalIds = (int*)malloc(map->capacity * sizeof(int));
+	map->denseIds = createKeySet(map->capacity);
+
+	if (map->externalIds == NULL || map->denseIds == NULL)
+	{
+		freeIdMap(map);
+		return NULL;
+	}
+
+	return map;
+}
+
+
+/**
+* @brief	Obter o ndice denso de um identificador externo, atribuindo o seguinte se ainda no existir
+* @param	map			Mapeamento de identificadores
+* @param	externalId	Identificador externo
+* @param	isNew		Apontador para indicar se o identificador foi acrescentado agora (pode ser NULL)
+* @return	ndice denso (ou -1 se no houver memria)
+*/
+int addExternalId(IdMap* map, int externalId, bool* isNew)
+{
+	if (isNew != NULL)
+	{
+		*isNew = false;
+	}
+
+	if (map == NULL)
+	{
+		return -1;
+	}
+
+	int denseId = getKeyValue(map->denseIds, externalId);
+	if (denseId >= 0)
+	{
+		return denseId;
+	}
+
+	if (map->numberOfIds == map->capacity)
+	{
+		int* externalIds = (int*)realloc(map->externalIds, map->capacity * 2 * sizeof(int));
+		if (externalIds == NULL)
+		{
+			return -1;
+		}
+
+		map->externalIds = externalIds;
+		map->capacity *= 2;
+	}
+
+	denseId = map->numberOfIds;
+	if (!insertKey(map->denseIds, externalId, denseId))
+	{
+		return -1;
+	}
+
+	map->externalIds[denseId] = externalId;
+	map->numberOfIds++;
+
+	if (isNew != NULL)
+	{
+		*isNew = true;
+	}
+
+	return denseId;
+}
+
+
+/**
+* @brief	Obter o ndice denso de um identificador externo
+* @param	map			Mapeamento de identificadores
+* @param	externalId	Identificador externo
+* @return	ndice denso (ou -1 se o identificador no existir)
+*/
+int getDenseId(IdMap* map, int externalId)
+{
+	if (map == NULL)
+	{
+		return -1;
+	}
+
+	return getKeyValue(map->denseIds, externalId);
+}
+
+
+/**
+* @brief	Obter o identificador externo de um ndice denso
+* @param	map			Mapeamento de identificadores
+* @param	denseId		ndice denso
+* @param	externalId	Apontador para o identificador externo
+* @return	Booleano para o resultado da funo (falso se o ndice no existir)
+*/
+bool getExternalId(IdMap* map, int denseId, int* externalId)
+{
+	if (map == NULL || denseId < 0 || denseId >= map->numberOfIds)
+	{
+		return false;
+	}
+
+	*externalId = map->externalIds[denseId];
+
+	return true;
+}
+
+
+/**
+* @brief	Libertar o mapeamento de identificadores da memria
+* @param	map		Mapeamento de identificadores
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool freeIdMap(IdMap* map)
+{
+	if (map == NULL)
+	{
+		return false;
+	}
+
+	free(map->externalIds);
+	freeKeySet(map->denseIds);
+	free(map);
+
+	return true;
+}
+
+#pragma endregion
+
+
+#pragma region carregar dados com ndices densos
+
+/**
+* @brief	Ler trabalhos de ficheiro binrio, substituindo os identificadores por ndices densos
+* @param	fileName	Nome do ficheiro
+* @param	jobsMap		Mapeamento dos identificadores dos trabalhos (preenchido durante a leitura)
+* @return	Lista de trabalhos (ou NULL se no houver memria; a lista j lida  libertada)
+*/
+Job* readJobs_Dense(char fileName[], IdMap* jobsMap)
+{
+	FILE* file = NULL;
+
+	if (jobsMap == NULL || (file = fopen(fileName, "rb")) == NULL) // erro ao abrir o ficheiro
+	{
+		return NULL;
+	}
+
+	int recordSize = readJobsFileHeader(file);
+	if (recordSize < 0) // formato no suportado
+	{
+		fclose(file);
+		return NULL;
+	}
+
+	Job* head = NULL;
+	JobFile currentInFile;
+	bool isNew = false;
+	bool failed = false;
+
+	while (readJobRecord(file, recordSize, &currentInFile))
+	{
+		int id = addExternalId(jobsMap, currentInFile.id, &isNew);
+		if (id < 0) // se no houver memria para o mapeamento
+		{
+			failed = true;
+			break;
+		}
+
+		if (isNew) // os registos repetidos so detetados pelo mapeamento, sem percorrer a lista
+		{
+			Job* current = newJob_WithDates(id, currentInFile.releaseDate, currentInFile.dueDate, currentInFile.weight);
+			if (current == NULL) // se no houver memria para alocar
+			{
+				failed = true;
+				break;
+			}
+
+			current->next = head;
+			head = current;
+		}
+	}
+
+	fclose(file);
+
+	if (failed)
+	{
+		freeJobs(head);
+		return NULL;
+	}
+
+	return head;
+}
+
+
+/**
+* @brief	Ler mquinas de ficheiro binrio, substituindo os identificadores por ndices densos
+* @param	fileName		Nome do ficheiro
+* @param	machinesMap		Mapeamento dos identificadores das mquinas (preenchido durante a leitura)
+* @return	Lista de mquinas (ou NULL se no houver memria; a lista j lida  libertada)
+*/
+Machine* readMachines_Dense(char fileName[], IdMap* machinesMap)
+{
+	FILE* file = NULL;
+
+	if (machinesMap == NULL || (file = fopen(fileName, "rb")) == NULL) // erro ao abrir o ficheiro
+	{
+		return NULL;
+	}
+
+	Machine* head = NULL;
+	MachineFile currentInFile;
+	bool isNew = false;
+	bool failed = false;
+
+	while (fread(&currentInFile, sizeof(MachineFile), 1, file))
+	{
+		int id = addExternalId(machinesMap, currentInFile.id, &isNew);
+		if (id < 0) // se no houver memria para o mapeamento
+		{
+			failed = true;
+			break;
+		}
+
+		if (isNew)
+		{
+			Machine* current = newMachine(id, currentInFile.isBusy);
+			if (current == NULL) // se no houver memria para alocar
+			{
+				failed = true;
+				break;
+			}
+
+			current->next = head;
+			head = current;
+		}
+	}
+
+	fclose(file);
+
+	if (failed)
+	{
+		freeMachines(head);
+		return NULL;
+	}
+
+	return head;
+}
+
+
+/**
+* @brief	Ler operaes de ficheiro binrio, substituindo os identificadores das operaes e dos trabalhos por ndices densos
+* @param	fileName		Nome do ficheiro
+* @param	operationsMap	Mapeamento dos identificadores das operaes (preenchido durante a leitura)
+* @param	jobsMap			Mapeamento dos identificadores dos trabalhos (trabalhos desconhecidos so acrescentados)
+* @return	Lista de operaes (ou NULL se no houver memria; a lista j lida  libertada)
+*/
+Operation* readOperations_Dense(char fileName[], IdMap* operationsMap, IdMap* jobsMap)
+{
+	FILE* file = NULL;
+
+	if (operationsMap == NULL || jobsMap == NULL || (file = fopen(fileName, "rb")) == NULL) // erro ao abrir o ficheiro
+	{
+		return NULL;
+	}
+
+	Operation* head = NULL;
+	FileOperation currentInFile;
+	bool isNew = false;
+	bool failed = false;
+
+	while (fread(&currentInFile, sizeof(FileOperation), 1, file))
+	{
+		int id = addExternalId(operationsMap, currentInFile.id, &isNew);
+		if (id < 0) // se no houver memria para o mapeamento
+		{
+			failed = true;
+			break;
+		}
+
+		if (isNew)
+		{
+			int jobID = addExternalId(jobsMap, currentInFile.jobID, NULL);
+			Operation* current = jobID >= 0 ? newOperation(id, jobID) : NULL;
+			if (current == NULL) // se no houver memria para alocar
+			{
+				failed = true;
+				break;
+			}
+
+			current->next = head;
+			head = current;
+		}
+	}
+
+	fclose(file);
+
+	if (failed)
+	{
+		freeOperations(head);
+		return NULL;
+	}
+
+	return head;
+}
+
+
+/**
+* @brief	Ler execues de ficheiro binrio para a tabela hash, substituindo os identificadores por ndices densos.
+*			Os repetidos so detetados com um conjunto de chaves (operao densa, mquina densa), em tempo constante
+* @param	fileName		Nome do ficheiro
+* @param	table			Tabela hash das execues
+* @param	operationsMap	Mapeamento dos identificadores das operaes (operaes desconhecidas so acrescentadas)
+* @param	machinesMap		Mapeamento dos identificadores das mquinas (mquinas desconhecidas so acrescentadas)
+* @return	Quantidade de execues inseridas (ou -1 se no foi possvel ler o ficheiro ou no houver memria;
+*			as execues j inseridas ficam na tabela)
+*/
+int readExecutions_Dense_AtTable(char fileName[], ExecutionNode* table[], IdMap* operationsMap, IdMap* machinesMap)
+{
+	FILE* file = NULL;
+
+	if (table == NULL || operationsMap == NULL || machinesMap == NULL || (file = fopen(fileName, "rb")) == NULL) // erro ao abrir o ficheiro
+	{
+		return -1;
+	}
+
+	int existing = 0;
+	for (int b = 0; b < HASH_TABLE_SIZE; b++)
+	{
+		existing += table[b]->numberOfExecutions;
+	}
+
+	KeySet* keys = createKeySet(existing);
+	if (keys == NULL) // se no houver memria para alocar
+	{
+		fclose(file);
+		return -1;
+	}
+
+	// as execues que j estavam na tabela contam para os repetidos
+	for (int b = 0; b < HASH_TABLE_SIZE; b++)
+	{
+		for (Execution* aux = table[b]->start; aux != NULL; aux = aux->next)
+		{
+			insertKey(keys, EXECUTION_KEY(aux->operationID, aux->machineID), b);
+		}
+	}
+
+	FileExecution currentInFile;
+	int inserted = 0;
+	bool failed = false;
+
+	while (fread(&currentInFile, sizeof(FileExecution), 1, file))
+	{
+		int operationID = addExternalId(operationsMap, currentInFile.operationID, NULL);
+		int machineID = addExternalId(machinesMap, currentInFile.machineID, NULL);
+		if (operationID < 0 || machineID < 0) // se no houver memria para os mapeamentos
+		{
+			failed = true;
+			break;
+		}
+
+		int index = generateHash_AtTable(table, operationID);
+
+		if (!insertKey(keys, EXECUTION_KEY(operationID, machineID), index)) // ignorar registos repetidos
+		{
+			continue;
+		}
+
+		Execution* new = newExecution(operationID, machineID, currentInFile.runtime);
+		if (new == NULL) // se no houver memria para alocar
+		{
+			failed = true;
+			break;
+		}
+
+		// j se sabe que  nica,  ligada diretamente no incio da posio (como em insertExecution_AtTable)
+		new->next = table[index]->start;
+		table[index]->start = new;
+		table[index]->numberOfExecutions++;
+		bumpOperationVersion(operationID);
+		inserted++;
+	}
+
+	freeKeySet(keys);
+	fclose(file);
+
+	return failed ? -1 : inserted;
+}
+
+#pragma endregion
+
+
+#pragma region gravar dados com identificadores originais
+
+/**
+* @brief	Gravar trabalhos com ndices densos em ficheiro binrio, com os identificadores originais
+* @param	fileName	Nome do ficheiro
+* @param	head		Lista de trabalhos
+* @param	jobsMap		Mapeamento dos identificadores dos trabalhos
+* @return	Booleano para o resultado da funo (falso se algum ndice no existir no mapeamento)
+*/
+bool writeJobs_Dense(char fileName[], Job* head, IdMap* jobsMap)
+{
+	FILE* file = NULL;
+
+	if (head == NULL || (file = fopen(fileName, "wb")) == NULL)
+	{
+		return false;
+	}
+
+	JobFile currentInFile;
+	bool mapped = writeJobsFileHeader(file);
+
+	for (Job* current = head; current != NULL && mapped; current = current->next)
+	{
+		mapped = getExternalId(jobsMap, current->id, &currentInFile.id);
+		if (mapped)
+		{
+			currentInFile.releaseDate = current->releaseDate;
+			currentInFile.dueDate = current->dueDate;
+			currentInFile.weight = current->weight;
+			fwrite(&currentInFile, sizeof(JobFile), 1, file);
+		}
+	}
+
+	fclose(file);
+
+	return mapped;
+}
+
+
+/**
+* @brief	Gravar mquinas com ndices densos em ficheiro binrio, com os identificadores originais
+* @param	fileName		Nome do ficheiro
+* @param	head			Lista de mquinas
+* @param	machinesMap		Mapeamento dos identificadores das mquinas
+* @return	Booleano para o resultado da funo (falso se algum ndice no existir no mapeamento)
+*/
+bool writeMachines_Dense(char fileName[], Machine* head, IdMap* machinesMap)
+{
+	FILE* file = NULL;
+
+	if (head == NULL || (file = fopen(fileName, "wb")) == NULL)
+	{
+		return false;
+	}
+
+	MachineFile currentInFile;
+	bool mapped = true;
+
+	for (Machine* current = head; current != NULL && mapped; current = current->next)
+	{
+		mapped = getExternalId(machinesMap, current->id, &currentInFile.id);
+		if (mapped)
+		{
+			currentInFile.isBusy = current->isBusy;
+			fwrite(&currentInFile, sizeof(MachineFile), 1, file);
+		}
+	}
+
+	fclose(file);
+
+	return mapped;
+}
+
+
+/**
+* @brief	Gravar operaes com ndices densos em ficheiro binrio, com os identificadores originais
+* @param	fileName		Nome do ficheiro
+* @param	head			Lista de operaes
+* @param	operationsMap	Mapeamento dos identificadores das operaes
+* @param	jobsMap			Mapeamento dos identificadores dos trabalhos
+* @return	Booleano para o resultado da funo (falso se algum ndice no existir no mapeamento)
+*/
+bool writeOperations_Dense(char fileName[], Operation* head, IdMap* operationsMap, IdMap* jobsMap)
+{
+	FILE* file = NULL;
+
+	if (head == NULL || (file = fopen(fileName, "wb")) == NULL)
+	{
+		return false;
+	}
+
+	FileOperation currentInFile;
+	bool mapped = true;
+
+	for (Operation* current = head; current != NULL && mapped; current = current->next)
+	{
+		mapped = getExternalId(operationsMap, current->id, &currentInFile.id) && getExternalId(jobsMap, current->jobID, &currentInFile.jobID);
+		if (mapped)
+		{
+			fwrite(&currentInFile, sizeof(FileOperation), 1, file);
+		}
+	}
+
+	fclose(file);
+
+	return mapped;
+}
+
+
+/**
+* @brief	Gravar execues com ndices densos da tabela hash em ficheiro binrio, com os identificadores originais
+* @param	fileName		Nome do ficheiro
+* @param	table			Tabela hash das execues
+* @param	operationsMap	Mapeamento dos identificadores das operaes
+* @param	machinesMap		Mapeamento dos identificadores das mquinas
+* @return	Booleano para o resultado da funo (falso se algum ndice no existir no mapeamento)
+*/
+bool writeExecutions_Dense_AtTable(char fileName[], ExecutionNode* table[], IdMap* operationsMap, IdMap* machinesMap)
+{
+	FILE* file = NULL;
+
+	if (table == NULL || (file = fopen(fileName, "wb")) == NULL)
+	{
+		return false;
+	}
+
+	FileExecution currentInFile;
+	bool mapped = true;
+
+	for (int i = 0; i < HASH_TABLE_SIZE && mapped; i++)
+	{
+		for (Execution* current = table[i]->start; current != NULL && mapped; current = current->next)
+		{
+			mapped = getExternalId(operationsMap, current->operationID, &currentInFile.operationID) && getExternalId(machinesMap, current->machineID, &currentInFile.machineID);
+			if (mapped)
+			{
+				currentInFile.runtime = current->runtime;
+				fwrite(&currentInFile, sizeof(FileExecution), 1, file);
+			}
+		}
+	}
+
+	fclose(file);
+
+	return mapped;
+}
+
+#pragma endregion
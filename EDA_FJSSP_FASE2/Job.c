@@ -14,11 +14,25 @@
 
 
 /**
-* @brief	Criar novo trabalho
+* @brief	Criar novo trabalho (disponvel desde o incio, sem data de entrega e com peso 1)
 * @param	id	Identificador do trabalho
 * @return	Novo trabalho
 */
 Job* newJob(int id)
+{
+	return newJob_WithDates(id, 0, JOB_NO_DUE_DATE, 1);
+}
+
+
+/**
+* @brief	Criar novo trabalho com data de disponibilidade, data de entrega e peso
+* @param	id				Identificador do trabalho
+* @param	releaseDate		Instante a partir do qual a primeira operao pode comear
+* @param	dueDate			Instante at ao qual o trabalho deve estar acabado (JOB_NO_DUE_DATE se no tiver)
+* @param	weight			Peso (prioridade) do trabalho no atraso ponderado
+* @return	Novo trabalho
+*/
+Job* newJob_WithDates(int id, int releaseDate, int dueDate, int weight)
 {
 	Job* new = (Job*)malloc(sizeof(Job));
 	if (new == NULL) // se no houver memria para alocar
@@ -27,12 +41,42 @@ Job* newJob(int id)
 	}
 
 	new->id = id;
+	new->releaseDate = releaseDate;
+	new->dueDate = dueDate;
+	new->weight = weight;
 	new->next = NULL;
 
 	return new;
 }
 
 
+/**
+* @brief	Alterar a data de disponibilidade, a data de entrega e o peso de um trabalho
+* @param	head			Lista de trabalhos
+* @param	id				Identificador do trabalho
+* @param	releaseDate		Instante a partir do qual a primeira operao pode comear
+* @param	dueDate			Instante at ao qual o trabalho deve estar acabado (JOB_NO_DUE_DATE se no tiver)
+* @param	weight			Peso (prioridade) do trabalho no atraso ponderado
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool updateJobDates(Job* head, int id, int releaseDate, int dueDate, int weight)
+{
+	for (Job* aux = head; aux != NULL; aux = aux->next)
+	{
+		if (aux->id == id)
+		{
+			aux->releaseDate = releaseDate;
+			aux->dueDate = dueDate;
+			aux->weight = weight;
+			bumpJobVersion(id);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
 /**
 * @brief	Inserir novo trabalho no incio da lista de trabalhos
 * @param	head	Lista de trabalhos
@@ -56,6 +100,8 @@ Job* insertJobAtStart(Job* head, Job* new)
 		head = new;
 	}
 
+	bumpJobVersion(new->id);
+
 	return head;
 }
 
@@ -80,6 +126,7 @@ bool deleteJob(Job** head, int id)   //aponta para o endere
 	if (aux != NULL && aux->id == id) { // se o elemento que ser apagado  o primeiro da lista
 		*head = aux->next;
 		free(aux);
+		bumpJobVersion(id);
 		return true;
 	}
 
@@ -96,6 +143,72 @@ bool deleteJob(Job** head, int id)   //aponta para o endere
 
 	auxAnt->next = aux->next; // desassociar o elemento da lista
 	free(aux);
+	bumpJobVersion(id);
+
+	return true;
+}
+
+
+/**
+* @brief	Escrever o cabealho do ficheiro de trabalhos (formato e tamanho de cada registo)
+* @param	file	Ficheiro aberto para escrita, no incio
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool writeJobsFileHeader(FILE* file)
+{
+	JobFileHeader header = { JOBS_FILE_MAGIC, JOBS_FILE_VERSION, (int)sizeof(JobFile) };
+
+	return fwrite(&header, sizeof(JobFileHeader), 1, file) == 1;
+}
+
+
+/**
+* @brief	Ler e validar o cabealho do ficheiro de trabalhos.
+*			Os ficheiros da verso 1 no tm cabealho: cada registo  s o identificador do trabalho (um int)
+* @param	file	Ficheiro aberto para leitura, no incio (fica no primeiro registo)
+* @return	Tamanho de cada registo: sizeof(JobFile), sizeof(int) na verso 1 (ou -1 se o formato no for suportado)
+*/
+int readJobsFileHeader(FILE* file)
+{
+	JobFileHeader header;
+
+	if (fread(&header, sizeof(JobFileHeader), 1, file) != 1 || header.magic != JOBS_FILE_MAGIC)
+	{
+		rewind(file); // ficheiro da verso 1 (ou vazio)
+		return (int)sizeof(int);
+	}
+
+	if (header.version != JOBS_FILE_VERSION || header.recordSize != (int)sizeof(JobFile))
+	{
+		return -1;
+	}
+
+	return (int)sizeof(JobFile);
+}
+
+
+/**
+* @brief	Ler um registo do ficheiro de trabalhos, na verso indicada pelo cabealho
+* @param	file		Ficheiro aberto para leitura
+* @param	recordSize	Tamanho de cada registo, devolvido por readJobsFileHeader
+* @param	record		Apontador para o registo lido (na verso 1, as datas e o peso so os de newJob)
+* @return	Booleano para o resultado da funo (falso no fim do ficheiro)
+*/
+bool readJobRecord(FILE* file, int recordSize, JobFile* record)
+{
+	if (recordSize == (int)sizeof(JobFile))
+	{
+		return fread(record, sizeof(JobFile), 1, file) == 1;
+	}
+
+	if (recordSize != (int)sizeof(int) || fread(&record->id, sizeof(int), 1, file) != 1)
+	{
+		return false;
+	}
+
+	record->releaseDate = 0;
+	record->dueDate = JOB_NO_DUE_DATE;
+	record->weight = 1;
 
 	return true;
 }
@@ -114,12 +227,20 @@ bool writeJobs(char* fileName, Job* h) {
 
 	if ((fp = fopen(fileName, "wb")) == NULL) return false;
 
+	if (!writeJobsFileHeader(fp)) {
+		fclose(fp);
+		return false;
+	}
+
 	Job* aux = h;
 	JobFile auxJob;	//para gravar em ficheiro!
 
 	while (aux) {		//while(aux!=NULL)
 
 		auxJob.id = aux->id;
+		auxJob.releaseDate = aux->releaseDate;
+		auxJob.dueDate = aux->dueDate;
+		auxJob.weight = aux->weight;
 
 		fwrite(&auxJob, sizeof(JobFile), 1, fp);
 		aux = aux->next;
@@ -143,12 +264,23 @@ Job* readJobs(char* fileName)
 
 	if ((fp = fopen(fileName, "rb")) == NULL) return NULL;
 
+	int recordSize = readJobsFileHeader(fp);
+	if (recordSize < 0) { // formato no suportado
+		fclose(fp);
+		return NULL;
+	}
+
 	//l n registos no ficheiro
 	JobFile auxJob;
-	while (fread(&auxJob, sizeof(JobFile), 1, fp)) {
+	while (readJobRecord(fp, recordSize, &auxJob)) {
 
-		aux = newJob(auxJob.id);
-		h = insertJobAtStart(h, aux);   //inserir a lista na ficha
+		aux = newJob_WithDates(auxJob.id, auxJob.releaseDate, auxJob.dueDate, auxJob.weight);
+		Job* inserted = insertJobAtStart(h, aux);   //inserir a lista na ficha
+		if (inserted == NULL) { // registo repetido, a lista no  alterada
+			free(aux);
+			continue;
+		}
+		h = inserted;
 	}
 	fclose(fp);
 	return h;
@@ -163,7 +295,14 @@ Job* readJobs(char* fileName)
 void displayJob(Job* head) {
 	Job* aux = head;
 	while (aux) {		//mesmo que while (aux!=NULL)
-		printf("ID: %d\n", aux->id);
+		if (aux->dueDate == JOB_NO_DUE_DATE)
+		{
+			printf("ID: %d, Disponvel: %d, Peso: %d\n", aux->id, aux->releaseDate, aux->weight);
+		}
+		else
+		{
+			printf("ID: %d, Disponvel: %d, Entrega: %d, Peso: %d\n", aux->id, aux->releaseDate, aux->dueDate, aux->weight);
+		}
 		aux = aux->next;
 	}
 }
@@ -194,4 +333,58 @@ bool searchJob(Job* head, int id)
 	}
 
 	return false;
+}
+
+
+/**
+* @brief	Copiar a lista de trabalhos, mantendo a mesma ordem
+* @param	head	Lista de trabalhos
+* @return	Nova lista de trabalhos
+*/
+Job* copyJobs(Job* head)
+{
+	Job* copy = NULL;
+	Job* last = NULL;
+
+	for (Job* aux = head; aux != NULL; aux = aux->next)
+	{
+		Job* new = newJob_WithDates(aux->id, aux->releaseDate, aux->dueDate, aux->weight);
+		if (new == NULL) // se no houver memria para alocar
+		{
+			freeJobs(copy);
+			return NULL;
+		}
+
+		if (last == NULL) // inserir no fim, sem procurar duplicados porque a lista original j no os tem
+		{
+			copy = new;
+		}
+		else
+		{
+			last->next = new;
+		}
+		last = new;
+	}
+
+	return copy;
+}
+
+
+/**
+* @brief	Libertar a lista de trabalhos da memria
+* @param	head	Lista de trabalhos
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool freeJobs(Job* head)
+{
+	Job* aux = head;
+
+	while (aux != NULL)
+	{
+		Job* next = aux->next;
+		free(aux);
+		aux = next;
+	}
+
+	return true;
 }
\ No newline at end of file
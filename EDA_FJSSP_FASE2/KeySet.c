@@ -0,0 +1,315 @@
+/**
+ * @brief	Ficheiro com as funes de um conjunto de chaves inteiras (tabela hash de endereamento aberto)
+ * @file	keyset.c
+ * @author	Vnia Pereira
+ * @email	a19264@alunos.ipca.pt
+ * @date	2022
+ * @Disciplina Estruturas de Dados Avanadas
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "header.h"
+
+
+#pragma region trabalhar com conjunto de chaves
+
+/**
+* @brief	Criar conjunto de chaves vazio
+* @param	expectedKeys	Quantidade de chaves prevista (o conjunto cresce se for ultrapassada)
+* @return	Conjunto de chaves criado (ou NULL se no houver memria)
+*/
+KeySet* createKeySet(int expectedKeys)
+{
+	KeySet* set = (KeySet*)malloc(sizeof(KeySet));
+	if (set == NULL) // se no houver memria para alocar
+	{
+		return NULL;
+	}
+
+	// potncia de 2 com pelo menos o dobro das chaves, para manter as sequncias de procura curtas
+	int capacity = 16;
+	while (capacity < expectedKeys * 2)
+	{
+		capacity *= 2;
+	}
+
+	set->keys = (long long*)malloc(capacity * sizeof(long long));
+	set->values = (int*)malloc(capacity * sizeof(int));
+	set->used = (bool*)calloc(capacity, sizeof(bool));
+
+	if (set->keys == NULL || set->values == NULL || set->used == NULL)
+	{
+		freeKeySet(set);
+		return NULL;
+	}
+
+	set->capacity = capacity;
+	set->numberOfKeys = 0;
+
+	return set;
+}
+
+
+/**
+* @brief	Calcular a posio inicial de uma chave no conjunto
+* @param	key			Chave
+* @param	capacity	Capacidade do conjunto (potncia de 2)
+* @return	Posio inicial
+*/
+static int getKeySlot(long long key, int capacity)
+{
+	uint64_t hash = (uint64_t)key * 0x9E3779B97F4A7C15ull;
+	hash ^= hash >> 32;
+
+	return (int)(hash & (uint64_t)(capacity - 1));
+}
+
+
+/**
+* @brief	Duplicar a capacidade do conjunto, voltando a colocar todas as chaves
+* @param	set		Conjunto de chaves
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+static bool growKeySet(KeySet* set)
+{
+	int capacity = set->capacity * 2;
+	long long* keys = (long long*)malloc(capacity * sizeof(long long));
+	int* values = (int*)malloc(capacity * sizeof(int));
+	bool* used = (bool*)calloc(capacity, sizeof(bool));
+
+	if (keys == NULL || values == NULL || used == NULL)
+	{
+		free(keys);
+		free(values);
+		free(used);
+		return false;
+	}
+
+	for (int i = 0; i < set->capacity; i++)
+	{
+		if (set->used[i])
+		{
+			int slot = getKeySlot(set->keys[i], capacity);
+			while (used[slot])
+			{
+				slot = (slot + 1) & (capacity - 1);
+			}
+
+			keys[slot] = set->keys[i];
+			values[slot] = set->values[i];
+			used[slot] = true;
+		}
+	}
+
+	free(set->keys);
+	free(set->values);
+	free(set->used);
+
+	set->keys = keys;
+	set->values = values;
+	set->used = used;
+	set->capacity = capacity;
+
+	return true;
+}
+
+
+/**
+* @brief	Inserir uma chave com um valor associado no conjunto
+* @param	set		Conjunto de chaves
+* @param	key		Chave
+* @param	value	Valor associado  chave
+* @return	Booleano para o resultado da funo (falso se a chave j existir, o valor no  alterado)
+*/
+bool insertKey(KeySet* set, long long key, int value)
+{
+	if (set == NULL)
+	{
+		return false;
+	}
+
+	if ((set->numberOfKeys + 1) * 2 > set->capacity && !growKeySet(set))
+	{
+		return false;
+	}
+
+	int slot = getKeySlot(key, set->capacity);
+
+	while (set->used[slot]) // procura linear at encontrar a chave ou uma posio livre
+	{
+		if (set->keys[slot] == key)
+		{
+			return false;
+		}
+		slot = (slot + 1) & (set->capacity - 1);
+	}
+
+	set->keys[slot] = key;
+	set->values[slot] = value;
+	set->used[slot] = true;
+	set->numberOfKeys++;
+
+	return true;
+}
+
+
+/**
+* @brief	Associar um valor a uma chave do conjunto, inserindo a chave se ainda no existir
+* @param	set		Conjunto de chaves
+* @param	key		Chave
+* @param	value	Valor associado  chave
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool setKeyValue(KeySet* set, long long key, int value)
+{
+	if (set == NULL)
+	{
+		return false;
+	}
+
+	int slot = getKeySlot(key, set->capacity);
+
+	while (set->used[slot])
+	{
+		if (set->keys[slot] == key)
+		{
+			set->values[slot] = value;
+			return true;
+		}
+		slot = (slot + 1) & (set->capacity - 1);
+	}
+
+	return insertKey(set, key, value);
+}
+
+
+/**
+* @brief	Obter o valor associado a uma chave do conjunto
+* @param	set		Conjunto de chaves
+* @param	key		Chave
+* @return	Valor associado (ou -1 se a chave no existir)
+*/
+int getKeyValue(KeySet* set, long long key)
+{
+	if (set == NULL)
+	{
+		return -1;
+	}
+
+	int slot = getKeySlot(key, set->capacity);
+
+	while (set->used[slot])
+	{
+		if (set->keys[slot] == key)
+		{
+			return set->values[slot];
+		}
+		slot = (slot + 1) & (set->capacity - 1);
+	}
+
+	return -1;
+}
+
+
+/**
+* @brief	Procurar por uma chave no conjunto
+* @param	set		Conjunto de chaves
+* @param	key		Chave
+* @return	Booleano para o resultado da funo (se encontrou ou no)
+*/
+bool searchKey(KeySet* set, long long key)
+{
+	if (set == NULL)
+	{
+		return false;
+	}
+
+	int slot = getKeySlot(key, set->capacity);
+
+	while (set->used[slot])
+	{
+		if (set->keys[slot] == key)
+		{
+			return true;
+		}
+		slot = (slot + 1) & (set->capacity - 1);
+	}
+
+	return false;
+}
+
+
+/**
+* @brief	Remover uma chave do conjunto.
+*			As chaves seguintes da mesma sequncia de procura so recuadas, para no ser preciso marcar posies apagadas
+* @param	set		Conjunto de chaves
+* @param	key		Chave
+* @return	Booleano para o resultado da funo (falso se a chave no existir)
+*/
+bool removeKey(KeySet* set, long long key)
+{
+	if (set == NULL)
+	{
+		return false;
+	}
+
+	int mask = set->capacity - 1;
+	int slot = getKeySlot(key, set->capacity);
+
+	while (set->used[slot] && set->keys[slot] != key)
+	{
+		slot = (slot + 1) & mask;
+	}
+
+	if (!set->used[slot]) // se a chave no existir
+	{
+		return false;
+	}
+
+	int next = (slot + 1) & mask;
+
+	while (set->used[next])
+	{
+		int home = getKeySlot(set->keys[next], set->capacity);
+
+		// a chave pode ocupar a posio libertada se esta estiver entre a sua posio inicial e a atual
+		if (((next - home) & mask) >= ((next - slot) & mask))
+		{
+			set->keys[slot] = set->keys[next];
+			set->values[slot] = set->values[next];
+			slot = next;
+		}
+		next = (next + 1) & mask;
+	}
+
+	set->used[slot] = false;
+	set->numberOfKeys--;
+
+	return true;
+}
+
+
+/**
+* @brief	Libertar o conjunto de chaves da memria
+* @param	set		Conjunto de chaves
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool freeKeySet(KeySet* set)
+{
+	if (set == NULL)
+	{
+		return false;
+	}
+
+	free(set->keys);
+	free(set->values);
+	free(set->used);
+	free(set);
+
+	return true;
+}
+
+#pragma endregion
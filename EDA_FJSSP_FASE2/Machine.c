@@ -109,7 +109,12 @@ Machine* readMachine(char* fileName)
 	while (fread(&auxMachine, sizeof(MachineFile), 1, fp)) {
 
 		aux = newMachine(auxMachine.id, auxMachine.isBusy);
-		head = insertMachineAtStart(head, aux);
+		Machine* inserted = insertMachineAtStart(head, aux);
+		if (inserted == NULL) { // registo repetido, a lista no  alterada
+			free(aux);
+			continue;
+		}
+		head = inserted;
 	}
 	fclose(fp);
 	return head;
@@ -165,4 +170,58 @@ bool searchMachine(Machine* head, int id)
 	}
 
 	return false;
+}
+
+
+/**
+* @brief	Copiar a lista de mquinas, mantendo a mesma ordem
+* @param	head	Lista de mquinas
+* @return	Nova lista de mquinas
+*/
+Machine* copyMachines(Machine* head)
+{
+	Machine* copy = NULL;
+	Machine* last = NULL;
+
+	for (Machine* aux = head; aux != NULL; aux = aux->next)
+	{
+		Machine* new = newMachine(aux->id, aux->isBusy);
+		if (new == NULL) // se no houver memria para alocar
+		{
+			freeMachines(copy);
+			return NULL;
+		}
+
+		if (last == NULL) // inserir no fim, sem procurar duplicados porque a lista original j no os tem
+		{
+			copy = new;
+		}
+		else
+		{
+			last->next = new;
+		}
+		last = new;
+	}
+
+	return copy;
+}
+
+
+/**
+* @brief	Libertar a lista de mquinas da memria
+* @param	head	Lista de mquinas
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool freeMachines(Machine* head)
+{
+	Machine* aux = head;
+
+	while (aux != NULL)
+	{
+		Machine* next = aux->next;
+		free(aux);
+		aux = next;
+	}
+
+	return true;
 }
\ No newline at end of file
@@ -0,0 +1,843 @@
+/**
+ * @brief	Ficheiro com as funes dos calendrios de disponibilidade das mquinas
+ * @file	machinecalendar.c
+ * @author	Vnia Pereira
+ * @email	a19264@alunos.ipca.pt
+ * @date	2022
+ * @Disciplina Estruturas de Dados Avanadas
+ *
+ * -----------------
+ *
+ * O calendrio de cada mquina  um conjunto de intervalos [incio, fim) em que a mquina no est livre,
+ * ordenado pelo incio e sem sobreposies: paragens (manuteno, turnos, avarias) e reservas de operaes j escalonadas.
+ *
+ * Os intervalos de cada mquina esto numa rvore AVL ordenada pelo incio, em que cada n guarda o tempo livre
+ * antes do seu intervalo (folga) e a maior folga da sua subrvore. Assim, inserir, remover e responder a
+ * "primeiro instante >= t em que a mquina fica livre durante d unidades" so todos em tempo logartmico,
+ * mesmo quando as consultas e as reservas so alternadas (como no plano em tempo real).
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <limits.h>
+#include "header.h"
+
+
+#pragma region rvore de folgas
+
+/**
+* @brief	Obter a altura de uma rvore
+*/
+static int getCalendarHeight(CalendarNode* node)
+{
+	return node != NULL ? node->height : 0;
+}
+
+
+/**
+* @brief	Obter a maior folga de uma rvore (-1 se estiver vazia)
+*/
+static int getMaxGap(CalendarNode* node)
+{
+	return node != NULL ? node->maxGap : -1;
+}
+
+
+/**
+* @brief	Recalcular a altura e a maior folga de um n a partir dos filhos
+* @param	node	N da rvore
+*/
+static void updateCalendarNode(CalendarNode* node)
+{
+	int left = getCalendarHeight(node->left);
+	int right = getCalendarHeight(node->right);
+	node->height = 1 + (left > right ? left : right);
+
+	node->maxGap = node->gapBefore;
+	if (getMaxGap(node->left) > node->maxGap)
+	{
+		node->maxGap = getMaxGap(node->left);
+	}
+	if (getMaxGap(node->right) > node->maxGap)
+	{
+		node->maxGap = getMaxGap(node->right);
+	}
+}
+
+
+/**
+* @brief	Rodar uma rvore para a direita
+* @param	node	Raiz da rvore (com filho esquerdo)
+* @return	Nova raiz
+*/
+static CalendarNode* rotateCalendarRight(CalendarNode* node)
+{
+	CalendarNode* left = node->left;
+
+	node->left = left->right;
+	left->right = node;
+	updateCalendarNode(node);
+	updateCalendarNode(left);
+
+	return left;
+}
+
+
+/**
+* @brief	Rodar uma rvore para a esquerda
+* @param	node	Raiz da rvore (com filho direito)
+* @return	Nova raiz
+*/
+static CalendarNode* rotateCalendarLeft(CalendarNode* node)
+{
+	CalendarNode* right = node->right;
+
+	node->right = right->left;
+	right->left = node;
+	updateCalendarNode(node);
+	updateCalendarNode(right);
+
+	return right;
+}
+
+
+/**
+* @brief	Equilibrar um n (com rotaes se a diferena de alturas for 2) e recalcular a maior folga
+* @param	node	N da rvore
+* @return	Nova raiz da subrvore
+*/
+static CalendarNode* balanceCalendarNode(CalendarNode* node)
+{
+	updateCalendarNode(node);
+
+	if (getCalendarHeight(node->left) > getCalendarHeight(node->right) + 1)
+	{
+		if (getCalendarHeight(node->left->left) < getCalendarHeight(node->left->right)) // rotao dupla (esquerda-direita)
+		{
+			node->left = rotateCalendarLeft(node->left);
+		}
+		return rotateCalendarRight(node);
+	}
+
+	if (getCalendarHeight(node->right) > getCalendarHeight(node->left) + 1)
+	{
+		if (getCalendarHeight(node->right->right) < getCalendarHeight(node->right->left)) // rotao dupla (direita-esquerda)
+		{
+			node->right = rotateCalendarRight(node->right);
+		}
+		return rotateCalendarLeft(node);
+	}
+
+	return node;
+}
+
+
+/**
+* @brief	Inserir um n na rvore, ordenado pelo incio do intervalo
+* @param	node	rvore
+* @param	new		Novo n (o incio no pode existir na rvore)
+* @return	Nova raiz da rvore
+*/
+static CalendarNode* insertCalendarNode(CalendarNode* node, CalendarNode* new)
+{
+	if (node == NULL)
+	{
+		updateCalendarNode(new);
+		return new;
+	}
+
+	if (new->interval.start < node->interval.start)
+	{
+		node->left = insertCalendarNode(node->left, new);
+	}
+	else
+	{
+		node->right = insertCalendarNode(node->right, new);
+	}
+
+	return balanceCalendarNode(node);
+}
+
+
+/**
+* @brief	Desligar o menor n de uma rvore
+* @param	node	rvore (no vazia)
+* @param	min		Apontador para o n desligado
+* @return	Nova raiz da rvore
+*/
+static CalendarNode* removeMinCalendarNode(CalendarNode* node, CalendarNode** min)
+{
+	if (node->left == NULL)
+	{
+		*min = node;
+		return node->right;
+	}
+
+	node->left = removeMinCalendarNode(node->left, min);
+
+	return balanceCalendarNode(node);
+}
+
+
+/**
+* @brief	Desligar da rvore o n com um determinado incio (o n no  libertado)
+* @param	node	rvore
+* @param	start	Incio do intervalo (tem de existir)
+* @return	Nova raiz da rvore
+*/
+static CalendarNode* removeCalendarNode(CalendarNode* node, int start)
+{
+	if (start < node->interval.start)
+	{
+		node->left = removeCalendarNode(node->left, start);
+		return balanceCalendarNode(node);
+	}
+	if (start > node->interval.start)
+	{
+		node->right = removeCalendarNode(node->right, start);
+		return balanceCalendarNode(node);
+	}
+
+	if (node->left == NULL)
+	{
+		return node->right;
+	}
+	if (node->right == NULL)
+	{
+		return node->left;
+	}
+
+	// o sucessor ocupa o lugar do n removido
+	CalendarNode* successor = NULL;
+	CalendarNode* right = removeMinCalendarNode(node->right, &successor);
+
+	successor->left = node->left;
+	successor->right = right;
+
+	return balanceCalendarNode(successor);
+}
+
+
+/**
+* @brief	Alterar a folga de um n e recalcular a maior folga no caminho desde a raiz
+* @param	node	rvore
+* @param	start	Incio do intervalo do n (tem de existir)
+* @param	gap		Nova folga
+*/
+static void setGapBefore(CalendarNode* node, int start, int gap)
+{
+	if (start < node->interval.start)
+	{
+		setGapBefore(node->left, start, gap);
+	}
+	else if (start > node->interval.start)
+	{
+		setGapBefore(node->right, start, gap);
+	}
+	else
+	{
+		node->gapBefore = gap;
+	}
+
+	updateCalendarNode(node);
+}
+
+
+/**
+* @brief	Obter o primeiro intervalo que termina depois de um instante
+*			(como no h sobreposies, os fins esto pela mesma ordem que os incios)
+* @param	node	rvore
+* @param	time	Instante
+* @return	N do intervalo (ou NULL se no existir)
+*/
+static CalendarNode* findFirstEndingAfter(CalendarNode* node, int time)
+{
+	CalendarNode* found = NULL;
+
+	while (node != NULL)
+	{
+		if (node->interval.end > time)
+		{
+			found = node;
+			node = node->left;
+		}
+		else
+		{
+			node = node->right;
+		}
+	}
+
+	return found;
+}
+
+
+/**
+* @brief	Obter o primeiro intervalo que comea num instante ou depois
+* @param	node	rvore
+* @param	time	Instante
+* @return	N do intervalo (ou NULL se no existir)
+*/
+static CalendarNode* findFirstStartingFrom(CalendarNode* node, int time)
+{
+	CalendarNode* found = NULL;
+
+	while (node != NULL)
+	{
+		if (node->interval.start >= time)
+		{
+			found = node;
+			node = node->left;
+		}
+		else
+		{
+			node = node->right;
+		}
+	}
+
+	return found;
+}
+
+
+/**
+* @brief	Obter o ltimo intervalo que comea antes de um instante
+* @param	node	rvore
+* @param	time	Instante
+* @return	N do intervalo (ou NULL se no existir)
+*/
+static CalendarNode* findLastStartingBefore(CalendarNode* node, int time)
+{
+	CalendarNode* found = NULL;
+
+	while (node != NULL)
+	{
+		if (node->interval.start < time)
+		{
+			found = node;
+			node = node->right;
+		}
+		else
+		{
+			node = node->left;
+		}
+	}
+
+	return found;
+}
+
+
+/**
+* @brief	Procurar o primeiro intervalo que comea depois de um instante e tem folga de pelo menos d unidades.
+*			As subrvores cuja maior folga no chega so ignoradas
+* @param	node		rvore
+* @param	after		Instante (s contam os intervalos que comeam depois dele)
+* @param	duration	Folga necessria
+* @return	N do intervalo (ou NULL se no existir)
+*/
+static CalendarNode* findGap(CalendarNode* node, int after, int duration)
+{
+	if (node == NULL || node->maxGap < duration)
+	{
+		return NULL;
+	}
+
+	if (node->interval.start <= after)
+	{
+		return findGap(node->right, after, duration);
+	}
+
+	CalendarNode* found = findGap(node->left, after, duration);
+	if (found == NULL && node->gapBefore >= duration)
+	{
+		found = node;
+	}
+	if (found == NULL)
+	{
+		found = findGap(node->right, after, duration);
+	}
+
+	return found;
+}
+
+
+/**
+* @brief	Libertar uma rvore de intervalos da memria
+* @param	node	rvore
+*/
+static void freeCalendarNodes(CalendarNode* node)
+{
+	while (node != NULL)
+	{
+		freeCalendarNodes(node->left);
+
+		CalendarNode* right = node->right;
+		free(node);
+		node = right; // o filho direito  libertado no ciclo, para limitar a recursividade
+	}
+}
+
+#pragma endregion
+
+
+#pragma region trabalhar com calendrios
+
+/**
+* @brief	Criar o conjunto de calendrios das mquinas, vazio
+* @return	Conjunto de calendrios criado (ou NULL se no houver memria)
+*/
+MachineCalendars* createMachineCalendars()
+{
+	MachineCalendars* calendars = (MachineCalendars*)malloc(sizeof(MachineCalendars));
+	if (calendars == NULL) // se no houver memria para alocar
+	{
+		return NULL;
+	}
+
+	calendars->capacity = NUMBER_MACHINES;
+	calendars->numberOfMachines = 0;
+	calendars->machines = (MachineCalendar*)malloc(calendars->capacity * sizeof(MachineCalendar));
+	calendars->positions = createKeySet(NUMBER_MACHINES);
+
+	if (calendars->machines == NULL || calendars->positions == NULL)
+	{
+		free(calendars->machines);
+		freeKeySet(calendars->positions);
+		free(calendars);
+		return NULL;
+	}
+
+	return calendars;
+}
+
+
+/**
+* @brief	Obter o calendrio de uma mquina, criando-o se ainda no existir
+* @param	calendars	Conjunto de calendrios
+* @param	machineID	Identificador da mquina
+* @param	create		Se o calendrio deve ser criado quando no existir
+* @return	Calendrio da mquina (ou NULL se no existir)
+*/
+MachineCalendar* getMachineCalendar(MachineCalendars* calendars, int machineID, bool create)
+{
+	if (calendars == NULL)
+	{
+		return NULL;
+	}
+
+	int position = getKeyValue(calendars->positions, machineID);
+	if (position >= 0)
+	{
+		return &calendars->machines[position];
+	}
+
+	if (!create)
+	{
+		return NULL;
+	}
+
+	if (calendars->numberOfMachines == calendars->capacity)
+	{
+		MachineCalendar* machines = (MachineCalendar*)realloc(calendars->machines, calendars->capacity * 2 * sizeof(MachineCalendar));
+		if (machines == NULL)
+		{
+			return NULL;
+		}
+
+		calendars->machines = machines;
+		calendars->capacity *= 2;
+	}
+
+	position = calendars->numberOfMachines++;
+	insertKey(calendars->positions, machineID, position);
+
+	MachineCalendar* calendar = &calendars->machines[position];
+	memset(calendar, 0, sizeof(MachineCalendar));
+	calendar->machineID = machineID;
+
+	return calendar;
+}
+
+
+/**
+* @brief	Ligar um intervalo novo  rvore do calendrio, atualizando a sua folga e a do intervalo seguinte
+* @param	calendar	Calendrio da mquina
+* @param	interval	Intervalo a inserir (no se sobrepe a nenhum)
+* @return	Booleano para o resultado da funo (falso se no houver memria)
+*/
+static bool linkCalendarInterval(MachineCalendar* calendar, CalendarInterval interval)
+{
+	CalendarNode* new = (CalendarNode*)malloc(sizeof(CalendarNode));
+	if (new == NULL) // se no houver memria para alocar
+	{
+		return false;
+	}
+
+	CalendarNode* previous = findLastStartingBefore(calendar->root, interval.start);
+	CalendarNode* next = findFirstStartingFrom(calendar->root, interval.start);
+
+	new->interval = interval;
+	new->gapBefore = previous != NULL ? interval.start - previous->interval.end : INT_MAX;
+	new->left = NULL;
+	new->right = NULL;
+
+	calendar->root = insertCalendarNode(calendar->root, new);
+	calendar->count++;
+
+	if (next != NULL)
+	{
+		setGapBefore(calendar->root, next->interval.start, next->interval.start - interval.end);
+	}
+
+	return true;
+}
+
+
+/**
+* @brief	Desligar e libertar o intervalo que comea num instante, atualizando a folga do intervalo seguinte
+* @param	calendar	Calendrio da mquina
+* @param	start		Incio do intervalo (tem de existir)
+*/
+static void unlinkCalendarInterval(MachineCalendar* calendar, int start)
+{
+	CalendarNode* node = findFirstStartingFrom(calendar->root, start);
+	CalendarNode* previous = findLastStartingBefore(calendar->root, start);
+	CalendarNode* next = findFirstStartingFrom(calendar->root, start + 1);
+
+	calendar->root = removeCalendarNode(calendar->root, start);
+	calendar->count--;
+	free(node);
+
+	if (next != NULL)
+	{
+		setGapBefore(calendar->root, next->interval.start, previous != NULL ? next->interval.start - previous->interval.end : INT_MAX);
+	}
+}
+
+
+/**
+* @brief	Inserir um intervalo ocupado no calendrio de uma mquina.
+*			Uma paragem que se sobrepe a outras paragens  juntada com elas; qualquer outra sobreposio no  permitida
+* @param	calendars	Conjunto de calendrios
+* @param	machineID	Identificador da mquina
+* @param	interval	Intervalo a inserir
+* @return	Booleano para o resultado da funo (falso se o intervalo for invlido ou se sobrepuser)
+*/
+static bool insertCalendarInterval(MachineCalendars* calendars, int machineID, CalendarInterval interval)
+{
+	if (interval.end <= interval.start)
+	{
+		return false;
+	}
+
+	MachineCalendar* calendar = getMachineCalendar(calendars, machineID, true);
+	if (calendar == NULL)
+	{
+		return false;
+	}
+
+	// intervalos sobrepostos: os que comeam antes do fim, a partir do primeiro que termina depois do incio
+	CalendarNode* first = findFirstEndingAfter(calendar->root, interval.start);
+	CalendarNode* last = NULL;
+
+	for (CalendarNode* aux = first; aux != NULL && aux->interval.start < interval.end; aux = findFirstStartingFrom(calendar->root, aux->interval.start + 1))
+	{
+		if (interval.type != INTERVAL_DOWNTIME || aux->interval.type != INTERVAL_DOWNTIME)
+		{
+			return false;
+		}
+		last = aux;
+	}
+
+	if (last != NULL) // juntar as paragens sobrepostas num s intervalo
+	{
+		int firstStart = first->interval.start;
+		int lastStart = last->interval.start;
+
+		if (firstStart < interval.start)
+		{
+			interval.start = firstStart;
+		}
+		if (last->interval.end > interval.end)
+		{
+			interval.end = last->interval.end;
+		}
+
+		// as paragens juntadas so removidas, do primeiro ao ltimo
+		for (CalendarNode* aux = first; aux != NULL && aux->interval.start <= lastStart; aux = findFirstStartingFrom(calendar->root, firstStart))
+		{
+			unlinkCalendarInterval(calendar, aux->interval.start);
+		}
+	}
+
+	return linkCalendarInterval(calendar, interval);
+}
+
+
+/**
+* @brief	Acrescentar uma paragem (manuteno, fora de turno, avaria) ao calendrio de uma mquina
+* @param	calendars	Conjunto de calendrios
+* @param	machineID	Identificador da mquina
+* @param	start		Incio da paragem
+* @param	end			Fim da paragem (exclusivo)
+* @return	Booleano para o resultado da funo (falso se o intervalo for invlido ou se sobrepuser a uma reserva)
+*/
+bool addDowntime(MachineCalendars* calendars, int machineID, int start, int end)
+{
+	CalendarInterval interval = { start, end, INTERVAL_DOWNTIME, -1 };
+
+	return insertCalendarInterval(calendars, machineID, interval);
+}
+
+
+/**
+* @brief	Reservar uma mquina para uma operao durante um intervalo
+* @param	calendars		Conjunto de calendrios
+* @param	machineID		Identificador da mquina
+* @param	operationID		Identificador da operao
+* @param	start			Incio da reserva
+* @param	end				Fim da reserva (exclusivo)
+* @return	Booleano para o resultado da funo (falso se o intervalo for invlido ou a mquina no estiver livre)
+*/
+bool addReservation(MachineCalendars* calendars, int machineID, int operationID, int start, int end)
+{
+	CalendarInterval interval = { start, end, INTERVAL_RESERVATION, operationID };
+
+	return insertCalendarInterval(calendars, machineID, interval);
+}
+
+
+/**
+* @brief	Remover o intervalo que comea num instante do calendrio de uma mquina
+* @param	calendars	Conjunto de calendrios
+* @param	machineID	Identificador da mquina
+* @param	start		Incio do intervalo
+* @return	Booleano para o resultado da funo (falso se no existir)
+*/
+bool removeCalendarInterval(MachineCalendars* calendars, int machineID, int start)
+{
+	MachineCalendar* calendar = getMachineCalendar(calendars, machineID, false);
+	if (calendar == NULL)
+	{
+		return false;
+	}
+
+	CalendarNode* node = findFirstStartingFrom(calendar->root, start);
+	if (node == NULL || node->interval.start != start)
+	{
+		return false;
+	}
+
+	unlinkCalendarInterval(calendar, start);
+
+	return true;
+}
+
+
+/**
+* @brief	Verificar se uma mquina est livre durante todo um intervalo
+* @param	calendars	Conjunto de calendrios
+* @param	machineID	Identificador da mquina
+* @param	start		Incio do intervalo
+* @param	end			Fim do intervalo (exclusivo)
+* @return	Booleano para o resultado da funo (se est livre ou no)
+*/
+bool isMachineAvailable(MachineCalendars* calendars, int machineID, int start, int end)
+{
+	MachineCalendar* calendar = getMachineCalendar(calendars, machineID, false);
+	if (calendar == NULL)
+	{
+		return true;
+	}
+
+	CalendarNode* node = findFirstEndingAfter(calendar->root, start);
+
+	return node == NULL || node->interval.start >= end;
+}
+
+
+/**
+* @brief	Obter o primeiro instante, a partir de t, em que a mquina fica livre durante um perodo seguido
+*			(tem em conta as paragens e as reservas). Tempo logartmico na quantidade de intervalos do calendrio
+* @param	calendars	Conjunto de calendrios
+* @param	machineID	Identificador da mquina
+* @param	time		Instante a partir do qual se procura
+* @param	duration	Durao do perodo
+* @return	Primeiro instante possvel
+*/
+int getEarliestStart(MachineCalendars* calendars, int machineID, int time, int duration)
+{
+	MachineCalendar* calendar = getMachineCalendar(calendars, machineID, false);
+	if (calendar == NULL || calendar->count == 0)
+	{
+		return time;
+	}
+
+	CalendarNode* node = findFirstEndingAfter(calendar->root, time);
+	if (node == NULL) // depois do ltimo intervalo
+	{
+		return time;
+	}
+
+	// o espao livre que contm t (ou comea em t); o intervalo anterior termina sempre at t
+	if (node->interval.start - time >= duration)
+	{
+		return time;
+	}
+
+	CalendarNode* found = findGap(calendar->root, node->interval.start, duration);
+
+	if (found == NULL) // nenhuma folga chega, comea depois do ltimo intervalo
+	{
+		CalendarNode* last = calendar->root;
+		while (last->right != NULL)
+		{
+			last = last->right;
+		}
+		return last->interval.end;
+	}
+
+	return found->interval.start - found->gapBefore; // fim do intervalo anterior
+}
+
+
+/**
+* @brief	Obter o primeiro intervalo do calendrio de uma mquina que comea num instante ou depois.
+*			Para percorrer os intervalos por ordem, voltar a chamar com o incio do intervalo devolvido + 1
+* @param	calendars	Conjunto de calendrios
+* @param	machineID	Identificador da mquina
+* @param	time		Instante
+* @return	Intervalo (ou NULL se no existir; vlido at o intervalo ser removido)
+*/
+CalendarInterval* getNextCalendarInterval(MachineCalendars* calendars, int machineID, int time)
+{
+	MachineCalendar* calendar = getMachineCalendar(calendars, machineID, false);
+	if (calendar == NULL)
+	{
+		return NULL;
+	}
+
+	CalendarNode* node = findFirstStartingFrom(calendar->root, time);
+
+	return node != NULL ? &node->interval : NULL;
+}
+
+
+/**
+* @brief	Libertar o conjunto de calendrios da memria
+* @param	calendars	Conjunto de calendrios
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool freeMachineCalendars(MachineCalendars* calendars)
+{
+	if (calendars == NULL)
+	{
+		return false;
+	}
+
+	for (int i = 0; i < calendars->numberOfMachines; i++)
+	{
+		freeCalendarNodes(calendars->machines[i].root);
+	}
+
+	free(calendars->machines);
+	freeKeySet(calendars->positions);
+	free(calendars);
+
+	return true;
+}
+
+#pragma endregion
+
+
+#pragma region ficheiros
+
+/**
+* @brief	Gravar os intervalos de uma rvore em ficheiro binrio, pela ordem do incio
+* @param	file		Ficheiro aberto para escrita
+* @param	machineID	Identificador da mquina
+* @param	node		rvore
+*/
+static void writeCalendarNodes(FILE* file, int machineID, CalendarNode* node)
+{
+	if (node == NULL)
+	{
+		return;
+	}
+
+	writeCalendarNodes(file, machineID, node->left);
+
+	FileCalendarInterval currentInFile;
+	currentInFile.machineID = machineID;
+	currentInFile.start = node->interval.start;
+	currentInFile.end = node->interval.end;
+	currentInFile.type = (int)node->interval.type;
+	currentInFile.operationID = node->interval.operationID;
+
+	fwrite(&currentInFile, sizeof(FileCalendarInterval), 1, file);
+
+	writeCalendarNodes(file, machineID, node->right);
+}
+
+
+/**
+* @brief	Gravar os calendrios das mquinas em ficheiro binrio
+* @param	fileName	Nome do ficheiro
+* @param	calendars	Conjunto de calendrios
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool writeMachineCalendars(char fileName[], MachineCalendars* calendars)
+{
+	if (calendars == NULL)
+	{
+		return false;
+	}
+
+	FILE* file = NULL;
+
+	if ((file = fopen(fileName, "wb")) == NULL) // erro ao abrir o ficheiro
+	{
+		return false;
+	}
+
+	for (int i = 0; i < calendars->numberOfMachines; i++)
+	{
+		writeCalendarNodes(file, calendars->machines[i].machineID, calendars->machines[i].root);
+	}
+
+	fclose(file);
+
+	return true;
+}
+
+
+/**
+* @brief	Ler os calendrios das mquinas de ficheiro binrio
+* @param	fileName	Nome do ficheiro
+* @return	Conjunto de calendrios (ou NULL se no foi possvel ler o ficheiro)
+*/
+MachineCalendars* readMachineCalendars(char fileName[])
+{
+	FILE* file = NULL;
+
+	if ((file = fopen(fileName, "rb")) == NULL) // erro ao abrir o ficheiro
+	{
+		return NULL;
+	}
+
+	MachineCalendars* calendars = createMachineCalendars();
+	FileCalendarInterval currentInFile;
+
+	while (calendars != NULL && fread(&currentInFile, sizeof(FileCalendarInterval), 1, file))
+	{
+		CalendarInterval interval = { currentInFile.start, currentInFile.end, (CalendarIntervalType)currentInFile.type, currentInFile.operationID };
+
+		insertCalendarInterval(calendars, currentInFile.machineID, interval); // intervalos invlidos ou sobrepostos so ignorados
+	}
+
+	fclose(file);
+
+	return calendars;
+}
+
+#pragma endregion
@@ -15,17 +15,69 @@
 #include <stdio.h>
 #include <locale.h>
 #include <stdbool.h>
+#include <string.h>
 #include "header.h"
 
 
+/**
+* @brief	Modo de servio: carregar o modelo dos ficheiros binrios uma vez e responder a pedidos no socket local
+* @param	socketPath	Caminho do socket local
+* @return	Resultado do programa na linha de comandos
+*/
+static int runServiceMode(char socketPath[])
+{
+	ExecutionNode* executionsTable[HASH_TABLE_SIZE];
+
+	createExecutionsTable(executionsTable);
+
+	Job* jobs = readJobs_Parallel(JOBS_FILENAME_BINARY, 0);
+	Machine* machines = readMachines_Parallel(MACHINES_FILENAME_BINARY, 0);
+	Operation* operations = readOperations_Parallel(OPERATIONS_FILENAME_BINARY, 0);
+	readExecutions_AtTable_Parallel(EXECUTIONS_FILENAME_BINARY, executionsTable, 0);
+
+	if (!startModel(newModel(jobs, machines, operations, executionsTable)))
+	{
+		printf("No foi possvel carregar o modelo!\n");
+		return 1;
+	}
+
+	TaskPool* pool = createTaskPool(0);
+	Service* service = createService(pool, socketPath);
+
+	if (service == NULL)
+	{
+		printf("No foi possvel criar o servio em %s!\n", socketPath);
+		freeTaskPool(pool);
+		stopModel();
+		return 1;
+	}
+
+	printf("Servio  espera de pedidos em %s\n", socketPath);
+	bool stopped = runService(service);
+
+	freeService(service);
+	freeTaskPool(pool);
+	stopModel();
+
+	return stopped ? 0 : 1;
+}
+
+
 /**
 * @brief	Funo principal do programa
+* @param	argc	Quantidade de argumentos
+* @param	argv	Argumentos ("--service [socket]" para o modo de servio)
 * @return	Resultado do programa na linha de comandos
 */
-int main()
+int main(int argc, char* argv[])
 {
 	setlocale(LC_ALL, "Portuguese"); // permitir caracteres especiais (portugueses)
 
+	if (argc > 1 && strcmp(argv[1], "--service") == 0)
+	{
+		return runServiceMode(argc > 2 ? argv[2] : SERVICE_SOCKET_PATH);
+	}
+
 	// listas
 	Job* jobs = NULL;
 	Operation* operations = NULL;
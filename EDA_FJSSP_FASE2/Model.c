@@ -0,0 +1,585 @@
+/**
+ * @brief	Ficheiro com as funes para partilhar o modelo entre threads (leituras sem bloqueio sobre verses imutveis)
+ * @file	model.c
+ * @author	Vnia Pereira
+ * @email	a19264@alunos.ipca.pt
+ * @date	2022
+ * @Disciplina Estruturas de Dados Avanadas
+ *
+ * -----------------
+ *
+ * As leituras no bloqueiam: cada leitor anuncia a poca global em que entrou e usa a verso publicada nesse momento.
+ * As escritas so feitas numa cpia da verso atual que depois  publicada de forma atmica (read-copy-update).
+ * A verso substituda s  libertada quando nenhum leitor ativo tiver entrado numa poca anterior  sua substituio.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "header.h"
+
+
+/**
+ * @brief	Estrutura de dados para representar uma verso substituda,  espera de ser libertada
+ */
+typedef struct RetiredModel
+{
+	Model* model;
+	long epoch; // poca global no momento em que foi substituda
+	struct RetiredModel* next;
+} RetiredModel;
+
+/**
+ * @brief	Estrutura de dados para representar o estado de cada leitor registado
+ */
+typedef struct ModelReader
+{
+	volatile long inUse;
+	volatile long epoch; // poca em que a leitura atual comeou, 0 se no estiver a ler
+} ModelReader;
+
+
+static Model* volatile currentModel = NULL;
+static volatile long globalEpoch = 1;
+static ModelReader readers[MAX_MODEL_READERS];
+static RetiredModel* retiredModels = NULL; // protegida pelo writerLock
+static Mutex writerLock;
+
+
+#pragma region verses do modelo
+
+/**
+* @brief	Criar nova verso do modelo, que fica dona das listas e da tabela recebidas
+* @param	jobs		Lista de trabalhos
+* @param	machines	Lista de mquinas
+* @param	operations	Lista de operaes
+* @param	table		Tabela hash das execues (os ns das posies passam para o modelo)
+* @return	Nova verso do modelo
+*/
+Model* newModel(Job* jobs, Machine* machines, Operation* operations, ExecutionNode* table[])
+{
+	Model* new = (Model*)malloc(sizeof(Model));
+	if (new == NULL) // se no houver memria para alocar
+	{
+		return NULL;
+	}
+
+	new->jobs = jobs;
+	new->machines = machines;
+	new->operations = operations;
+	new->version = 0;
+
+	for (int i = 0; i < HASH_TABLE_SIZE; i++)
+	{
+		new->executionsTable[i] = table[i];
+	}
+
+	return new;
+}
+
+
+/**
+* @brief	Copiar uma verso do modelo por completo (todas as listas e a tabela hash)
+* @param	model	Verso do modelo a copiar
+* @return	Nova verso do modelo
+*/
+Model* copyModel(Model* model)
+{
+	if (model == NULL)
+	{
+		return NULL;
+	}
+
+	Model* new = (Model*)malloc(sizeof(Model));
+	if (new == NULL) // se no houver memria para alocar
+	{
+		return NULL;
+	}
+
+	new->jobs = copyJobs(model->jobs);
+	new->machines = copyMachines(model->machines);
+	new->operations = copyOperations(model->operations);
+	copyExecutionsTable(model->executionsTable, new->executionsTable);
+	new->version = model->version;
+
+	return new;
+}
+
+
+/**
+* @brief	Libertar uma verso do modelo da memria
+* @param	model	Verso do modelo
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool freeModel(Model* model)
+{
+	if (model == NULL)
+	{
+		return false;
+	}
+
+	freeJobs(model->jobs);
+	freeMachines(model->machines);
+	freeOperations(model->operations);
+	freeExecutionsTable(model->executionsTable);
+	free(model);
+
+	return true;
+}
+
+
+/**
+* @brief	Publicar a primeira verso do modelo
+* @param	model	Verso inicial do modelo
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool startModel(Model* model)
+{
+	if (model == NULL || currentModel != NULL) // se j existir uma verso publicada
+	{
+		return false;
+	}
+
+	initMutex(&writerLock);
+
+	for (int i = 0; i < MAX_MODEL_READERS; i++)
+	{
+		readers[i].inUse = 0;
+		readers[i].epoch = 0;
+	}
+
+	atomicExchangePointer((void* volatile*)&currentModel, model);
+
+	return true;
+}
+
+
+/**
+* @brief	Libertar a verso publicada e todas as verses substitudas.
+*			S deve ser chamada quando no houver leitores nem escritores ativos
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool stopModel()
+{
+	Model* model = (Model*)atomicExchangePointer((void* volatile*)&currentModel, NULL);
+	if (model == NULL)
+	{
+		return false;
+	}
+
+	while (retiredModels != NULL)
+	{
+		RetiredModel* next = retiredModels->next;
+		freeModel(retiredModels->model);
+		free(retiredModels);
+		retiredModels = next;
+	}
+
+	freeModel(model);
+	destroyMutex(&writerLock);
+
+	return true;
+}
+
+#pragma endregion
+
+
+#pragma region leitura sem bloqueio
+
+/**
+* @brief	Registar a thread atual como leitora
+* @return	Identificador do leitor (ou -1 se j existirem MAX_MODEL_READERS leitores)
+*/
+int registerModelReader()
+{
+	for (int i = 0; i < MAX_MODEL_READERS; i++)
+	{
+		if (atomicCompareExchange(&readers[i].inUse, 0, 1))
+		{
+			atomicStore(&readers[i].epoch, 0);
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+
+/**
+* @brief	Remover o registo de um leitor
+* @param	reader	Identificador do leitor
+*/
+void unregisterModelReader(int reader)
+{
+	if (reader < 0 || reader >= MAX_MODEL_READERS)
+	{
+		return;
+	}
+
+	atomicStore(&readers[reader].epoch, 0);
+	atomicStore(&readers[reader].inUse, 0);
+}
+
+
+/**
+* @brief	Comear uma leitura: obter a verso publicada, que no  libertada at endModelRead
+* @param	reader	Identificador do leitor
+* @return	Verso do modelo (no pode ser alterada)
+*/
+Model* beginModelRead(int reader)
+{
+	// anunciar a poca antes de ler o apontador, para que o escritor saiba que esta verso pode estar em uso
+	atomicStore(&readers[reader].epoch, atomicLoad(&globalEpoch));
+
+	return (Model*)atomicLoadPointer((void* volatile*)&currentModel);
+}
+
+
+/**
+* @brief	Terminar uma leitura, a verso obtida deixa de poder ser usada
+* @param	reader	Identificador do leitor
+*/
+void endModelRead(int reader)
+{
+	atomicStore(&readers[reader].epoch, 0);
+}
+
+#pragma endregion
+
+
+#pragma region escrita por cpia
+
+/**
+* @brief	Comear uma alterao: obter uma cpia da verso publicada para ser alterada.
+*			Os escritores so executados um de cada vez, at publishModelUpdate ou cancelModelUpdate
+* @return	Cpia da verso atual do modelo
+*/
+Model* beginModelUpdate()
+{
+	lockMutex(&writerLock);
+
+	Model* draft = copyModel((Model*)atomicLoadPointer((void* volatile*)&currentModel));
+	if (draft == NULL)
+	{
+		unlockMutex(&writerLock);
+	}
+
+	return draft;
+}
+
+
+/**
+* @brief	Publicar uma cpia alterada como a nova verso do modelo
+* @param	draft	Cpia obtida com beginModelUpdate
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool publishModelUpdate(Model* draft)
+{
+	if (draft == NULL)
+	{
+		return false;
+	}
+
+	RetiredModel* retired = (RetiredModel*)malloc(sizeof(RetiredModel));
+	if (retired == NULL) // se no houver memria para alocar
+	{
+		cancelModelUpdate(draft);
+		return false;
+	}
+
+	draft->version++;
+
+	// a partir daqui os novos leitores obtm a nova verso
+	retired->model = (Model*)atomicExchangePointer((void* volatile*)&currentModel, draft);
+	retired->epoch = atomicLoad(&globalEpoch);
+	retired->next = retiredModels;
+	retiredModels = retired;
+
+	atomicAdd(&globalEpoch, 1);
+
+	reclaimModels();
+
+	unlockMutex(&writerLock);
+
+	return true;
+}
+
+
+/**
+* @brief	Cancelar uma alterao, descartando a cpia
+* @param	draft	Cpia obtida com beginModelUpdate
+*/
+void cancelModelUpdate(Model* draft)
+{
+	freeModel(draft);
+	unlockMutex(&writerLock);
+}
+
+
+/**
+* @brief	Libertar as verses substitudas que j no podem estar a ser lidas.
+*			Deve ser chamada por um escritor (com o writerLock bloqueado)
+* @return	Quantidade de verses libertadas
+*/
+int reclaimModels()
+{
+	long minEpoch = atomicLoad(&globalEpoch);
+
+	// a poca mais antiga entre os leitores ativos
+	for (int i = 0; i < MAX_MODEL_READERS; i++)
+	{
+		long epoch = atomicLoad(&readers[i].epoch);
+
+		if (epoch != 0 && epoch < minEpoch)
+		{
+			minEpoch = epoch;
+		}
+	}
+
+	int reclaimed = 0;
+	RetiredModel* aux = retiredModels;
+	RetiredModel* auxAnt = NULL;
+
+	while (aux != NULL)
+	{
+		RetiredModel* next = aux->next;
+
+		// um leitor que entrou numa poca posterior  substituio j obteve uma verso mais recente
+		if (aux->epoch < minEpoch)
+		{
+			if (auxAnt == NULL)
+			{
+				retiredModels = next;
+			}
+			else
+			{
+				auxAnt->next = next;
+			}
+
+			freeModel(aux->model);
+			free(aux);
+			reclaimed++;
+		}
+		else
+		{
+			auxAnt = aux;
+		}
+
+		aux = next;
+	}
+
+	return reclaimed;
+}
+
+#pragma endregion
+
+
+#pragma region consultas sobre uma verso
+
+/**
+* @brief	Procurar por uma execuo numa verso do modelo
+* @param	model			Verso do modelo
+* @param	operationID		Identificador da operao
+* @param	machineID		Identificador da mquina
+* @return	Execuo encontrada ou retorna nulo se no encontrar
+*/
+Execution* searchExecution_AtModel(Model* model, int operationID, int machineID)
+{
+	if (model == NULL)
+	{
+		return NULL;
+	}
+
+	int index = generateHash_AtTable(model->executionsTable, operationID);
+
+	return searchExecution(model->executionsTable[index]->start, operationID, machineID);
+}
+
+
+/**
+* @brief	Obter o tempo mnimo ou mximo para completar um trabalho numa verso do modelo,
+*			procurando as execues de cada operao apenas na respetiva posio da tabela hash
+* @param	model		Verso do modelo
+* @param	jobID		Identificador do trabalho
+* @param	useMax			Se deve ser escolhida a execuo mais lenta em vez da mais rpida
+* @param	executions		Apontador para a lista de execues escolhidas a ser devolvida (NULL para no criar a lista)
+* @param	chosenArray		Array para as execues escolhidas (s usado at capacity)
+* @param	capacity		Capacidade do array
+* @param	numberOfChosen	Apontador para a quantidade de execues escolhidas (pode ser NULL)
+* @return	Quantidade de tempo
+*/
+static int getTimeToCompleteJob_AtModel(Model* model, int jobID, bool useMax, Execution** executions, FileExecution chosenArray[], int capacity, int* numberOfChosen)
+{
+	int count = 0;
+
+	if (numberOfChosen != NULL)
+	{
+		*numberOfChosen = 0;
+	}
+
+	if (model == NULL || model->operations == NULL)
+	{
+		return -1;
+	}
+
+	int counter = 0;
+
+	for (Operation* operation = model->operations; operation != NULL; operation = operation->next)
+	{
+		if (operation->jobID != jobID)
+		{
+			continue;
+		}
+
+		int index = generateHash_AtTable(model->executionsTable, operation->id);
+		Execution* chosen = NULL;
+
+		for (Execution* aux = model->executionsTable[index]->start; aux != NULL; aux = aux->next)
+		{
+			if (aux->operationID == operation->id
+				&& (chosen == NULL || (useMax ? aux->runtime > chosen->runtime : aux->runtime < chosen->runtime)))
+			{
+				chosen = aux;
+			}
+		}
+
+		if (chosen != NULL)
+		{
+			counter += chosen->runtime;
+
+			// a verso  partilhada, por isso  devolvida uma cpia da execuo escolhida
+			if (executions != NULL)
+			{
+				Execution* copy = newExecution(chosen->operationID, chosen->machineID, chosen->runtime);
+				Execution* inserted = copy != NULL ? insertExecutionAtStart(*executions, copy) : NULL;
+
+				if (inserted != NULL)
+				{
+					*executions = inserted;
+				}
+				else // execuo repetida (operao repetida na lista), a lista no  alterada
+				{
+					free(copy);
+				}
+			}
+
+			if (count < capacity)
+			{
+				chosenArray[count].operationID = chosen->operationID;
+				chosenArray[count].machineID = chosen->machineID;
+				chosenArray[count].runtime = chosen->runtime;
+			}
+			count++;
+		}
+	}
+
+	if (numberOfChosen != NULL)
+	{
+		*numberOfChosen = count;
+	}
+
+	return counter;
+}
+
+
+/**
+* @brief	Obter o mnimo de tempo necessrio para completar um trabalho numa verso do modelo
+* @param	model			Verso do modelo
+* @param	jobID			Identificador do trabalho
+* @param	minExecutions	Apontador para a lista de execues a ser devolvida, relativamente ao tempo mnimo
+* @return	Quantidade de tempo
+*/
+int getMinTimeToCompleteJob_AtModel(Model* model, int jobID, Execution** minExecutions)
+{
+	return getTimeToCompleteJob_AtModel(model, jobID, false, minExecutions, NULL, 0, NULL);
+}
+
+
+/**
+* @brief	Obter o mximo de tempo necessrio para completar um trabalho numa verso do modelo
+* @param	model			Verso do modelo
+* @param	jobID			Identificador do trabalho
+* @param	maxExecutions	Apontador para a lista de execues a ser devolvida, relativamente ao tempo mximo
+* @return	Quantidade de tempo
+*/
+int getMaxTimeToCompleteJob_AtModel(Model* model, int jobID, Execution** maxExecutions)
+{
+	return getTimeToCompleteJob_AtModel(model, jobID, true, maxExecutions, NULL, 0, NULL);
+}
+
+
+/**
+* @brief	Obter o mnimo de tempo necessrio para completar um trabalho numa verso do modelo,
+*			escrevendo as execues escolhidas num array (sem alocar memria)
+* @param	model			Verso do modelo
+* @param	jobID			Identificador do trabalho
+* @param	minExecutions	Array para as execues escolhidas, uma por operao do trabalho
+* @param	capacity		Capacidade do array
+* @param	numberOfChosen	Apontador para a quantidade de execues escolhidas (se for maior que capacity, o array ficou incompleto)
+* @return	Quantidade de tempo
+*/
+int getMinTimeToCompleteJob_AtModel_ToArray(Model* model, int jobID, FileExecution minExecutions[], int capacity, int* numberOfChosen)
+{
+	return getTimeToCompleteJob_AtModel(model, jobID, false, NULL, minExecutions, capacity, numberOfChosen);
+}
+
+
+/**
+* @brief	Obter o mximo de tempo necessrio para completar um trabalho numa verso do modelo,
+*			escrevendo as execues escolhidas num array (sem alocar memria)
+* @param	model			Verso do modelo
+* @param	jobID			Identificador do trabalho
+* @param	maxExecutions	Array para as execues escolhidas, uma por operao do trabalho
+* @param	capacity		Capacidade do array
+* @param	numberOfChosen	Apontador para a quantidade de execues escolhidas (se for maior que capacity, o array ficou incompleto)
+* @return	Quantidade de tempo
+*/
+int getMaxTimeToCompleteJob_AtModel_ToArray(Model* model, int jobID, FileExecution maxExecutions[], int capacity, int* numberOfChosen)
+{
+	return getTimeToCompleteJob_AtModel(model, jobID, true, NULL, maxExecutions, capacity, numberOfChosen);
+}
+
+
+/**
+* @brief	Mostrar uma verso do modelo na consola
+* @param	model	Verso do modelo
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool displayModel(Model* model)
+{
+	if (model == NULL)
+	{
+		return false;
+	}
+
+	printf("Verso: %ld\n", model->version);
+	displayJob(model->jobs);
+	displayMachines(model->machines);
+	displayOperations(model->operations);
+	displayExecutions_AtTable(model->executionsTable);
+
+	return true;
+}
+
+
+/**
+* @brief	Armazenar uma verso do modelo nos ficheiros binrios
+* @param	model	Verso do modelo
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool writeModel(Model* model)
+{
+	if (model == NULL)
+	{
+		return false;
+	}
+
+	bool written = writeJobs(JOBS_FILENAME_BINARY, model->jobs);
+	written = writeMachines(MACHINES_FILENAME_BINARY, model->machines) && written;
+	written = writeOperations(OPERATIONS_FILENAME_BINARY, model->operations) && written;
+	written = writeExecutions_AtTable(EXECUTIONS_FILENAME_BINARY, model->executionsTable) && written;
+
+	return written;
+}
+
+#pragma endregion
@@ -0,0 +1,923 @@
+/**
+ * @brief	Ficheiro com as funes para exportar e importar o modelo completo num ficheiro de texto (TSV)
+ * @file	modeltext.c
+ * @author	Vnia Pereira
+ * @email	a19264@alunos.ipca.pt
+ * @date	2022
+ * @Disciplina Estruturas de Dados Avanadas
+ *
+ * -----------------
+ *
+ * Formato do ficheiro (texto ASCII, independente da configurao regional):
+ *	- uma seco por estrutura, comeada por uma linha com o nome entre parnteses retos, por esta ordem:
+ *		[jobs]			id	releaseDate	dueDate	weight		(dueDate = 2147483647 se o trabalho no tiver data de entrega)
+ *		[machines]		id	isBusy						(isBusy = 0 ou 1)
+ *		[operations]	id	jobID
+ *		[executions]	operationID	machineID	runtime
+ *	- uma linha por registo, com os campos inteiros separados por tabulaes (tambm so aceites vrgulas);
+ *	- linhas vazias e linhas comeadas por '#' so ignoradas; o fim de linha pode ser "\n" ou "\r\n";
+ *	- o identificador da operao de cada execuo no pode ser negativo ( usado na funo de hash).
+ * Os registos so escritos pela ordem das listas (e das posies da tabela hash), e lidos pela mesma ordem.
+ * Tal como na leitura dos ficheiros binrios, os registos repetidos so ignorados.
+ *
+ * A escrita formata os nmeros  mo num buffer grande, sem printf. A leitura carrega o ficheiro inteiro para
+ * memria e divide-o em partes de MODEL_TEXT_CHUNK_SIZE bytes, alinhadas ao incio das linhas. Cada parte  lida
+ * por uma tarefa do conjunto de threads, que cria os ns em listas locais; no fim, as listas so ligadas pela
+ * ordem das partes numa nica passagem, removendo os repetidos com conjuntos de chaves.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "header.h"
+
+
+#define MODEL_TEXT_BUFFER_SIZE (1 << 20) // bytes acumulados em memria antes de cada escrita no ficheiro
+#define MODEL_TEXT_MAX_LINE 64 // maior linha escrita (4 inteiros de 11 caracteres, separadores e fim de linha)
+
+
+/**
+ * @brief	Seces do ficheiro de texto do modelo
+ */
+typedef enum ModelTextSection
+{
+	SECTION_NONE = -1,
+	SECTION_JOBS,
+	SECTION_MACHINES,
+	SECTION_OPERATIONS,
+	SECTION_EXECUTIONS
+} ModelTextSection;
+
+/**
+ * @brief	Estrutura de dados para a escrita do ficheiro de texto em blocos grandes
+ */
+typedef struct TextWriter
+{
+	FILE* file;
+	char* buffer;
+	int used;
+	bool failed;
+} TextWriter;
+
+/**
+ * @brief	Estrutura de dados com uma parte do ficheiro e os ns criados a partir dela
+ */
+typedef struct TextChunk
+{
+	const char* start;
+	const char* end; // a seguir ao ltimo byte (fim de uma linha)
+	ModelTextSection firstSection; // seco em que a parte comea
+	ModelTextSection lastSection; // ltima seco aberta dentro da parte (SECTION_NONE se no abrir nenhuma)
+	bool failed;
+	Job* jobs; // listas locais, pela ordem do ficheiro
+	Job* lastJob;
+	Machine* machines;
+	Machine* lastMachine;
+	Operation* operations;
+	Operation* lastOperation;
+	Execution* starts[HASH_TABLE_SIZE]; // execues, uma lista por posio da tabela hash
+	Execution* ends[HASH_TABLE_SIZE];
+	unsigned int hashSeed; // semente da funo de hash da tabela de destino
+	int counts[4]; // registos lidos de cada seco
+} TextChunk;
+
+static const char* sectionNames[] = { "[jobs]", "[machines]", "[operations]", "[executions]" };
+static const int sectionFields[] = { 4, 2, 2, 3 };
+
+
+#pragma region escrita
+
+/**
+* @brief	Escrever no ficheiro o que est no buffer
+*/
+static void flushTextWriter(TextWriter* writer)
+{
+	if (writer->used > 0 && fwrite(writer->buffer, 1, writer->used, writer->file) != (size_t)writer->used)
+	{
+		writer->failed = true;
+	}
+
+	writer->used = 0;
+}
+
+/**
+* @brief	Escrever uma linha com um texto constante
+*/
+static void writeTextLine(TextWriter* writer, const char* text)
+{
+	int length = (int)strlen(text);
+
+	if (writer->used + length + 1 > MODEL_TEXT_BUFFER_SIZE)
+	{
+		flushTextWriter(writer);
+	}
+
+	memcpy(writer->buffer + writer->used, text, length);
+	writer->used += length;
+	writer->buffer[writer->used++] = '\n';
+}
+
+/**
+* @brief	Escrever uma linha com inteiros separados por tabulaes; os dgitos so gerados do fim para o incio
+*/
+static void writeIntLine(TextWriter* writer, const int values[], int count)
+{
+	if (writer->used + MODEL_TEXT_MAX_LINE > MODEL_TEXT_BUFFER_SIZE)
+	{
+		flushTextWriter(writer);
+	}
+
+	char* text = writer->buffer + writer->used;
+	int size = 0;
+
+	for (int i = 0; i < count; i++)
+	{
+		char digits[10];
+		int length = 0;
+		uint32_t number = (uint32_t)values[i];
+
+		if (values[i] < 0)
+		{
+			text[size++] = '-';
+			number = 0u - number;
+		}
+
+		do
+		{
+			digits[length++] = (char)('0' + number % 10);
+			number /= 10;
+		} while (number > 0);
+
+		while (length > 0)
+		{
+			text[size++] = digits[--length];
+		}
+
+		text[size++] = i + 1 < count ? '\t' : '\n';
+	}
+
+	writer->used += size;
+}
+
+/**
+* @brief	Exportar as estruturas do modelo para um ficheiro de texto
+* @param	fileName	Nome do ficheiro
+* @param	jobs		Lista de trabalhos
+* @param	machines	Lista de mquinas
+* @param	operations	Lista de operaes
+* @param	table		Tabela hash das execues
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool writeModelText(char fileName[], Job* jobs, Machine* machines, Operation* operations, ExecutionNode* table[])
+{
+	TextWriter writer;
+
+	// em modo binrio para o fim de linha ser sempre "\n"
+	if ((writer.file = fopen(fileName, "wb")) == NULL) // se no foi possvel abrir o ficheiro
+	{
+		return false;
+	}
+
+	writer.buffer = (char*)malloc(MODEL_TEXT_BUFFER_SIZE);
+	writer.used = 0;
+	writer.failed = false;
+
+	if (writer.buffer == NULL)
+	{
+		fclose(writer.file);
+		return false;
+	}
+
+	int values[4];
+
+	writeTextLine(&writer, "# FJSSP model, text format 1");
+
+	writeTextLine(&writer, sectionNames[SECTION_JOBS]);
+	writeTextLine(&writer, "# id\treleaseDate\tdueDate\tweight");
+	for (Job* aux = jobs; aux != NULL; aux = aux->next)
+	{
+		values[0] = aux->id;
+		values[1] = aux->releaseDate;
+		values[2] = aux->dueDate;
+		values[3] = aux->weight;
+		writeIntLine(&writer, values, 4);
+	}
+
+	writeTextLine(&writer, sectionNames[SECTION_MACHINES]);
+	writeTextLine(&writer, "# id\tisBusy");
+	for (Machine* aux = machines; aux != NULL; aux = aux->next)
+	{
+		values[0] = aux->id;
+		values[1] = aux->isBusy ? 1 : 0;
+		writeIntLine(&writer, values, 2);
+	}
+
+	writeTextLine(&writer, sectionNames[SECTION_OPERATIONS]);
+	writeTextLine(&writer, "# id\tjobID");
+	for (Operation* aux = operations; aux != NULL; aux = aux->next)
+	{
+		values[0] = aux->id;
+		values[1] = aux->jobID;
+		writeIntLine(&writer, values, 2);
+	}
+
+	writeTextLine(&writer, sectionNames[SECTION_EXECUTIONS]);
+	writeTextLine(&writer, "# operationID\tmachineID\truntime");
+	for (int b = 0; b < HASH_TABLE_SIZE && table != NULL; b++)
+	{
+		for (Execution* aux = table[b]->start; aux != NULL; aux = aux->next)
+		{
+			values[0] = aux->operationID;
+			values[1] = aux->machineID;
+			values[2] = aux->runtime;
+			writeIntLine(&writer, values, 3);
+		}
+	}
+
+	flushTextWriter(&writer);
+
+	bool written = !writer.failed && !ferror(writer.file);
+
+	if (fclose(writer.file) != 0)
+	{
+		written = false;
+	}
+	free(writer.buffer);
+
+	return written;
+}
+
+#pragma endregion
+
+
+#pragma region leitura
+
+/**
+* @brief	Obter a seco aberta por uma linha comeada por '['
+* @return	Seco (ou SECTION_NONE se o nome no for conhecido)
+*/
+static ModelTextSection parseSection(const char* line, const char* lineEnd)
+{
+	while (lineEnd > line && (lineEnd[-1] == '\r' || lineEnd[-1] == ' ' || lineEnd[-1] == '\t'))
+	{
+		lineEnd--;
+	}
+
+	for (int s = SECTION_JOBS; s <= SECTION_EXECUTIONS; s++)
+	{
+		size_t length = strlen(sectionNames[s]);
+
+		if ((size_t)(lineEnd - line) == length && memcmp(line, sectionNames[s], length) == 0)
+		{
+			return (ModelTextSection)s;
+		}
+	}
+
+	return SECTION_NONE;
+}
+
+/**
+* @brief	Ler os inteiros de uma linha, separados por tabulaes ou vrgulas (sem depender da configurao regional)
+* @return	Booleano para o resultado da funo (falso se a linha no tiver exatamente count inteiros vlidos)
+*/
+static bool parseIntLine(const char* text, const char* lineEnd, int values[], int count)
+{
+	if (lineEnd > text && lineEnd[-1] == '\r')
+	{
+		lineEnd--;
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		bool negative = false;
+		uint32_t number = 0;
+		const char* digits;
+
+		if (text < lineEnd && *text == '-')
+		{
+			negative = true;
+			text++;
+		}
+
+		digits = text;
+		while (text < lineEnd && *text >= '0' && *text <= '9')
+		{
+			uint32_t digit = (uint32_t)(*text - '0');
+
+			if (number > (2147483648u - digit) / 10) // no cabe num int
+			{
+				return false;
+			}
+			number = number * 10 + digit;
+			text++;
+		}
+
+		if (text == digits || (!negative && number > 2147483647u))
+		{
+			return false;
+		}
+
+		values[i] = negative ? (int)(0u - number) : (int)number;
+
+		if (i + 1 < count)
+		{
+			if (text >= lineEnd || (*text != '\t' && *text != ','))
+			{
+				return false;
+			}
+			text++;
+		}
+	}
+
+	return text == lineEnd;
+}
+
+/**
+* @brief	Procurar, de trs para a frente, a ltima seco aberta dentro de cada parte
+*/
+static void findChunkSections(int first, int last, void* argument)
+{
+	TextChunk* chunks = (TextChunk*)argument;
+
+	for (int c = first; c < last; c++)
+	{
+		TextChunk* chunk = &chunks[c];
+		const char* line = chunk->end;
+
+		chunk->lastSection = SECTION_NONE;
+
+		while (line > chunk->start)
+		{
+			const char* lineEnd = line - 1; // '\n' da linha anterior
+			line = lineEnd;
+			while (line > chunk->start && line[-1] != '\n')
+			{
+				line--;
+			}
+
+			if (*line == '[')
+			{
+				chunk->lastSection = parseSection(line, lineEnd);
+				if (chunk->lastSection == SECTION_NONE) // seco desconhecida
+				{
+					chunk->failed = true;
+				}
+				break;
+			}
+		}
+	}
+}
+
+/**
+* @brief	Criar o n de um registo e lig-lo no fim da lista local da sua seco
+* @return	Booleano para o resultado da funo (falso se no houver memria)
+*/
+static bool appendRecord(TextChunk* chunk, ModelTextSection section, int values[])
+{
+	switch (section)
+	{
+	case SECTION_JOBS:
+	{
+		Job* new = newJob_WithDates(values[0], values[1], values[2], values[3]);
+		if (new == NULL)
+		{
+			return false;
+		}
+
+		if (chunk->lastJob == NULL)
+		{
+			chunk->jobs = new;
+		}
+		else
+		{
+			chunk->lastJob->next = new;
+		}
+		chunk->lastJob = new;
+		break;
+	}
+
+	case SECTION_MACHINES:
+	{
+		Machine* new = newMachine(values[0], values[1] != 0);
+		if (new == NULL)
+		{
+			return false;
+		}
+
+		if (chunk->lastMachine == NULL)
+		{
+			chunk->machines = new;
+		}
+		else
+		{
+			chunk->lastMachine->next = new;
+		}
+		chunk->lastMachine = new;
+		break;
+	}
+
+	case SECTION_OPERATIONS:
+	{
+		Operation* new = newOperation(values[0], values[1]);
+		if (new == NULL)
+		{
+			return false;
+		}
+
+		if (chunk->lastOperation == NULL)
+		{
+			chunk->operations = new;
+		}
+		else
+		{
+			chunk->lastOperation->next = new;
+		}
+		chunk->lastOperation = new;
+		break;
+	}
+
+	default:
+	{
+		Execution* new = newExecution(values[0], values[1], values[2]);
+		if (new == NULL)
+		{
+			return false;
+		}
+
+		int index = generateHash_WithSeed(new->operationID, chunk->hashSeed);
+		if (chunk->ends[index] == NULL)
+		{
+			chunk->starts[index] = new;
+		}
+		else
+		{
+			chunk->ends[index]->next = new;
+		}
+		chunk->ends[index] = new;
+		break;
+	}
+	}
+
+	chunk->counts[section]++;
+
+	return true;
+}
+
+/**
+* @brief	Criar os ns de todas as linhas de cada parte, em listas locais
+*/
+static void parseChunks(int first, int last, void* argument)
+{
+	TextChunk* chunks = (TextChunk*)argument;
+
+	for (int c = first; c < last; c++)
+	{
+		TextChunk* chunk = &chunks[c];
+		ModelTextSection section = chunk->firstSection;
+		const char* line = chunk->start;
+
+		while (line < chunk->end && !chunk->failed)
+		{
+			const char* lineEnd = (const char*)memchr(line, '\n', chunk->end - line);
+			int values[4];
+
+			if (*line == '[')
+			{
+				section = parseSection(line, lineEnd);
+				chunk->failed = section == SECTION_NONE;
+			}
+			else if (*line != '#' && *line != '\n' && *line != '\r') // ignorar comentrios e linhas vazias
+			{
+				chunk->failed = section == SECTION_NONE
+					|| !parseIntLine(line, lineEnd, values, sectionFields[section])
+					|| (section == SECTION_EXECUTIONS && values[0] < 0) // a posio na tabela hash no aceita negativos
+					|| !appendRecord(chunk, section, values);
+			}
+
+			line = lineEnd + 1;
+		}
+	}
+}
+
+/**
+* @brief	Obter a quantidade de registos de uma seco em todas as partes
+*/
+static int countRecords(TextChunk chunks[], int numberOfChunks, ModelTextSection section)
+{
+	long long count = 0;
+
+	for (int c = 0; c < numberOfChunks; c++)
+	{
+		count += chunks[c].counts[section];
+	}
+
+	return (int)count;
+}
+
+/**
+* @brief	Ligar as listas locais de trabalhos pela ordem das partes, ignorando os identificadores repetidos
+* @return	Booleano para o resultado da funo (falso se no houver memria)
+*/
+static bool mergeJobs(TextChunk chunks[], int numberOfChunks, Job** head)
+{
+	KeySet* ids = createKeySet(countRecords(chunks, numberOfChunks, SECTION_JOBS));
+	if (ids == NULL)
+	{
+		return false;
+	}
+
+	Job* last = NULL;
+
+	for (int c = 0; c < numberOfChunks; c++)
+	{
+		Job* aux = chunks[c].jobs;
+		chunks[c].jobs = NULL;
+
+		while (aux != NULL)
+		{
+			Job* next = aux->next;
+			aux->next = NULL;
+
+			if (!insertKey(ids, aux->id, 0)) // registo repetido
+			{
+				free(aux);
+			}
+			else
+			{
+				if (last == NULL)
+				{
+					*head = aux;
+				}
+				else
+				{
+					last->next = aux;
+				}
+				last = aux;
+			}
+
+			aux = next;
+		}
+	}
+
+	freeKeySet(ids);
+
+	return true;
+}
+
+/**
+* @brief	Ligar as listas locais de mquinas pela ordem das partes, ignorando os identificadores repetidos
+* @return	Booleano para o resultado da funo (falso se no houver memria)
+*/
+static bool mergeMachines(TextChunk chunks[], int numberOfChunks, Machine** head)
+{
+	KeySet* ids = createKeySet(countRecords(chunks, numberOfChunks, SECTION_MACHINES));
+	if (ids == NULL)
+	{
+		return false;
+	}
+
+	Machine* last = NULL;
+
+	for (int c = 0; c < numberOfChunks; c++)
+	{
+		Machine* aux = chunks[c].machines;
+		chunks[c].machines = NULL;
+
+		while (aux != NULL)
+		{
+			Machine* next = aux->next;
+			aux->next = NULL;
+
+			if (!insertKey(ids, aux->id, 0)) // registo repetido
+			{
+				free(aux);
+			}
+			else
+			{
+				if (last == NULL)
+				{
+					*head = aux;
+				}
+				else
+				{
+					last->next = aux;
+				}
+				last = aux;
+			}
+
+			aux = next;
+		}
+	}
+
+	freeKeySet(ids);
+
+	return true;
+}
+
+/**
+* @brief	Ligar as listas locais de operaes pela ordem das partes, ignorando os identificadores repetidos
+* @return	Booleano para o resultado da funo (falso se no houver memria)
+*/
+static bool mergeOperations(TextChunk chunks[], int numberOfChunks, Operation** head)
+{
+	KeySet* ids = createKeySet(countRecords(chunks, numberOfChunks, SECTION_OPERATIONS));
+	if (ids == NULL)
+	{
+		return false;
+	}
+
+	Operation* last = NULL;
+
+	for (int c = 0; c < numberOfChunks; c++)
+	{
+		Operation* aux = chunks[c].operations;
+		chunks[c].operations = NULL;
+
+		while (aux != NULL)
+		{
+			Operation* next = aux->next;
+			aux->next = NULL;
+
+			if (!insertKey(ids, aux->id, 0)) // registo repetido
+			{
+				free(aux);
+			}
+			else
+			{
+				if (last == NULL)
+				{
+					*head = aux;
+				}
+				else
+				{
+					last->next = aux;
+				}
+				last = aux;
+			}
+
+			aux = next;
+		}
+	}
+
+	freeKeySet(ids);
+
+	return true;
+}
+
+/**
+* @brief	Ligar as listas locais de execues no fim de cada posio da tabela, pela ordem das partes.
+*			As execues que j estavam na tabela contam para os repetidos
+* @return	Booleano para o resultado da funo (falso se no houver memria)
+*/
+static bool mergeExecutions(TextChunk chunks[], int numberOfChunks, ExecutionNode* table[])
+{
+	int count = countRecords(chunks, numberOfChunks, SECTION_EXECUTIONS);
+
+	for (int b = 0; b < HASH_TABLE_SIZE; b++)
+	{
+		count += table[b]->numberOfExecutions;
+	}
+
+	KeySet* keys = createKeySet(count);
+	if (keys == NULL)
+	{
+		return false;
+	}
+
+	Execution* last[HASH_TABLE_SIZE];
+
+	for (int b = 0; b < HASH_TABLE_SIZE; b++)
+	{
+		last[b] = NULL;
+		for (Execution* aux = table[b]->start; aux != NULL; aux = aux->next)
+		{
+			insertKey(keys, EXECUTION_KEY(aux->operationID, aux->machineID), b);
+			last[b] = aux;
+		}
+	}
+
+	for (int c = 0; c < numberOfChunks; c++)
+	{
+		for (int b = 0; b < HASH_TABLE_SIZE; b++)
+		{
+			Execution* aux = chunks[c].starts[b];
+			chunks[c].starts[b] = NULL;
+
+			while (aux != NULL)
+			{
+				Execution* next = aux->next;
+				aux->next = NULL;
+
+				if (!insertKey(keys, EXECUTION_KEY(aux->operationID, aux->machineID), b)) // registo repetido
+				{
+					free(aux);
+				}
+				else
+				{
+					if (last[b] == NULL)
+					{
+						table[b]->start = aux;
+					}
+					else
+					{
+						last[b]->next = aux;
+					}
+					last[b] = aux;
+					table[b]->numberOfExecutions++;
+				}
+
+				aux = next;
+			}
+		}
+	}
+
+	freeKeySet(keys);
+
+	return true;
+}
+
+/**
+* @brief	Libertar os ns que ficaram nas listas locais de uma parte
+*/
+static void freeChunk(TextChunk* chunk)
+{
+	freeJobs(chunk->jobs);
+	freeMachines(chunk->machines);
+	freeOperations(chunk->operations);
+	for (int b = 0; b < HASH_TABLE_SIZE; b++)
+	{
+		freeExecutions(chunk->starts[b]);
+	}
+}
+
+/**
+* @brief	Importar as estruturas do modelo de um ficheiro de texto, com as partes do ficheiro lidas em paralelo
+* @param	pool		Conjunto de threads (NULL para ler tudo na thread atual)
+* @param	fileName	Nome do ficheiro
+* @param	jobs		Endereo onde guardar a lista de trabalhos
+* @param	machines	Endereo onde guardar a lista de mquinas
+* @param	operations	Endereo onde guardar a lista de operaes
+* @param	table		Tabela hash das execues (j criada, pode ter execues; as lidas so acrescentadas no fim de cada posio)
+* @return	Quantidade de registos lidos, repetidos includos (ou -1 se o ficheiro no existe ou no  vlido)
+*/
+long long readModelText(TaskPool* pool, char fileName[], Job** jobs, Machine** machines, Operation** operations, ExecutionNode* table[])
+{
+	*jobs = NULL;
+	*machines = NULL;
+	*operations = NULL;
+
+	long long size = getFileSize(fileName);
+	if (size < 0)
+	{
+		return -1;
+	}
+
+	FILE* file = NULL;
+	char* text = (char*)malloc((size_t)size + 1);
+
+	if (text == NULL || (file = fopen(fileName, "rb")) == NULL)
+	{
+		free(text);
+		return -1;
+	}
+
+	bool loaded = fread(text, 1, (size_t)size, file) == (size_t)size;
+	fclose(file);
+
+	if (size > 0 && text[size - 1] != '\n') // a ltima linha tambm tem de acabar em '\n'
+	{
+		text[size++] = '\n';
+	}
+
+	// dividir o texto em partes que comeam no incio de uma linha
+	long long numberOfChunks = size / MODEL_TEXT_CHUNK_SIZE + 1;
+	TextChunk* chunks = (TextChunk*)calloc((size_t)numberOfChunks, sizeof(TextChunk));
+	loaded = loaded && chunks != NULL;
+
+	const char* end = text + size;
+	const char* position = text;
+	int used = 0;
+
+	while (loaded && position < end)
+	{
+		const char* chunkEnd = end;
+
+		if (end - position > MODEL_TEXT_CHUNK_SIZE)
+		{
+			const char* middle = position + MODEL_TEXT_CHUNK_SIZE - 1;
+			chunkEnd = (const char*)memchr(middle, '\n', end - middle) + 1; // existe sempre, o texto acaba em '\n'
+		}
+
+		chunks[used].start = position;
+		chunks[used].end = chunkEnd;
+		used++;
+		position = chunkEnd;
+	}
+
+	if (loaded && used > 0)
+	{
+		// cada parte comea na ltima seco aberta antes dela
+		parallelFor(pool, 0, used, 1, findChunkSections, chunks);
+
+		ModelTextSection section = SECTION_NONE;
+		for (int c = 0; c < used; c++)
+		{
+			chunks[c].firstSection = section;
+			chunks[c].hashSeed = table[0]->hashSeed;
+			if (chunks[c].lastSection != SECTION_NONE)
+			{
+				section = chunks[c].lastSection;
+			}
+		}
+
+		parallelFor(pool, 0, used, 1, parseChunks, chunks);
+	}
+
+	free(text);
+
+	long long numberOfRecords = 0;
+	for (int c = 0; c < used; c++)
+	{
+		loaded = loaded && !chunks[c].failed;
+		for (int s = SECTION_JOBS; s <= SECTION_EXECUTIONS; s++)
+		{
+			numberOfRecords += chunks[c].counts[s];
+		}
+	}
+
+	loaded = loaded
+		&& mergeJobs(chunks, used, jobs)
+		&& mergeMachines(chunks, used, machines)
+		&& mergeOperations(chunks, used, operations)
+		&& mergeExecutions(chunks, used, table);
+
+	if (!loaded) // os ns que no chegaram a ser ligados so libertados
+	{
+		for (int c = 0; c < used; c++)
+		{
+			freeChunk(&chunks[c]);
+		}
+		freeJobs(*jobs);
+		freeMachines(*machines);
+		freeOperations(*operations);
+		*jobs = NULL;
+		*machines = NULL;
+		*operations = NULL;
+	}
+
+	free(chunks);
+
+	return loaded ? numberOfRecords : -1;
+}
+
+#pragma endregion
+
+
+#pragma region modelo
+
+/**
+* @brief	Exportar uma verso do modelo para um ficheiro de texto
+* @param	model		Verso do modelo
+* @param	fileName	Nome do ficheiro
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool dumpModel_Text(Model* model, char fileName[])
+{
+	if (model == NULL)
+	{
+		return false;
+	}
+
+	return writeModelText(fileName, model->jobs, model->machines, model->operations, model->executionsTable);
+}
+
+/**
+* @brief	Criar uma verso do modelo a partir de um ficheiro de texto, lido em paralelo
+* @param	pool		Conjunto de threads (NULL para ler tudo na thread atual)
+* @param	fileName	Nome do ficheiro
+* @return	Nova verso do modelo (ou NULL se o ficheiro no existe ou no  vlido)
+*/
+Model* loadModel_Text(TaskPool* pool, char fileName[])
+{
+	Job* jobs = NULL;
+	Machine* machines = NULL;
+	Operation* operations = NULL;
+	ExecutionNode* table[HASH_TABLE_SIZE];
+
+	createExecutionsTable(table);
+
+	if (readModelText(pool, fileName, &jobs, &machines, &operations, table) < 0)
+	{
+		for (int b = 0; b < HASH_TABLE_SIZE; b++)
+		{
+			free(table[b]);
+		}
+		return NULL;
+	}
+
+	return newModel(jobs, machines, operations, table);
+}
+
+#pragma endregion
@@ -0,0 +1,1654 @@
+/**
+ * @brief	Ficheiro com as funes dos objetivos do escalonamento e do arquivo de Pareto
+ * @file	objectives.c
+ * @author	Vnia Pereira
+ * @email	a19264@alunos.ipca.pt
+ * @date	2022
+ * @Disciplina Estruturas de Dados Avanadas
+ *
+ * -----------------
+ *
+ * Um plano  representado, sobre a imagem compilada do problema, por dois vetores:
+ *	- a alternativa (mquina) escolhida para cada operao;
+ *	- a sequncia de trabalhos: a k-sima ocorrncia do trabalho j representa a k-sima operao de j.
+ * Cada operao comea quando a sua mquina e a operao anterior do trabalho estiverem livres
+ * (a primeira operao de cada trabalho no comea antes da data de disponibilidade do trabalho).
+ *
+ * Objetivos (todos a minimizar): fim do plano, carga total (soma dos tempos escolhidos) e carga da mquina mais carregada.
+ * A carga total e a carga de cada mquina so atualizadas em tempo constante ao mudar uma alternativa,
+ * e a maior carga numa rvore de segmentos (O(log m)). O plano  descodificado por inteiro (O(n)) da primeira vez
+ * que um objetivo  pedido; a partir da, mudar uma alternativa ou trocar posies da sequncia s recalcula as operaes
+ * cujo fim muda (as seguintes no trabalho ou na mquina), pela ordem da sequncia, e o fim de cada trabalho atualiza
+ * o atraso ponderado e o fim do plano (maior fim de um trabalho, numa rvore de segmentos).
+ *
+ * Com tempos de preparao, cada mquina gasta, antes de cada operao, o tempo de preparao entre a famlia da sua operao
+ * anterior e a da operao. A ordem das operaes em cada mquina fica guardada (anterior e seguinte) no clculo do plano,
+ * para que a variao dos tempos de preparao de um movimento seja obtida em tempo constante.
+ *
+ * O arquivo de Pareto guarda os planos no dominados, ordenados pelos objetivos: um plano que domine o novo
+ * s pode estar antes da posio do novo, e os planos dominados pelo novo s podem estar depois.
+ * Os planos com o mesmo fim formam uma escada (carga total a crescer, maior carga a descer), por isso cada grupo
+ *  verificado com uma pesquisa binria: a dominncia custa O(g log n), com g fins diferentes no arquivo.
+ * Guardar ou remover planos continua a deslocar o fim do array (O(n) cpias de memria).
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include "header.h"
+
+
+#pragma region avaliao dos objetivos
+
+/**
+* @brief	Verificar se um vetor de objetivos domina outro (no  pior em nenhum objetivo e  melhor em pelo menos um)
+* @param	first	Primeiro vetor
+* @param	second	Segundo vetor
+* @return	Booleano para o resultado da funo (se o primeiro domina o segundo)
+*/
+bool dominates(ObjectiveVector* first, ObjectiveVector* second)
+{
+	if (first->makespan > second->makespan || first->totalWorkload > second->totalWorkload || first->maxMachineWorkload > second->maxMachineWorkload)
+	{
+		return false;
+	}
+
+	return first->makespan < second->makespan || first->totalWorkload < second->totalWorkload || first->maxMachineWorkload < second->maxMachineWorkload;
+}
+
+
+/**
+* @brief	Atualizar a carga de uma mquina e a rvore de segmentos com a maior carga
+*/
+static void addMachineWorkload(AssignmentEvaluator* evaluator, int machine, int runtime)
+{
+	evaluator->machineWorkloads[machine] += runtime;
+
+	int node = evaluator->treeLeaves + machine;
+	evaluator->workloadTree[node] = evaluator->machineWorkloads[machine];
+
+	for (node /= 2; node >= 1; node /= 2)
+	{
+		int left = evaluator->workloadTree[2 * node];
+		int right = evaluator->workloadTree[2 * node + 1];
+		evaluator->workloadTree[node] = left > right ? left : right;
+	}
+}
+
+
+/**
+* @brief	Preparar os auxiliares das mquinas para construir ou calcular um plano (mquinas livres e sem operaes)
+*/
+static void resetMachines(AssignmentEvaluator* evaluator)
+{
+	int numberOfMachines = evaluator->snapshot->header->numberOfMachines;
+
+	evaluator->makespanIsValid = false; // a ordem das mquinas vai ser refeita, o plano tem de ser descodificado de novo
+	memset(evaluator->machineReady, 0, numberOfMachines * sizeof(int));
+	memset(evaluator->machineFirst, -1, numberOfMachines * sizeof(int));
+	memset(evaluator->machineLast, -1, numberOfMachines * sizeof(int));
+}
+
+
+/**
+* @brief	Obter o tempo de preparao de uma mquina entre duas operaes (0 se uma delas no existir ou no houver tempos de preparao)
+*/
+static int getSetupBetween(AssignmentEvaluator* evaluator, int machine, int previous, int next)
+{
+	if (evaluator->setups == NULL || previous < 0 || next < 0 || evaluator->machineSetups[machine] < 0)
+	{
+		return 0;
+	}
+
+	// a matriz  obtida pela posio, porque o array de matrizes pode mudar de stio quando outra mquina  acrescentada
+	const SetupMatrix* matrix = &evaluator->setups->machines[evaluator->machineSetups[machine]];
+
+	return getSetupTime_AtMatrix(matrix, evaluator->operationFamilies[previous], evaluator->operationFamilies[next]);
+}
+
+
+/**
+* @brief	Obter o tempo de preparao de uma mquina antes de uma operao, depois da ltima operao colocada na mquina
+*/
+static int getSetupBefore(AssignmentEvaluator* evaluator, int machine, int operation)
+{
+	return getSetupBetween(evaluator, machine, evaluator->machineLast[machine], operation);
+}
+
+
+/**
+* @brief	Obter o incio de uma operao: quando a operao anterior do trabalho acabar e a mquina estiver livre e preparada
+*/
+static int getOperationStart(AssignmentEvaluator* evaluator, int job, int machine, int setup)
+{
+	int machineReady = evaluator->machineReady[machine] + setup;
+
+	return evaluator->jobReady[job] > machineReady ? evaluator->jobReady[job] : machineReady;
+}
+
+
+/**
+* @brief	Colocar uma operao no fim de uma mquina, atualizando os instantes livres e a ordem das operaes da mquina
+*/
+static void placeOperation(AssignmentEvaluator* evaluator, int job, int machine, int operation, int end)
+{
+	int last = evaluator->machineLast[machine];
+
+	evaluator->machinePrevious[operation] = last;
+	evaluator->machineNext[operation] = -1;
+
+	if (last >= 0)
+	{
+		evaluator->machineNext[last] = operation;
+	}
+	else
+	{
+		evaluator->machineFirst[machine] = operation;
+	}
+
+	evaluator->machineLast[machine] = operation;
+	evaluator->jobReady[job] = end;
+	evaluator->machineReady[machine] = end;
+}
+
+
+/**
+* @brief	Obter o atraso ponderado de um trabalho que acaba num instante
+*/
+static long long getJobTardiness(const ProblemSnapshot* snapshot, int job, int end)
+{
+	if (end <= snapshot->jobDueDates[job])
+	{
+		return 0;
+	}
+
+	return (long long)snapshot->jobWeights[job] * (end - snapshot->jobDueDates[job]);
+}
+
+
+/**
+* @brief	Atualizar o fim de um trabalho na rvore de segmentos com o fim do plano
+*/
+static void setJobEnd(AssignmentEvaluator* evaluator, int job, int end)
+{
+	int node = evaluator->jobLeaves + job;
+	evaluator->jobEndTree[node] = end;
+
+	for (node /= 2; node >= 1; node /= 2)
+	{
+		int left = evaluator->jobEndTree[2 * node];
+		int right = evaluator->jobEndTree[2 * node + 1];
+		evaluator->jobEndTree[node] = left > right ? left : right;
+	}
+}
+
+
+/**
+* @brief	Marcar uma operao para ser recalculada (cada operao s entra uma vez na fila)
+*/
+static void markOperation(AssignmentEvaluator* evaluator, int operation)
+{
+	if (operation < 0 || evaluator->isPending[operation])
+	{
+		return;
+	}
+
+	evaluator->isPending[operation] = true;
+	evaluator->pendingOperations[evaluator->numberOfPending++] = operation;
+}
+
+
+/**
+* @brief	Descer uma operao na fila de operaes a recalcular (a menor posio na sequncia fica  frente)
+*/
+static void siftDownPending(AssignmentEvaluator* evaluator, int index)
+{
+	int* heap = evaluator->pendingOperations;
+	const int* positions = evaluator->sequencePositions;
+
+	while (true)
+	{
+		int smallest = index;
+		int left = 2 * index + 1;
+		int right = left + 1;
+
+		if (left < evaluator->numberOfPending && positions[heap[left]] < positions[heap[smallest]])
+		{
+			smallest = left;
+		}
+		if (right < evaluator->numberOfPending && positions[heap[right]] < positions[heap[smallest]])
+		{
+			smallest = right;
+		}
+		if (smallest == index)
+		{
+			return;
+		}
+
+		int operation = heap[index];
+		heap[index] = heap[smallest];
+		heap[smallest] = operation;
+		index = smallest;
+	}
+}
+
+
+/**
+* @brief	Acrescentar uma operao  fila de operaes a recalcular, j ordenada
+*/
+static void pushPending(AssignmentEvaluator* evaluator, int operation)
+{
+	if (evaluator->isPending[operation])
+	{
+		return;
+	}
+
+	int* heap = evaluator->pendingOperations;
+	const int* positions = evaluator->sequencePositions;
+	int index = evaluator->numberOfPending++;
+
+	evaluator->isPending[operation] = true;
+
+	while (index > 0 && positions[heap[(index - 1) / 2]] > positions[operation])
+	{
+		heap[index] = heap[(index - 1) / 2];
+		index = (index - 1) / 2;
+	}
+
+	heap[index] = operation;
+}
+
+
+/**
+* @brief	Recalcular as operaes marcadas e as que dependem delas. As operaes so recalculadas pela ordem da sequncia,
+*			porque a operao anterior do trabalho e a anterior da mquina esto sempre antes na sequncia;
+*			s as operaes seguintes de uma operao cujo fim mudou entram na fila
+*/
+static void propagateSchedule(AssignmentEvaluator* evaluator)
+{
+	const ProblemSnapshot* snapshot = evaluator->snapshot;
+
+	// as marcas foram feitas antes de a sequncia estar acabada, por isso a fila s  ordenada agora
+	for (int i = evaluator->numberOfPending / 2 - 1; i >= 0; i--)
+	{
+		siftDownPending(evaluator, i);
+	}
+
+	while (evaluator->numberOfPending > 0)
+	{
+		int operation = evaluator->pendingOperations[0];
+		evaluator->pendingOperations[0] = evaluator->pendingOperations[--evaluator->numberOfPending];
+		siftDownPending(evaluator, 0);
+		evaluator->isPending[operation] = false;
+
+		int job = snapshot->operationJobs[operation];
+		int alternative = evaluator->alternatives[operation];
+		int machine = snapshot->alternativeMachines[alternative];
+		int previous = evaluator->machinePrevious[operation];
+
+		int start = operation > snapshot->jobOperationStarts[job] ? evaluator->operationEnds[operation - 1] : snapshot->jobReleaseDates[job];
+		int machineReady = previous >= 0 ? evaluator->operationEnds[previous] + getSetupBetween(evaluator, machine, previous, operation) : 0;
+		if (machineReady > start)
+		{
+			start = machineReady;
+		}
+
+		int end = start + snapshot->alternativeRuntimes[alternative];
+		int oldEnd = evaluator->operationEnds[operation];
+		if (end == oldEnd)
+		{
+			continue;
+		}
+
+		evaluator->operationEnds[operation] = end;
+
+		if (operation + 1 < snapshot->jobOperationStarts[job + 1])
+		{
+			pushPending(evaluator, operation + 1);
+		}
+		else // ltima operao do trabalho: o fim do trabalho mudou
+		{
+			evaluator->weightedTardiness += getJobTardiness(snapshot, job, end) - getJobTardiness(snapshot, job, oldEnd);
+			setJobEnd(evaluator, job, end);
+		}
+
+		if (evaluator->machineNext[operation] >= 0)
+		{
+			pushPending(evaluator, evaluator->machineNext[operation]);
+		}
+	}
+
+	evaluator->makespan = evaluator->jobEndTree[1];
+}
+
+
+/**
+* @brief	Retirar uma operao da ordem de uma mquina, atualizando os tempos de preparao
+*/
+static void unlinkOperation(AssignmentEvaluator* evaluator, int operation, int machine)
+{
+	int previous = evaluator->machinePrevious[operation];
+	int next = evaluator->machineNext[operation];
+
+	evaluator->totalSetupTime += (long long)getSetupBetween(evaluator, machine, previous, next)
+		- getSetupBetween(evaluator, machine, previous, operation) - getSetupBetween(evaluator, machine, operation, next);
+
+	if (previous >= 0)
+	{
+		evaluator->machineNext[previous] = next;
+	}
+	else
+	{
+		evaluator->machineFirst[machine] = next;
+	}
+
+	if (next >= 0)
+	{
+		evaluator->machinePrevious[next] = previous;
+	}
+	else
+	{
+		evaluator->machineLast[machine] = previous;
+	}
+
+	markOperation(evaluator, next);
+}
+
+
+/**
+* @brief	Inserir uma operao na ordem de uma mquina, pela sua posio na sequncia, atualizando os tempos de preparao.
+*			A operao anterior da mquina  procurada para trs na sequncia (tempo constante se a operao ficar em primeiro ou em ltimo)
+*/
+static void linkOperation(AssignmentEvaluator* evaluator, int operation, int machine)
+{
+	const ProblemSnapshot* snapshot = evaluator->snapshot;
+	int position = evaluator->sequencePositions[operation];
+	int first = evaluator->machineFirst[machine];
+	int last = evaluator->machineLast[machine];
+	int previous = -1;
+
+	if (first >= 0 && evaluator->sequencePositions[first] < position)
+	{
+		previous = last;
+
+		if (evaluator->sequencePositions[last] > position)
+		{
+			int i = position - 1;
+			while (snapshot->alternativeMachines[evaluator->alternatives[evaluator->sequenceOperations[i]]] != machine)
+			{
+				i--;
+			}
+			previous = evaluator->sequenceOperations[i];
+		}
+	}
+
+	int next = previous >= 0 ? evaluator->machineNext[previous] : first;
+
+	evaluator->machinePrevious[operation] = previous;
+	evaluator->machineNext[operation] = next;
+
+	if (previous >= 0)
+	{
+		evaluator->machineNext[previous] = operation;
+	}
+	else
+	{
+		evaluator->machineFirst[machine] = operation;
+	}
+
+	if (next >= 0)
+	{
+		evaluator->machinePrevious[next] = operation;
+	}
+	else
+	{
+		evaluator->machineLast[machine] = operation;
+	}
+
+	evaluator->totalSetupTime += (long long)getSetupBetween(evaluator, machine, previous, operation)
+		+ getSetupBetween(evaluator, machine, operation, next) - getSetupBetween(evaluator, machine, previous, next);
+
+	markOperation(evaluator, operation);
+	markOperation(evaluator, next);
+}
+
+
+/**
+* @brief	Trocar duas posies seguidas da sequncia num plano j descodificado. As duas operaes continuam as mesmas
+*			(cada trabalho mantm as suas ocorrncias antes das outras posies); s trocam de ordem na mquina se partilharem a mquina
+*/
+static void swapAdjacentOperations(AssignmentEvaluator* evaluator, int position)
+{
+	const ProblemSnapshot* snapshot = evaluator->snapshot;
+	int job = evaluator->sequence[position];
+
+	if (job == evaluator->sequence[position + 1])
+	{
+		return;
+	}
+
+	int first = evaluator->sequenceOperations[position];
+	int second = evaluator->sequenceOperations[position + 1];
+
+	evaluator->sequence[position] = evaluator->sequence[position + 1];
+	evaluator->sequence[position + 1] = job;
+	evaluator->sequenceOperations[position] = second;
+	evaluator->sequenceOperations[position + 1] = first;
+	evaluator->sequencePositions[second] = position;
+	evaluator->sequencePositions[first] = position + 1;
+
+	int machine = snapshot->alternativeMachines[evaluator->alternatives[first]];
+	if (machine != snapshot->alternativeMachines[evaluator->alternatives[second]])
+	{
+		return; // as operaes anteriores de cada uma no mudaram, por isso os fins tambm no
+	}
+
+	// seguidas na sequncia e na mesma mquina: previous -> first -> second -> next passa a previous -> second -> first -> next
+	int previous = evaluator->machinePrevious[first];
+	int next = evaluator->machineNext[second];
+
+	evaluator->totalSetupTime += (long long)getSetupBetween(evaluator, machine, previous, second) + getSetupBetween(evaluator, machine, second, first)
+		+ getSetupBetween(evaluator, machine, first, next) - getSetupBetween(evaluator, machine, previous, first)
+		- getSetupBetween(evaluator, machine, first, second) - getSetupBetween(evaluator, machine, second, next);
+
+	if (previous >= 0)
+	{
+		evaluator->machineNext[previous] = second;
+	}
+	else
+	{
+		evaluator->machineFirst[machine] = second;
+	}
+
+	if (next >= 0)
+	{
+		evaluator->machinePrevious[next] = first;
+	}
+	else
+	{
+		evaluator->machineLast[machine] = first;
+	}
+
+	evaluator->machinePrevious[second] = previous;
+	evaluator->machineNext[second] = first;
+	evaluator->machinePrevious[first] = second;
+	evaluator->machineNext[first] = next;
+
+	markOperation(evaluator, second);
+	markOperation(evaluator, first);
+	markOperation(evaluator, next);
+}
+
+
+/**
+* @brief	Criar um avaliador de planos, com a alternativa mais rpida de cada operao
+*			e a sequncia que percorre os trabalhos operao a operao
+* @param	snapshot	Imagem compilada do problema (tem de existir enquanto o avaliador existir)
+* @return	Avaliador criado (ou NULL se no houver memria ou se alguma operao no tiver alternativas)
+*/
+AssignmentEvaluator* createAssignmentEvaluator(ProblemSnapshot* snapshot)
+{
+	if (snapshot == NULL || countOperationsWithoutAlternatives_AtSnapshot(snapshot) != 0) // todas as operaes precisam de uma mquina
+	{
+		return NULL;
+	}
+
+	int numberOfOperations = snapshot->header->numberOfOperations;
+	int numberOfMachines = snapshot->header->numberOfMachines;
+	int numberOfJobs = snapshot->header->numberOfJobs;
+
+	AssignmentEvaluator* evaluator = (AssignmentEvaluator*)calloc(1, sizeof(AssignmentEvaluator));
+	if (evaluator == NULL) // se no houver memria para alocar
+	{
+		return NULL;
+	}
+
+	evaluator->treeLeaves = 1;
+	while (evaluator->treeLeaves < numberOfMachines)
+	{
+		evaluator->treeLeaves *= 2;
+	}
+
+	evaluator->jobLeaves = 1;
+	while (evaluator->jobLeaves < numberOfJobs)
+	{
+		evaluator->jobLeaves *= 2;
+	}
+
+	evaluator->snapshot = snapshot;
+	evaluator->alternatives = (int*)malloc((numberOfOperations + 1) * sizeof(int));
+	evaluator->sequence = (int*)malloc((numberOfOperations + 1) * sizeof(int));
+	evaluator->machineWorkloads = (int*)calloc(numberOfMachines + 1, sizeof(int));
+	evaluator->workloadTree = (int*)calloc(2 * evaluator->treeLeaves, sizeof(int));
+	evaluator->jobReady = (int*)malloc((numberOfJobs + 1) * sizeof(int));
+	evaluator->jobPositions = (int*)malloc((numberOfJobs + 1) * sizeof(int));
+	evaluator->machineReady = (int*)malloc((numberOfMachines + 1) * sizeof(int));
+	evaluator->machineFirst = (int*)malloc((numberOfMachines + 1) * sizeof(int));
+	evaluator->machineLast = (int*)malloc((numberOfMachines + 1) * sizeof(int));
+	evaluator->machinePrevious = (int*)malloc((numberOfOperations + 1) * sizeof(int));
+	evaluator->machineNext = (int*)malloc((numberOfOperations + 1) * sizeof(int));
+	evaluator->operationEnds = (int*)malloc((numberOfOperations + 1) * sizeof(int));
+	evaluator->sequenceOperations = (int*)malloc((numberOfOperations + 1) * sizeof(int));
+	evaluator->sequencePositions = (int*)malloc((numberOfOperations + 1) * sizeof(int));
+	evaluator->pendingOperations = (int*)malloc((numberOfOperations + 1) * sizeof(int));
+	evaluator->isPending = (bool*)calloc(numberOfOperations + 1, sizeof(bool));
+	evaluator->jobEndTree = (int*)calloc(2 * evaluator->jobLeaves, sizeof(int));
+
+	if (evaluator->alternatives == NULL || evaluator->sequence == NULL || evaluator->machineWorkloads == NULL || evaluator->workloadTree == NULL
+		|| evaluator->jobReady == NULL || evaluator->jobPositions == NULL || evaluator->machineReady == NULL
+		|| evaluator->machineFirst == NULL || evaluator->machineLast == NULL || evaluator->machinePrevious == NULL || evaluator->machineNext == NULL
+		|| evaluator->operationEnds == NULL || evaluator->sequenceOperations == NULL || evaluator->sequencePositions == NULL
+		|| evaluator->pendingOperations == NULL || evaluator->isPending == NULL || evaluator->jobEndTree == NULL)
+	{
+		freeAssignmentEvaluator(evaluator);
+		return NULL;
+	}
+
+	// alternativa mais rpida (a primeira, na imagem do problema)
+	for (int i = 0; i < numberOfOperations; i++)
+	{
+		int alternative = snapshot->operationAlternativeStarts[i];
+
+		evaluator->alternatives[i] = alternative;
+		evaluator->totalWorkload += snapshot->alternativeRuntimes[alternative];
+		addMachineWorkload(evaluator, snapshot->alternativeMachines[alternative], snapshot->alternativeRuntimes[alternative]);
+	}
+
+	// primeira operao de cada trabalho, depois a segunda de cada trabalho, ...
+	int count = 0;
+	for (int k = 0; count < numberOfOperations; k++)
+	{
+		for (int j = 0; j < numberOfJobs; j++)
+		{
+			if (snapshot->jobOperationStarts[j] + k < snapshot->jobOperationStarts[j + 1])
+			{
+				evaluator->sequence[count++] = j;
+			}
+		}
+	}
+
+	evaluator->makespanIsValid = false;
+
+	return evaluator;
+}
+
+
+/**
+* @brief	Libertar o avaliador de planos da memria (a imagem do problema no  libertada)
+* @param	evaluator	Avaliador
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool freeAssignmentEvaluator(AssignmentEvaluator* evaluator)
+{
+	if (evaluator == NULL)
+	{
+		return false;
+	}
+
+	free(evaluator->alternatives);
+	free(evaluator->sequence);
+	free(evaluator->machineWorkloads);
+	free(evaluator->workloadTree);
+	free(evaluator->jobReady);
+	free(evaluator->jobPositions);
+	free(evaluator->machineReady);
+	free(evaluator->machineFirst);
+	free(evaluator->machineLast);
+	free(evaluator->machinePrevious);
+	free(evaluator->machineNext);
+	free(evaluator->operationEnds);
+	free(evaluator->sequenceOperations);
+	free(evaluator->sequencePositions);
+	free(evaluator->pendingOperations);
+	free(evaluator->isPending);
+	free(evaluator->jobEndTree);
+	free(evaluator->machineSetups);
+	free(evaluator->operationFamilies);
+	free(evaluator);
+
+	return true;
+}
+
+
+/**
+* @brief	Mudar a alternativa (mquina) de uma operao, atualizando as cargas. Se o plano j estiver descodificado,
+*			a operao passa para a ordem da nova mquina e s so recalculadas as operaes cujo fim muda
+* @param	evaluator		Avaliador
+* @param	operation		Posio da operao na imagem do problema
+* @param	alternative		ndice da nova alternativa nas alternativas da imagem
+* @return	Booleano para o resultado da funo (falso se a alternativa no for da operao)
+*/
+bool setAlternative_AtEvaluator(AssignmentEvaluator* evaluator, int operation, int alternative)
+{
+	if (evaluator == NULL || operation < 0 || operation >= evaluator->snapshot->header->numberOfOperations)
+	{
+		return false;
+	}
+
+	const ProblemSnapshot* snapshot = evaluator->snapshot;
+
+	if (alternative < snapshot->operationAlternativeStarts[operation] || alternative >= snapshot->operationAlternativeStarts[operation + 1])
+	{
+		return false;
+	}
+
+	int previous = evaluator->alternatives[operation];
+	if (previous == alternative)
+	{
+		return true;
+	}
+
+	int source = snapshot->alternativeMachines[previous];
+	int target = snapshot->alternativeMachines[alternative];
+
+	evaluator->totalWorkload += snapshot->alternativeRuntimes[alternative] - snapshot->alternativeRuntimes[previous];
+	addMachineWorkload(evaluator, source, -snapshot->alternativeRuntimes[previous]);
+	addMachineWorkload(evaluator, target, snapshot->alternativeRuntimes[alternative]);
+
+	evaluator->alternatives[operation] = alternative;
+
+	if (!evaluator->makespanIsValid) // o plano ainda no foi descodificado, ser calculado por inteiro quando for pedido
+	{
+		return true;
+	}
+
+	if (source != target)
+	{
+		unlinkOperation(evaluator, operation, source);
+		linkOperation(evaluator, operation, target);
+	}
+
+	markOperation(evaluator, operation);
+	propagateSchedule(evaluator);
+
+	return true;
+}
+
+
+/**
+* @brief	Mudar a sequncia de trabalhos do plano
+* @param	evaluator	Avaliador
+* @param	sequence	Sequncia (cada trabalho aparece tantas vezes quantas as suas operaes)
+* @return	Booleano para o resultado da funo (falso se a sequncia no for vlida)
+*/
+bool setSequence_AtEvaluator(AssignmentEvaluator* evaluator, int sequence[])
+{
+	if (evaluator == NULL || sequence == NULL)
+	{
+		return false;
+	}
+
+	const ProblemSnapshot* snapshot = evaluator->snapshot;
+	int numberOfJobs = snapshot->header->numberOfJobs;
+	int numberOfOperations = snapshot->header->numberOfOperations;
+
+	memset(evaluator->jobPositions, 0, numberOfJobs * sizeof(int));
+
+	for (int i = 0; i < numberOfOperations; i++)
+	{
+		int job = sequence[i];
+
+		if (job < 0 || job >= numberOfJobs || snapshot->jobOperationStarts[job] + evaluator->jobPositions[job] >= snapshot->jobOperationStarts[job + 1])
+		{
+			return false;
+		}
+
+		evaluator->jobPositions[job]++;
+	}
+
+	memcpy(evaluator->sequence, sequence, numberOfOperations * sizeof(int));
+	evaluator->makespanIsValid = false;
+
+	return true;
+}
+
+
+/**
+* @brief	Trocar duas posies da sequncia de trabalhos (a sequncia continua vlida). Se o plano j estiver descodificado,
+*			a troca  feita como trocas de posies seguidas (O(distncia) entre as posies) e s so recalculadas
+*			as operaes cujo fim muda
+* @param	evaluator	Avaliador
+* @param	first		Primeira posio
+* @param	second		Segunda posio
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool swapSequence_AtEvaluator(AssignmentEvaluator* evaluator, int first, int second)
+{
+	int numberOfOperations = evaluator != NULL ? evaluator->snapshot->header->numberOfOperations : 0;
+
+	if (first < 0 || second < 0 || first >= numberOfOperations || second >= numberOfOperations)
+	{
+		return false;
+	}
+
+	if (!evaluator->makespanIsValid)
+	{
+		int job = evaluator->sequence[first];
+		evaluator->sequence[first] = evaluator->sequence[second];
+		evaluator->sequence[second] = job;
+
+		return true;
+	}
+
+	int low = first < second ? first : second;
+	int high = first < second ? second : first;
+
+	if (evaluator->sequence[low] == evaluator->sequence[high])
+	{
+		return true;
+	}
+
+	// levar o trabalho da primeira posio at  segunda, e depois o da segunda (agora uma posio antes) at  primeira
+	for (int i = low; i < high; i++)
+	{
+		swapAdjacentOperations(evaluator, i);
+	}
+	for (int i = high - 2; i >= low; i--)
+	{
+		swapAdjacentOperations(evaluator, i);
+	}
+
+	propagateSchedule(evaluator);
+
+	return true;
+}
+
+
+/**
+* @brief	Calcular o fim do plano e o atraso ponderado (cada operao comea quando a mquina e a operao anterior do trabalho estiverem livres)
+* @param	evaluator	Avaliador
+* @param	starts		Array para o incio de cada operao (ou NULL se no for necessrio)
+* @return	Fim do plano
+*/
+int decodeSchedule_AtEvaluator(AssignmentEvaluator* evaluator, int starts[])
+{
+	const ProblemSnapshot* snapshot = evaluator->snapshot;
+	int numberOfOperations = snapshot->header->numberOfOperations;
+	int makespan = 0;
+
+	evaluator->totalSetupTime = 0;
+	memcpy(evaluator->jobReady, snapshot->jobReleaseDates, snapshot->header->numberOfJobs * sizeof(int));
+	memset(evaluator->jobPositions, 0, snapshot->header->numberOfJobs * sizeof(int));
+	resetMachines(evaluator);
+
+	for (int i = 0; i < numberOfOperations; i++)
+	{
+		int job = evaluator->sequence[i];
+		int operation = snapshot->jobOperationStarts[job] + evaluator->jobPositions[job]++;
+		int alternative = evaluator->alternatives[operation];
+		int machine = snapshot->alternativeMachines[alternative];
+		int setup = getSetupBefore(evaluator, machine, operation);
+		int start = getOperationStart(evaluator, job, machine, setup);
+		int end = start + snapshot->alternativeRuntimes[alternative];
+
+		evaluator->totalSetupTime += setup;
+		evaluator->operationEnds[operation] = end;
+		evaluator->sequenceOperations[i] = operation;
+		evaluator->sequencePositions[operation] = i;
+
+		if (starts != NULL)
+		{
+			starts[operation] = start;
+		}
+
+		placeOperation(evaluator, job, machine, operation, end);
+
+		if (end > makespan)
+		{
+			makespan = end;
+		}
+	}
+
+	// atraso ponderado, a partir do fim de cada trabalho (jobReady tem agora o fim da ltima operao),
+	// e rvore com o fim de cada trabalho (os trabalhos sem operaes no contam para o fim do plano)
+	evaluator->weightedTardiness = 0;
+	memset(evaluator->jobEndTree, 0, 2 * evaluator->jobLeaves * sizeof(int));
+
+	for (int j = 0; j < snapshot->header->numberOfJobs; j++)
+	{
+		evaluator->weightedTardiness += getJobTardiness(snapshot, j, evaluator->jobReady[j]);
+
+		if (snapshot->jobOperationStarts[j] < snapshot->jobOperationStarts[j + 1])
+		{
+			evaluator->jobEndTree[evaluator->jobLeaves + j] = evaluator->jobReady[j];
+		}
+	}
+
+	for (int node = evaluator->jobLeaves - 1; node >= 1; node--)
+	{
+		int left = evaluator->jobEndTree[2 * node];
+		int right = evaluator->jobEndTree[2 * node + 1];
+		evaluator->jobEndTree[node] = left > right ? left : right;
+	}
+
+	evaluator->makespan = makespan;
+	evaluator->makespanIsValid = true;
+
+	return makespan;
+}
+
+
+/**
+* @brief	Obter os trs objetivos do plano atual (o fim do plano s  recalculado se o plano mudou)
+* @param	evaluator	Avaliador
+* @param	objectives	Apontador para os objetivos
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool getObjectives_AtEvaluator(AssignmentEvaluator* evaluator, ObjectiveVector* objectives)
+{
+	if (evaluator == NULL || objectives == NULL)
+	{
+		return false;
+	}
+
+	if (!evaluator->makespanIsValid)
+	{
+		decodeSchedule_AtEvaluator(evaluator, NULL);
+	}
+
+	objectives->makespan = evaluator->makespan;
+	objectives->totalWorkload = evaluator->totalWorkload;
+	objectives->maxMachineWorkload = evaluator->workloadTree[1];
+
+	return true;
+}
+
+/**
+* @brief	Obter o atraso ponderado do plano atual. O plano s  descodificado por inteiro se ainda no o foi
+*			(ou se a sequncia foi substituda); depois, cada mudana de alternativa ou da sequncia atualiza o atraso
+*			com o fim dos trabalhos cujas operaes seguintes (no trabalho ou na mquina) mudaram
+* @param	evaluator	Avaliador
+* @return	Soma, para cada trabalho atrasado, do peso vezes o atraso
+*/
+long long getWeightedTardiness_AtEvaluator(AssignmentEvaluator* evaluator)
+{
+	if (evaluator == NULL)
+	{
+		return 0;
+	}
+
+	if (!evaluator->makespanIsValid)
+	{
+		decodeSchedule_AtEvaluator(evaluator, NULL);
+	}
+
+	return evaluator->weightedTardiness;
+}
+
+#pragma endregion
+
+
+#pragma region tempos de preparao no avaliador
+
+/**
+* @brief	Usar tempos de preparao no clculo do plano: antes de cada operao, a mquina gasta o tempo de preparao
+*			entre a famlia da operao anterior da mquina e a famlia da operao
+* @param	evaluator	Avaliador
+* @param	setups		Tempos de preparao (ou NULL para deixar de os usar; tem de existir enquanto forem usados).
+*						Podem ser acrescentadas matrizes de outras mquinas depois, mas as mquinas sem matriz
+*						e as famlias das operaes so as deste momento ( preciso chamar a funo de novo se mudarem)
+* @return	Booleano para o resultado da funo (falso se no houver memria)
+*/
+bool attachSetupTimes_AtEvaluator(AssignmentEvaluator* evaluator, SetupTimes* setups)
+{
+	if (evaluator == NULL)
+	{
+		return false;
+	}
+
+	free(evaluator->machineSetups);
+	free(evaluator->operationFamilies);
+	evaluator->setups = NULL;
+	evaluator->machineSetups = NULL;
+	evaluator->operationFamilies = NULL;
+	evaluator->makespanIsValid = false;
+
+	if (setups == NULL)
+	{
+		return true;
+	}
+
+	const ProblemSnapshot* snapshot = evaluator->snapshot;
+	int numberOfMachines = snapshot->header->numberOfMachines;
+	int numberOfOperations = snapshot->header->numberOfOperations;
+
+	// posio da matriz de cada mquina e famlia de cada operao pela posio na imagem, para consultas sem tabelas
+	int* machineSetups = (int*)malloc((numberOfMachines + 1) * sizeof(int));
+	int* operationFamilies = (int*)malloc((numberOfOperations + 1) * sizeof(int));
+
+	if (machineSetups == NULL || operationFamilies == NULL) // se no houver memria para alocar
+	{
+		free(machineSetups);
+		free(operationFamilies);
+		return false;
+	}
+
+	for (int m = 0; m < numberOfMachines; m++)
+	{
+		machineSetups[m] = getKeyValue(setups->positions, snapshot->machineIDs[m]);
+	}
+
+	for (int o = 0; o < numberOfOperations; o++)
+	{
+		operationFamilies[o] = getOperationFamily(setups, snapshot->operationIDs[o]);
+	}
+
+	evaluator->setups = setups;
+	evaluator->machineSetups = machineSetups;
+	evaluator->operationFamilies = operationFamilies;
+
+	return true;
+}
+
+
+/**
+* @brief	Obter a soma dos tempos de preparao do plano atual (s  recalculada se o plano mudou)
+* @param	evaluator	Avaliador
+* @return	Soma dos tempos de preparao de todas as mquinas
+*/
+long long getTotalSetupTime_AtEvaluator(AssignmentEvaluator* evaluator)
+{
+	if (evaluator == NULL)
+	{
+		return 0;
+	}
+
+	if (!evaluator->makespanIsValid)
+	{
+		decodeSchedule_AtEvaluator(evaluator, NULL);
+	}
+
+	return evaluator->totalSetupTime;
+}
+
+
+/**
+* @brief	Obter, em tempo constante, a variao da soma dos tempos de preparao ao trocar uma operao
+*			com a operao seguinte da mesma mquina (a -> b -> c -> d passa a a -> c -> b -> d)
+* @param	evaluator	Avaliador
+* @param	operation	Posio da operao b na imagem do problema
+* @return	Variao da soma dos tempos de preparao (0 se a operao for a ltima da mquina)
+*/
+long long getSetupDelta_Swap_AtEvaluator(AssignmentEvaluator* evaluator, int operation)
+{
+	if (evaluator == NULL || operation < 0 || operation >= evaluator->snapshot->header->numberOfOperations)
+	{
+		return 0;
+	}
+
+	if (!evaluator->makespanIsValid)
+	{
+		decodeSchedule_AtEvaluator(evaluator, NULL);
+	}
+
+	int b = operation;
+	int c = evaluator->machineNext[b];
+	if (c < 0)
+	{
+		return 0;
+	}
+
+	int a = evaluator->machinePrevious[b];
+	int d = evaluator->machineNext[c];
+	int machine = evaluator->snapshot->alternativeMachines[evaluator->alternatives[b]];
+
+	return (long long)getSetupBetween(evaluator, machine, a, c) + getSetupBetween(evaluator, machine, c, b) + getSetupBetween(evaluator, machine, b, d)
+		- getSetupBetween(evaluator, machine, a, b) - getSetupBetween(evaluator, machine, b, c) - getSetupBetween(evaluator, machine, c, d);
+}
+
+
+/**
+* @brief	Obter, em tempo constante, a variao da soma dos tempos de preparao ao mover uma operao
+*			para outra alternativa (ou a mesma mquina), logo a seguir a uma operao dessa mquina
+* @param	evaluator		Avaliador
+* @param	operation		Posio da operao na imagem do problema
+* @param	alternative		Alternativa de destino (ndice nas alternativas da imagem)
+* @param	afterOperation	Operao da mquina de destino depois da qual a operao fica (-1 para ficar em primeiro)
+* @return	Variao da soma dos tempos de preparao (0 se o movimento no for vlido)
+*/
+long long getSetupDelta_Move_AtEvaluator(AssignmentEvaluator* evaluator, int operation, int alternative, int afterOperation)
+{
+	if (evaluator == NULL || operation < 0 || operation >= evaluator->snapshot->header->numberOfOperations || afterOperation == operation)
+	{
+		return 0;
+	}
+
+	const ProblemSnapshot* snapshot = evaluator->snapshot;
+
+	if (alternative < snapshot->operationAlternativeStarts[operation] || alternative >= snapshot->operationAlternativeStarts[operation + 1])
+	{
+		return 0;
+	}
+
+	if (!evaluator->makespanIsValid)
+	{
+		decodeSchedule_AtEvaluator(evaluator, NULL);
+	}
+
+	int source = snapshot->alternativeMachines[evaluator->alternatives[operation]];
+	int target = snapshot->alternativeMachines[alternative];
+
+	if (afterOperation >= 0 && snapshot->alternativeMachines[evaluator->alternatives[afterOperation]] != target)
+	{
+		return 0;
+	}
+
+	// retirar a operao da mquina de origem
+	int previous = evaluator->machinePrevious[operation];
+	int next = evaluator->machineNext[operation];
+	long long delta = (long long)getSetupBetween(evaluator, source, previous, next)
+		- getSetupBetween(evaluator, source, previous, operation) - getSetupBetween(evaluator, source, operation, next);
+
+	// inserir entre afterOperation e a operao que lhe segue (sem contar com a prpria operao, j retirada)
+	int before = afterOperation;
+	int after = afterOperation >= 0 ? evaluator->machineNext[afterOperation] : evaluator->machineFirst[target];
+	if (after == operation)
+	{
+		after = next;
+	}
+
+	delta += (long long)getSetupBetween(evaluator, target, before, operation) + getSetupBetween(evaluator, target, operation, after)
+		- getSetupBetween(evaluator, target, before, after);
+
+	return delta;
+}
+
+#pragma endregion
+
+
+#pragma region regras de despacho
+
+/**
+* @brief	Construir um plano com uma regra de despacho: em cada passo, entre as operaes seguintes dos trabalhos
+*			que podem comear antes do menor fim possvel (conjunto de conflito),  escalonada a de maior prioridade,
+*			na alternativa em que termina mais cedo. O plano construdo fica no avaliador (alternativas e sequncia)
+*
+*			EDD: a menor data de entrega primeiro
+*			ATC: maior (peso / tempo) * exp(-max(folga, 0) / (k * tempo mdio)), com folga = entrega - trabalho que falta - incio
+* @param	evaluator	Avaliador
+* @param	rule		Regra de despacho
+* @param	lookahead	Parmetro k da regra ATC (0 para usar ATC_LOOKAHEAD)
+* @return	Booleano para o resultado da funo (falso se no houver memria ou se uma operao no tiver alternativas)
+*/
+bool buildDispatchSchedule_AtEvaluator(AssignmentEvaluator* evaluator, DispatchRule rule, double lookahead)
+{
+	if (evaluator == NULL)
+	{
+		return false;
+	}
+
+	const ProblemSnapshot* snapshot = evaluator->snapshot;
+	int numberOfJobs = snapshot->header->numberOfJobs;
+	int numberOfOperations = snapshot->header->numberOfOperations;
+
+	int* remainingWork = (int*)malloc((numberOfJobs + 1) * sizeof(int)); // soma dos tempos mnimos das operaes que faltam
+	int* candidates = (int*)malloc((numberOfJobs + 1) * sizeof(int)); // trabalhos que ainda tm operaes
+	if (remainingWork == NULL || candidates == NULL) // se no houver memria para alocar
+	{
+		free(remainingWork);
+		free(candidates);
+		return false;
+	}
+
+	if (lookahead <= 0)
+	{
+		lookahead = ATC_LOOKAHEAD;
+	}
+
+	double averageRuntime = numberOfOperations > 0 ? (double)snapshot->header->totalMinWorkload / numberOfOperations : 1;
+	if (averageRuntime <= 0)
+	{
+		averageRuntime = 1;
+	}
+
+	int numberOfCandidates = 0;
+	for (int j = 0; j < numberOfJobs; j++)
+	{
+		remainingWork[j] = snapshot->jobMinTimes[j];
+
+		if (snapshot->jobOperationStarts[j] < snapshot->jobOperationStarts[j + 1])
+		{
+			candidates[numberOfCandidates++] = j;
+		}
+	}
+
+	memcpy(evaluator->jobReady, snapshot->jobReleaseDates, numberOfJobs * sizeof(int));
+	memset(evaluator->jobPositions, 0, numberOfJobs * sizeof(int));
+	resetMachines(evaluator);
+
+	for (int step = 0; step < numberOfOperations; step++)
+	{
+		// menor fim possvel entre as operaes seguintes de todos os trabalhos
+		int earliestEnd = -1;
+
+		for (int c = 0; c < numberOfCandidates; c++)
+		{
+			int job = candidates[c];
+			int operation = snapshot->jobOperationStarts[job] + evaluator->jobPositions[job];
+
+			for (int a = snapshot->operationAlternativeStarts[operation]; a < snapshot->operationAlternativeStarts[operation + 1]; a++)
+			{
+				int machine = snapshot->alternativeMachines[a];
+				int start = getOperationStart(evaluator, job, machine, getSetupBefore(evaluator, machine, operation));
+
+				if (earliestEnd < 0 || start + snapshot->alternativeRuntimes[a] < earliestEnd)
+				{
+					earliestEnd = start + snapshot->alternativeRuntimes[a];
+				}
+			}
+		}
+
+		// entre os que podem comear antes desse fim, escolher o de maior prioridade
+		int bestCandidate = -1;
+		int bestAlternative = -1;
+		int bestStart = 0;
+		double bestPriority = 0;
+
+		for (int c = 0; c < numberOfCandidates; c++)
+		{
+			int job = candidates[c];
+			int operation = snapshot->jobOperationStarts[job] + evaluator->jobPositions[job];
+			int alternative = -1;
+			int start = 0;
+
+			for (int a = snapshot->operationAlternativeStarts[operation]; a < snapshot->operationAlternativeStarts[operation + 1]; a++)
+			{
+				int machine = snapshot->alternativeMachines[a];
+				int begin = getOperationStart(evaluator, job, machine, getSetupBefore(evaluator, machine, operation));
+
+				if (alternative < 0 || begin + snapshot->alternativeRuntimes[a] < start + snapshot->alternativeRuntimes[alternative])
+				{
+					alternative = a;
+					start = begin;
+				}
+			}
+
+			if (alternative < 0 || start > earliestEnd)
+			{
+				continue;
+			}
+
+			double priority;
+			if (rule == DISPATCH_EDD)
+			{
+				priority = -(double)snapshot->jobDueDates[job];
+			}
+			else
+			{
+				int runtime = snapshot->alternativeRuntimes[alternative] > 0 ? snapshot->alternativeRuntimes[alternative] : 1;
+				double slack = (double)snapshot->jobDueDates[job] - remainingWork[job] - start;
+				priority = (double)snapshot->jobWeights[job] / runtime * exp(-(slack > 0 ? slack : 0) / (lookahead * averageRuntime));
+			}
+
+			if (bestCandidate < 0 || priority > bestPriority || (priority == bestPriority && start < bestStart))
+			{
+				bestCandidate = c;
+				bestAlternative = alternative;
+				bestStart = start;
+				bestPriority = priority;
+			}
+		}
+
+		if (bestCandidate < 0) // nenhuma operao seguinte tem alternativas, o plano no pode ser completado
+		{
+			free(remainingWork);
+			free(candidates);
+			evaluator->makespanIsValid = false;
+			return false;
+		}
+
+		int job = candidates[bestCandidate];
+		int operation = snapshot->jobOperationStarts[job] + evaluator->jobPositions[job];
+		int end = bestStart + snapshot->alternativeRuntimes[bestAlternative];
+
+		setAlternative_AtEvaluator(evaluator, operation, bestAlternative);
+		evaluator->sequence[step] = job;
+		placeOperation(evaluator, job, snapshot->alternativeMachines[bestAlternative], operation, end);
+		evaluator->jobPositions[job]++;
+		remainingWork[job] -= snapshot->operationMinRuntimes[operation];
+
+		if (snapshot->jobOperationStarts[job] + evaluator->jobPositions[job] == snapshot->jobOperationStarts[job + 1])
+		{
+			candidates[bestCandidate] = candidates[--numberOfCandidates]; // o trabalho acabou
+		}
+	}
+
+	free(remainingWork);
+	free(candidates);
+
+	evaluator->makespanIsValid = false;
+
+	return true;
+}
+
+#pragma endregion
+
+
+#pragma region arquivo de Pareto
+
+/**
+* @brief	Criar um arquivo de Pareto vazio
+* @param	numberOfOperations	Quantidade de operaes de cada plano guardado
+* @return	Arquivo criado (ou NULL se no houver memria)
+*/
+ParetoArchive* createParetoArchive(int numberOfOperations)
+{
+	ParetoArchive* archive = (ParetoArchive*)malloc(sizeof(ParetoArchive));
+	if (archive == NULL) // se no houver memria para alocar
+	{
+		return NULL;
+	}
+
+	archive->capacity = 64;
+	archive->count = 0;
+	archive->numberOfOperations = numberOfOperations;
+	archive->members = (ParetoMember*)malloc(archive->capacity * sizeof(ParetoMember));
+
+	if (archive->members == NULL)
+	{
+		free(archive);
+		return NULL;
+	}
+
+	return archive;
+}
+
+
+/**
+* @brief	Comparar dois vetores de objetivos pela ordem do arquivo (fim do plano, carga total e maior carga)
+*/
+static int compareObjectives(ObjectiveVector* first, ObjectiveVector* second)
+{
+	if (first->makespan != second->makespan)
+	{
+		return first->makespan < second->makespan ? -1 : 1;
+	}
+	if (first->totalWorkload != second->totalWorkload)
+	{
+		return first->totalWorkload < second->totalWorkload ? -1 : 1;
+	}
+	if (first->maxMachineWorkload != second->maxMachineWorkload)
+	{
+		return first->maxMachineWorkload < second->maxMachineWorkload ? -1 : 1;
+	}
+
+	return 0;
+}
+
+
+/**
+* @brief	Obter a primeira posio do arquivo com fim do plano maior ou igual a um valor (pesquisa binria)
+* @param	archive		Arquivo
+* @param	high		Posio a seguir  ltima a considerar
+* @param	makespan	Fim do plano
+* @return	Posio (high se no existir)
+*/
+static int findFirstMakespan(ParetoArchive* archive, int high, int makespan)
+{
+	int low = 0;
+
+	while (low < high)
+	{
+		int middle = (low + high) / 2;
+
+		if (archive->members[middle].objectives.makespan < makespan)
+		{
+			low = middle + 1;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+
+	return low;
+}
+
+
+/**
+* @brief	Obter a primeira posio de um grupo (mesmo fim do plano) com carga total maior ou igual a um valor (pesquisa binria)
+* @param	archive			Arquivo
+* @param	low				Primeira posio do grupo
+* @param	high			Posio a seguir  ltima do grupo
+* @param	totalWorkload	Carga total
+* @return	Posio (high se no existir)
+*/
+static int findFirstTotalWorkload(ParetoArchive* archive, int low, int high, long long totalWorkload)
+{
+	while (low < high)
+	{
+		int middle = (low + high) / 2;
+
+		if (archive->members[middle].objectives.totalWorkload < totalWorkload)
+		{
+			low = middle + 1;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+
+	return low;
+}
+
+
+/**
+* @brief	Obter a primeira posio de um grupo (mesmo fim do plano) com maior carga menor que um valor (pesquisa binria,
+*			a maior carga desce ao longo do grupo)
+* @param	archive				Arquivo
+* @param	low					Primeira posio do grupo
+* @param	high				Posio a seguir  ltima do grupo
+* @param	maxMachineWorkload	Maior carga
+* @return	Posio (high se no existir)
+*/
+static int findFirstMaxWorkloadBelow(ParetoArchive* archive, int low, int high, int maxMachineWorkload)
+{
+	while (low < high)
+	{
+		int middle = (low + high) / 2;
+
+		if (archive->members[middle].objectives.maxMachineWorkload >= maxMachineWorkload)
+		{
+			low = middle + 1;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+
+	return low;
+}
+
+
+/**
+* @brief	Inserir um plano no arquivo de Pareto, se no for dominado (nem igual a um plano guardado),
+*			removendo os planos que passam a ser dominados.
+*			Em cada grupo com o mesmo fim do plano, o plano com a maior carga total que no passa a do novo
+*			 o de menor maior carga entre os candidatos, por isso basta uma pesquisa binria por grupo
+* @param	archive			Arquivo
+* @param	objectives		Objetivos do plano
+* @param	alternatives	Alternativa de cada operao (copiada)
+* @param	sequence		Sequncia de trabalhos (copiada)
+* @return	Booleano para o resultado da funo (se o plano foi guardado)
+*/
+bool insertParetoArchive(ParetoArchive* archive, ObjectiveVector* objectives, int alternatives[], int sequence[])
+{
+	if (archive == NULL || objectives == NULL || alternatives == NULL || sequence == NULL)
+	{
+		return false;
+	}
+
+	// posio do novo plano pela ordem do arquivo (pesquisa binria)
+	int low = 0;
+	int high = archive->count;
+
+	while (low < high)
+	{
+		int middle = (low + high) / 2;
+
+		if (compareObjectives(&archive->members[middle].objectives, objectives) < 0)
+		{
+			low = middle + 1;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+
+	int position = low;
+
+	if (position < archive->count && compareObjectives(&archive->members[position].objectives, objectives) == 0)
+	{
+		return false; // j existe um plano com os mesmos objetivos
+	}
+
+	// s um plano antes da posio pode dominar o novo (fim do plano menor ou igual), grupo a grupo do fim para o incio
+	for (int end = position; end > 0; )
+	{
+		int start = findFirstMakespan(archive, end, archive->members[end - 1].objectives.makespan);
+		int last = findFirstTotalWorkload(archive, start, end, objectives->totalWorkload + 1) - 1;
+
+		if (last >= start && archive->members[last].objectives.maxMachineWorkload <= objectives->maxMachineWorkload)
+		{
+			return false;
+		}
+
+		end = start;
+	}
+
+	int size = archive->numberOfOperations;
+	int* solution = (int*)malloc((2 * size > 0 ? 2 * size : 1) * sizeof(int));
+	if (solution == NULL) // se no houver memria para alocar
+	{
+		return false;
+	}
+
+	memcpy(solution, alternatives, size * sizeof(int));
+	memcpy(solution + size, sequence, size * sizeof(int));
+
+	// remover os planos dominados pelo novo (s podem estar depois da posio): em cada grupo so um intervalo seguido,
+	// com carga total maior ou igual e maior carga maior ou igual  do novo
+	int kept = position;
+	for (int start = position; start < archive->count; )
+	{
+		int end = findFirstMakespan(archive, archive->count, archive->members[start].objectives.makespan + 1);
+		int first = findFirstTotalWorkload(archive, start, end, objectives->totalWorkload);
+		int last = findFirstMaxWorkloadBelow(archive, first, end, objectives->maxMachineWorkload);
+
+		if (first == last && kept == start) // nada a remover nem a deslocar neste grupo
+		{
+			kept = end;
+		}
+		else
+		{
+			for (int i = first; i < last; i++)
+			{
+				free(archive->members[i].alternatives);
+			}
+
+			memmove(&archive->members[kept], &archive->members[start], (first - start) * sizeof(ParetoMember));
+			kept += first - start;
+			memmove(&archive->members[kept], &archive->members[last], (end - last) * sizeof(ParetoMember));
+			kept += end - last;
+		}
+
+		start = end;
+	}
+	archive->count = kept;
+
+	if (archive->count == archive->capacity)
+	{
+		ParetoMember* members = (ParetoMember*)realloc(archive->members, archive->capacity * 2 * sizeof(ParetoMember));
+		if (members == NULL)
+		{
+			free(solution);
+			return false;
+		}
+
+		archive->members = members;
+		archive->capacity *= 2;
+	}
+
+	memmove(&archive->members[position + 1], &archive->members[position], (archive->count - position) * sizeof(ParetoMember));
+
+	archive->members[position].objectives = *objectives;
+	archive->members[position].alternatives = solution;
+	archive->members[position].sequence = solution + size;
+	archive->count++;
+
+	return true;
+}
+
+
+/**
+* @brief	Libertar o arquivo de Pareto e os planos guardados
+* @param	archive		Arquivo
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool freeParetoArchive(ParetoArchive* archive)
+{
+	if (archive == NULL)
+	{
+		return false;
+	}
+
+	for (int i = 0; i < archive->count; i++)
+	{
+		free(archive->members[i].alternatives); // a sequncia est no mesmo bloco
+	}
+
+	free(archive->members);
+	free(archive);
+
+	return true;
+}
+
+#pragma endregion
+
+
+#pragma region procura da frente de Pareto
+
+/**
+* @brief	Gerar o prximo nmero aleatrio (xorshift64*)
+*/
+static unsigned int nextParetoRandom(unsigned long long* random)
+{
+	*random ^= *random >> 12;
+	*random ^= *random << 25;
+	*random ^= *random >> 27;
+
+	return (unsigned int)((*random * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+
+/**
+* @brief	Construir um plano de forma gulosa: as operaes so escalonadas pela sequncia atual
+*			e cada uma vai para a alternativa com o menor custo ponderado (fim da operao, tempo e carga da mquina)
+* @param	evaluator		Avaliador (as alternativas so alteradas)
+* @param	weights			Pesos do fim da operao, do tempo e da carga da mquina
+*/
+static void buildGreedyAssignment(AssignmentEvaluator* evaluator, int weights[3])
+{
+	const ProblemSnapshot* snapshot = evaluator->snapshot;
+	int numberOfOperations = snapshot->header->numberOfOperations;
+
+	memcpy(evaluator->jobReady, snapshot->jobReleaseDates, snapshot->header->numberOfJobs * sizeof(int));
+	memset(evaluator->jobPositions, 0, snapshot->header->numberOfJobs * sizeof(int));
+	resetMachines(evaluator);
+
+	for (int i = 0; i < numberOfOperations; i++)
+	{
+		int job = evaluator->sequence[i];
+		int operation = snapshot->jobOperationStarts[job] + evaluator->jobPositions[job]++;
+		int best = -1;
+		long long bestCost = 0;
+		int bestEnd = 0;
+
+		if (snapshot->operationAlternativeStarts[operation] == snapshot->operationAlternativeStarts[operation + 1])
+		{
+			continue; // operao sem alternativas (o avaliador no  criado para estas imagens)
+		}
+
+		// a carga da mquina da alternativa atual no conta com esta operao
+		int current = evaluator->alternatives[operation];
+		addMachineWorkload(evaluator, snapshot->alternativeMachines[current], -snapshot->alternativeRuntimes[current]);
+
+		for (int a = snapshot->operationAlternativeStarts[operation]; a < snapshot->operationAlternativeStarts[operation + 1]; a++)
+		{
+			int machine = snapshot->alternativeMachines[a];
+			int runtime = snapshot->alternativeRuntimes[a];
+			int start = getOperationStart(evaluator, job, machine, getSetupBefore(evaluator, machine, operation));
+			long long cost = (long long)weights[0] * (start + runtime) + (long long)weights[1] * runtime + (long long)weights[2] * (evaluator->machineWorkloads[machine] + runtime);
+
+			if (best < 0 || cost < bestCost)
+			{
+				best = a;
+				bestCost = cost;
+				bestEnd = start + runtime;
+			}
+		}
+
+		addMachineWorkload(evaluator, snapshot->alternativeMachines[current], snapshot->alternativeRuntimes[current]);
+		setAlternative_AtEvaluator(evaluator, operation, best);
+
+		placeOperation(evaluator, job, snapshot->alternativeMachines[best], operation, bestEnd);
+	}
+}
+
+
+/**
+* @brief	Procurar planos no dominados: em cada iterao a sequncia  perturbada e  construdo um plano guloso
+*			com pesos aleatrios para os trs objetivos; cada plano  inserido no arquivo
+* @param	snapshot	Imagem compilada do problema
+* @param	iterations	Quantidade de planos construdos
+* @param	seed		Semente dos nmeros aleatrios
+* @return	Arquivo com a frente de Pareto encontrada (ou NULL se no houver memria)
+*/
+ParetoArchive* solveParetoFront(ProblemSnapshot* snapshot, int iterations, unsigned long long seed)
+{
+	AssignmentEvaluator* evaluator = createAssignmentEvaluator(snapshot);
+	if (evaluator == NULL)
+	{
+		return NULL;
+	}
+
+	int numberOfOperations = snapshot->header->numberOfOperations;
+	ParetoArchive* archive = createParetoArchive(numberOfOperations);
+	int* base = (int*)malloc((numberOfOperations + 1) * sizeof(int));
+
+	if (archive == NULL || base == NULL) // se no houver memria para alocar
+	{
+		freeAssignmentEvaluator(evaluator);
+		freeParetoArchive(archive);
+		free(base);
+		return NULL;
+	}
+
+	memcpy(base, evaluator->sequence, numberOfOperations * sizeof(int));
+
+	unsigned long long random = seed | 1;
+	ObjectiveVector objectives;
+
+	// os trs planos extremos, um para cada objetivo
+	int extremes[3][3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+
+	for (int i = 0; i < iterations; i++)
+	{
+		int weights[3];
+
+		if (i < 3)
+		{
+			memcpy(weights, extremes[i], sizeof(weights));
+		}
+		else
+		{
+			weights[0] = nextParetoRandom(&random) % 16;
+			weights[1] = nextParetoRandom(&random) % 16;
+			weights[2] = nextParetoRandom(&random) % 16;
+
+			// perturbar a sequncia base com algumas trocas de posies vizinhas
+			setSequence_AtEvaluator(evaluator, base);
+			for (int k = 0; k < numberOfOperations / 8 + 1 && numberOfOperations > 1; k++)
+			{
+				int position = nextParetoRandom(&random) % (numberOfOperations - 1);
+				swapSequence_AtEvaluator(evaluator, position, position + 1);
+			}
+		}
+
+		buildGreedyAssignment(evaluator, weights);
+		getObjectives_AtEvaluator(evaluator, &objectives);
+		insertParetoArchive(archive, &objectives, evaluator->alternatives, evaluator->sequence);
+	}
+
+	free(base);
+	freeAssignmentEvaluator(evaluator);
+
+	return archive;
+}
+
+#pragma endregion
@@ -0,0 +1,769 @@
+/**
+ * @brief	Ficheiro com as funes do escalonamento em tempo real (alterado a cada evento, sem ser refeito)
+ * @file	onlineschedule.c
+ * @author	Vnia Pereira
+ * @email	a19264@alunos.ipca.pt
+ * @date	2022
+ * @Disciplina Estruturas de Dados Avanadas
+ *
+ * -----------------
+ *
+ * O plano guarda, para cada operao escalonada, a mquina e o intervalo escolhidos. Os intervalos ficam reservados
+ * nos calendrios das mquinas, por isso uma nova operao  colocada no primeiro espao livre que chegue
+ * (entre reservas e paragens), depois do fim da operao anterior do mesmo trabalho.
+ *
+ * Reparao depois de um evento:
+ *	- deslocamento  direita: se uma operao acaba mais tarde, a operao seguinte do trabalho  recolocada
+ *	  (e assim sucessivamente, apenas se for necessrio);
+ *	- deslocamento  esquerda: quando um espao fica livre (trabalho removido, operao mais curta), as operaes
+ *	  que comeam at ONLINE_REPAIR_WINDOW unidades depois so recolocadas mais cedo, se for possvel,
+ *	  com no mximo ONLINE_MAX_REPAIR_MOVES recolocaes por evento.
+ * As operaes ficam sempre na mesma mquina durante a reparao.
+ *
+ * O atraso ponderado do plano  mantido a cada alterao: s muda quando muda o fim da ltima operao de um trabalho,
+ * por isso cada evento s o atualiza para os trabalhos afetados.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "header.h"
+
+
+#pragma region trabalhar com plano em tempo real
+
+/**
+* @brief	Criar plano em tempo real vazio (com calendrios das mquinas vazios)
+* @return	Plano criado (ou NULL se no houver memria)
+*/
+OnlineSchedule* createOnlineSchedule()
+{
+	OnlineSchedule* schedule = (OnlineSchedule*)calloc(1, sizeof(OnlineSchedule));
+	if (schedule == NULL) // se no houver memria para alocar
+	{
+		return NULL;
+	}
+
+	schedule->capacity = 64;
+	schedule->operations = (ScheduledOperation*)malloc(schedule->capacity * sizeof(ScheduledOperation));
+	schedule->positions = createKeySet(schedule->capacity);
+	schedule->jobsCapacity = 16;
+	schedule->jobs = (OnlineJob*)malloc(schedule->jobsCapacity * sizeof(OnlineJob));
+	schedule->jobPositions = createKeySet(schedule->jobsCapacity);
+	schedule->calendars = createMachineCalendars();
+
+	if (schedule->operations == NULL || schedule->positions == NULL || schedule->jobs == NULL || schedule->jobPositions == NULL || schedule->calendars == NULL)
+	{
+		freeOnlineSchedule(schedule);
+		return NULL;
+	}
+
+	return schedule;
+}
+
+
+/**
+* @brief	Libertar o plano em tempo real da memria
+* @param	schedule	Plano
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool freeOnlineSchedule(OnlineSchedule* schedule)
+{
+	if (schedule == NULL)
+	{
+		return false;
+	}
+
+	free(schedule->operations);
+	freeKeySet(schedule->positions);
+	free(schedule->jobs);
+	freeKeySet(schedule->jobPositions);
+	freeMachineCalendars(schedule->calendars);
+	free(schedule);
+
+	return true;
+}
+
+
+/**
+* @brief	Obter a operao escalonada com um identificador
+* @param	schedule		Plano
+* @param	operationID		Identificador da operao
+* @return	Operao escalonada (ou NULL se no estiver no plano)
+*/
+static ScheduledOperation* findScheduledOperation(OnlineSchedule* schedule, int operationID)
+{
+	int position = getKeyValue(schedule->positions, operationID);
+
+	if (position < 0 || !schedule->operations[position].isActive)
+	{
+		return NULL;
+	}
+
+	return &schedule->operations[position];
+}
+
+
+/**
+* @brief	Obter um trabalho do plano, criando-o (disponvel desde o incio, sem data de entrega e com peso 1) se for pedido
+* @param	schedule	Plano
+* @param	jobID		Identificador do trabalho
+* @param	create		Se o trabalho deve ser criado quando no existir
+* @return	Trabalho (ou NULL se no existir e no foi criado)
+*/
+static OnlineJob* getOnlineJob(OnlineSchedule* schedule, int jobID, bool create)
+{
+	int position = getKeyValue(schedule->jobPositions, jobID);
+
+	if (position >= 0)
+	{
+		return &schedule->jobs[position];
+	}
+
+	if (!create)
+	{
+		return NULL;
+	}
+
+	if (schedule->numberOfJobs == schedule->jobsCapacity)
+	{
+		OnlineJob* jobs = (OnlineJob*)realloc(schedule->jobs, schedule->jobsCapacity * 2 * sizeof(OnlineJob));
+		if (jobs == NULL) // se no houver memria para alocar
+		{
+			return NULL;
+		}
+
+		schedule->jobs = jobs;
+		schedule->jobsCapacity *= 2;
+	}
+
+	OnlineJob* job = &schedule->jobs[schedule->numberOfJobs];
+	job->jobID = jobID;
+	job->lastOperation = -1;
+	job->releaseDate = 0;
+	job->dueDate = JOB_NO_DUE_DATE;
+	job->weight = 1;
+
+	setKeyValue(schedule->jobPositions, jobID, schedule->numberOfJobs++);
+
+	return job;
+}
+
+
+/**
+* @brief	Obter o atraso ponderado de um trabalho que acaba num instante
+*/
+static long long getJobTardiness(OnlineJob* job, int completion)
+{
+	return completion > job->dueDate ? (long long)job->weight * (completion - job->dueDate) : 0;
+}
+
+
+/**
+* @brief	Atualizar o atraso ponderado do plano quando o fim da ltima operao de um trabalho muda
+* @param	schedule	Plano
+* @param	operation	Operao que mudou (nada muda se no for a ltima do trabalho)
+* @param	oldEnd		Fim anterior da operao (-1 se ainda no contava para o trabalho)
+*/
+static void updateJobCompletion(OnlineSchedule* schedule, ScheduledOperation* operation, int oldEnd)
+{
+	if (operation->jobNext >= 0 || oldEnd == operation->end)
+	{
+		return;
+	}
+
+	OnlineJob* job = getOnlineJob(schedule, operation->jobID, false);
+
+	if (oldEnd >= 0)
+	{
+		schedule->weightedTardiness -= getJobTardiness(job, oldEnd);
+	}
+	schedule->weightedTardiness += getJobTardiness(job, operation->end);
+}
+
+
+/**
+* @brief	Obter o instante a partir do qual uma operao pode comear (fim da operao anterior do trabalho,
+*			ou data de disponibilidade do trabalho se for a primeira)
+*/
+static int getReadyTime(OnlineSchedule* schedule, ScheduledOperation* operation)
+{
+	if (operation->jobPrevious >= 0)
+	{
+		return schedule->operations[operation->jobPrevious].end;
+	}
+
+	return getOnlineJob(schedule, operation->jobID, false)->releaseDate;
+}
+
+
+/**
+* @brief	Escalonar uma nova operao no fim do seu trabalho, na mquina em que termina mais cedo.
+*			A operao  colocada no primeiro espao livre que chegue, mesmo que seja entre operaes j escalonadas
+* @param	schedule		Plano
+* @param	operationID		Identificador da operao
+* @param	jobID			Identificador do trabalho
+* @param	alternatives	Execues possveis da operao (mquina e tempo)
+* @param	count			Quantidade de execues possveis
+* @return	Instante de incio escolhido (ou -1 se no foi possvel escalonar)
+*/
+int scheduleOperation_Online(OnlineSchedule* schedule, int operationID, int jobID, FileExecution alternatives[], int count)
+{
+	if (schedule == NULL || alternatives == NULL || count <= 0 || findScheduledOperation(schedule, operationID) != NULL)
+	{
+		return -1;
+	}
+
+	OnlineJob* job = getOnlineJob(schedule, jobID, true);
+	if (job == NULL)
+	{
+		return -1;
+	}
+
+	int previous = job->lastOperation;
+	int ready = previous >= 0 ? schedule->operations[previous].end : job->releaseDate;
+	int bestMachine = -1;
+	int bestStart = 0;
+	int bestEnd = 0;
+
+	for (int i = 0; i < count; i++)
+	{
+		int start = getEarliestStart(schedule->calendars, alternatives[i].machineID, ready, alternatives[i].runtime);
+
+		if (bestMachine < 0 || start + alternatives[i].runtime < bestEnd)
+		{
+			bestMachine = i;
+			bestStart = start;
+			bestEnd = start + alternatives[i].runtime;
+		}
+	}
+
+	int machineID = alternatives[bestMachine].machineID;
+	if (!addReservation(schedule->calendars, machineID, operationID, bestStart, bestEnd))
+	{
+		return -1;
+	}
+
+	// reaproveitar a posio se a operao j esteve no plano
+	int position = getKeyValue(schedule->positions, operationID);
+	if (position < 0)
+	{
+		if (schedule->count == schedule->capacity)
+		{
+			ScheduledOperation* operations = (ScheduledOperation*)realloc(schedule->operations, schedule->capacity * 2 * sizeof(ScheduledOperation));
+			if (operations == NULL)
+			{
+				removeCalendarInterval(schedule->calendars, machineID, bestStart);
+				return -1;
+			}
+
+			schedule->operations = operations;
+			schedule->capacity *= 2;
+		}
+
+		position = schedule->count++;
+		setKeyValue(schedule->positions, operationID, position);
+	}
+
+	ScheduledOperation* operation = &schedule->operations[position];
+	operation->operationID = operationID;
+	operation->jobID = jobID;
+	operation->machineID = machineID;
+	operation->start = bestStart;
+	operation->end = bestEnd;
+	operation->jobPrevious = previous;
+	operation->jobNext = -1;
+	operation->isActive = true;
+
+	// a nova operao passa a ser a ltima do trabalho, no lugar da anterior
+	if (previous >= 0)
+	{
+		schedule->weightedTardiness -= getJobTardiness(job, schedule->operations[previous].end);
+		schedule->operations[previous].jobNext = position;
+	}
+	schedule->weightedTardiness += getJobTardiness(job, bestEnd);
+	job->lastOperation = position;
+
+	return bestStart;
+}
+
+
+/**
+* @brief	Escalonar uma nova operao, com as execues possveis obtidas da tabela hash das execues
+* @param	schedule		Plano
+* @param	table			Tabela hash das execues
+* @param	operationID		Identificador da operao
+* @param	jobID			Identificador do trabalho
+* @return	Instante de incio escolhido (ou -1 se no foi possvel escalonar)
+*/
+int scheduleOperation_AtTable_Online(OnlineSchedule* schedule, ExecutionNode* table[], int operationID, int jobID)
+{
+	if (table == NULL)
+	{
+		return -1;
+	}
+
+	int count = 0;
+	int index = generateHash_AtTable(table, operationID);
+
+	for (Execution* aux = table[index]->start; aux != NULL; aux = aux->next)
+	{
+		if (aux->operationID == operationID)
+		{
+			count++;
+		}
+	}
+
+	FileExecution* alternatives = (FileExecution*)malloc((count > 0 ? count : 1) * sizeof(FileExecution));
+	if (alternatives == NULL) // se no houver memria para alocar
+	{
+		return -1;
+	}
+
+	count = 0;
+	for (Execution* aux = table[index]->start; aux != NULL; aux = aux->next)
+	{
+		if (aux->operationID == operationID)
+		{
+			alternatives[count].operationID = operationID;
+			alternatives[count].machineID = aux->machineID;
+			alternatives[count].runtime = aux->runtime;
+			count++;
+		}
+	}
+
+	int start = scheduleOperation_Online(schedule, operationID, jobID, alternatives, count);
+
+	free(alternatives);
+
+	return start;
+}
+
+#pragma endregion
+
+
+#pragma region reparao do plano
+
+/**
+ * @brief	Estado da reparao do plano depois de um evento
+ */
+typedef struct OnlineRepair
+{
+	int* queue; // posies das operaes a recolocar
+	int count;
+	int capacity;
+	int moves; // recolocaes feitas
+	int optionalMoves; // recolocaes feitas que no eram obrigatrias (deslocamentos  esquerda)
+	int windowEnd; // as recolocaes opcionais s so feitas a operaes que comeam antes deste instante
+} OnlineRepair;
+
+static void enqueueMachineRepairs(OnlineSchedule* schedule, OnlineRepair* repair, int machineID, int freedStart);
+
+
+/**
+* @brief	Acrescentar uma operao  fila de reparao
+*/
+static void enqueueRepair(OnlineRepair* repair, int position)
+{
+	if (repair->count == repair->capacity)
+	{
+		int capacity = repair->capacity > 0 ? repair->capacity * 2 : 16;
+		int* queue = (int*)realloc(repair->queue, capacity * sizeof(int));
+		if (queue == NULL)
+		{
+			return;
+		}
+
+		repair->queue = queue;
+		repair->capacity = capacity;
+	}
+
+	repair->queue[repair->count++] = position;
+}
+
+
+/**
+* @brief	Recolocar uma operao no primeiro espao livre da sua mquina depois do fim da operao anterior do trabalho.
+*			Se a operao mudar, a operao seguinte do trabalho  acrescentada  fila
+* @param	schedule	Plano
+* @param	repair		Estado da reparao
+* @param	position	Posio da operao
+*/
+static void repairOperation(OnlineSchedule* schedule, OnlineRepair* repair, int position)
+{
+	ScheduledOperation* operation = &schedule->operations[position];
+	if (!operation->isActive)
+	{
+		return;
+	}
+
+	int ready = getReadyTime(schedule, operation);
+	bool required = operation->start < ready; // a operao anterior do trabalho acaba depois do incio
+
+	if (!required && (operation->start >= repair->windowEnd || repair->optionalMoves >= ONLINE_MAX_REPAIR_MOVES))
+	{
+		return;
+	}
+
+	int duration = operation->end - operation->start;
+	int oldStart = operation->start;
+	int oldEnd = operation->end;
+
+	removeCalendarInterval(schedule->calendars, operation->machineID, oldStart);
+
+	int start = getEarliestStart(schedule->calendars, operation->machineID, ready, duration);
+
+	if (!required && start >= oldStart) // no h espao mais cedo, fica onde estava
+	{
+		start = oldStart;
+	}
+
+	addReservation(schedule->calendars, operation->machineID, operation->operationID, start, start + duration);
+	operation->start = start;
+	operation->end = start + duration;
+
+	if (start == oldStart)
+	{
+		return;
+	}
+
+	updateJobCompletion(schedule, operation, oldEnd);
+
+	repair->moves++;
+	if (!required)
+	{
+		repair->optionalMoves++;
+	}
+
+	// a operao seguinte do trabalho pode ter de ir para mais tarde, ou pode agora comear mais cedo
+	if (operation->jobNext >= 0 && operation->end != oldEnd)
+	{
+		enqueueRepair(repair, operation->jobNext);
+	}
+
+	// o espao deixado livre pode ser aproveitado pelas operaes seguintes da mquina
+	if (start > oldStart)
+	{
+		enqueueMachineRepairs(schedule, repair, operation->machineID, oldStart);
+	}
+}
+
+
+/**
+* @brief	Acrescentar  fila as operaes de uma mquina que comeam na janela depois de um espao que ficou livre
+* @param	schedule	Plano
+* @param	repair		Estado da reparao
+* @param	machineID	Identificador da mquina
+* @param	freedStart	Incio do espao que ficou livre
+*/
+static void enqueueMachineRepairs(OnlineSchedule* schedule, OnlineRepair* repair, int machineID, int freedStart)
+{
+	// intervalos que comeam no espao livre ou depois, dentro da janela
+	for (CalendarInterval* interval = getNextCalendarInterval(schedule->calendars, machineID, freedStart);
+		interval != NULL && interval->start < freedStart + ONLINE_REPAIR_WINDOW;
+		interval = getNextCalendarInterval(schedule->calendars, machineID, interval->start + 1))
+	{
+		if (interval->type == INTERVAL_RESERVATION)
+		{
+			int position = getKeyValue(schedule->positions, interval->operationID);
+			if (position >= 0)
+			{
+				enqueueRepair(repair, position);
+			}
+		}
+	}
+}
+
+
+/**
+* @brief	Processar a fila de reparao at ficar vazia
+* @param	schedule	Plano
+* @param	repair		Estado da reparao
+* @return	Quantidade de operaes recolocadas
+*/
+static int runRepair(OnlineSchedule* schedule, OnlineRepair* repair)
+{
+	for (int i = 0; i < repair->count; i++)
+	{
+		repairOperation(schedule, repair, repair->queue[i]);
+	}
+
+	free(repair->queue);
+
+	return repair->moves;
+}
+
+
+/**
+* @brief	Remover um trabalho do plano e reparar as operaes afetadas (deslocamento  esquerda, limitado  janela)
+* @param	schedule	Plano
+* @param	jobID		Identificador do trabalho
+* @return	Quantidade de operaes recolocadas (ou -1 se o trabalho no estiver no plano)
+*/
+int removeJob_Online(OnlineSchedule* schedule, int jobID)
+{
+	if (schedule == NULL)
+	{
+		return -1;
+	}
+
+	OnlineJob* job = getOnlineJob(schedule, jobID, false);
+	if (job == NULL || job->lastOperation < 0)
+	{
+		return -1;
+	}
+
+	int position = job->lastOperation;
+	schedule->weightedTardiness -= getJobTardiness(job, schedule->operations[position].end);
+
+	OnlineRepair repair = { NULL, 0, 0, 0, 0, 0 };
+	int earliestFreed = -1;
+
+	// percorrer o trabalho do fim para o incio, libertando as reservas
+	while (position >= 0)
+	{
+		ScheduledOperation* operation = &schedule->operations[position];
+
+		removeCalendarInterval(schedule->calendars, operation->machineID, operation->start);
+		operation->isActive = false;
+
+		if (earliestFreed < 0 || operation->start < earliestFreed)
+		{
+			earliestFreed = operation->start;
+		}
+
+		enqueueMachineRepairs(schedule, &repair, operation->machineID, operation->start);
+		position = operation->jobPrevious;
+	}
+
+	job->lastOperation = -1;
+
+	repair.windowEnd = earliestFreed + ONLINE_REPAIR_WINDOW;
+
+	return runRepair(schedule, &repair);
+}
+
+
+/**
+* @brief	Alterar o tempo de uma operao escalonada (por exemplo, um atraso na mquina) e reparar o plano.
+*			Se a operao ficar mais longa e j no couber no seu espao,  recolocada, e as operaes seguintes do trabalho
+*			so deslocadas  direita apenas se for necessrio; se ficar mais curta, as operaes seguintes podem comear mais cedo
+* @param	schedule		Plano
+* @param	operationID		Identificador da operao
+* @param	runtime			Novas unidades de tempo
+* @return	Quantidade de operaes recolocadas, alm da prpria (ou -1 se a operao no estiver no plano)
+*/
+int updateRuntime_Online(OnlineSchedule* schedule, int operationID, int runtime)
+{
+	if (schedule == NULL || runtime <= 0)
+	{
+		return -1;
+	}
+
+	ScheduledOperation* operation = findScheduledOperation(schedule, operationID);
+	if (operation == NULL)
+	{
+		return -1;
+	}
+
+	int oldEnd = operation->end;
+	int start = operation->start;
+
+	removeCalendarInterval(schedule->calendars, operation->machineID, start);
+
+	if (!isMachineAvailable(schedule->calendars, operation->machineID, start, start + runtime)) // j no cabe no seu espao
+	{
+		start = getEarliestStart(schedule->calendars, operation->machineID, getReadyTime(schedule, operation), runtime);
+	}
+
+	addReservation(schedule->calendars, operation->machineID, operationID, start, start + runtime);
+
+	int oldStart = operation->start;
+	operation->start = start;
+	operation->end = start + runtime;
+
+	updateJobCompletion(schedule, operation, oldEnd);
+
+	OnlineRepair repair = { NULL, 0, 0, 0, 0, (oldEnd < operation->end ? oldEnd : operation->end) + ONLINE_REPAIR_WINDOW };
+
+	if (operation->jobNext >= 0 && operation->end != oldEnd)
+	{
+		enqueueRepair(&repair, operation->jobNext);
+	}
+
+	if (operation->end < oldEnd || start != oldStart) // ficou espao livre na mquina
+	{
+		enqueueMachineRepairs(schedule, &repair, operation->machineID, start != oldStart ? oldStart : operation->end);
+	}
+
+	return runRepair(schedule, &repair);
+}
+
+
+/**
+* @brief	Definir a data de disponibilidade, a data de entrega e o peso de um trabalho do plano.
+*			Se a primeira operao j escalonada comear antes da nova data de disponibilidade,  deslocada  direita
+* @param	schedule		Plano
+* @param	jobID			Identificador do trabalho
+* @param	releaseDate		Instante a partir do qual a primeira operao pode comear
+* @param	dueDate			Instante at ao qual o trabalho deve estar acabado (JOB_NO_DUE_DATE se no tiver)
+* @param	weight			Peso do trabalho no atraso ponderado
+* @return	Quantidade de operaes recolocadas (ou -1 se falhou)
+*/
+int setJobDates_Online(OnlineSchedule* schedule, int jobID, int releaseDate, int dueDate, int weight)
+{
+	if (schedule == NULL)
+	{
+		return -1;
+	}
+
+	OnlineJob* job = getOnlineJob(schedule, jobID, true);
+	if (job == NULL)
+	{
+		return -1;
+	}
+
+	int last = job->lastOperation;
+
+	if (last >= 0)
+	{
+		schedule->weightedTardiness -= getJobTardiness(job, schedule->operations[last].end);
+	}
+
+	job->releaseDate = releaseDate;
+	job->dueDate = dueDate;
+	job->weight = weight;
+
+	if (last < 0)
+	{
+		return 0;
+	}
+
+	schedule->weightedTardiness += getJobTardiness(job, schedule->operations[last].end);
+
+	int first = last;
+	while (schedule->operations[first].jobPrevious >= 0)
+	{
+		first = schedule->operations[first].jobPrevious;
+	}
+
+	if (schedule->operations[first].start >= releaseDate)
+	{
+		return 0;
+	}
+
+	OnlineRepair repair = { NULL, 0, 0, 0, 0, releaseDate + ONLINE_REPAIR_WINDOW };
+	enqueueRepair(&repair, first);
+
+	return runRepair(schedule, &repair);
+}
+
+#pragma endregion
+
+
+#pragma region consultar plano em tempo real
+
+/**
+* @brief	Obter a mquina e o intervalo de uma operao escalonada
+* @param	schedule		Plano
+* @param	operationID		Identificador da operao
+* @param	result			Apontador para a operao escalonada
+* @return	Booleano para o resultado da funo (falso se a operao no estiver no plano)
+*/
+bool getScheduledOperation_Online(OnlineSchedule* schedule, int operationID, ScheduledOperation* result)
+{
+	if (schedule == NULL || result == NULL)
+	{
+		return false;
+	}
+
+	ScheduledOperation* operation = findScheduledOperation(schedule, operationID);
+	if (operation == NULL)
+	{
+		return false;
+	}
+
+	*result = *operation;
+
+	return true;
+}
+
+
+/**
+* @brief	Obter o instante em que termina a ltima operao do plano
+* @param	schedule	Plano
+* @return	Fim do plano (0 se estiver vazio)
+*/
+int getMakespan_Online(OnlineSchedule* schedule)
+{
+	int makespan = 0;
+
+	if (schedule == NULL)
+	{
+		return 0;
+	}
+
+	for (int i = 0; i < schedule->count; i++)
+	{
+		if (schedule->operations[i].isActive && schedule->operations[i].end > makespan)
+		{
+			makespan = schedule->operations[i].end;
+		}
+	}
+
+	return makespan;
+}
+
+
+/**
+* @brief	Obter o atraso ponderado do plano (soma, para cada trabalho atrasado, do peso vezes o atraso), mantido a cada alterao
+* @param	schedule	Plano
+* @return	Atraso ponderado
+*/
+long long getWeightedTardiness_Online(OnlineSchedule* schedule)
+{
+	return schedule != NULL ? schedule->weightedTardiness : 0;
+}
+
+
+/**
+* @brief	Verificar se o plano  vlido: cada operao comea depois da anterior do trabalho e no se sobrepe a nada na sua mquina
+* @param	schedule	Plano
+* @return	Booleano para o resultado da funo (se  vlido ou no)
+*/
+bool checkOnlineSchedule(OnlineSchedule* schedule)
+{
+	if (schedule == NULL)
+	{
+		return false;
+	}
+
+	for (int i = 0; i < schedule->count; i++)
+	{
+		ScheduledOperation* operation = &schedule->operations[i];
+		if (!operation->isActive)
+		{
+			continue;
+		}
+
+		if (operation->start < getReadyTime(schedule, operation))
+		{
+			return false;
+		}
+
+		// a reserva da operao tem de existir no calendrio com o mesmo intervalo
+		CalendarInterval* interval = getNextCalendarInterval(schedule->calendars, operation->machineID, operation->start);
+		bool found = interval != NULL && interval->type == INTERVAL_RESERVATION && interval->operationID == operation->operationID
+			&& interval->start == operation->start && interval->end == operation->end;
+
+		if (!found)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+#pragma endregion
@@ -59,6 +59,9 @@ Operation* insertOperation_AtStart(Operation* head, Operation* new)
 		head = new;
 	}
 
+	bumpOperationVersion(new->id);
+	bumpJobVersion(new->jobID);
+
 	return head;
 }
 
@@ -80,6 +83,8 @@ bool deleteOperation(Operation** head, int id)
 
 	if (aux != NULL && aux->id == id) { // se o elemento que ser apagado  o primeiro da lista
 		*head = aux->next;
+		bumpOperationVersion(id);
+		bumpJobVersion(aux->jobID);
 		free(aux);
 		return true;
 	}
@@ -96,6 +101,8 @@ bool deleteOperation(Operation** head, int id)
 	}
 
 	auxAnt->next = aux->next; // desassociar o elemento da lista
+	bumpOperationVersion(id);
+	bumpJobVersion(aux->jobID);
 	free(aux);
 
 	return true;
@@ -122,6 +129,8 @@ int deleteOperation_ByJob(Operation** head, int jobID)
 		operationDeleted = aux->id;
 		*head = aux->next;
 		free(aux);
+		bumpOperationVersion(operationDeleted);
+		bumpJobVersion(jobID);
 
 		return operationDeleted;
 	}
@@ -140,6 +149,8 @@ int deleteOperation_ByJob(Operation** head, int jobID)
 	operationDeleted = aux->id;
 	auxAnt->next = aux->next; // desassociar o elemento da lista
 	free(aux);
+	bumpOperationVersion(operationDeleted);
+	bumpJobVersion(jobID);
 
 	return operationDeleted;
 }
@@ -205,7 +216,13 @@ Operation* readOperations(char fileName[])
 	while (fread(&currentInFile, sizeof(FileOperation), 1, file)) // l todos os registos do ficheiro e guarda na lista
 	{
 		current = newOperation(currentInFile.id, currentInFile.jobID);
-		head = insertOperation_AtStart(head, current);
+		Operation* inserted = insertOperation_AtStart(head, current);
+		if (inserted == NULL) // registo repetido, a lista no  alterada
+		{
+			free(current);
+			continue;
+		}
+		head = inserted;
 	}
 
 	fclose(file);
@@ -324,7 +341,8 @@ Operation* getOperation(Operation* head, int id)
 
 
 /**
-* @brief	Obter o mnimo de tempo necessrio para completo um trabalho e as respetivas execues
+* @brief	Obter o mnimo de tempo necessrio para completo um trabalho e as respetivas execues.
+*			As operaes sem execues so ignoradas, como em getMinTimeToCompleteJob_ToArray
 * @param	operations		Lista de operaes
 * @param	executions		Lista de execues
 * @param	jobID			Identificador do trabalho
@@ -338,7 +356,6 @@ int getMinTimeToCompleteJob(Operation* operations, Execution* executions, int jo
 		return -1;
 	}
 
-	int time = 999;
 	int counter = 0;
 
 	Operation* auxOperation = operations;
@@ -353,24 +370,36 @@ int getMinTimeToCompleteJob(Operation* operations, Execution* executions, int jo
 			{
 				if (auxExecution->operationID == auxOperation->id) // se encontrar a execuo de operao relativa  operao
 				{
-					// guardar execuo de operao com menor tempo de utilizao
-					if (auxExecution->runtime < time)
+					// guardar execuo de operao com menor tempo de utilizao (a primeira encontrada serve de referncia)
+					if (minExecution == NULL || auxExecution->runtime < minExecution->runtime)
 					{
-						time = auxExecution->runtime;
-						minExecution = newExecution(auxExecution->operationID, auxExecution->machineID, auxExecution->runtime);
+						minExecution = auxExecution; // a cpia s  criada depois de percorrer todas as execues
 					}
 				}
 
 				auxExecution = auxExecution->next;
 			}
 
-			*minExecutions = insertExecutionAtStart(*minExecutions, minExecution);
+			if (minExecution != NULL) // se a operao tiver execues (as operaes sem execues so ignoradas)
+			{
+				counter += minExecution->runtime; // acumular o tempo de utilizao de cada execuo de operao
+
+				Execution* copy = newExecution(minExecution->operationID, minExecution->machineID, minExecution->runtime);
+				Execution* inserted = copy != NULL ? insertExecutionAtStart(*minExecutions, copy) : NULL;
+				if (inserted != NULL)
+				{
+					*minExecutions = inserted;
+				}
+				else // execuo j escolhida antes (operao repetida na lista), a lista no  alterada
+				{
+					free(copy);
+				}
+				minExecution = NULL;
+			}
 
 			// repor lista percorrida (currentExecution), para que se for necessrio voltar a percorrer o while da execuo de operaes de novo
 			auxExecution = NULL;
 			auxExecution = executions;
-			counter += time; // acumular o tempo de utilizao de cada execuo de operao
-			time = 999; // resetar tempo para a prxima iterao
 
 		}
 
@@ -382,7 +411,8 @@ int getMinTimeToCompleteJob(Operation* operations, Execution* executions, int jo
 
 
 /**
-* @brief	Obter o mximo de tempo necessrio para completo um trabalho e as respetivas execues
+* @brief	Obter o mximo de tempo necessrio para completo um trabalho e as respetivas execues.
+*			As operaes sem execues so ignoradas, como em getMaxTimeToCompleteJob_ToArray
 * @param	operations		Lista de operaes
 * @param	executions		Lista de execues
 * @param	jobID			Identificador do trabalho
@@ -396,7 +426,6 @@ int getMaxTimeToCompleteJob(Operation* operations, Execution* executions, int jo
 		return -1;
 	}
 
-	int time = 0;
 	int counter = 0;
 
 	Operation* auxOperation = operations;
@@ -411,24 +440,36 @@ int getMaxTimeToCompleteJob(Operation* operations, Execution* executions, int jo
 			{
 				if (auxExecution->operationID == auxOperation->id) // se encontrar a execuo de operao relativa  operao
 				{
-					// guardar execuo de operao com maior tempo de utilizao
-					if (auxExecution->runtime > time)
+					// guardar execuo de operao com maior tempo de utilizao (a primeira encontrada serve de referncia)
+					if (maxExecution == NULL || auxExecution->runtime > maxExecution->runtime)
 					{
-						time = auxExecution->runtime;
-						maxExecution = newExecution(auxExecution->operationID, auxExecution->machineID, auxExecution->runtime);
+						maxExecution = auxExecution; // a cpia s  criada depois de percorrer todas as execues
 					}
 				}
 
 				auxExecution = auxExecution->next;
 			}
 
-			*maxExecutions = insertExecutionAtStart(*maxExecutions, maxExecution);
+			if (maxExecution != NULL) // se a operao tiver execues (as operaes sem execues so ignoradas)
+			{
+				counter += maxExecution->runtime; // acumular o tempo de utilizao de cada execuo de operao
+
+				Execution* copy = newExecution(maxExecution->operationID, maxExecution->machineID, maxExecution->runtime);
+				Execution* inserted = copy != NULL ? insertExecutionAtStart(*maxExecutions, copy) : NULL;
+				if (inserted != NULL)
+				{
+					*maxExecutions = inserted;
+				}
+				else // execuo j escolhida antes (operao repetida na lista), a lista no  alterada
+				{
+					free(copy);
+				}
+				maxExecution = NULL;
+			}
 
 			// repor lista percorrida (currentExecution), para que se for necessrio voltar a percorrer o while da execuo de operaes de novo
 			auxExecution = NULL;
 			auxExecution = executions;
-			counter += time; // acumular o tempo de utilizao de cada execuo de operao
-			time = 0; // resetar tempo de utilizao para a prxima iterao
 
 		}
 
@@ -438,6 +479,98 @@ int getMaxTimeToCompleteJob(Operation* operations, Execution* executions, int jo
 	return counter;
 }
 
+/**
+* @brief	Obter o tempo mnimo ou mximo para completar um trabalho, escrevendo as execues escolhidas num array
+*			dado por quem chama (sem alocar memria). As operaes sem execues so ignoradas
+* @param	operations		Lista de operaes
+* @param	executions		Lista de execues
+* @param	jobID			Identificador do trabalho
+* @param	useMax			Se deve ser escolhida a execuo mais lenta em vez da mais rpida
+* @param	chosen			Array para as execues escolhidas, pela ordem das operaes na lista (pode ser NULL se capacity for 0)
+* @param	capacity		Capacidade do array
+* @param	numberOfChosen	Apontador para a quantidade de execues escolhidas (se for maior que capacity, o array ficou incompleto)
+* @return	Quantidade de tempo (ou -1 se as listas estiverem vazias)
+*/
+static int getTimeToCompleteJob_ToArray(Operation* operations, Execution* executions, int jobID, bool useMax, FileExecution chosen[], int capacity, int* numberOfChosen)
+{
+	*numberOfChosen = 0;
+
+	if (operations == NULL || executions == NULL) // se as listas estiverem vazias
+	{
+		return -1;
+	}
+
+	int counter = 0;
+
+	for (Operation* operation = operations; operation != NULL; operation = operation->next)
+	{
+		if (operation->jobID != jobID)
+		{
+			continue;
+		}
+
+		Execution* best = NULL;
+
+		for (Execution* aux = executions; aux != NULL; aux = aux->next)
+		{
+			if (aux->operationID == operation->id
+				&& (best == NULL || (useMax ? aux->runtime > best->runtime : aux->runtime < best->runtime)))
+			{
+				best = aux;
+			}
+		}
+
+		if (best == NULL) // operao sem execues
+		{
+			continue;
+		}
+
+		if (*numberOfChosen < capacity)
+		{
+			chosen[*numberOfChosen].operationID = best->operationID;
+			chosen[*numberOfChosen].machineID = best->machineID;
+			chosen[*numberOfChosen].runtime = best->runtime;
+		}
+
+		(*numberOfChosen)++;
+		counter += best->runtime;
+	}
+
+	return counter;
+}
+
+
+/**
+* @brief	Obter o mnimo de tempo necessrio para completar um trabalho, escrevendo as execues escolhidas num array (sem alocar memria)
+* @param	operations		Lista de operaes
+* @param	executions		Lista de execues
+* @param	jobID			Identificador do trabalho
+* @param	minExecutions	Array para as execues escolhidas, uma por operao do trabalho
+* @param	capacity		Capacidade do array
+* @param	numberOfChosen	Apontador para a quantidade de execues escolhidas (se for maior que capacity, o array ficou incompleto)
+* @return	Quantidade de tempo (ou -1 se as listas estiverem vazias)
+*/
+int getMinTimeToCompleteJob_ToArray(Operation* operations, Execution* executions, int jobID, FileExecution minExecutions[], int capacity, int* numberOfChosen)
+{
+	return getTimeToCompleteJob_ToArray(operations, executions, jobID, false, minExecutions, capacity, numberOfChosen);
+}
+
+
+/**
+* @brief	Obter o mximo de tempo necessrio para completar um trabalho, escrevendo as execues escolhidas num array (sem alocar memria)
+* @param	operations		Lista de operaes
+* @param	executions		Lista de execues
+* @param	jobID			Identificador do trabalho
+* @param	maxExecutions	Array para as execues escolhidas, uma por operao do trabalho
+* @param	capacity		Capacidade do array
+* @param	numberOfChosen	Apontador para a quantidade de execues escolhidas (se for maior que capacity, o array ficou incompleto)
+* @return	Quantidade de tempo (ou -1 se as listas estiverem vazias)
+*/
+int getMaxTimeToCompleteJob_ToArray(Operation* operations, Execution* executions, int jobID, FileExecution maxExecutions[], int capacity, int* numberOfChosen)
+{
+	return getTimeToCompleteJob_ToArray(operations, executions, jobID, true, maxExecutions, capacity, numberOfChosen);
+}
+
 /**
 * @brief	Obter a mdia de tempo necessrio para completar uma operao, considerando todas as alternativas possveis
 * @param	head			Lista de execues
@@ -473,4 +606,191 @@ float getAverageTimeToCompleteOperation(Execution* head, int operationID)
 	}
 
 	return average;
-}
\ No newline at end of file
+}
+
+
+/**
+* @brief	Copiar a lista de operaes, mantendo a mesma ordem
+* @param	head	Lista de operaes
+* @return	Nova lista de operaes
+*/
+Operation* copyOperations(Operation* head)
+{
+	Operation* copy = NULL;
+	Operation* last = NULL;
+
+	for (Operation* aux = head; aux != NULL; aux = aux->next)
+	{
+		Operation* new = newOperation(aux->id, aux->jobID);
+		if (new == NULL) // se no houver memria para alocar
+		{
+			freeOperations(copy);
+			return NULL;
+		}
+
+		if (last == NULL) // inserir no fim, sem procurar duplicados porque a lista original j no os tem
+		{
+			copy = new;
+		}
+		else
+		{
+			last->next = new;
+		}
+		last = new;
+	}
+
+	return copy;
+}
+
+
+/**
+* @brief	Libertar a lista de operaes da memria
+* @param	head	Lista de operaes
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool freeOperations(Operation* head)
+{
+	Operation* aux = head;
+
+	while (aux != NULL)
+	{
+		Operation* next = aux->next;
+		free(aux);
+		aux = next;
+	}
+
+	return true;
+}
+
+/**
+ * @brief	Dados partilhados pelas tarefas do clculo paralelo dos tempos dos trabalhos
+ */
+typedef struct JobTimesTask
+{
+	Operation** operations; // array com todas as operaes
+	ExecutionNode** table;
+	int* minRuntimes; // tempo mnimo de cada operao
+	int* maxRuntimes; // tempo mximo de cada operao
+} JobTimesTask;
+
+
+/**
+* @brief	Calcular o tempo mnimo e mximo das operaes de um intervalo, procurando na tabela hash das execues
+* @param	first		Primeira operao do intervalo
+* @param	last		Operao a seguir  ltima do intervalo
+* @param	argument	Dados partilhados (JobTimesTask)
+*/
+static void getOperationRuntimes_Range(int first, int last, void* argument)
+{
+	JobTimesTask* data = (JobTimesTask*)argument;
+
+	for (int i = first; i < last; i++)
+	{
+		int id = data->operations[i]->id;
+		int min = -1;
+		int max = -1;
+
+		for (Execution* aux = data->table[generateHash_AtTable(data->table, id)]->start; aux != NULL; aux = aux->next)
+		{
+			if (aux->operationID == id)
+			{
+				if (min == -1 || aux->runtime < min)
+				{
+					min = aux->runtime;
+				}
+				if (aux->runtime > max)
+				{
+					max = aux->runtime;
+				}
+			}
+		}
+
+		data->minRuntimes[i] = min;
+		data->maxRuntimes[i] = max;
+	}
+}
+
+
+/**
+* @brief	Obter o mnimo e o mximo de tempo necessrio para completar cada um dos trabalhos, em paralelo.
+*			O tempo de cada operao  calculado em paralelo (as operaes so divididas pelas threads do conjunto)
+*			e depois somado ao respetivo trabalho
+* @param	pool		Conjunto de threads (NULL para calcular na thread atual)
+* @param	jobs		Lista de trabalhos
+* @param	operations	Lista de operaes
+* @param	table		Tabela hash das execues
+* @param	times		Array onde so guardados os tempos de cada trabalho
+* @param	capacity	Tamanho do array
+* @return	Quantidade de trabalhos guardados no array (ou -1 se falhou)
+*/
+int getTimesToCompleteJobs_Parallel(TaskPool* pool, Job* jobs, Operation* operations, ExecutionNode* table[], JobTimes* times, int capacity)
+{
+	if (jobs == NULL || operations == NULL || table == NULL || times == NULL)
+	{
+		return -1;
+	}
+
+	int numberOfJobs = 0;
+	int numberOfOperations = 0;
+
+	for (Operation* aux = operations; aux != NULL; aux = aux->next)
+	{
+		numberOfOperations++;
+	}
+
+	KeySet* jobIndexes = createKeySet(capacity);
+	JobTimesTask data;
+
+	data.operations = (Operation**)malloc(numberOfOperations * sizeof(Operation*));
+	data.minRuntimes = (int*)malloc(numberOfOperations * sizeof(int));
+	data.maxRuntimes = (int*)malloc(numberOfOperations * sizeof(int));
+	data.table = table;
+
+	if (jobIndexes == NULL || data.operations == NULL || data.minRuntimes == NULL || data.maxRuntimes == NULL)
+	{
+		freeKeySet(jobIndexes);
+		free(data.operations);
+		free(data.minRuntimes);
+		free(data.maxRuntimes);
+		return -1;
+	}
+
+	// posio de cada trabalho no array de resultados
+	for (Job* aux = jobs; aux != NULL && numberOfJobs < capacity; aux = aux->next)
+	{
+		if (insertKey(jobIndexes, aux->id, numberOfJobs))
+		{
+			times[numberOfJobs].jobID = aux->id;
+			times[numberOfJobs].minTime = 0;
+			times[numberOfJobs].maxTime = 0;
+			numberOfJobs++;
+		}
+	}
+
+	int i = 0;
+	for (Operation* aux = operations; aux != NULL; aux = aux->next)
+	{
+		data.operations[i++] = aux;
+	}
+
+	parallelFor(pool, 0, numberOfOperations, 0, getOperationRuntimes_Range, &data);
+
+	// somar o tempo de cada operao ao seu trabalho (operaes sem execues no contam)
+	for (i = 0; i < numberOfOperations; i++)
+	{
+		int index = getKeyValue(jobIndexes, data.operations[i]->jobID);
+
+		if (index >= 0 && data.minRuntimes[i] >= 0)
+		{
+			times[index].minTime += data.minRuntimes[i];
+			times[index].maxTime += data.maxRuntimes[i];
+		}
+	}
+
+	freeKeySet(jobIndexes);
+	free(data.operations);
+	free(data.minRuntimes);
+	free(data.maxRuntimes);
+
+	return numberOfJobs;
+}
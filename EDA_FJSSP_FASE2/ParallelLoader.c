@@ -0,0 +1,529 @@
+/**
+ * @brief	Ficheiro com as funes para ler os ficheiros binrios com vrias threads
+ * @file	parallelloader.c
+ * @author	Vnia Pereira
+ * @email	a19264@alunos.ipca.pt
+ * @date	2022
+ * @Disciplina Estruturas de Dados Avanadas
+ *
+ * -----------------
+ *
+ * Cada ficheiro  dividido em intervalos de bytes alinhados ao tamanho do registo, um por thread.
+ * Cada thread l o seu intervalo com o seu prprio FILE* e descodifica os registos para parties locais.
+ * No fim, as parties so juntadas numa nica passagem, removendo duplicados com um conjunto de chaves.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "header.h"
+
+
+/**
+ * @brief	Estrutura de dados com o trabalho de cada thread de leitura
+ */
+typedef struct LoaderWorker
+{
+	char* fileName;
+	long long offset; // bytes antes do primeiro registo (cabealho do ficheiro)
+	long long firstRecord;
+	int numberOfRecords;
+	size_t recordSize;
+	char* records; // onde os registos deste intervalo so lidos
+	bool failed;
+	unsigned int hashSeed; // semente da funo de hash da tabela de destino
+	// parties locais das execues, uma lista por posio da tabela hash
+	Execution* starts[HASH_TABLE_SIZE];
+	Execution* ends[HASH_TABLE_SIZE];
+} LoaderWorker;
+
+
+#pragma region leitura em paralelo
+
+/**
+* @brief	Mudar a posio de leitura de um ficheiro, suportando ficheiros com mais de 2 GB
+* @param	file	Ficheiro
+* @param	offset	Posio em bytes desde o incio
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+static bool seekFile(FILE* file, long long offset)
+{
+#ifdef _WIN32
+	return _fseeki64(file, offset, SEEK_SET) == 0;
+#else
+	return fseeko(file, (off_t)offset, SEEK_SET) == 0;
+#endif
+}
+
+
+/**
+* @brief	Obter o tamanho de um ficheiro em bytes
+* @param	fileName	Nome do ficheiro
+* @return	Tamanho do ficheiro (ou -1 se no foi possvel abrir)
+*/
+long long getFileSize(char fileName[])
+{
+	FILE* file = NULL;
+
+	if ((file = fopen(fileName, "rb")) == NULL) // se no foi possvel abrir o ficheiro
+	{
+		return -1;
+	}
+
+#ifdef _WIN32
+	_fseeki64(file, 0, SEEK_END);
+	long long size = _ftelli64(file);
+#else
+	fseeko(file, 0, SEEK_END);
+	long long size = (long long)ftello(file);
+#endif
+
+	fclose(file);
+
+	return size;
+}
+
+
+/**
+* @brief	Ler o intervalo de registos de uma thread
+* @param	data	Trabalho da thread (LoaderWorker)
+*/
+static void readRecordRange(void* data)
+{
+	LoaderWorker* worker = (LoaderWorker*)data;
+	FILE* file = NULL;
+
+	worker->failed = true;
+
+	if ((file = fopen(worker->fileName, "rb")) == NULL) // cada thread tem o seu prprio ficheiro aberto
+	{
+		return;
+	}
+
+	if (seekFile(file, worker->offset + worker->firstRecord * (long long)worker->recordSize)
+		&& fread(worker->records, worker->recordSize, worker->numberOfRecords, file) == (size_t)worker->numberOfRecords)
+	{
+		worker->failed = false;
+	}
+
+	fclose(file);
+}
+
+
+/**
+* @brief	Ler o intervalo de execues de uma thread e descodific-las para listas locais, uma por posio da tabela hash
+* @param	data	Trabalho da thread (LoaderWorker)
+*/
+static void readExecutionRange(void* data)
+{
+	LoaderWorker* worker = (LoaderWorker*)data;
+
+	readRecordRange(worker);
+	if (worker->failed)
+	{
+		return;
+	}
+
+	FileExecution* records = (FileExecution*)worker->records;
+
+	for (int i = 0; i < worker->numberOfRecords; i++)
+	{
+		Execution* execution = newExecution(records[i].operationID, records[i].machineID, records[i].runtime);
+		if (execution == NULL) // se no houver memria para alocar
+		{
+			worker->failed = true;
+			return;
+		}
+
+		// inserir no fim da lista local, para manter a ordem do ficheiro
+		int index = generateHash_WithSeed(execution->operationID, worker->hashSeed);
+		if (worker->ends[index] == NULL)
+		{
+			worker->starts[index] = execution;
+		}
+		else
+		{
+			worker->ends[index]->next = execution;
+		}
+		worker->ends[index] = execution;
+	}
+}
+
+
+/**
+* @brief	Dividir um ficheiro em intervalos de registos e executar uma funo de leitura para cada intervalo numa thread
+* @param	fileName			Nome do ficheiro
+* @param	offset				Bytes antes do primeiro registo (cabealho do ficheiro)
+* @param	recordSize			Tamanho de cada registo em bytes
+* @param	numberOfThreads		Quantidade de threads (0 para usar todos os processadores)
+* @param	function			Funo de leitura de cada intervalo
+* @param	hashSeed			Semente da funo de hash da tabela de destino (0 se no houver tabela)
+* @param	records				Apontador para o array com todos os registos lidos
+* @param	workers				Apontador para o array de trabalhos das threads
+* @return	Quantidade de threads usadas (0 se falhou)
+*/
+static int runLoaderWorkers(char fileName[], long long offset, size_t recordSize, int numberOfThreads, void (*function)(void*), unsigned int hashSeed, char** records, LoaderWorker** workers)
+{
+	long long fileSize = getFileSize(fileName) - offset;
+	if (fileSize <= 0)
+	{
+		return 0;
+	}
+
+	long long numberOfRecords = fileSize / (long long)recordSize; // um registo incompleto no fim  ignorado
+
+	if (numberOfThreads <= 0)
+	{
+		numberOfThreads = getNumberOfProcessors();
+	}
+
+	// no vale a pena criar threads para intervalos muito pequenos
+	if (numberOfRecords / PARALLEL_LOADER_MIN_RECORDS < numberOfThreads)
+	{
+		numberOfThreads = (int)(numberOfRecords / PARALLEL_LOADER_MIN_RECORDS);
+	}
+	if (numberOfThreads < 1)
+	{
+		numberOfThreads = 1;
+	}
+
+	*records = (char*)malloc((size_t)numberOfRecords * recordSize);
+	*workers = (LoaderWorker*)calloc(numberOfThreads, sizeof(LoaderWorker));
+	Thread* threads = (Thread*)malloc(numberOfThreads * sizeof(Thread));
+	bool* started = (bool*)calloc(numberOfThreads, sizeof(bool));
+
+	if (*records == NULL || *workers == NULL || threads == NULL || started == NULL)
+	{
+		free(*records);
+		free(*workers);
+		free(threads);
+		free(started);
+		return 0;
+	}
+
+	long long first = 0;
+
+	for (int i = 0; i < numberOfThreads; i++)
+	{
+		// os registos que sobram da diviso so distribudos pelas primeiras threads
+		long long count = numberOfRecords / numberOfThreads + (i < numberOfRecords % numberOfThreads ? 1 : 0);
+
+		(*workers)[i].fileName = fileName;
+		(*workers)[i].offset = offset;
+		(*workers)[i].firstRecord = first;
+		(*workers)[i].numberOfRecords = (int)count;
+		(*workers)[i].recordSize = recordSize;
+		(*workers)[i].records = *records + first * (long long)recordSize;
+		(*workers)[i].hashSeed = hashSeed;
+
+		first += count;
+	}
+
+	// a thread atual l o primeiro intervalo, as restantes so criadas
+	for (int i = 1; i < numberOfThreads; i++)
+	{
+		started[i] = createThread(&threads[i], function, &(*workers)[i]);
+	}
+
+	function(&(*workers)[0]);
+
+	for (int i = 1; i < numberOfThreads; i++)
+	{
+		if (started[i])
+		{
+			joinThread(&threads[i]);
+		}
+		else // se no foi possvel criar a thread, o intervalo  lido pela thread atual
+		{
+			function(&(*workers)[i]);
+		}
+	}
+
+	free(threads);
+	free(started);
+
+	return numberOfThreads;
+}
+
+
+/**
+* @brief	Ler todos os registos de um ficheiro binrio para um array, com vrias threads
+* @param	fileName			Nome do ficheiro
+* @param	recordSize			Tamanho de cada registo em bytes
+* @param	numberOfThreads		Quantidade de threads (0 para usar todos os processadores)
+* @param	numberOfRecords		Apontador para a quantidade de registos lidos
+* @return	Array com os registos (ou NULL se falhou)
+*/
+void* readRecords_Parallel(char fileName[], size_t recordSize, int numberOfThreads, int* numberOfRecords)
+{
+	return readRecords_Parallel_AtOffset(fileName, 0, recordSize, numberOfThreads, numberOfRecords);
+}
+
+
+/**
+* @brief	Ler todos os registos de um ficheiro binrio com cabealho para um array, com vrias threads
+* @param	fileName			Nome do ficheiro
+* @param	offset				Bytes antes do primeiro registo (cabealho do ficheiro)
+* @param	recordSize			Tamanho de cada registo em bytes
+* @param	numberOfThreads		Quantidade de threads (0 para usar todos os processadores)
+* @param	numberOfRecords		Apontador para a quantidade de registos lidos
+* @return	Array com os registos (ou NULL se falhou)
+*/
+void* readRecords_Parallel_AtOffset(char fileName[], long long offset, size_t recordSize, int numberOfThreads, int* numberOfRecords)
+{
+	char* records = NULL;
+	LoaderWorker* workers = NULL;
+
+	*numberOfRecords = 0;
+
+	int used = runLoaderWorkers(fileName, offset, recordSize, numberOfThreads, readRecordRange, 0, &records, &workers);
+	if (used == 0)
+	{
+		return NULL;
+	}
+
+	bool failed = false;
+
+	for (int i = 0; i < used; i++)
+	{
+		failed = failed || workers[i].failed;
+		*numberOfRecords += workers[i].numberOfRecords;
+	}
+
+	free(workers);
+
+	if (failed)
+	{
+		free(records);
+		*numberOfRecords = 0;
+		return NULL;
+	}
+
+	return records;
+}
+
+#pragma endregion
+
+
+#pragma region carregar estruturas em paralelo
+
+/**
+* @brief	Ler lista de trabalhos de ficheiro binrio, com vrias threads
+* @param	fileName			Nome do ficheiro para ler a lista
+* @param	numberOfThreads		Quantidade de threads (0 para usar todos os processadores)
+* @return	Lista de trabalhos (na mesma ordem que readJobs)
+*/
+Job* readJobs_Parallel(char fileName[], int numberOfThreads)
+{
+	FILE* file = NULL;
+
+	if ((file = fopen(fileName, "rb")) == NULL) // se no foi possvel abrir o ficheiro
+	{
+		return NULL;
+	}
+
+	int recordSize = readJobsFileHeader(file);
+	fclose(file);
+
+	if (recordSize != (int)sizeof(JobFile)) // formato no suportado, ou ficheiro da verso 1 (pequeno, lido sem threads)
+	{
+		return recordSize < 0 ? NULL : readJobs(fileName);
+	}
+
+	int count = 0;
+	JobFile* records = (JobFile*)readRecords_Parallel_AtOffset(fileName, sizeof(JobFileHeader), sizeof(JobFile), numberOfThreads, &count);
+	if (records == NULL)
+	{
+		return NULL;
+	}
+
+	KeySet* ids = createKeySet(count);
+	Job* head = NULL;
+
+	for (int i = 0; i < count; i++)
+	{
+		if (insertKey(ids, records[i].id, i)) // ignorar identificadores repetidos, como em insertJobAtStart
+		{
+			Job* new = newJob_WithDates(records[i].id, records[i].releaseDate, records[i].dueDate, records[i].weight);
+			new->next = head;
+			head = new;
+		}
+	}
+
+	freeKeySet(ids);
+	free(records);
+
+	return head;
+}
+
+
+/**
+* @brief	Ler lista de mquinas de ficheiro binrio, com vrias threads
+* @param	fileName			Nome do ficheiro para ler a lista
+* @param	numberOfThreads		Quantidade de threads (0 para usar todos os processadores)
+* @return	Lista de mquinas (na mesma ordem que readMachine)
+*/
+Machine* readMachines_Parallel(char fileName[], int numberOfThreads)
+{
+	int count = 0;
+	MachineFile* records = (MachineFile*)readRecords_Parallel(fileName, sizeof(MachineFile), numberOfThreads, &count);
+	if (records == NULL)
+	{
+		return NULL;
+	}
+
+	KeySet* ids = createKeySet(count);
+	Machine* head = NULL;
+
+	for (int i = 0; i < count; i++)
+	{
+		if (insertKey(ids, records[i].id, i)) // ignorar identificadores repetidos, como em insertMachineAtStart
+		{
+			Machine* new = newMachine(records[i].id, records[i].isBusy);
+			new->next = head;
+			head = new;
+		}
+	}
+
+	freeKeySet(ids);
+	free(records);
+
+	return head;
+}
+
+
+/**
+* @brief	Ler lista de operaes de ficheiro binrio, com vrias threads
+* @param	fileName			Nome do ficheiro para ler a lista
+* @param	numberOfThreads		Quantidade de threads (0 para usar todos os processadores)
+* @return	Lista de operaes (na mesma ordem que readOperations)
+*/
+Operation* readOperations_Parallel(char fileName[], int numberOfThreads)
+{
+	int count = 0;
+	FileOperation* records = (FileOperation*)readRecords_Parallel(fileName, sizeof(FileOperation), numberOfThreads, &count);
+	if (records == NULL)
+	{
+		return NULL;
+	}
+
+	KeySet* ids = createKeySet(count);
+	Operation* head = NULL;
+
+	for (int i = 0; i < count; i++)
+	{
+		if (insertKey(ids, records[i].id, i)) // ignorar identificadores repetidos, como em insertOperation_AtStart
+		{
+			Operation* new = newOperation(records[i].id, records[i].jobID);
+			new->next = head;
+			head = new;
+		}
+	}
+
+	freeKeySet(ids);
+	free(records);
+
+	return head;
+}
+
+
+/**
+* @brief	Ler de ficheiro binrio os registos de todas as execues para a tabela hash, com vrias threads.
+*			Cada thread cria as execues do seu intervalo em listas locais por posio da tabela,
+*			que depois so ligadas s posies da tabela numa nica passagem
+* @param	fileName			Nome do ficheiro para ler os registos
+* @param	table				Tabela hash das execues (pode j ter execues)
+* @param	numberOfThreads		Quantidade de threads (0 para usar todos os processadores)
+* @return	Quantidade de execues inseridas na tabela (ou -1 se falhou)
+*/
+int readExecutions_AtTable_Parallel(char fileName[], ExecutionNode* table[], int numberOfThreads)
+{
+	char* records = NULL;
+	LoaderWorker* workers = NULL;
+
+	int used = runLoaderWorkers(fileName, 0, sizeof(FileExecution), numberOfThreads, readExecutionRange, table[0]->hashSeed, &records, &workers);
+	if (used == 0)
+	{
+		return -1;
+	}
+
+	free(records); // os registos j foram descodificados para as listas locais
+
+	bool failed = false;
+	int total = 0;
+
+	for (int i = 0; i < used; i++)
+	{
+		failed = failed || workers[i].failed;
+		total += workers[i].numberOfRecords;
+	}
+
+	KeySet* keys = failed ? NULL : createKeySet(total);
+	bool loaded = keys != NULL;
+	int inserted = 0;
+
+	// as execues que j estavam na tabela contam para os duplicados
+	for (int b = 0; b < HASH_TABLE_SIZE && loaded; b++)
+	{
+		for (Execution* aux = table[b]->start; aux != NULL; aux = aux->next)
+		{
+			insertKey(keys, EXECUTION_KEY(aux->operationID, aux->machineID), b);
+		}
+	}
+
+	// juntar as parties: cada execuo  visitada uma vez e ligada no fim de uma lista nova por posio,
+	// que no fim  colocada antes das execues que j existiam (a mesma ordem que readExecutions_AtTable)
+	Execution* starts[HASH_TABLE_SIZE] = { NULL };
+	Execution* ends[HASH_TABLE_SIZE] = { NULL };
+
+	for (int i = 0; i < used; i++)
+	{
+		for (int b = 0; b < HASH_TABLE_SIZE; b++)
+		{
+			Execution* aux = workers[i].starts[b];
+
+			while (aux != NULL)
+			{
+				Execution* next = aux->next;
+
+				if (loaded && insertKey(keys, EXECUTION_KEY(aux->operationID, aux->machineID), b))
+				{
+					aux->next = NULL;
+					if (ends[b] == NULL)
+					{
+						starts[b] = aux;
+					}
+					else
+					{
+						ends[b]->next = aux;
+					}
+					ends[b] = aux;
+					table[b]->numberOfExecutions++;
+					inserted++;
+				}
+				else // execuo repetida (ou leitura falhada)
+				{
+					free(aux);
+				}
+
+				aux = next;
+			}
+		}
+	}
+
+	for (int b = 0; b < HASH_TABLE_SIZE; b++)
+	{
+		if (ends[b] != NULL)
+		{
+			ends[b]->next = table[b]->start;
+			table[b]->start = starts[b];
+		}
+	}
+
+	freeKeySet(keys);
+	free(workers);
+
+	return loaded ? inserted : -1;
+}
+
+#pragma endregion
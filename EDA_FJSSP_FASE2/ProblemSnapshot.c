@@ -0,0 +1,893 @@
+/**
+ * @brief	Ficheiro com as funes da imagem compilada (s de leitura) do problema, usada pelos algoritmos de escalonamento
+ * @file	problemsnapshot.c
+ * @author	Vnia Pereira
+ * @email	a19264@alunos.ipca.pt
+ * @date	2022
+ * @Disciplina Estruturas de Dados Avanadas
+ *
+ * -----------------
+ *
+ * A imagem  um nico bloco contguo, sem apontadores, alinhado a CACHE_LINE_SIZE bytes:
+ *
+ *	[cabealho][jobIDs][jobOperationStarts][operationIDs][operationJobs][operationAlternativeStarts]
+ *	[alternativeMachines][alternativeRuntimes][machineIDs][operationMinRuntimes][operationMaxRuntimes][jobMinTimes][jobMaxTimes]
+ *	[jobReleaseDates][jobDueDates][jobWeights]
+ *
+ * Cada array comea numa posio mltipla de CACHE_LINE_SIZE, guardada no cabealho como distncia ao incio do bloco.
+ * Os arrays seguem o formato CSR: as operaes do trabalho j so [jobOperationStarts[j], jobOperationStarts[j + 1])
+ * e as alternativas da operao o so [operationAlternativeStarts[o], operationAlternativeStarts[o + 1]),
+ * ordenadas pelo tempo (a primeira  a mais rpida). Trabalhos e mquinas ficam por ordem crescente do identificador,
+ * as operaes por trabalho e depois por identificador.
+ *
+ * Como o bloco no tem apontadores,  gravado tal como est e pode ser aberto diretamente do ficheiro (mmap / MapViewOfFile).
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include "header.h"
+
+
+#pragma region memria alinhada
+
+/**
+* @brief	Alocar memria alinhada a CACHE_LINE_SIZE bytes, a zero
+* @param	size	Quantidade de bytes (mltiplo de CACHE_LINE_SIZE)
+* @return	Memria alocada (ou NULL se no houver memria)
+*/
+static void* allocateAligned(long long size)
+{
+	void* block = NULL;
+
+#ifdef _WIN32
+	block = _aligned_malloc((size_t)size, CACHE_LINE_SIZE);
+#else
+	if (posix_memalign(&block, CACHE_LINE_SIZE, (size_t)size) != 0)
+	{
+		block = NULL;
+	}
+#endif
+
+	if (block != NULL)
+	{
+		memset(block, 0, (size_t)size);
+	}
+
+	return block;
+}
+
+
+/**
+* @brief	Libertar memria alocada com allocateAligned
+*/
+static void freeAligned(void* block)
+{
+#ifdef _WIN32
+	_aligned_free(block);
+#else
+	free(block);
+#endif
+}
+
+
+/**
+* @brief	Arredondar uma quantidade de bytes para o mltiplo de CACHE_LINE_SIZE seguinte
+*/
+static long long alignSize(long long size)
+{
+	return (size + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+}
+
+#pragma endregion
+
+
+#pragma region compilar imagem do problema
+
+/**
+* @brief	Comparar dois inteiros (para qsort)
+*/
+static int compareInts(const void* a, const void* b)
+{
+	int x = *(const int*)a;
+	int y = *(const int*)b;
+
+	return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+
+/**
+* @brief	Comparar duas operaes pelo ndice do trabalho e depois pelo identificador (para qsort)
+*/
+static int compareSnapshotOperations(const void* a, const void* b)
+{
+	const FileOperation* x = (const FileOperation*)a;
+	const FileOperation* y = (const FileOperation*)b;
+
+	if (x->jobID != y->jobID)
+	{
+		return x->jobID < y->jobID ? -1 : 1;
+	}
+
+	return x->id < y->id ? -1 : (x->id > y->id ? 1 : 0);
+}
+
+
+/**
+* @brief	Ordenar um array de identificadores, retirar os repetidos e criar o conjunto identificador -> posio
+* @param	ids		Array de identificadores
+* @param	count	Apontador para a quantidade de identificadores (atualizada sem os repetidos)
+* @return	Conjunto com a posio de cada identificador (ou NULL se no houver memria)
+*/
+static KeySet* sortUniqueIds(int* ids, int* count)
+{
+	qsort(ids, *count, sizeof(int), compareInts);
+
+	int unique = 0;
+	for (int i = 0; i < *count; i++)
+	{
+		if (unique == 0 || ids[unique - 1] != ids[i])
+		{
+			ids[unique++] = ids[i];
+		}
+	}
+	*count = unique;
+
+	KeySet* positions = createKeySet(unique);
+	for (int i = 0; i < unique && positions != NULL; i++)
+	{
+		insertKey(positions, ids[i], i);
+	}
+
+	return positions;
+}
+
+
+/**
+* @brief	Preencher os apontadores para os arrays de uma imagem a partir das posies guardadas no cabealho
+* @param	snapshot	Imagem do problema (com o bloco j definido)
+*/
+static void resolveSnapshotArrays(ProblemSnapshot* snapshot)
+{
+	const char* block = (const char*)snapshot->block;
+	const ProblemSnapshotHeader* header = (const ProblemSnapshotHeader*)block;
+
+	snapshot->header = header;
+	snapshot->jobIDs = (const int*)(block + header->jobIDsOffset);
+	snapshot->jobOperationStarts = (const int*)(block + header->jobOperationStartsOffset);
+	snapshot->operationIDs = (const int*)(block + header->operationIDsOffset);
+	snapshot->operationJobs = (const int*)(block + header->operationJobsOffset);
+	snapshot->operationAlternativeStarts = (const int*)(block + header->operationAlternativeStartsOffset);
+	snapshot->alternativeMachines = (const int*)(block + header->alternativeMachinesOffset);
+	snapshot->alternativeRuntimes = (const int*)(block + header->alternativeRuntimesOffset);
+	snapshot->machineIDs = (const int*)(block + header->machineIDsOffset);
+	snapshot->operationMinRuntimes = (const int*)(block + header->operationMinRuntimesOffset);
+	snapshot->operationMaxRuntimes = (const int*)(block + header->operationMaxRuntimesOffset);
+	snapshot->jobMinTimes = (const int*)(block + header->jobMinTimesOffset);
+	snapshot->jobMaxTimes = (const int*)(block + header->jobMaxTimesOffset);
+	snapshot->jobReleaseDates = (const int*)(block + header->jobReleaseDatesOffset);
+	snapshot->jobDueDates = (const int*)(block + header->jobDueDatesOffset);
+	snapshot->jobWeights = (const int*)(block + header->jobWeightsOffset);
+}
+
+
+/**
+* @brief	Reservar espao para um array de inteiros no bloco da imagem
+* @param	size	Apontador para o tamanho atual do bloco (atualizado)
+* @param	count	Quantidade de inteiros
+* @return	Posio do array no bloco
+*/
+static long long reserveSnapshotArray(long long* size, long long count)
+{
+	long long offset = *size;
+
+	*size += alignSize(count * (long long)sizeof(int));
+
+	return offset;
+}
+
+
+/**
+* @brief	Compilar a imagem s de leitura do problema a partir das listas e da tabela hash.
+*			Os trabalhos das operaes que no esto na lista de trabalhos e as mquinas que s aparecem nas execues tambm so includos.
+*			Execues de operaes desconhecidas so ignoradas
+* @param	jobs			Lista de trabalhos
+* @param	machines		Lista de mquinas
+* @param	operations		Lista de operaes
+* @param	executions		Tabela hash das execues
+* @return	Imagem compilada (ou NULL se no houver memria)
+*/
+ProblemSnapshot* compileProblemSnapshot(Job* jobs, Machine* machines, Operation* operations, ExecutionNode* executions[])
+{
+	int numberOfJobs = 0;
+	int numberOfMachines = 0;
+	int numberOfOperations = 0;
+	int numberOfExecutions = 0;
+
+	for (Job* aux = jobs; aux != NULL; aux = aux->next) numberOfJobs++;
+	for (Machine* aux = machines; aux != NULL; aux = aux->next) numberOfMachines++;
+	for (Operation* aux = operations; aux != NULL; aux = aux->next) numberOfOperations++;
+	for (int i = 0; i < HASH_TABLE_SIZE; i++)
+	{
+		for (Execution* aux = executions[i]->start; aux != NULL; aux = aux->next) numberOfExecutions++;
+	}
+
+	ProblemSnapshot* snapshot = (ProblemSnapshot*)calloc(1, sizeof(ProblemSnapshot));
+	int* jobIDs = (int*)malloc((numberOfJobs + numberOfOperations + 1) * sizeof(int));
+	int* machineIDs = (int*)malloc((numberOfMachines + numberOfExecutions + 1) * sizeof(int));
+	FileOperation* sortedOperations = (FileOperation*)malloc((numberOfOperations + 1) * sizeof(FileOperation));
+	KeySet* jobPositions = NULL;
+	KeySet* machinePositions = NULL;
+	KeySet* operationPositions = NULL;
+
+	if (snapshot == NULL || jobIDs == NULL || machineIDs == NULL || sortedOperations == NULL)
+	{
+		goto failed;
+	}
+
+	// trabalhos e mquinas por ordem crescente do identificador, sem repetidos
+	numberOfJobs = 0;
+	for (Job* aux = jobs; aux != NULL; aux = aux->next) jobIDs[numberOfJobs++] = aux->id;
+	for (Operation* aux = operations; aux != NULL; aux = aux->next) jobIDs[numberOfJobs++] = aux->jobID;
+
+	numberOfMachines = 0;
+	for (Machine* aux = machines; aux != NULL; aux = aux->next) machineIDs[numberOfMachines++] = aux->id;
+	for (int i = 0; i < HASH_TABLE_SIZE; i++)
+	{
+		for (Execution* aux = executions[i]->start; aux != NULL; aux = aux->next) machineIDs[numberOfMachines++] = aux->machineID;
+	}
+
+	jobPositions = sortUniqueIds(jobIDs, &numberOfJobs);
+	machinePositions = sortUniqueIds(machineIDs, &numberOfMachines);
+
+	// operaes por trabalho e depois por identificador (jobID passa a ser a posio do trabalho)
+	operationPositions = createKeySet(numberOfOperations);
+	if (jobPositions == NULL || machinePositions == NULL || operationPositions == NULL)
+	{
+		goto failed;
+	}
+
+	numberOfOperations = 0;
+	for (Operation* aux = operations; aux != NULL; aux = aux->next)
+	{
+		if (insertKey(operationPositions, aux->id, 0)) // ignorar operaes repetidas
+		{
+			sortedOperations[numberOfOperations].id = aux->id;
+			sortedOperations[numberOfOperations].jobID = getKeyValue(jobPositions, aux->jobID);
+			numberOfOperations++;
+		}
+	}
+
+	qsort(sortedOperations, numberOfOperations, sizeof(FileOperation), compareSnapshotOperations);
+
+	freeKeySet(operationPositions);
+	operationPositions = createKeySet(numberOfOperations);
+	if (operationPositions == NULL)
+	{
+		goto failed;
+	}
+
+	for (int i = 0; i < numberOfOperations; i++)
+	{
+		insertKey(operationPositions, sortedOperations[i].id, i);
+	}
+
+	int numberOfAlternatives = 0;
+	for (int i = 0; i < HASH_TABLE_SIZE; i++)
+	{
+		for (Execution* aux = executions[i]->start; aux != NULL; aux = aux->next)
+		{
+			if (getKeyValue(operationPositions, aux->operationID) >= 0)
+			{
+				numberOfAlternatives++;
+			}
+		}
+	}
+
+	// disposio do bloco
+	long long size = alignSize(sizeof(ProblemSnapshotHeader));
+	ProblemSnapshotHeader layout;
+
+	memset(&layout, 0, sizeof(layout));
+	layout.magic = PROBLEM_SNAPSHOT_MAGIC;
+	layout.version = PROBLEM_SNAPSHOT_VERSION;
+	layout.numberOfJobs = numberOfJobs;
+	layout.numberOfOperations = numberOfOperations;
+	layout.numberOfAlternatives = numberOfAlternatives;
+	layout.numberOfMachines = numberOfMachines;
+	layout.jobIDsOffset = reserveSnapshotArray(&size, numberOfJobs);
+	layout.jobOperationStartsOffset = reserveSnapshotArray(&size, numberOfJobs + 1);
+	layout.operationIDsOffset = reserveSnapshotArray(&size, numberOfOperations);
+	layout.operationJobsOffset = reserveSnapshotArray(&size, numberOfOperations);
+	layout.operationAlternativeStartsOffset = reserveSnapshotArray(&size, numberOfOperations + 1);
+	layout.alternativeMachinesOffset = reserveSnapshotArray(&size, numberOfAlternatives);
+	layout.alternativeRuntimesOffset = reserveSnapshotArray(&size, numberOfAlternatives);
+	layout.machineIDsOffset = reserveSnapshotArray(&size, numberOfMachines);
+	layout.operationMinRuntimesOffset = reserveSnapshotArray(&size, numberOfOperations);
+	layout.operationMaxRuntimesOffset = reserveSnapshotArray(&size, numberOfOperations);
+	layout.jobMinTimesOffset = reserveSnapshotArray(&size, numberOfJobs);
+	layout.jobMaxTimesOffset = reserveSnapshotArray(&size, numberOfJobs);
+	layout.jobReleaseDatesOffset = reserveSnapshotArray(&size, numberOfJobs);
+	layout.jobDueDatesOffset = reserveSnapshotArray(&size, numberOfJobs);
+	layout.jobWeightsOffset = reserveSnapshotArray(&size, numberOfJobs);
+	layout.size = size;
+
+	snapshot->block = allocateAligned(size);
+	if (snapshot->block == NULL)
+	{
+		goto failed;
+	}
+
+	snapshot->size = size;
+	snapshot->isMapped = false;
+	memcpy(snapshot->block, &layout, sizeof(layout));
+	resolveSnapshotArrays(snapshot);
+
+	// os arrays so preenchidos atravs de apontadores sem const, apenas durante a compilao
+	char* block = (char*)snapshot->block;
+	ProblemSnapshotHeader* header = (ProblemSnapshotHeader*)block;
+	int* jobOperationStarts = (int*)(block + layout.jobOperationStartsOffset);
+	int* operationIDs = (int*)(block + layout.operationIDsOffset);
+	int* operationJobs = (int*)(block + layout.operationJobsOffset);
+	int* alternativeStarts = (int*)(block + layout.operationAlternativeStartsOffset);
+	int* alternativeMachines = (int*)(block + layout.alternativeMachinesOffset);
+	int* alternativeRuntimes = (int*)(block + layout.alternativeRuntimesOffset);
+	int* operationMinRuntimes = (int*)(block + layout.operationMinRuntimesOffset);
+	int* operationMaxRuntimes = (int*)(block + layout.operationMaxRuntimesOffset);
+	int* jobMinTimes = (int*)(block + layout.jobMinTimesOffset);
+	int* jobMaxTimes = (int*)(block + layout.jobMaxTimesOffset);
+	int* jobReleaseDates = (int*)(block + layout.jobReleaseDatesOffset);
+	int* jobDueDates = (int*)(block + layout.jobDueDatesOffset);
+	int* jobWeights = (int*)(block + layout.jobWeightsOffset);
+
+	memcpy(block + layout.jobIDsOffset, jobIDs, numberOfJobs * sizeof(int));
+	memcpy(block + layout.machineIDsOffset, machineIDs, numberOfMachines * sizeof(int));
+
+	// trabalhos que s aparecem nas operaes ficam com os valores por omisso de newJob
+	for (int j = 0; j < numberOfJobs; j++)
+	{
+		jobReleaseDates[j] = 0;
+		jobDueDates[j] = JOB_NO_DUE_DATE;
+		jobWeights[j] = 1;
+	}
+
+	for (Job* aux = jobs; aux != NULL; aux = aux->next)
+	{
+		int j = getKeyValue(jobPositions, aux->id);
+
+		jobReleaseDates[j] = aux->releaseDate;
+		jobDueDates[j] = aux->dueDate;
+		jobWeights[j] = aux->weight;
+	}
+
+	for (int i = 0; i < numberOfOperations; i++)
+	{
+		operationIDs[i] = sortedOperations[i].id;
+		operationJobs[i] = sortedOperations[i].jobID;
+		jobOperationStarts[sortedOperations[i].jobID + 1]++;
+	}
+
+	for (int j = 0; j < numberOfJobs; j++)
+	{
+		jobOperationStarts[j + 1] += jobOperationStarts[j];
+	}
+
+	// alternativas: contar por operao, calcular os incios e depois preencher
+	for (int i = 0; i < HASH_TABLE_SIZE; i++)
+	{
+		for (Execution* aux = executions[i]->start; aux != NULL; aux = aux->next)
+		{
+			int operation = getKeyValue(operationPositions, aux->operationID);
+			if (operation >= 0)
+			{
+				alternativeStarts[operation + 1]++;
+			}
+		}
+	}
+
+	for (int o = 0; o < numberOfOperations; o++)
+	{
+		alternativeStarts[o + 1] += alternativeStarts[o];
+		operationMinRuntimes[o] = alternativeStarts[o]; // usado temporariamente como posio de escrita
+	}
+
+	for (int i = 0; i < HASH_TABLE_SIZE; i++)
+	{
+		for (Execution* aux = executions[i]->start; aux != NULL; aux = aux->next)
+		{
+			int operation = getKeyValue(operationPositions, aux->operationID);
+			if (operation >= 0)
+			{
+				int position = operationMinRuntimes[operation]++;
+				alternativeMachines[position] = getKeyValue(machinePositions, aux->machineID);
+				alternativeRuntimes[position] = aux->runtime;
+			}
+		}
+	}
+
+	// ordenar as alternativas de cada operao pelo tempo (so poucas, ordenao por insero) e calcular os agregados
+	for (int o = 0; o < numberOfOperations; o++)
+	{
+		int first = alternativeStarts[o];
+		int last = alternativeStarts[o + 1];
+
+		for (int i = first + 1; i < last; i++)
+		{
+			int machine = alternativeMachines[i];
+			int runtime = alternativeRuntimes[i];
+			int k = i - 1;
+
+			while (k >= first && (alternativeRuntimes[k] > runtime || (alternativeRuntimes[k] == runtime && alternativeMachines[k] > machine)))
+			{
+				alternativeMachines[k + 1] = alternativeMachines[k];
+				alternativeRuntimes[k + 1] = alternativeRuntimes[k];
+				k--;
+			}
+
+			alternativeMachines[k + 1] = machine;
+			alternativeRuntimes[k + 1] = runtime;
+		}
+
+		operationMinRuntimes[o] = last > first ? alternativeRuntimes[first] : 0;
+		operationMaxRuntimes[o] = last > first ? alternativeRuntimes[last - 1] : 0;
+
+		jobMinTimes[operationJobs[o]] += operationMinRuntimes[o];
+		jobMaxTimes[operationJobs[o]] += operationMaxRuntimes[o];
+		header->totalMinWorkload += operationMinRuntimes[o];
+	}
+
+	for (int j = 0; j < numberOfJobs; j++)
+	{
+		if (jobMinTimes[j] > header->makespanLowerBound)
+		{
+			header->makespanLowerBound = jobMinTimes[j];
+		}
+	}
+
+	free(jobIDs);
+	free(machineIDs);
+	free(sortedOperations);
+	freeKeySet(jobPositions);
+	freeKeySet(machinePositions);
+	freeKeySet(operationPositions);
+
+	return snapshot;
+
+failed:
+	if (snapshot != NULL)
+	{
+		freeAligned(snapshot->block);
+		free(snapshot);
+	}
+	free(jobIDs);
+	free(machineIDs);
+	free(sortedOperations);
+	freeKeySet(jobPositions);
+	freeKeySet(machinePositions);
+	freeKeySet(operationPositions);
+
+	return NULL;
+}
+
+#pragma endregion
+
+
+#pragma region gravar e abrir imagem do problema
+
+/**
+* @brief	Gravar a imagem do problema em ficheiro binrio (o bloco  gravado tal como est em memria)
+* @param	fileName	Nome do ficheiro
+* @param	snapshot	Imagem do problema
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool writeProblemSnapshot(char fileName[], ProblemSnapshot* snapshot)
+{
+	if (snapshot == NULL)
+	{
+		return false;
+	}
+
+	FILE* file = NULL;
+
+	if ((file = fopen(fileName, "wb")) == NULL) // erro ao abrir o ficheiro
+	{
+		return false;
+	}
+
+	bool written = fwrite(snapshot->block, 1, (size_t)snapshot->size, file) == (size_t)snapshot->size;
+
+	fclose(file);
+
+	return written;
+}
+
+
+/**
+* @brief	Verificar se um array de incios (formato CSR) comea em 0, nunca diminui e acaba no total
+* @param	starts	Array com count + 1 incios
+* @param	count	Quantidade de grupos
+* @param	total	Quantidade de elementos de todos os grupos
+* @return	Booleano para o resultado da funo (se  vlido ou no)
+*/
+static bool isValidStarts(const int* starts, int count, int total)
+{
+	if (starts[0] != 0 || starts[count] != total)
+	{
+		return false;
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		if (starts[i] > starts[i + 1])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+/**
+* @brief	Verificar se todas as posies de um array esto em [0, limit)
+* @param	positions	Array de posies
+* @param	count		Quantidade de posies
+* @param	limit		Primeira posio invlida
+* @return	Booleano para o resultado da funo (se  vlido ou no)
+*/
+static bool isValidPositions(const int* positions, int count, int limit)
+{
+	for (int i = 0; i < count; i++)
+	{
+		if (positions[i] < 0 || positions[i] >= limit)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+/**
+* @brief	Verificar se o cabealho de um bloco  vlido, se todos os arrays cabem no bloco
+*			e se os ndices guardados nos arrays (incios das operaes e das alternativas, trabalho de cada operao
+*			e mquina de cada alternativa) no saem dos arrays a que se referem
+* @param	block	Bloco da imagem
+* @param	size	Tamanho do bloco
+* @return	Booleano para o resultado da funo (se  vlido ou no)
+*/
+static bool isValidSnapshot(const void* block, long long size)
+{
+	const ProblemSnapshotHeader* header = (const ProblemSnapshotHeader*)block;
+
+	if (size < (long long)sizeof(ProblemSnapshotHeader) || header->magic != PROBLEM_SNAPSHOT_MAGIC || header->version != PROBLEM_SNAPSHOT_VERSION || header->size != size)
+	{
+		return false;
+	}
+
+	if (header->numberOfJobs < 0 || header->numberOfOperations < 0 || header->numberOfAlternatives < 0 || header->numberOfMachines < 0)
+	{
+		return false;
+	}
+
+	long long offsets[] = {
+		header->jobIDsOffset, header->jobOperationStartsOffset, header->operationIDsOffset, header->operationJobsOffset,
+		header->operationAlternativeStartsOffset, header->alternativeMachinesOffset, header->alternativeRuntimesOffset, header->machineIDsOffset,
+		header->operationMinRuntimesOffset, header->operationMaxRuntimesOffset, header->jobMinTimesOffset, header->jobMaxTimesOffset,
+		header->jobReleaseDatesOffset, header->jobDueDatesOffset, header->jobWeightsOffset
+	};
+	long long counts[] = {
+		header->numberOfJobs, header->numberOfJobs + 1LL, header->numberOfOperations, header->numberOfOperations,
+		header->numberOfOperations + 1LL, header->numberOfAlternatives, header->numberOfAlternatives, header->numberOfMachines,
+		header->numberOfOperations, header->numberOfOperations, header->numberOfJobs, header->numberOfJobs,
+		header->numberOfJobs, header->numberOfJobs, header->numberOfJobs
+	};
+
+	for (int i = 0; i < (int)(sizeof(offsets) / sizeof(offsets[0])); i++)
+	{
+		if (offsets[i] < (long long)sizeof(ProblemSnapshotHeader) || offsets[i] % CACHE_LINE_SIZE != 0 || offsets[i] + counts[i] * (long long)sizeof(int) > size)
+		{
+			return false;
+		}
+	}
+
+	// o contedo tambm vem do ficheiro: um ndice errado levaria o avaliador e a simulao a ler fora dos arrays
+	const char* bytes = (const char*)block;
+
+	return isValidStarts((const int*)(bytes + header->jobOperationStartsOffset), header->numberOfJobs, header->numberOfOperations)
+		&& isValidStarts((const int*)(bytes + header->operationAlternativeStartsOffset), header->numberOfOperations, header->numberOfAlternatives)
+		&& isValidPositions((const int*)(bytes + header->operationJobsOffset), header->numberOfOperations, header->numberOfJobs)
+		&& isValidPositions((const int*)(bytes + header->alternativeMachinesOffset), header->numberOfAlternatives, header->numberOfMachines);
+}
+
+
+/**
+* @brief	Abrir uma imagem do problema gravada em ficheiro, projetando o ficheiro em memria (sem ler nem copiar os dados)
+* @param	fileName	Nome do ficheiro
+* @return	Imagem do problema (ou NULL se no foi possvel abrir ou o ficheiro no  vlido)
+*/
+ProblemSnapshot* openProblemSnapshot(char fileName[])
+{
+	ProblemSnapshot* snapshot = (ProblemSnapshot*)calloc(1, sizeof(ProblemSnapshot));
+	if (snapshot == NULL) // se no houver memria para alocar
+	{
+		return NULL;
+	}
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	LARGE_INTEGER fileSize;
+
+	if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+	{
+		if (file != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(file);
+		}
+		free(snapshot);
+		return NULL;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	void* block = mapping != NULL ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+
+	CloseHandle(file); // a projeo mantm o ficheiro aberto
+	if (mapping != NULL)
+	{
+		CloseHandle(mapping);
+	}
+
+	if (block == NULL)
+	{
+		free(snapshot);
+		return NULL;
+	}
+
+	snapshot->size = fileSize.QuadPart;
+#else
+	int file = open(fileName, O_RDONLY);
+	struct stat fileStat;
+
+	if (file < 0 || fstat(file, &fileStat) != 0 || fileStat.st_size == 0)
+	{
+		if (file >= 0)
+		{
+			close(file);
+		}
+		free(snapshot);
+		return NULL;
+	}
+
+	void* block = mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+	close(file); // a projeo mantm o ficheiro aberto
+
+	if (block == MAP_FAILED)
+	{
+		free(snapshot);
+		return NULL;
+	}
+
+	snapshot->size = (long long)fileStat.st_size;
+#endif
+
+	snapshot->block = block;
+	snapshot->isMapped = true;
+
+	if (!isValidSnapshot(block, snapshot->size))
+	{
+		closeProblemSnapshot(snapshot);
+		return NULL;
+	}
+
+	resolveSnapshotArrays(snapshot);
+
+	return snapshot;
+}
+
+
+/**
+* @brief	Fechar uma imagem do problema (compilada ou aberta de ficheiro) e libert-la da memria
+* @param	snapshot	Imagem do problema
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool closeProblemSnapshot(ProblemSnapshot* snapshot)
+{
+	if (snapshot == NULL)
+	{
+		return false;
+	}
+
+	if (snapshot->isMapped)
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(snapshot->block);
+#else
+		munmap(snapshot->block, (size_t)snapshot->size);
+#endif
+	}
+	else
+	{
+		freeAligned(snapshot->block);
+	}
+
+	free(snapshot);
+
+	return true;
+}
+
+#pragma endregion
+
+
+#pragma region consultar imagem do problema
+
+/**
+* @brief	Obter a posio de um trabalho na imagem (pesquisa binria, os trabalhos esto ordenados pelo identificador)
+* @param	snapshot	Imagem do problema
+* @param	jobID		Identificador do trabalho
+* @return	Posio do trabalho (ou -1 se no existir)
+*/
+int getJobIndex_AtSnapshot(ProblemSnapshot* snapshot, int jobID)
+{
+	if (snapshot == NULL)
+	{
+		return -1;
+	}
+
+	int low = 0;
+	int high = snapshot->header->numberOfJobs - 1;
+
+	while (low <= high)
+	{
+		int middle = low + (high - low) / 2;
+
+		if (snapshot->jobIDs[middle] == jobID)
+		{
+			return middle;
+		}
+
+		if (snapshot->jobIDs[middle] < jobID)
+		{
+			low = middle + 1;
+		}
+		else
+		{
+			high = middle - 1;
+		}
+	}
+
+	return -1;
+}
+
+
+/**
+* @brief	Obter o tempo mnimo necessrio para completar um trabalho, a partir da imagem
+* @param	snapshot	Imagem do problema
+* @param	jobID		Identificador do trabalho
+* @return	Quantidade de tempo (ou -1 se o trabalho no existir)
+*/
+int getMinTimeToCompleteJob_AtSnapshot(ProblemSnapshot* snapshot, int jobID)
+{
+	int job = getJobIndex_AtSnapshot(snapshot, jobID);
+
+	return job < 0 ? -1 : snapshot->jobMinTimes[job];
+}
+
+
+/**
+* @brief	Obter o tempo mximo necessrio para completar um trabalho, a partir da imagem
+* @param	snapshot	Imagem do problema
+* @param	jobID		Identificador do trabalho
+* @return	Quantidade de tempo (ou -1 se o trabalho no existir)
+*/
+int getMaxTimeToCompleteJob_AtSnapshot(ProblemSnapshot* snapshot, int jobID)
+{
+	int job = getJobIndex_AtSnapshot(snapshot, jobID);
+
+	return job < 0 ? -1 : snapshot->jobMaxTimes[job];
+}
+
+
+/**
+* @brief	Escolher a alternativa mais rpida (ou mais lenta) de cada operao de um trabalho, a partir da imagem.
+*			So devolvidas posies nos arrays de alternativas, sem copiar nem alocar memria
+* @param	snapshot		Imagem do problema
+* @param	jobID			Identificador do trabalho
+* @param	useMax			Se deve ser escolhida a alternativa mais lenta em vez da mais rpida
+* @param	alternatives	Array para a alternativa escolhida de cada operao (-1 se a operao no tiver alternativas)
+* @param	capacity		Capacidade do array
+* @return	Quantidade de operaes do trabalho (ou -1 se o trabalho no existir)
+*/
+static int getChosenAlternatives_AtSnapshot(ProblemSnapshot* snapshot, int jobID, bool useMax, int alternatives[], int capacity)
+{
+	int job = getJobIndex_AtSnapshot(snapshot, jobID);
+	if (job < 0)
+	{
+		return -1;
+	}
+
+	int first = snapshot->jobOperationStarts[job];
+	int count = snapshot->jobOperationStarts[job + 1] - first;
+
+	for (int i = 0; i < count && i < capacity; i++)
+	{
+		int operation = first + i;
+		int chosen = -1;
+
+		for (int a = snapshot->operationAlternativeStarts[operation]; a < snapshot->operationAlternativeStarts[operation + 1]; a++)
+		{
+			if (chosen < 0 || (useMax ? snapshot->alternativeRuntimes[a] > snapshot->alternativeRuntimes[chosen] : snapshot->alternativeRuntimes[a] < snapshot->alternativeRuntimes[chosen]))
+			{
+				chosen = a;
+			}
+		}
+
+		alternatives[i] = chosen;
+	}
+
+	return count;
+}
+
+
+/**
+* @brief	Obter a alternativa mais rpida de cada operao de um trabalho, a partir da imagem (sem alocar memria)
+* @param	snapshot		Imagem do problema
+* @param	jobID			Identificador do trabalho
+* @param	alternatives	Array para a posio da alternativa escolhida de cada operao, em alternativeMachines e alternativeRuntimes
+* @param	capacity		Capacidade do array
+* @return	Quantidade de operaes do trabalho (se for maior que capacity, o array ficou incompleto; -1 se o trabalho no existir)
+*/
+int getMinAlternatives_AtSnapshot(ProblemSnapshot* snapshot, int jobID, int alternatives[], int capacity)
+{
+	return getChosenAlternatives_AtSnapshot(snapshot, jobID, false, alternatives, capacity);
+}
+
+
+/**
+* @brief	Obter a alternativa mais lenta de cada operao de um trabalho, a partir da imagem (sem alocar memria)
+* @param	snapshot		Imagem do problema
+* @param	jobID			Identificador do trabalho
+* @param	alternatives	Array para a posio da alternativa escolhida de cada operao, em alternativeMachines e alternativeRuntimes
+* @param	capacity		Capacidade do array
+* @return	Quantidade de operaes do trabalho (se for maior que capacity, o array ficou incompleto; -1 se o trabalho no existir)
+*/
+int getMaxAlternatives_AtSnapshot(ProblemSnapshot* snapshot, int jobID, int alternatives[], int capacity)
+{
+	return getChosenAlternatives_AtSnapshot(snapshot, jobID, true, alternatives, capacity);
+}
+
+
+/**
+* @brief	Contar as operaes da imagem que no tm nenhuma alternativa (execuo).
+*			Uma imagem com operaes destas no pode ser planeada
+* @param	snapshot	Imagem do problema
+* @return	Quantidade de operaes sem alternativas (ou -1 se a imagem no existir)
+*/
+int countOperationsWithoutAlternatives_AtSnapshot(ProblemSnapshot* snapshot)
+{
+	if (snapshot == NULL)
+	{
+		return -1;
+	}
+
+	int count = 0;
+
+	for (int i = 0; i < snapshot->header->numberOfOperations; i++)
+	{
+		if (snapshot->operationAlternativeStarts[i] == snapshot->operationAlternativeStarts[i + 1])
+		{
+			count++;
+		}
+	}
+
+	return count;
+}
+
+#pragma endregion
@@ -0,0 +1,665 @@
+/**
+ * @brief	Ficheiro com as funes da cache de consultas (tempos dos trabalhos e das operaes)
+ * @file	querycache.c
+ * @author	Vnia Pereira
+ * @email	a19264@alunos.ipca.pt
+ * @date	2022
+ * @Disciplina Estruturas de Dados Avanadas
+ *
+ * -----------------
+ *
+ * Cada trabalho e cada operao tem um contador de verso, incrementado pelas funes insert*, update* e delete*
+ * sempre que alteram o trabalho, as suas operaes ou as execues de uma operao. Os contadores pertencem a
+ * cada cache: as funes de alterao percorrem as caches registadas (nenhuma, se no houver caches) e
+ * incrementam o contador de cada uma com uma operao atmica, sem bloqueios, porque tambm so chamadas pela
+ * tabela hash concorrente e pelas threads de leitura de ficheiros. Cada cache tem um nmero fixo de contadores
+ * (QUERY_VERSION_SLOTS) e um identificador usa o contador da posio calculada a partir dele: identificadores
+ * com o mesmo contador s obrigam a recalcular mais vezes, nunca devolvem um resultado desatualizado.
+ *
+ * Cada resultado da cache guarda as verses com que foi calculado: a do trabalho (ou da operao) e, nas
+ * consultas sobre trabalhos, a de cada operao do trabalho. Um resultado s  reutilizado se nenhuma destas
+ * verses tiver mudado, por isso uma alterao s execues de uma operao s obriga a recalcular as consultas
+ * que dependem dessa operao.
+ *
+ * A memria das entradas  limitada: quando  ultrapassada, so removidas as entradas usadas h mais tempo.
+ * Uma cache corresponde a um s conjunto de listas; se as listas forem substitudas sem passar pelas funes
+ * de alterao (por exemplo, ao ler de ficheiro com insertExecutionAtStart), a cache deve ser limpa com
+ * clearQueryCache. Uma cache no deve ser usada por vrias threads em simultneo, e s pode ser criada ou
+ * libertada quando nenhuma thread estiver a alterar as listas.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "header.h"
+
+
+#define QUERY_KEY(type, argument) (((long long)(type) << 32) | (unsigned int)(argument))
+
+
+#pragma region verses dos trabalhos e das operaes
+
+static QueryCache* volatile registeredCaches = NULL; // caches que recebem as alteraes
+static volatile long registryLock = 0;
+
+
+/**
+* @brief	Bloquear o registo de caches (espera ativa, s  usado ao criar e libertar caches)
+*/
+static void lockRegistry()
+{
+	while (!atomicCompareExchange(&registryLock, 0, 1))
+	{
+		yieldThread();
+	}
+}
+
+
+/**
+* @brief	Libertar o registo de caches
+*/
+static void unlockRegistry()
+{
+	atomicStore(&registryLock, 0);
+}
+
+
+/**
+* @brief	Acrescentar uma cache ao registo, para passar a receber as alteraes
+* @param	cache	Cache de consultas
+*/
+static void registerCache(QueryCache* cache)
+{
+	lockRegistry();
+
+	cache->nextCache = registeredCaches;
+	atomicExchangePointer((void* volatile*)&registeredCaches, cache); // as alteraes em curso veem a lista antiga ou a nova
+
+	unlockRegistry();
+}
+
+
+/**
+* @brief	Retirar uma cache do registo
+* @param	cache	Cache de consultas
+*/
+static void unregisterCache(QueryCache* cache)
+{
+	lockRegistry();
+
+	QueryCache* volatile* link = &registeredCaches;
+	while (*link != NULL && *link != cache)
+	{
+		link = &(*link)->nextCache;
+	}
+
+	if (*link == cache)
+	{
+		atomicExchangePointer((void* volatile*)link, cache->nextCache);
+	}
+
+	unlockRegistry();
+}
+
+
+/**
+* @brief	Calcular a posio do contador de verso de um identificador
+* @param	id		Identificador do trabalho ou da operao
+* @return	Posio no array de contadores
+*/
+static int getVersionSlot(int id)
+{
+	unsigned int hash = (unsigned int)id * 0x9E3779B1u;
+	hash ^= hash >> 16;
+
+	return (int)(hash & (QUERY_VERSION_SLOTS - 1));
+}
+
+
+/**
+* @brief	Registar uma alterao a um trabalho (dados do trabalho ou lista das suas operaes), em todas as caches
+* @param	jobID	Identificador do trabalho
+*/
+void bumpJobVersion(int jobID)
+{
+	int slot = getVersionSlot(jobID);
+
+	for (QueryCache* cache = (QueryCache*)atomicLoadPointer((void* volatile*)&registeredCaches); cache != NULL; cache = cache->nextCache)
+	{
+		atomicAdd(&cache->jobVersions[slot], 1);
+	}
+}
+
+
+/**
+* @brief	Registar uma alterao a uma operao (a prpria operao ou as suas execues), em todas as caches
+* @param	operationID		Identificador da operao
+*/
+void bumpOperationVersion(int operationID)
+{
+	int slot = getVersionSlot(operationID);
+
+	for (QueryCache* cache = (QueryCache*)atomicLoadPointer((void* volatile*)&registeredCaches); cache != NULL; cache = cache->nextCache)
+	{
+		atomicAdd(&cache->operationVersions[slot], 1);
+	}
+}
+
+
+/**
+* @brief	Obter a verso atual de um trabalho numa cache
+* @param	cache	Cache de consultas
+* @param	jobID	Identificador do trabalho
+* @return	Verso do trabalho (0 se no houver cache)
+*/
+int getJobVersion(QueryCache* cache, int jobID)
+{
+	return cache != NULL ? (int)(atomicLoad(&cache->jobVersions[getVersionSlot(jobID)]) & 0x7FFFFFFF) : 0;
+}
+
+
+/**
+* @brief	Obter a verso atual de uma operao numa cache
+* @param	cache			Cache de consultas
+* @param	operationID		Identificador da operao
+* @return	Verso da operao (0 se no houver cache)
+*/
+int getOperationVersion(QueryCache* cache, int operationID)
+{
+	return cache != NULL ? (int)(atomicLoad(&cache->operationVersions[getVersionSlot(operationID)]) & 0x7FFFFFFF) : 0;
+}
+
+#pragma endregion
+
+
+#pragma region entradas da cache
+
+/**
+* @brief	Obter a memria ocupada por uma entrada da cache
+*/
+static long long getEntryBytes(QueryCacheEntry* entry)
+{
+	return (long long)sizeof(QueryCacheEntry) + (long long)entry->numberOfDependencies * sizeof(QueryDependency);
+}
+
+
+/**
+* @brief	Desligar uma entrada da lista de utilizao
+*/
+static void unlinkEntry(QueryCache* cache, int position)
+{
+	QueryCacheEntry* entry = &cache->entries[position];
+
+	if (entry->newer >= 0)
+	{
+		cache->entries[entry->newer].older = entry->older;
+	}
+	else
+	{
+		cache->newest = entry->older;
+	}
+
+	if (entry->older >= 0)
+	{
+		cache->entries[entry->older].newer = entry->newer;
+	}
+	else
+	{
+		cache->oldest = entry->newer;
+	}
+}
+
+
+/**
+* @brief	Ligar uma entrada como a usada mais recentemente
+*/
+static void linkEntryAsNewest(QueryCache* cache, int position)
+{
+	QueryCacheEntry* entry = &cache->entries[position];
+
+	entry->newer = -1;
+	entry->older = cache->newest;
+
+	if (cache->newest >= 0)
+	{
+		cache->entries[cache->newest].newer = position;
+	}
+	else
+	{
+		cache->oldest = position;
+	}
+
+	cache->newest = position;
+}
+
+
+/**
+* @brief	Remover uma entrada da cache, deixando a posio livre
+*/
+static void removeEntry(QueryCache* cache, int position)
+{
+	QueryCacheEntry* entry = &cache->entries[position];
+
+	unlinkEntry(cache, position);
+	removeKey(cache->index, entry->key);
+
+	cache->stats.bytes -= getEntryBytes(entry);
+	cache->stats.numberOfEntries--;
+
+	free(entry->dependencies);
+	entry->dependencies = NULL;
+	entry->numberOfDependencies = 0;
+
+	entry->newer = cache->firstFree;
+	cache->firstFree = position;
+}
+
+
+/**
+* @brief	Remover as entradas usadas h mais tempo at a memria ocupada estar dentro do limite
+*/
+static void evictEntries(QueryCache* cache)
+{
+	while (cache->stats.bytes > cache->maxBytes && cache->oldest >= 0)
+	{
+		removeEntry(cache, cache->oldest);
+		cache->stats.evictions++;
+	}
+}
+
+
+/**
+* @brief	Obter uma posio livre no array de entradas, aumentando-o se for preciso
+* @return	Posio livre (ou -1 se no houver memria)
+*/
+static int getFreeEntry(QueryCache* cache)
+{
+	if (cache->firstFree < 0)
+	{
+		int capacity = cache->capacity * 2;
+		QueryCacheEntry* entries = (QueryCacheEntry*)realloc(cache->entries, capacity * sizeof(QueryCacheEntry));
+		if (entries == NULL) // se no houver memria para alocar
+		{
+			return -1;
+		}
+
+		for (int i = cache->capacity; i < capacity; i++)
+		{
+			entries[i].dependencies = NULL;
+			entries[i].numberOfDependencies = 0;
+			entries[i].newer = i + 1 < capacity ? i + 1 : -1;
+		}
+
+		cache->firstFree = cache->capacity;
+		cache->entries = entries;
+		cache->capacity = capacity;
+	}
+
+	int position = cache->firstFree;
+	cache->firstFree = cache->entries[position].newer;
+
+	return position;
+}
+
+
+/**
+* @brief	Guardar um resultado na cache (a cache fica com as dependncias)
+*/
+static void storeEntry(QueryCache* cache, long long key, int version, double result, QueryDependency* dependencies, int numberOfDependencies, long long computeMicroseconds)
+{
+	int position = getFreeEntry(cache);
+	if (position < 0 || !insertKey(cache->index, key, position))
+	{
+		if (position >= 0)
+		{
+			cache->entries[position].newer = cache->firstFree;
+			cache->firstFree = position;
+		}
+		free(dependencies);
+		return;
+	}
+
+	QueryCacheEntry* entry = &cache->entries[position];
+	entry->key = key;
+	entry->version = version;
+	entry->result = result;
+	entry->computeMicroseconds = computeMicroseconds;
+	entry->dependencies = dependencies;
+	entry->numberOfDependencies = numberOfDependencies;
+
+	linkEntryAsNewest(cache, position);
+
+	cache->stats.bytes += getEntryBytes(entry);
+	cache->stats.numberOfEntries++;
+
+	evictEntries(cache);
+}
+
+
+/**
+* @brief	Procurar um resultado vlido na cache; as entradas desatualizadas so removidas
+* @param	cache		Cache de consultas
+* @param	key			Chave da consulta
+* @param	version		Verso atual do trabalho (ou da operao) da consulta
+* @param	result		Apontador para o resultado encontrado
+* @return	Booleano para o resultado da funo (se encontrou ou no)
+*/
+static bool lookupEntry(QueryCache* cache, long long key, int version, double* result)
+{
+	int position = getKeyValue(cache->index, key);
+	if (position < 0) // se a consulta no estiver na cache
+	{
+		cache->stats.misses++;
+		return false;
+	}
+
+	QueryCacheEntry* entry = &cache->entries[position];
+	bool valid = entry->version == version;
+
+	for (int i = 0; valid && i < entry->numberOfDependencies; i++)
+	{
+		valid = getOperationVersion(cache, entry->dependencies[i].operationID) == entry->dependencies[i].version;
+	}
+
+	if (!valid) // calculado com verses antigas
+	{
+		removeEntry(cache, position);
+		cache->stats.staleEntries++;
+		cache->stats.misses++;
+		return false;
+	}
+
+	unlinkEntry(cache, position);
+	linkEntryAsNewest(cache, position);
+
+	cache->stats.hits++;
+	cache->stats.savedMicroseconds += entry->computeMicroseconds;
+	*result = entry->result;
+
+	return true;
+}
+
+#pragma endregion
+
+
+#pragma region trabalhar com a cache de consultas
+
+/**
+* @brief	Criar cache de consultas vazia
+* @param	maxBytes	Memria mxima ocupada pelas entradas (QUERY_CACHE_DEFAULT_BYTES se for 0 ou negativa)
+* @return	Cache de consultas criada (ou NULL se no houver memria)
+*/
+QueryCache* createQueryCache(long long maxBytes)
+{
+	QueryCache* cache = (QueryCache*)calloc(1, sizeof(QueryCache));
+	if (cache == NULL) // se no houver memria para alocar
+	{
+		return NULL;
+	}
+
+	cache->entries = (QueryCacheEntry*)malloc(QUERY_CACHE_INITIAL_ENTRIES * sizeof(QueryCacheEntry));
+	cache->index = createKeySet(QUERY_CACHE_INITIAL_ENTRIES);
+	cache->jobVersions = (volatile long*)calloc(QUERY_VERSION_SLOTS, sizeof(long));
+	cache->operationVersions = (volatile long*)calloc(QUERY_VERSION_SLOTS, sizeof(long));
+
+	if (cache->entries == NULL || cache->index == NULL || cache->jobVersions == NULL || cache->operationVersions == NULL)
+	{
+		free(cache->entries);
+		freeKeySet(cache->index);
+		free((void*)cache->jobVersions);
+		free((void*)cache->operationVersions);
+		free(cache);
+		return NULL;
+	}
+
+	cache->capacity = QUERY_CACHE_INITIAL_ENTRIES;
+	cache->maxBytes = maxBytes > 0 ? maxBytes : QUERY_CACHE_DEFAULT_BYTES;
+	cache->newest = -1;
+	cache->oldest = -1;
+	cache->firstFree = 0;
+
+	for (int i = 0; i < cache->capacity; i++)
+	{
+		cache->entries[i].dependencies = NULL;
+		cache->entries[i].numberOfDependencies = 0;
+		cache->entries[i].newer = i + 1 < cache->capacity ? i + 1 : -1;
+	}
+
+	registerCache(cache);
+
+	return cache;
+}
+
+
+/**
+* @brief	Remover todas as entradas da cache de consultas (as estatsticas de acertos so mantidas)
+* @param	cache	Cache de consultas
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool clearQueryCache(QueryCache* cache)
+{
+	if (cache == NULL)
+	{
+		return false;
+	}
+
+	while (cache->newest >= 0)
+	{
+		removeEntry(cache, cache->newest);
+	}
+
+	return true;
+}
+
+
+/**
+* @brief	Libertar a cache de consultas da memria, retirando-a do registo (nenhuma thread pode estar a alterar as listas)
+* @param	cache	Cache de consultas
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool freeQueryCache(QueryCache* cache)
+{
+	if (cache == NULL)
+	{
+		return false;
+	}
+
+	unregisterCache(cache);
+	clearQueryCache(cache);
+
+	free(cache->entries);
+	freeKeySet(cache->index);
+	free((void*)cache->jobVersions);
+	free((void*)cache->operationVersions);
+	free(cache);
+
+	return true;
+}
+
+
+/**
+* @brief	Obter o tempo mnimo ou mximo para completar um trabalho, usando a cache se o resultado ainda for vlido
+* @param	cache			Cache de consultas
+* @param	operations		Lista de operaes
+* @param	executions		Lista de execues
+* @param	jobID			Identificador do trabalho
+* @param	type			QUERY_MIN_JOB_TIME ou QUERY_MAX_JOB_TIME
+* @return	Quantidade de tempo (ou -1 se as listas estiverem vazias)
+*/
+static int getTimeToCompleteJob_Cached(QueryCache* cache, Operation* operations, Execution* executions, int jobID, QueryType type)
+{
+	if (operations == NULL || executions == NULL) // se as listas estiverem vazias
+	{
+		return -1;
+	}
+
+	long long key = QUERY_KEY(type, jobID);
+	int version = getJobVersion(cache, jobID);
+	double result;
+
+	if (cache != NULL && lookupEntry(cache, key, version, &result))
+	{
+		return (int)result;
+	}
+
+	// verses das operaes do trabalho, lidas antes do clculo
+	int numberOfDependencies = 0;
+	for (Operation* aux = operations; aux != NULL; aux = aux->next)
+	{
+		if (aux->jobID == jobID)
+		{
+			numberOfDependencies++;
+		}
+	}
+
+	QueryDependency* dependencies = NULL;
+	if (cache != NULL && numberOfDependencies > 0)
+	{
+		dependencies = (QueryDependency*)malloc(numberOfDependencies * sizeof(QueryDependency));
+		if (dependencies == NULL) // sem memria, o resultado  calculado mas no  guardado
+		{
+			cache = NULL;
+		}
+	}
+
+	if (dependencies != NULL)
+	{
+		int i = 0;
+		for (Operation* aux = operations; aux != NULL; aux = aux->next)
+		{
+			if (aux->jobID == jobID)
+			{
+				dependencies[i].operationID = aux->id;
+				dependencies[i].version = getOperationVersion(cache, aux->id);
+				i++;
+			}
+		}
+	}
+
+	long long start = getTimeMicroseconds();
+
+	int numberOfChosen;
+	int time = type == QUERY_MIN_JOB_TIME
+		? getMinTimeToCompleteJob_ToArray(operations, executions, jobID, NULL, 0, &numberOfChosen)
+		: getMaxTimeToCompleteJob_ToArray(operations, executions, jobID, NULL, 0, &numberOfChosen);
+
+	long long elapsed = getTimeMicroseconds() - start;
+
+	if (cache != NULL)
+	{
+		cache->stats.computeMicroseconds += elapsed;
+		storeEntry(cache, key, version, time, dependencies, numberOfDependencies, elapsed);
+	}
+
+	return time;
+}
+
+
+/**
+* @brief	Obter o mnimo de tempo necessrio para completar um trabalho, usando a cache se o resultado ainda for vlido
+* @param	cache			Cache de consultas (NULL para calcular sempre)
+* @param	operations		Lista de operaes
+* @param	executions		Lista de execues
+* @param	jobID			Identificador do trabalho
+* @return	Quantidade de tempo
+*/
+int getMinTimeToCompleteJob_Cached(QueryCache* cache, Operation* operations, Execution* executions, int jobID)
+{
+	return getTimeToCompleteJob_Cached(cache, operations, executions, jobID, QUERY_MIN_JOB_TIME);
+}
+
+
+/**
+* @brief	Obter o mximo de tempo necessrio para completar um trabalho, usando a cache se o resultado ainda for vlido
+* @param	cache			Cache de consultas (NULL para calcular sempre)
+* @param	operations		Lista de operaes
+* @param	executions		Lista de execues
+* @param	jobID			Identificador do trabalho
+* @return	Quantidade de tempo
+*/
+int getMaxTimeToCompleteJob_Cached(QueryCache* cache, Operation* operations, Execution* executions, int jobID)
+{
+	return getTimeToCompleteJob_Cached(cache, operations, executions, jobID, QUERY_MAX_JOB_TIME);
+}
+
+
+/**
+* @brief	Obter a mdia de tempo necessrio para completar uma operao, usando a cache se o resultado ainda for vlido
+* @param	cache			Cache de consultas (NULL para calcular sempre)
+* @param	executions		Lista de execues
+* @param	operationID		Identificador da operao
+* @return	Valor da mdia de tempo
+*/
+float getAverageTimeToCompleteOperation_Cached(QueryCache* cache, Execution* executions, int operationID)
+{
+	if (executions == NULL) // se a lista estiver vazia
+	{
+		return -1.0f;
+	}
+
+	long long key = QUERY_KEY(QUERY_AVERAGE_OPERATION_TIME, operationID);
+	int version = getOperationVersion(cache, operationID);
+	double result;
+
+	if (cache != NULL && lookupEntry(cache, key, version, &result))
+	{
+		return (float)result;
+	}
+
+	long long start = getTimeMicroseconds();
+	float average = getAverageTimeToCompleteOperation(executions, operationID);
+	long long elapsed = getTimeMicroseconds() - start;
+
+	if (cache != NULL)
+	{
+		cache->stats.computeMicroseconds += elapsed;
+		storeEntry(cache, key, version, average, NULL, 0, elapsed);
+	}
+
+	return average;
+}
+
+
+/**
+* @brief	Obter as estatsticas da cache de consultas
+* @param	cache	Cache de consultas
+* @param	stats	Apontador para as estatsticas calculadas
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool getQueryCacheStats(QueryCache* cache, QueryCacheStats* stats)
+{
+	if (cache == NULL || stats == NULL)
+	{
+		return false;
+	}
+
+	*stats = cache->stats;
+	stats->maxBytes = cache->maxBytes;
+
+	long long queries = stats->hits + stats->misses;
+	stats->hitRate = queries > 0 ? (float)stats->hits / queries : 0.0f;
+
+	return true;
+}
+
+
+/**
+* @brief	Mostrar as estatsticas da cache de consultas na consola
+* @param	stats	Estatsticas da cache
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool displayQueryCacheStats(QueryCacheStats* stats)
+{
+	if (stats == NULL)
+	{
+		return false;
+	}
+
+	printf("Consultas: %lld, Acertos: %lld (%.1f%%), Falhas: %lld (desatualizadas: %lld)\n", stats->hits + stats->misses, stats->hits, stats->hitRate * 100.0f, stats->misses, stats->staleEntries);
+	printf("Entradas: %d, Memria: %lld de %lld bytes, Removidas por falta de memria: %lld\n", stats->numberOfEntries, stats->bytes, stats->maxBytes, stats->evictions);
+	printf("Tempo de clculo: %lld us, Tempo poupado: %lld us\n", stats->computeMicroseconds, stats->savedMicroseconds);
+
+	return true;
+}
+
+#pragma endregion
@@ -0,0 +1,746 @@
+/**
+ * @brief	Ficheiro com as funes dos cenrios de planeamento (verses do modelo com partilha de estrutura)
+ * @file	scenario.c
+ * @author	Vnia Pereira
+ * @email	a19264@alunos.ipca.pt
+ * @date	2022
+ * @Disciplina Estruturas de Dados Avanadas
+ *
+ * -----------------
+ *
+ * Os trabalhos, operaes e execues de um cenrio so guardados em rvores AVL persistentes: um n nunca  alterado
+ * depois de criado. Uma alterao copia apenas o caminho da raiz at ao n alterado (O(log n) ns) e partilha o resto
+ * da rvore com a verso anterior. Assim, criar uma cpia de um cenrio (fork)  O(1): basta partilhar as razes.
+ *
+ * Cada n conta quantos pais e razes o referenciam, e  libertado quando deixa de ser referenciado.
+ * As contagens so atmicas, por isso cenrios que partilham ns podem ser usados em threads diferentes
+ * (cada cenrio s deve ser alterado por uma thread de cada vez).
+ *
+ * Chaves: trabalhos pelo identificador, operaes pelo identificador (valor = trabalho) e
+ * execues por EXECUTION_KEY(operao, mquina) (valor = tempo), o que deixa as execues de uma operao seguidas.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <limits.h>
+#include "header.h"
+
+
+#pragma region rvore AVL persistente
+
+/**
+* @brief	Acrescentar uma referncia a um n
+* @param	node	N (pode ser NULL)
+* @return	O prprio n
+*/
+static PersistentNode* retainNode(PersistentNode* node)
+{
+	if (node != NULL)
+	{
+		atomicAdd(&node->references, 1);
+	}
+
+	return node;
+}
+
+
+/**
+* @brief	Retirar uma referncia a um n, libertando-o (e as referncias aos filhos) quando deixar de ser referenciado
+* @param	node	N (pode ser NULL)
+*/
+static void releaseNode(PersistentNode* node)
+{
+	while (node != NULL && atomicAdd(&node->references, -1) == 0)
+	{
+		PersistentNode* right = node->right;
+
+		releaseNode(node->left);
+		free(node);
+
+		node = right; // o filho direito  libertado no ciclo, para limitar a recursividade
+	}
+}
+
+
+/**
+* @brief	Obter a altura de uma rvore
+*/
+static int getHeight(PersistentNode* node)
+{
+	return node != NULL ? node->height : 0;
+}
+
+
+/**
+* @brief	Criar um n novo. O n fica com as referncias aos filhos que so passadas
+* @param	key		Chave
+* @param	value	Valor
+* @param	left	Subrvore esquerda (referncia passada ao novo n)
+* @param	right	Subrvore direita (referncia passada ao novo n)
+* @return	Novo n, com uma referncia (ou NULL se no houver memria)
+*/
+static PersistentNode* newPersistentNode(long long key, int value, PersistentNode* left, PersistentNode* right)
+{
+	PersistentNode* node = (PersistentNode*)malloc(sizeof(PersistentNode));
+	if (node == NULL) // se no houver memria para alocar
+	{
+		releaseNode(left);
+		releaseNode(right);
+		return NULL;
+	}
+
+	node->key = key;
+	node->value = value;
+	node->left = left;
+	node->right = right;
+	node->height = 1 + (getHeight(left) > getHeight(right) ? getHeight(left) : getHeight(right));
+	node->references = 1;
+
+	return node;
+}
+
+
+/**
+* @brief	Criar um n equilibrado com a chave, o valor e as subrvores dadas (com rotaes se a diferena de alturas for 2)
+* @param	key		Chave
+* @param	value	Valor
+* @param	left	Subrvore esquerda (referncia passada ao resultado)
+* @param	right	Subrvore direita (referncia passada ao resultado)
+* @return	Nova rvore equilibrada, com uma referncia
+*/
+static PersistentNode* balanceNode(long long key, int value, PersistentNode* left, PersistentNode* right)
+{
+	PersistentNode* result = NULL;
+
+	if (getHeight(left) > getHeight(right) + 1)
+	{
+		if (getHeight(left->left) >= getHeight(left->right)) // rotao simples  direita
+		{
+			result = newPersistentNode(left->key, left->value, retainNode(left->left),
+				newPersistentNode(key, value, retainNode(left->right), right));
+		}
+		else // rotao dupla (esquerda-direita)
+		{
+			PersistentNode* middle = left->right;
+			result = newPersistentNode(middle->key, middle->value,
+				newPersistentNode(left->key, left->value, retainNode(left->left), retainNode(middle->left)),
+				newPersistentNode(key, value, retainNode(middle->right), right));
+		}
+
+		releaseNode(left);
+	}
+	else if (getHeight(right) > getHeight(left) + 1)
+	{
+		if (getHeight(right->right) >= getHeight(right->left)) // rotao simples  esquerda
+		{
+			result = newPersistentNode(right->key, right->value,
+				newPersistentNode(key, value, left, retainNode(right->left)), retainNode(right->right));
+		}
+		else // rotao dupla (direita-esquerda)
+		{
+			PersistentNode* middle = right->left;
+			result = newPersistentNode(middle->key, middle->value,
+				newPersistentNode(key, value, left, retainNode(middle->left)),
+				newPersistentNode(right->key, right->value, retainNode(middle->right), retainNode(right->right)));
+		}
+
+		releaseNode(right);
+	}
+	else
+	{
+		result = newPersistentNode(key, value, left, right);
+	}
+
+	return result;
+}
+
+
+/**
+* @brief	Procurar uma chave numa rvore
+* @param	node	rvore
+* @param	key		Chave
+* @return	N com a chave (ou NULL se no existir)
+*/
+static PersistentNode* searchPersistentNode(PersistentNode* node, long long key)
+{
+	while (node != NULL && node->key != key)
+	{
+		node = key < node->key ? node->left : node->right;
+	}
+
+	return node;
+}
+
+
+/**
+* @brief	Obter uma nova verso da rvore com a chave inserida (ou com o valor substitudo, se j existir).
+*			A rvore original no  alterada
+* @param	node	rvore original
+* @param	key		Chave
+* @param	value	Valor
+* @return	Nova verso da rvore, com uma referncia
+*/
+static PersistentNode* insertPersistentNode(PersistentNode* node, long long key, int value)
+{
+	if (node == NULL)
+	{
+		return newPersistentNode(key, value, NULL, NULL);
+	}
+
+	if (key < node->key)
+	{
+		return balanceNode(node->key, node->value, insertPersistentNode(node->left, key, value), retainNode(node->right));
+	}
+	if (key > node->key)
+	{
+		return balanceNode(node->key, node->value, retainNode(node->left), insertPersistentNode(node->right, key, value));
+	}
+
+	return newPersistentNode(key, value, retainNode(node->left), retainNode(node->right));
+}
+
+
+/**
+* @brief	Obter uma nova verso da rvore sem o menor n
+* @param	node	rvore original (no vazia)
+* @return	Nova verso da rvore, com uma referncia
+*/
+static PersistentNode* deleteMinPersistentNode(PersistentNode* node)
+{
+	if (node->left == NULL)
+	{
+		return retainNode(node->right);
+	}
+
+	return balanceNode(node->key, node->value, deleteMinPersistentNode(node->left), retainNode(node->right));
+}
+
+
+/**
+* @brief	Obter uma nova verso da rvore sem uma chave que existe na rvore
+* @param	node	rvore original
+* @param	key		Chave (tem de existir)
+* @return	Nova verso da rvore, com uma referncia
+*/
+static PersistentNode* deletePersistentNode(PersistentNode* node, long long key)
+{
+	if (key < node->key)
+	{
+		return balanceNode(node->key, node->value, deletePersistentNode(node->left, key), retainNode(node->right));
+	}
+	if (key > node->key)
+	{
+		return balanceNode(node->key, node->value, retainNode(node->left), deletePersistentNode(node->right, key));
+	}
+
+	if (node->left == NULL)
+	{
+		return retainNode(node->right);
+	}
+	if (node->right == NULL)
+	{
+		return retainNode(node->left);
+	}
+
+	PersistentNode* successor = node->right;
+	while (successor->left != NULL)
+	{
+		successor = successor->left;
+	}
+
+	return balanceNode(successor->key, successor->value, retainNode(node->left), deleteMinPersistentNode(node->right));
+}
+
+
+/**
+* @brief	Substituir uma raiz por uma nova verso, libertando a referncia  verso anterior
+* @param	root		Apontador para a raiz
+* @param	newRoot		Nova verso (com uma referncia)
+*/
+static void replaceRoot(PersistentNode** root, PersistentNode* newRoot)
+{
+	PersistentNode* oldRoot = *root;
+
+	*root = newRoot;
+	releaseNode(oldRoot);
+}
+
+
+/**
+* @brief	Percorrer por ordem crescente os ns com chave num intervalo
+* @param	node		rvore
+* @param	low			Menor chave do intervalo
+* @param	high		Maior chave do intervalo
+* @param	function	Funo chamada para cada n
+* @param	argument	Argumento passado  funo
+*/
+static void visitRange(PersistentNode* node, long long low, long long high, void (*function)(PersistentNode*, void*), void* argument)
+{
+	while (node != NULL)
+	{
+		if (node->key < low)
+		{
+			node = node->right;
+		}
+		else if (node->key > high)
+		{
+			node = node->left;
+		}
+		else
+		{
+			visitRange(node->left, low, high, function, argument);
+			function(node, argument);
+			node = node->right;
+		}
+	}
+}
+
+#pragma endregion
+
+
+#pragma region trabalhar com cenrios
+
+/**
+* @brief	Criar um cenrio vazio
+* @return	Cenrio criado (ou NULL se no houver memria)
+*/
+Scenario* createScenario()
+{
+	Scenario* scenario = (Scenario*)calloc(1, sizeof(Scenario));
+
+	return scenario;
+}
+
+
+/**
+* @brief	Criar um cenrio com os trabalhos, operaes e execues do modelo atual
+* @param	jobs			Lista de trabalhos
+* @param	operations		Lista de operaes
+* @param	executions		Tabela hash das execues
+* @return	Cenrio criado (ou NULL se no houver memria)
+*/
+Scenario* createScenario_FromModel(Job* jobs, Operation* operations, ExecutionNode* executions[])
+{
+	Scenario* scenario = createScenario();
+	if (scenario == NULL)
+	{
+		return NULL;
+	}
+
+	for (Job* aux = jobs; aux != NULL; aux = aux->next)
+	{
+		insertJob_AtScenario(scenario, aux->id);
+	}
+
+	for (Operation* aux = operations; aux != NULL; aux = aux->next)
+	{
+		insertOperation_AtScenario(scenario, aux->id, aux->jobID);
+	}
+
+	for (int i = 0; i < HASH_TABLE_SIZE; i++)
+	{
+		for (Execution* aux = executions[i]->start; aux != NULL; aux = aux->next)
+		{
+			insertExecution_AtScenario(scenario, aux->operationID, aux->machineID, aux->runtime);
+		}
+	}
+
+	return scenario;
+}
+
+
+/**
+* @brief	Criar uma cpia de um cenrio em tempo constante (as rvores so partilhadas at serem alteradas)
+* @param	scenario	Cenrio original
+* @return	Novo cenrio (ou NULL se no houver memria)
+*/
+Scenario* forkScenario(Scenario* scenario)
+{
+	if (scenario == NULL)
+	{
+		return NULL;
+	}
+
+	Scenario* fork = (Scenario*)malloc(sizeof(Scenario));
+	if (fork == NULL) // se no houver memria para alocar
+	{
+		return NULL;
+	}
+
+	*fork = *scenario;
+	retainNode(fork->jobs);
+	retainNode(fork->operations);
+	retainNode(fork->executions);
+
+	return fork;
+}
+
+
+/**
+* @brief	Libertar um cenrio da memria (os ns partilhados com outros cenrios continuam em memria)
+* @param	scenario	Cenrio
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool freeScenario(Scenario* scenario)
+{
+	if (scenario == NULL)
+	{
+		return false;
+	}
+
+	releaseNode(scenario->jobs);
+	releaseNode(scenario->operations);
+	releaseNode(scenario->executions);
+	free(scenario);
+
+	return true;
+}
+
+
+/**
+* @brief	Inserir um trabalho num cenrio
+* @param	scenario	Cenrio
+* @param	jobID		Identificador do trabalho
+* @return	Booleano para o resultado da funo (falso se o trabalho j existir)
+*/
+bool insertJob_AtScenario(Scenario* scenario, int jobID)
+{
+	if (scenario == NULL || searchPersistentNode(scenario->jobs, jobID) != NULL)
+	{
+		return false;
+	}
+
+	replaceRoot(&scenario->jobs, insertPersistentNode(scenario->jobs, jobID, 0));
+	scenario->numberOfJobs++;
+
+	return true;
+}
+
+
+/**
+* @brief	Inserir uma operao num cenrio
+* @param	scenario		Cenrio
+* @param	operationID		Identificador da operao
+* @param	jobID			Identificador do trabalho da operao
+* @return	Booleano para o resultado da funo (falso se a operao j existir)
+*/
+bool insertOperation_AtScenario(Scenario* scenario, int operationID, int jobID)
+{
+	if (scenario == NULL || searchPersistentNode(scenario->operations, operationID) != NULL)
+	{
+		return false;
+	}
+
+	replaceRoot(&scenario->operations, insertPersistentNode(scenario->operations, operationID, jobID));
+	scenario->numberOfOperations++;
+
+	return true;
+}
+
+
+/**
+* @brief	Inserir uma execuo num cenrio
+* @param	scenario		Cenrio
+* @param	operationID		Identificador da operao
+* @param	machineID		Identificador da mquina
+* @param	runtime			Unidades de tempo
+* @return	Booleano para o resultado da funo (falso se a execuo j existir)
+*/
+bool insertExecution_AtScenario(Scenario* scenario, int operationID, int machineID, int runtime)
+{
+	long long key = EXECUTION_KEY(operationID, machineID);
+
+	if (scenario == NULL || searchPersistentNode(scenario->executions, key) != NULL)
+	{
+		return false;
+	}
+
+	replaceRoot(&scenario->executions, insertPersistentNode(scenario->executions, key, runtime));
+	scenario->numberOfExecutions++;
+
+	return true;
+}
+
+
+/**
+* @brief	Atualizar o tempo de uma execuo de um cenrio (as outras verses no so alteradas)
+* @param	scenario		Cenrio
+* @param	operationID		Identificador da operao
+* @param	machineID		Identificador da mquina
+* @param	runtime			Unidades de tempo
+* @return	Booleano para o resultado da funo (falso se a execuo no existir)
+*/
+bool updateRuntime_AtScenario(Scenario* scenario, int operationID, int machineID, int runtime)
+{
+	long long key = EXECUTION_KEY(operationID, machineID);
+
+	if (scenario == NULL || searchPersistentNode(scenario->executions, key) == NULL)
+	{
+		return false;
+	}
+
+	replaceRoot(&scenario->executions, insertPersistentNode(scenario->executions, key, runtime));
+
+	return true;
+}
+
+
+/**
+* @brief	Remover uma execuo de um cenrio
+* @param	scenario		Cenrio
+* @param	operationID		Identificador da operao
+* @param	machineID		Identificador da mquina
+* @return	Booleano para o resultado da funo (falso se a execuo no existir)
+*/
+bool deleteExecution_AtScenario(Scenario* scenario, int operationID, int machineID)
+{
+	long long key = EXECUTION_KEY(operationID, machineID);
+
+	if (scenario == NULL || searchPersistentNode(scenario->executions, key) == NULL)
+	{
+		return false;
+	}
+
+	replaceRoot(&scenario->executions, deletePersistentNode(scenario->executions, key));
+	scenario->numberOfExecutions--;
+
+	return true;
+}
+
+
+/**
+ * @brief	Lista de chaves recolhidas ao percorrer uma rvore
+ */
+typedef struct ScenarioKeys
+{
+	long long* keys;
+	int count;
+	int capacity;
+	int machineID; // mquina procurada (quando a recolha  por mquina)
+} ScenarioKeys;
+
+
+/**
+* @brief	Acrescentar a chave de um n  lista de chaves
+*/
+static void collectKey(PersistentNode* node, void* argument)
+{
+	ScenarioKeys* list = (ScenarioKeys*)argument;
+
+	if (list->count == list->capacity)
+	{
+		int capacity = list->capacity > 0 ? list->capacity * 2 : 16;
+		long long* keys = (long long*)realloc(list->keys, capacity * sizeof(long long));
+		if (keys == NULL)
+		{
+			return;
+		}
+
+		list->keys = keys;
+		list->capacity = capacity;
+	}
+
+	list->keys[list->count++] = node->key;
+}
+
+
+/**
+* @brief	Acrescentar a chave de uma execuo  lista de chaves, se for da mquina procurada
+*/
+static void collectKey_ByMachine(PersistentNode* node, void* argument)
+{
+	if ((int)(unsigned int)(node->key & 0xFFFFFFFF) == ((ScenarioKeys*)argument)->machineID)
+	{
+		collectKey(node, argument);
+	}
+}
+
+
+/**
+* @brief	Remover uma lista de execues de um cenrio
+* @param	scenario	Cenrio
+* @param	list		Chaves das execues a remover
+* @return	Quantidade de execues removidas
+*/
+static int deleteExecutionKeys(Scenario* scenario, ScenarioKeys* list)
+{
+	for (int i = 0; i < list->count; i++)
+	{
+		replaceRoot(&scenario->executions, deletePersistentNode(scenario->executions, list->keys[i]));
+	}
+
+	scenario->numberOfExecutions -= list->count;
+	free(list->keys);
+
+	return list->count;
+}
+
+
+/**
+* @brief	Remover uma operao e todas as suas execues de um cenrio
+* @param	scenario		Cenrio
+* @param	operationID		Identificador da operao
+* @return	Booleano para o resultado da funo (falso se a operao no existir)
+*/
+bool deleteOperation_AtScenario(Scenario* scenario, int operationID)
+{
+	if (scenario == NULL || searchPersistentNode(scenario->operations, operationID) == NULL)
+	{
+		return false;
+	}
+
+	replaceRoot(&scenario->operations, deletePersistentNode(scenario->operations, operationID));
+	scenario->numberOfOperations--;
+
+	// as execues da operao so um intervalo contnuo de chaves
+	ScenarioKeys list = { NULL, 0, 0, 0 };
+	visitRange(scenario->executions, EXECUTION_KEY(operationID, 0), EXECUTION_KEY(operationID, -1), collectKey, &list);
+	deleteExecutionKeys(scenario, &list);
+
+	return true;
+}
+
+
+/**
+* @brief	Remover de um cenrio todas as execues numa mquina (por exemplo, se a mquina avariar)
+* @param	scenario	Cenrio
+* @param	machineID	Identificador da mquina
+* @return	Quantidade de execues removidas (ou -1 se o cenrio no existir)
+*/
+int deleteMachine_AtScenario(Scenario* scenario, int machineID)
+{
+	if (scenario == NULL)
+	{
+		return -1;
+	}
+
+	ScenarioKeys list = { NULL, 0, 0, machineID };
+	visitRange(scenario->executions, EXECUTION_KEY(INT_MIN, 0), EXECUTION_KEY(INT_MAX, -1), collectKey_ByMachine, &list);
+
+	return deleteExecutionKeys(scenario, &list);
+}
+
+
+/**
+* @brief	Obter o tempo de uma execuo de um cenrio
+* @param	scenario		Cenrio
+* @param	operationID		Identificador da operao
+* @param	machineID		Identificador da mquina
+* @return	Unidades de tempo (ou -1 se a execuo no existir)
+*/
+int getRuntime_AtScenario(Scenario* scenario, int operationID, int machineID)
+{
+	if (scenario == NULL)
+	{
+		return -1;
+	}
+
+	PersistentNode* node = searchPersistentNode(scenario->executions, EXECUTION_KEY(operationID, machineID));
+
+	return node != NULL ? node->value : -1;
+}
+
+#pragma endregion
+
+
+#pragma region tempos de um trabalho num cenrio
+
+/**
+ * @brief	Estado do clculo do tempo de um trabalho num cenrio
+ */
+typedef struct ScenarioJobTime
+{
+	Scenario* scenario;
+	int jobID;
+	bool useMax; // falso para o tempo mnimo, verdadeiro para o mximo
+	int total;
+	int best; // melhor tempo da operao atual
+	bool found; // se a operao atual tem alguma execuo
+} ScenarioJobTime;
+
+
+/**
+* @brief	Considerar o tempo de uma execuo na operao atual
+*/
+static void visitJobExecution(PersistentNode* node, void* argument)
+{
+	ScenarioJobTime* state = (ScenarioJobTime*)argument;
+
+	if (!state->found || (state->useMax ? node->value > state->best : node->value < state->best))
+	{
+		state->best = node->value;
+	}
+	state->found = true;
+}
+
+
+/**
+* @brief	Acrescentar ao total o melhor tempo de uma operao, se for do trabalho procurado
+*/
+static void visitJobOperation(PersistentNode* node, void* argument)
+{
+	ScenarioJobTime* state = (ScenarioJobTime*)argument;
+
+	if (node->value != state->jobID)
+	{
+		return;
+	}
+
+	int operationID = (int)node->key;
+
+	state->found = false;
+	visitRange(state->scenario->executions, EXECUTION_KEY(operationID, 0), EXECUTION_KEY(operationID, -1), visitJobExecution, state);
+
+	if (state->found)
+	{
+		state->total += state->best;
+	}
+}
+
+
+/**
+* @brief	Calcular o tempo mnimo ou mximo para completar um trabalho num cenrio
+* @param	scenario	Cenrio
+* @param	jobID		Identificador do trabalho
+* @param	useMax		Falso para o tempo mnimo, verdadeiro para o mximo
+* @return	Quantidade de tempo (ou -1 se o trabalho no existir)
+*/
+static int getTimeToCompleteJob_AtScenario(Scenario* scenario, int jobID, bool useMax)
+{
+	if (scenario == NULL || searchPersistentNode(scenario->jobs, jobID) == NULL)
+	{
+		return -1;
+	}
+
+	ScenarioJobTime state = { scenario, jobID, useMax, 0, 0, false };
+	visitRange(scenario->operations, INT_MIN, INT_MAX, visitJobOperation, &state);
+
+	return state.total;
+}
+
+
+/**
+* @brief	Obter o tempo mnimo para completar um trabalho num cenrio
+* @param	scenario	Cenrio
+* @param	jobID		Identificador do trabalho
+* @return	Quantidade de tempo (ou -1 se o trabalho no existir)
+*/
+int getMinTimeToCompleteJob_AtScenario(Scenario* scenario, int jobID)
+{
+	return getTimeToCompleteJob_AtScenario(scenario, jobID, false);
+}
+
+
+/**
+* @brief	Obter o tempo mximo para completar um trabalho num cenrio
+* @param	scenario	Cenrio
+* @param	jobID		Identificador do trabalho
+* @return	Quantidade de tempo (ou -1 se o trabalho no existir)
+*/
+int getMaxTimeToCompleteJob_AtScenario(Scenario* scenario, int jobID)
+{
+	return getTimeToCompleteJob_AtScenario(scenario, jobID, true);
+}
+
+#pragma endregion
@@ -0,0 +1,494 @@
+/**
+ * @brief	Ficheiro com as funes para exportar o plano (trabalho, operao, mquina, incio, fim) para diagramas de Gantt
+ * @file	scheduleexport.c
+ * @author	Vnia Pereira
+ * @email	a19264@alunos.ipca.pt
+ * @date	2022
+ * @Disciplina Estruturas de Dados Avanadas
+ *
+ * -----------------
+ *
+ * O plano  exportado operao a operao, sem ter de o guardar todo em memria. Cada registo  formatado
+ * num buffer de GANTT_BUFFER_SIZE bytes, que s  escrito no ficheiro quando fica cheio; os nmeros so
+ * convertidos para texto  mo (sem printf), dois dgitos de cada vez.
+ *
+ * Formatos:
+ *	- binrio: cabealho (magic, verso, quantidade de operaes em 64 bits), seguido de um registo por operao
+ *	  com 5 inteiros de 32 bits (trabalho, operao, mquina, incio, fim), tudo em little-endian;
+ *	- CSV: linha de cabealho "job,operation,machine,start,end" e uma linha por operao;
+ *	- JSON: array de objetos {"job":..,"operation":..,"machine":..,"start":..,"end":..}, um por linha.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "header.h"
+
+
+#define GANTT_HEADER_SIZE 16
+#define GANTT_ENTRY_SIZE 20
+#define GANTT_MAX_ENTRY_SIZE 128 // maior registo formatado (JSON com 5 inteiros negativos de 10 dgitos)
+
+
+#pragma region formatao
+
+static const char digitPairs[201] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+
+/**
+* @brief	Escrever um inteiro em texto decimal, dois dgitos de cada vez
+* @return	Quantidade de caracteres escritos
+*/
+static int formatInt(char* text, int value)
+{
+	char digits[12];
+	int length = 0;
+	int size = 0;
+	uint32_t number = (uint32_t)value;
+
+	if (value < 0)
+	{
+		text[size++] = '-';
+		number = 0u - number;
+	}
+
+	// os dgitos so gerados do fim para o incio
+	while (number >= 100)
+	{
+		uint32_t pair = (number % 100) * 2;
+		number /= 100;
+		digits[length++] = digitPairs[pair + 1];
+		digits[length++] = digitPairs[pair];
+	}
+
+	if (number >= 10)
+	{
+		digits[length++] = digitPairs[number * 2 + 1];
+		digits[length++] = digitPairs[number * 2];
+	}
+	else
+	{
+		digits[length++] = (char)('0' + number);
+	}
+
+	while (length > 0)
+	{
+		text[size++] = digits[--length];
+	}
+
+	return size;
+}
+
+/**
+* @brief	Copiar um texto constante para o buffer
+* @return	Quantidade de caracteres escritos
+*/
+static int formatText(char* text, const char* value, int length)
+{
+	memcpy(text, value, length);
+	return length;
+}
+
+static void storeU32(uint8_t* bytes, uint32_t value)
+{
+	for (int i = 0; i < 4; i++)
+	{
+		bytes[i] = (uint8_t)(value >> (8 * i));
+	}
+}
+
+static void storeU64(uint8_t* bytes, uint64_t value)
+{
+	for (int i = 0; i < 8; i++)
+	{
+		bytes[i] = (uint8_t)(value >> (8 * i));
+	}
+}
+
+static uint32_t loadU32(const uint8_t* bytes)
+{
+	return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+static uint64_t loadU64(const uint8_t* bytes)
+{
+	return (uint64_t)loadU32(bytes) | ((uint64_t)loadU32(bytes + 4) << 32);
+}
+
+#pragma endregion
+
+
+#pragma region exportao
+
+/**
+* @brief	Escrever no ficheiro o que est no buffer
+*/
+static void flushScheduleExporter(ScheduleExporter* exporter)
+{
+	if (exporter->used > 0 && fwrite(exporter->buffer, 1, exporter->used, exporter->file) != (size_t)exporter->used)
+	{
+		exporter->failed = true;
+	}
+
+	exporter->used = 0;
+}
+
+/**
+* @brief	Criar o ficheiro do plano e escrever o incio do formato escolhido
+* @param	fileName	Nome do ficheiro
+* @param	format		Formato da exportao
+* @return	Exportador (ou NULL se no foi possvel criar o ficheiro)
+*/
+ScheduleExporter* createScheduleExporter(char fileName[], ScheduleExportFormat format)
+{
+	ScheduleExporter* exporter = (ScheduleExporter*)malloc(sizeof(ScheduleExporter));
+	if (exporter == NULL)
+	{
+		return NULL;
+	}
+
+	exporter->buffer = (char*)malloc(GANTT_BUFFER_SIZE);
+	exporter->file = fopen(fileName, format == EXPORT_BINARY ? "wb" : "w");
+
+	if (exporter->buffer == NULL || exporter->file == NULL)
+	{
+		if (exporter->file != NULL)
+		{
+			fclose(exporter->file);
+		}
+		free(exporter->buffer);
+		free(exporter);
+		return NULL;
+	}
+
+	setvbuf(exporter->file, NULL, _IONBF, 0); // o buffer do exportador j junta as escritas
+
+	exporter->format = format;
+	exporter->used = 0;
+	exporter->count = 0;
+	exporter->failed = false;
+
+	switch (format)
+	{
+	case EXPORT_BINARY:
+		// a quantidade de operaes s  conhecida no fim, o cabealho  reescrito ao fechar
+		memset(exporter->buffer, 0, GANTT_HEADER_SIZE);
+		exporter->used = GANTT_HEADER_SIZE;
+		break;
+
+	case EXPORT_CSV:
+		exporter->used = formatText(exporter->buffer, "job,operation,machine,start,end\n", 32);
+		break;
+
+	case EXPORT_JSON:
+		exporter->used = formatText(exporter->buffer, "[", 1);
+		break;
+	}
+
+	return exporter;
+}
+
+/**
+* @brief	Exportar uma operao do plano
+* @param	exporter	Exportador
+* @param	jobID		Identificador do trabalho
+* @param	operationID	Identificador da operao
+* @param	machineID	Identificador da mquina
+* @param	start		Incio da operao
+* @param	end			Fim da operao
+* @return	Booleano para o resultado da funo (falso se uma escrita no ficheiro j falhou)
+*/
+bool writeScheduleEntry(ScheduleExporter* exporter, int jobID, int operationID, int machineID, int start, int end)
+{
+	if (exporter == NULL || exporter->failed)
+	{
+		return false;
+	}
+
+	if (exporter->used + GANTT_MAX_ENTRY_SIZE > GANTT_BUFFER_SIZE)
+	{
+		flushScheduleExporter(exporter);
+	}
+
+	char* text = exporter->buffer + exporter->used;
+	int size = 0;
+
+	switch (exporter->format)
+	{
+	case EXPORT_BINARY:
+		storeU32((uint8_t*)text, (uint32_t)jobID);
+		storeU32((uint8_t*)text + 4, (uint32_t)operationID);
+		storeU32((uint8_t*)text + 8, (uint32_t)machineID);
+		storeU32((uint8_t*)text + 12, (uint32_t)start);
+		storeU32((uint8_t*)text + 16, (uint32_t)end);
+		size = GANTT_ENTRY_SIZE;
+		break;
+
+	case EXPORT_CSV:
+		size += formatInt(text + size, jobID);
+		text[size++] = ',';
+		size += formatInt(text + size, operationID);
+		text[size++] = ',';
+		size += formatInt(text + size, machineID);
+		text[size++] = ',';
+		size += formatInt(text + size, start);
+		text[size++] = ',';
+		size += formatInt(text + size, end);
+		text[size++] = '\n';
+		break;
+
+	case EXPORT_JSON:
+		if (exporter->count > 0)
+		{
+			text[size++] = ',';
+		}
+		size += formatText(text + size, "\n{\"job\":", 8);
+		size += formatInt(text + size, jobID);
+		size += formatText(text + size, ",\"operation\":", 13);
+		size += formatInt(text + size, operationID);
+		size += formatText(text + size, ",\"machine\":", 11);
+		size += formatInt(text + size, machineID);
+		size += formatText(text + size, ",\"start\":", 9);
+		size += formatInt(text + size, start);
+		size += formatText(text + size, ",\"end\":", 7);
+		size += formatInt(text + size, end);
+		text[size++] = '}';
+		break;
+	}
+
+	exporter->used += size;
+	exporter->count++;
+
+	return true;
+}
+
+/**
+* @brief	Terminar a exportao: escrever o fim do formato e o que falta do buffer, fechar o ficheiro e libertar o exportador
+* @param	exporter	Exportador
+* @return	Booleano para o resultado da funo (falso se alguma escrita no ficheiro falhou)
+*/
+bool closeScheduleExporter(ScheduleExporter* exporter)
+{
+	if (exporter == NULL)
+	{
+		return false;
+	}
+
+	flushScheduleExporter(exporter);
+
+	if (exporter->format == EXPORT_JSON)
+	{
+		exporter->used = formatText(exporter->buffer, "\n]\n", 3);
+		flushScheduleExporter(exporter);
+	}
+
+	if (exporter->format == EXPORT_BINARY)
+	{
+		uint8_t header[GANTT_HEADER_SIZE];
+
+		storeU32(header, GANTT_MAGIC);
+		storeU32(header + 4, GANTT_VERSION);
+		storeU64(header + 8, (uint64_t)exporter->count);
+
+		if (fseek(exporter->file, 0, SEEK_SET) != 0 || fwrite(header, GANTT_HEADER_SIZE, 1, exporter->file) != 1)
+		{
+			exporter->failed = true;
+		}
+	}
+
+	bool written = !exporter->failed && !ferror(exporter->file);
+
+	if (fclose(exporter->file) != 0)
+	{
+		written = false;
+	}
+
+	free(exporter->buffer);
+	free(exporter);
+
+	return written;
+}
+
+/**
+* @brief	Exportar o plano em tempo real (as operaes dos trabalhos removidos so ignoradas)
+* @param	schedule	Plano em tempo real
+* @param	fileName	Nome do ficheiro
+* @param	format		Formato da exportao
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool exportOnlineSchedule(OnlineSchedule* schedule, char fileName[], ScheduleExportFormat format)
+{
+	if (schedule == NULL)
+	{
+		return false;
+	}
+
+	ScheduleExporter* exporter = createScheduleExporter(fileName, format);
+	if (exporter == NULL)
+	{
+		return false;
+	}
+
+	for (int i = 0; i < schedule->count; i++)
+	{
+		ScheduledOperation* operation = &schedule->operations[i];
+
+		if (operation->isActive)
+		{
+			writeScheduleEntry(exporter, operation->jobID, operation->operationID, operation->machineID, operation->start, operation->end);
+		}
+	}
+
+	return closeScheduleExporter(exporter);
+}
+
+/**
+* @brief	Exportar o plano atual do avaliador (alternativas e sequncia), calculando o incio de cada operao
+* @param	evaluator	Avaliador
+* @param	fileName	Nome do ficheiro
+* @param	format		Formato da exportao
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool exportEvaluatorSchedule(AssignmentEvaluator* evaluator, char fileName[], ScheduleExportFormat format)
+{
+	if (evaluator == NULL)
+	{
+		return false;
+	}
+
+	const ProblemSnapshot* snapshot = evaluator->snapshot;
+	int numberOfOperations = snapshot->header->numberOfOperations;
+
+	int* starts = (int*)malloc((numberOfOperations > 0 ? numberOfOperations : 1) * sizeof(int));
+	if (starts == NULL)
+	{
+		return false;
+	}
+
+	ScheduleExporter* exporter = createScheduleExporter(fileName, format);
+	if (exporter == NULL)
+	{
+		free(starts);
+		return false;
+	}
+
+	decodeSchedule_AtEvaluator(evaluator, starts);
+
+	// as operaes esto agrupadas por trabalho, pela ordem do trabalho
+	for (int operation = 0; operation < numberOfOperations; operation++)
+	{
+		int alternative = evaluator->alternatives[operation];
+
+		writeScheduleEntry(exporter,
+			snapshot->jobIDs[snapshot->operationJobs[operation]],
+			snapshot->operationIDs[operation],
+			snapshot->machineIDs[snapshot->alternativeMachines[alternative]],
+			starts[operation],
+			starts[operation] + snapshot->alternativeRuntimes[alternative]);
+	}
+
+	free(starts);
+
+	return closeScheduleExporter(exporter);
+}
+
+#pragma endregion
+
+
+#pragma region leitura
+
+/**
+* @brief	Ler um plano exportado no formato binrio
+* @param	fileName	Nome do ficheiro
+* @param	count		Endereo onde guardar a quantidade de operaes lidas
+* @return	Array com as operaes do plano (ou NULL se o ficheiro no existe ou no  vlido)
+*/
+FileScheduleEntry* readScheduleEntries_Binary(char fileName[], long long* count)
+{
+	FILE* file = NULL;
+	uint8_t header[GANTT_HEADER_SIZE];
+
+	*count = 0;
+
+	if ((file = fopen(fileName, "rb")) == NULL) // se no foi possvel abrir o ficheiro
+	{
+		return NULL;
+	}
+
+	if (fread(header, GANTT_HEADER_SIZE, 1, file) != 1 || loadU32(header) != GANTT_MAGIC || loadU32(header + 4) != GANTT_VERSION)
+	{
+		fclose(file);
+		return NULL;
+	}
+
+	// a quantidade do cabealho no  de confiana: tem de caber no resto do ficheiro
+	long long numberOfEntries = (long long)loadU64(header + 8);
+	long long maxEntries = (getFileSize(fileName) - GANTT_HEADER_SIZE) / GANTT_ENTRY_SIZE;
+
+	if (numberOfEntries < 0 || numberOfEntries > maxEntries)
+	{
+		fclose(file);
+		return NULL;
+	}
+
+	FileScheduleEntry* entries = (FileScheduleEntry*)malloc((numberOfEntries > 0 ? (size_t)numberOfEntries : 1) * sizeof(FileScheduleEntry));
+	uint8_t* buffer = (uint8_t*)malloc(GANTT_BUFFER_SIZE);
+
+	if (entries == NULL || buffer == NULL)
+	{
+		free(entries);
+		free(buffer);
+		fclose(file);
+		return NULL;
+	}
+
+	long long entriesRead = 0;
+	int perBuffer = GANTT_BUFFER_SIZE / GANTT_ENTRY_SIZE;
+
+	while (entriesRead < numberOfEntries) // nunca so lidas mais operaes do que as do cabealho
+	{
+		int wanted = numberOfEntries - entriesRead < perBuffer ? (int)(numberOfEntries - entriesRead) : perBuffer;
+
+		if (fread(buffer, GANTT_ENTRY_SIZE, wanted, file) != (size_t)wanted) // ficheiro truncado
+		{
+			free(entries);
+			free(buffer);
+			fclose(file);
+			return NULL;
+		}
+
+		for (int i = 0; i < wanted; i++)
+		{
+			const uint8_t* record = buffer + (size_t)i * GANTT_ENTRY_SIZE;
+			FileScheduleEntry* entry = &entries[entriesRead + i];
+
+			entry->jobID = (int)loadU32(record);
+			entry->operationID = (int)loadU32(record + 4);
+			entry->machineID = (int)loadU32(record + 8);
+			entry->start = (int)loadU32(record + 12);
+			entry->end = (int)loadU32(record + 16);
+		}
+
+		entriesRead += wanted;
+	}
+
+	free(buffer);
+	fclose(file);
+
+	*count = numberOfEntries;
+	return entries;
+}
+
+#pragma endregion
@@ -0,0 +1,1053 @@
+/**
+ * @brief	Ficheiro com as funes do modo de servio: o modelo  carregado uma vez e os pedidos chegam por um socket local
+ * @file	service.c
+ * @author	Vnia Pereira
+ * @email	a19264@alunos.ipca.pt
+ * @date	2022
+ * @Disciplina Estruturas de Dados Avanadas
+ *
+ * -----------------
+ *
+ * Protocolo (todos os inteiros em little-endian):
+ *	- cada pedido e cada resposta comea com um cabealho de SERVICE_HEADER_SIZE bytes:
+ *	  tamanho dos dados a seguir (u32), identificador do pedido (u32, devolvido na resposta), tipo do pedido ou
+ *	  estado da resposta (i32, ServiceRequestType / ServiceStatus);
+ *	- dados de cada pedido -> dados da resposta (com estado SERVICE_OK):
+ *		SERVICE_PING				-> (nada)
+ *		SERVICE_SEARCH_EXECUTION	operao, mquina -> tempo
+ *		SERVICE_MIN_JOB_TIME		trabalho -> tempo, quantidade, (operao, mquina, tempo) por cada execuo escolhida
+ *		SERVICE_MAX_JOB_TIME		trabalho -> igual ao anterior
+ *		SERVICE_APPLY_BATCH			quantidade, (tipo, operao, mquina, tempo) por alterao
+ *									-> inseridas, atualizadas, removidas, falhadas, nova verso do modelo (i64)
+ *		SERVICE_SCHEDULE			regra de despacho -> fim do plano, atraso ponderado (i64), carga total (i64),
+ *									carga da mquina mais carregada
+ *		SERVICE_STATS				-> para cada tipo de pedido: pedidos, microssegundos no total, mximo (i64 cada)
+ *
+ * O ciclo de eventos (epoll) aceita ligaes e l os pedidos; cada pedido completo  executado por uma tarefa do
+ * conjunto de threads, sobre a verso publicada do modelo (leituras sem bloqueio, alteraes por cpia).
+ * Uma ligao pode enviar vrios pedidos sem esperar pelas respostas: as respostas podem chegar por outra ordem
+ * e so identificadas pelo identificador do pedido. A latncia vai da chegada do pedido at a resposta estar pronta.
+ * S existe em Linux; nas restantes plataformas createService devolve NULL.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "header.h"
+
+
+#pragma region mtricas
+
+/**
+* @brief	Obter as mtricas de latncia de um tipo de pedido
+* @param	service	Servio
+* @param	type	Tipo de pedido
+* @param	result	Endereo onde guardar as mtricas
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool getServiceLatency(Service* service, ServiceRequestType type, ServiceLatency* result)
+{
+	if (service == NULL || result == NULL || type < 0 || type >= SERVICE_REQUEST_TYPES)
+	{
+		return false;
+	}
+
+	ServiceLatency* latency = &service->latencies[type];
+
+	result->requests = atomicLoad(&latency->requests);
+	result->totalMicroseconds = atomicLoad(&latency->totalMicroseconds);
+	result->maxMicroseconds = atomicLoad(&latency->maxMicroseconds);
+	for (int b = 0; b < SERVICE_LATENCY_BUCKETS; b++)
+	{
+		result->histogram[b] = atomicLoad(&latency->histogram[b]);
+	}
+
+	return true;
+}
+
+/**
+* @brief	Obter um percentil da latncia, a partir do histograma (limite superior da classe onde cai)
+* @param	latency		Mtricas de latncia
+* @param	percentile	Percentil entre 0 e 100 (por exemplo, 99)
+* @return	Latncia em microssegundos (0 se no houver pedidos)
+*/
+int getServiceLatencyPercentile(ServiceLatency* latency, double percentile)
+{
+	if (latency == NULL || latency->requests <= 0)
+	{
+		return 0;
+	}
+
+	double wanted = latency->requests * percentile / 100.0;
+	long counted = 0;
+
+	for (int b = 0; b < SERVICE_LATENCY_BUCKETS; b++)
+	{
+		counted += latency->histogram[b];
+		if (counted >= wanted)
+		{
+			return b < 31 ? (1 << b) : 2147483647;
+		}
+	}
+
+	return latency->maxMicroseconds;
+}
+
+#pragma endregion
+
+
+#ifdef __linux__
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+
+/**
+ * @brief	Estrutura de dados para representar uma ligao de um cliente
+ */
+typedef struct ServiceConnection
+{
+	int socket;
+	Service* service;
+	char* input; // bytes recebidos que ainda no formam um pedido completo
+	int inputUsed;
+	int inputCapacity;
+	char* output; // respostas que ainda no foram enviadas (protegido pelo lock)
+	int outputUsed;
+	int outputCapacity;
+	Mutex lock;
+	bool closed; // o cliente desligou, as respostas que faltam so descartadas
+	bool waitingToWrite; // se o ciclo de eventos est  espera de poder escrever (EPOLLOUT)
+	volatile long references; // o ciclo de eventos e cada pedido em curso
+	struct ServiceConnection* previous;
+	struct ServiceConnection* next;
+} ServiceConnection;
+
+/**
+ * @brief	Estrutura de dados para representar um pedido completo,  espera de ser executado
+ */
+typedef struct ServiceRequest
+{
+	ServiceConnection* connection;
+	unsigned int id;
+	int type;
+	long long receivedAt; // microssegundos
+	int size;
+	char data[]; // dados do pedido
+} ServiceRequest;
+
+/**
+ * @brief	Estrutura de dados para construir os dados de uma resposta
+ */
+typedef struct ServiceResponse
+{
+	char* data; // comea com espao para o cabealho
+	int used;
+	int capacity;
+	bool failed;
+} ServiceResponse;
+
+
+#pragma region codificao
+
+static void storeU32(char* bytes, uint32_t value)
+{
+	for (int i = 0; i < 4; i++)
+	{
+		bytes[i] = (char)(value >> (8 * i));
+	}
+}
+
+static uint32_t loadU32(const char* bytes)
+{
+	const unsigned char* data = (const unsigned char*)bytes;
+	return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+/**
+* @brief	Acrescentar bytes  resposta, aumentando a memria quando for preciso
+*/
+static void putBytes(ServiceResponse* response, const char* bytes, int size)
+{
+	if (response->failed)
+	{
+		return;
+	}
+
+	if (response->used + size > response->capacity)
+	{
+		int capacity = response->capacity * 2 > response->used + size ? response->capacity * 2 : response->used + size;
+		char* data = (char*)realloc(response->data, capacity);
+		if (data == NULL)
+		{
+			response->failed = true;
+			return;
+		}
+		response->data = data;
+		response->capacity = capacity;
+	}
+
+	memcpy(response->data + response->used, bytes, size);
+	response->used += size;
+}
+
+static void putInt(ServiceResponse* response, int value)
+{
+	char bytes[4];
+	storeU32(bytes, (uint32_t)value);
+	putBytes(response, bytes, 4);
+}
+
+static void putLong(ServiceResponse* response, long long value)
+{
+	char bytes[8];
+	storeU32(bytes, (uint32_t)value);
+	storeU32(bytes + 4, (uint32_t)((unsigned long long)value >> 32));
+	putBytes(response, bytes, 8);
+}
+
+/**
+* @brief	Obter o i-simo inteiro dos dados de um pedido
+*/
+static int getInt(ServiceRequest* request, int index)
+{
+	return (int)loadU32(request->data + 4 * index);
+}
+
+
+#pragma endregion
+
+
+#pragma region ligaes
+
+/**
+* @brief	Largar uma referncia a uma ligao; a ltima fecha o socket e liberta a memria
+*/
+static void releaseConnection(ServiceConnection* connection)
+{
+	if (atomicAdd(&connection->references, -1) != 0)
+	{
+		return;
+	}
+
+	close(connection->socket);
+	destroyMutex(&connection->lock);
+	free(connection->input);
+	free(connection->output);
+	free(connection);
+}
+
+/**
+* @brief	Escrever no socket as respostas pendentes, e pedir ao ciclo de eventos para avisar quando puder escrever mais.
+*			Deve ser chamada com o lock da ligao bloqueado
+*/
+static void flushConnection(ServiceConnection* connection)
+{
+	int sent = 0;
+
+	while (sent < connection->outputUsed)
+	{
+		ssize_t result = send(connection->socket, connection->output + sent, connection->outputUsed - sent, MSG_NOSIGNAL);
+		if (result <= 0)
+		{
+			if (result < 0 && errno == EINTR)
+			{
+				continue;
+			}
+			break; // EAGAIN (o socket est cheio) ou erro (o ciclo de eventos vai receber EPOLLERR/EPOLLHUP)
+		}
+		sent += (int)result;
+	}
+
+	memmove(connection->output, connection->output + sent, connection->outputUsed - sent);
+	connection->outputUsed -= sent;
+
+	// s  preciso mudar os eventos pedidos quando o socket encheu ou deixou de ter respostas pendentes
+	if ((connection->outputUsed > 0) != connection->waitingToWrite)
+	{
+		struct epoll_event event;
+		event.events = EPOLLIN | (connection->outputUsed > 0 ? EPOLLOUT : 0);
+		event.data.ptr = connection;
+		epoll_ctl(connection->service->eventLoop, EPOLL_CTL_MOD, connection->socket, &event);
+		connection->waitingToWrite = connection->outputUsed > 0;
+	}
+}
+
+/**
+* @brief	Acrescentar uma resposta s respostas pendentes da ligao e tentar envi-la logo
+*/
+static void sendResponse(ServiceConnection* connection, ServiceResponse* response)
+{
+	lockMutex(&connection->lock);
+
+	if (!connection->closed)
+	{
+		if (connection->outputUsed + response->used > connection->outputCapacity)
+		{
+			int capacity = connection->outputCapacity * 2 > connection->outputUsed + response->used
+				? connection->outputCapacity * 2 : connection->outputUsed + response->used;
+			char* output = (char*)realloc(connection->output, capacity);
+
+			if (output != NULL)
+			{
+				connection->output = output;
+				connection->outputCapacity = capacity;
+			}
+		}
+
+		if (connection->outputUsed + response->used <= connection->outputCapacity)
+		{
+			bool wasEmpty = connection->outputUsed == 0;
+
+			memcpy(connection->output + connection->outputUsed, response->data, response->used);
+			connection->outputUsed += response->used;
+
+			if (wasEmpty) // se j havia respostas pendentes, o ciclo de eventos est  espera de poder escrever
+			{
+				flushConnection(connection);
+			}
+		}
+	}
+
+	unlockMutex(&connection->lock);
+}
+
+/**
+* @brief	Fechar uma ligao do lado do ciclo de eventos (os pedidos em curso terminam, mas as respostas so descartadas)
+*/
+static void closeConnection(Service* service, ServiceConnection* connection)
+{
+	lockMutex(&connection->lock);
+	connection->closed = true;
+	epoll_ctl(service->eventLoop, EPOLL_CTL_DEL, connection->socket, NULL);
+	unlockMutex(&connection->lock);
+
+	if (connection->previous == NULL)
+	{
+		service->connections = connection->next;
+	}
+	else
+	{
+		connection->previous->next = connection->next;
+	}
+	if (connection->next != NULL)
+	{
+		connection->next->previous = connection->previous;
+	}
+
+	releaseConnection(connection);
+}
+
+#pragma endregion
+
+
+#pragma region pedidos
+
+/**
+* @brief	Registar a latncia de um pedido
+*/
+static void recordLatency(Service* service, int type, long long microseconds)
+{
+	ServiceLatency* latency = &service->latencies[type];
+	long value = (long)microseconds;
+	int bucket = 0;
+
+	while (bucket < SERVICE_LATENCY_BUCKETS - 1 && (1LL << bucket) <= microseconds)
+	{
+		bucket++;
+	}
+
+	atomicAdd(&latency->requests, 1);
+	atomicAdd(&latency->totalMicroseconds, value);
+	atomicAdd(&latency->histogram[bucket], 1);
+
+	long maximum = atomicLoad(&latency->maxMicroseconds);
+	while (value > maximum && !atomicCompareExchange(&latency->maxMicroseconds, maximum, value))
+	{
+		maximum = atomicLoad(&latency->maxMicroseconds);
+	}
+}
+
+/**
+* @brief	Escrever na resposta o tempo e as execues escolhidas para completar um trabalho
+*/
+static ServiceStatus answerJobTime(Model* model, ServiceRequest* request, ServiceResponse* response)
+{
+	if (request->size != 4)
+	{
+		return SERVICE_BAD_REQUEST;
+	}
+
+	// as execues escolhidas ficam na pilha; s os trabalhos com muitas operaes obrigam a alocar memria
+	FileExecution buffer[SERVICE_JOB_EXECUTIONS];
+	FileExecution* chosen = buffer;
+	int jobID = getInt(request, 0);
+	int count = 0;
+
+	int time = request->type == SERVICE_MIN_JOB_TIME
+		? getMinTimeToCompleteJob_AtModel_ToArray(model, jobID, buffer, SERVICE_JOB_EXECUTIONS, &count)
+		: getMaxTimeToCompleteJob_AtModel_ToArray(model, jobID, buffer, SERVICE_JOB_EXECUTIONS, &count);
+
+	if (count == 0) // trabalho sem operaes (ou inexistente)
+	{
+		return SERVICE_NOT_FOUND;
+	}
+
+	if (count > SERVICE_JOB_EXECUTIONS)
+	{
+		chosen = (FileExecution*)malloc(count * sizeof(FileExecution));
+		if (chosen == NULL) // se no houver memria para alocar
+		{
+			return SERVICE_FAILED;
+		}
+
+		// a verso do modelo no muda enquanto o pedido  respondido, por isso a quantidade  a mesma
+		time = request->type == SERVICE_MIN_JOB_TIME
+			? getMinTimeToCompleteJob_AtModel_ToArray(model, jobID, chosen, count, &count)
+			: getMaxTimeToCompleteJob_AtModel_ToArray(model, jobID, chosen, count, &count);
+	}
+
+	putInt(response, time);
+	putInt(response, count);
+	for (int i = 0; i < count; i++)
+	{
+		putInt(response, chosen[i].operationID);
+		putInt(response, chosen[i].machineID);
+		putInt(response, chosen[i].runtime);
+	}
+
+	if (chosen != buffer)
+	{
+		free(chosen);
+	}
+
+	return SERVICE_OK;
+}
+
+/**
+* @brief	Aplicar um lote de alteraes s execues numa cpia do modelo e public-la
+*/
+static ServiceStatus answerApplyBatch(ServiceRequest* request, ServiceResponse* response)
+{
+	if (request->size < 4)
+	{
+		return SERVICE_BAD_REQUEST;
+	}
+
+	int count = getInt(request, 0);
+	if (count < 0 || (long long)request->size != 4 + 16LL * count)
+	{
+		return SERVICE_BAD_REQUEST;
+	}
+
+	ExecutionChange* changes = (ExecutionChange*)malloc((count > 0 ? count : 1) * sizeof(ExecutionChange));
+	if (changes == NULL)
+	{
+		return SERVICE_FAILED;
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		changes[i].type = (ExecutionChangeType)getInt(request, 1 + 4 * i);
+		changes[i].operationID = getInt(request, 2 + 4 * i);
+		changes[i].machineID = getInt(request, 3 + 4 * i);
+		changes[i].runtime = getInt(request, 4 + 4 * i);
+
+		if (changes[i].type < CHANGE_INSERT || changes[i].type > CHANGE_DELETE_OPERATION || changes[i].operationID < 0)
+		{
+			free(changes);
+			return SERVICE_BAD_REQUEST;
+		}
+	}
+
+	ExecutionBatchResult result;
+	Model* draft = beginModelUpdate();
+
+	if (draft == NULL)
+	{
+		free(changes);
+		return SERVICE_FAILED;
+	}
+
+	if (!applyExecutionChanges_AtTable(draft->executionsTable, changes, count, &result))
+	{
+		cancelModelUpdate(draft);
+		free(changes);
+		return SERVICE_FAILED;
+	}
+
+	long version = draft->version + 1; // depois de publicada, a cpia pode ser substituda por outro escritor
+	bool published = publishModelUpdate(draft);
+
+	free(changes);
+
+	if (!published)
+	{
+		return SERVICE_FAILED;
+	}
+
+	putInt(response, result.inserted);
+	putInt(response, result.updated);
+	putInt(response, result.deleted);
+	putInt(response, result.failed);
+	putLong(response, version);
+
+	return SERVICE_OK;
+}
+
+/**
+* @brief	Construir um plano com uma regra de despacho sobre a imagem compilada da verso do modelo.
+*			Um modelo com operaes sem execues (por exemplo, depois de CHANGE_DELETE_OPERATION) no tem plano possvel
+*/
+static ServiceStatus answerSchedule(Model* model, ServiceRequest* request, ServiceResponse* response)
+{
+	if (request->size != 4 || (getInt(request, 0) != DISPATCH_EDD && getInt(request, 0) != DISPATCH_ATC))
+	{
+		return SERVICE_BAD_REQUEST;
+	}
+
+	ProblemSnapshot* snapshot = compileProblemSnapshot(model->jobs, model->machines, model->operations, model->executionsTable);
+	if (snapshot == NULL)
+	{
+		return SERVICE_FAILED;
+	}
+
+	if (countOperationsWithoutAlternatives_AtSnapshot(snapshot) != 0) // o avaliador no seria criado
+	{
+		closeProblemSnapshot(snapshot);
+		return SERVICE_BAD_REQUEST;
+	}
+
+	AssignmentEvaluator* evaluator = createAssignmentEvaluator(snapshot);
+	ObjectiveVector objectives;
+	ServiceStatus status = SERVICE_FAILED;
+
+	if (evaluator != NULL
+		&& buildDispatchSchedule_AtEvaluator(evaluator, (DispatchRule)getInt(request, 0), ATC_LOOKAHEAD)
+		&& getObjectives_AtEvaluator(evaluator, &objectives))
+	{
+		putInt(response, objectives.makespan);
+		putLong(response, getWeightedTardiness_AtEvaluator(evaluator));
+		putLong(response, objectives.totalWorkload);
+		putInt(response, objectives.maxMachineWorkload);
+		status = SERVICE_OK;
+	}
+
+	freeAssignmentEvaluator(evaluator);
+	closeProblemSnapshot(snapshot);
+
+	return status;
+}
+
+/**
+* @brief	Executar um pedido sobre a verso publicada do modelo
+*/
+static ServiceStatus answerRequest(Service* service, ServiceRequest* request, ServiceResponse* response)
+{
+	if (request->type == SERVICE_PING)
+	{
+		return request->size == 0 ? SERVICE_OK : SERVICE_BAD_REQUEST;
+	}
+
+	if (request->type == SERVICE_STATS)
+	{
+		for (int t = 0; t < SERVICE_REQUEST_TYPES; t++)
+		{
+			ServiceLatency latency;
+			getServiceLatency(service, (ServiceRequestType)t, &latency);
+			putLong(response, latency.requests);
+			putLong(response, latency.totalMicroseconds);
+			putLong(response, latency.maxMicroseconds);
+		}
+		return SERVICE_OK;
+	}
+
+	if (request->type == SERVICE_APPLY_BATCH) // os escritores trabalham numa cpia, no precisam de ser leitores
+	{
+		return answerApplyBatch(request, response);
+	}
+
+	int reader = registerModelReader();
+	if (reader < 0)
+	{
+		return SERVICE_FAILED;
+	}
+
+	Model* model = beginModelRead(reader);
+	ServiceStatus status = SERVICE_BAD_REQUEST;
+
+	if (model == NULL)
+	{
+		status = SERVICE_FAILED;
+	}
+	else if (request->type == SERVICE_SEARCH_EXECUTION)
+	{
+		if (request->size == 8)
+		{
+			Execution* execution = searchExecution_AtModel(model, getInt(request, 0), getInt(request, 1));
+			status = execution != NULL ? SERVICE_OK : SERVICE_NOT_FOUND;
+			if (execution != NULL)
+			{
+				putInt(response, execution->runtime);
+			}
+		}
+	}
+	else if (request->type == SERVICE_MIN_JOB_TIME || request->type == SERVICE_MAX_JOB_TIME)
+	{
+		status = answerJobTime(model, request, response);
+	}
+	else if (request->type == SERVICE_SCHEDULE)
+	{
+		status = answerSchedule(model, request, response);
+	}
+
+	endModelRead(reader);
+	unregisterModelReader(reader);
+
+	return status;
+}
+
+/**
+* @brief	Tarefa de um pedido: executar, enviar a resposta e registar a latncia
+* @param	data	Pedido (ServiceRequest)
+*/
+static void runServiceRequest(void* data)
+{
+	ServiceRequest* request = (ServiceRequest*)data;
+	ServiceConnection* connection = request->connection;
+	Service* service = connection->service;
+	ServiceResponse response;
+
+	response.capacity = 256;
+	response.data = (char*)malloc(response.capacity);
+	response.used = SERVICE_HEADER_SIZE;
+	response.failed = response.data == NULL;
+
+	ServiceStatus status = SERVICE_BAD_REQUEST;
+
+	if (request->type >= 0 && request->type < SERVICE_REQUEST_TYPES)
+	{
+		status = answerRequest(service, request, &response);
+	}
+
+	if (response.failed) // sem memria para a resposta completa: responder s com o estado
+	{
+		char header[SERVICE_HEADER_SIZE];
+		free(response.data);
+		response.data = header;
+		response.used = SERVICE_HEADER_SIZE;
+		status = SERVICE_FAILED;
+	}
+	else if (status != SERVICE_OK)
+	{
+		response.used = SERVICE_HEADER_SIZE; // os dados de uma resposta com erro so descartados
+	}
+
+	storeU32(response.data, (uint32_t)(response.used - SERVICE_HEADER_SIZE));
+	storeU32(response.data + 4, request->id);
+	storeU32(response.data + 8, (uint32_t)status);
+
+	sendResponse(connection, &response);
+
+	if (request->type >= 0 && request->type < SERVICE_REQUEST_TYPES)
+	{
+		recordLatency(service, request->type, getTimeMicroseconds() - request->receivedAt);
+	}
+
+	if (!response.failed)
+	{
+		free(response.data);
+	}
+	free(request);
+	releaseConnection(connection);
+}
+
+/**
+* @brief	Criar uma tarefa para cada pedido completo recebido numa ligao
+* @return	Booleano para o resultado da funo (falso se o cliente enviou um pedido invlido)
+*/
+static bool dispatchRequests(Service* service, ServiceConnection* connection)
+{
+	long long now = getTimeMicroseconds();
+	int position = 0;
+
+	while (connection->inputUsed - position >= SERVICE_HEADER_SIZE)
+	{
+		const char* header = connection->input + position;
+		uint32_t size = loadU32(header);
+
+		if (size > SERVICE_MAX_REQUEST_SIZE)
+		{
+			return false;
+		}
+		if (connection->inputUsed - position - SERVICE_HEADER_SIZE < (int)size) // pedido incompleto
+		{
+			break;
+		}
+
+		ServiceRequest* request = (ServiceRequest*)malloc(sizeof(ServiceRequest) + size);
+		if (request == NULL)
+		{
+			return false;
+		}
+
+		request->connection = connection;
+		request->id = loadU32(header + 4);
+		request->type = (int)loadU32(header + 8);
+		request->receivedAt = now;
+		request->size = (int)size;
+		memcpy(request->data, header + SERVICE_HEADER_SIZE, size);
+
+		atomicAdd(&connection->references, 1);
+
+		if (!spawnTask(service->pool, &service->tasks, runServiceRequest, request)) // sem conjunto de threads
+		{
+			runServiceRequest(request);
+		}
+
+		position += SERVICE_HEADER_SIZE + (int)size;
+	}
+
+	memmove(connection->input, connection->input + position, connection->inputUsed - position);
+	connection->inputUsed -= position;
+
+	return true;
+}
+
+/**
+* @brief	Ler tudo o que chegou a uma ligao
+* @return	Booleano para o resultado da funo (falso se o cliente desligou ou enviou um pedido invlido)
+*/
+static bool readConnection(Service* service, ServiceConnection* connection)
+{
+	while (true)
+	{
+		if (connection->inputCapacity - connection->inputUsed < SERVICE_READ_SIZE)
+		{
+			// espao para um pedido completo (at SERVICE_MAX_REQUEST_SIZE), aumentado aos poucos
+			if (connection->inputCapacity >= SERVICE_MAX_REQUEST_SIZE + SERVICE_HEADER_SIZE + SERVICE_READ_SIZE)
+			{
+				return false;
+			}
+
+			int capacity = connection->inputCapacity * 2;
+			char* input = (char*)realloc(connection->input, capacity);
+			if (input == NULL)
+			{
+				return false;
+			}
+			connection->input = input;
+			connection->inputCapacity = capacity;
+		}
+
+		ssize_t result = recv(connection->socket, connection->input + connection->inputUsed,
+			connection->inputCapacity - connection->inputUsed, 0);
+
+		if (result == 0) // o cliente desligou
+		{
+			return false;
+		}
+		if (result < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			return errno == EAGAIN || errno == EWOULDBLOCK;
+		}
+
+		connection->inputUsed += (int)result;
+
+		if (!dispatchRequests(service, connection))
+		{
+			atomicAdd(&service->protocolErrors, 1);
+			return false;
+		}
+	}
+}
+
+/**
+* @brief	Aceitar todas as ligaes pendentes
+*/
+static void acceptConnections(Service* service)
+{
+	while (true)
+	{
+		int client = accept(service->listenSocket, NULL, NULL);
+		if (client < 0)
+		{
+			return; // EAGAIN: no h mais ligaes pendentes
+		}
+
+		fcntl(client, F_SETFL, fcntl(client, F_GETFL) | O_NONBLOCK);
+		fcntl(client, F_SETFD, FD_CLOEXEC);
+
+		ServiceConnection* connection = (ServiceConnection*)calloc(1, sizeof(ServiceConnection));
+		if (connection != NULL)
+		{
+			connection->input = (char*)malloc(2 * SERVICE_READ_SIZE);
+			connection->output = (char*)malloc(SERVICE_READ_SIZE);
+		}
+
+		if (connection == NULL || connection->input == NULL || connection->output == NULL)
+		{
+			if (connection != NULL)
+			{
+				free(connection->input);
+				free(connection->output);
+				free(connection);
+			}
+			close(client);
+			continue;
+		}
+
+		connection->socket = client;
+		connection->service = service;
+		connection->inputCapacity = 2 * SERVICE_READ_SIZE;
+		connection->outputCapacity = SERVICE_READ_SIZE;
+		connection->references = 1; // a referncia do ciclo de eventos
+		initMutex(&connection->lock);
+
+		struct epoll_event event;
+		event.events = EPOLLIN;
+		event.data.ptr = connection;
+
+		if (epoll_ctl(service->eventLoop, EPOLL_CTL_ADD, client, &event) != 0)
+		{
+			releaseConnection(connection);
+			continue;
+		}
+
+		connection->next = service->connections;
+		if (service->connections != NULL)
+		{
+			service->connections->previous = connection;
+		}
+		service->connections = connection;
+
+		atomicAdd(&service->acceptedConnections, 1);
+	}
+}
+
+#pragma endregion
+
+
+#pragma region servio
+
+/**
+* @brief	Criar o servio: o socket local fica  escuta, mas os pedidos s so tratados em runService.
+*			O modelo tem de ser publicado antes com startModel
+* @param	pool		Conjunto de threads que executa os pedidos (NULL para os executar no ciclo de eventos)
+* @param	socketPath	Caminho do socket local (um ficheiro antigo com o mesmo nome  removido)
+* @return	Servio criado (ou NULL se no foi possvel)
+*/
+Service* createService(TaskPool* pool, char socketPath[])
+{
+	struct sockaddr_un address;
+
+	if (socketPath == NULL || strlen(socketPath) >= sizeof(address.sun_path))
+	{
+		return NULL;
+	}
+
+	Service* service = (Service*)calloc(1, sizeof(Service));
+	if (service == NULL)
+	{
+		return NULL;
+	}
+
+	service->pool = pool;
+	initTaskGroup(&service->tasks);
+	strcpy(service->socketPath, socketPath);
+
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	strcpy(address.sun_path, socketPath);
+	unlink(socketPath);
+
+	service->listenSocket = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	service->eventLoop = epoll_create1(EPOLL_CLOEXEC);
+	service->wakeUp = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+	struct epoll_event listenEvent = { .events = EPOLLIN, .data.ptr = NULL };
+	struct epoll_event wakeEvent = { .events = EPOLLIN, .data.ptr = &service->wakeUp };
+
+	if (service->listenSocket < 0 || service->eventLoop < 0 || service->wakeUp < 0
+		|| bind(service->listenSocket, (struct sockaddr*)&address, sizeof(address)) != 0
+		|| listen(service->listenSocket, SOMAXCONN) != 0
+		|| epoll_ctl(service->eventLoop, EPOLL_CTL_ADD, service->listenSocket, &listenEvent) != 0
+		|| epoll_ctl(service->eventLoop, EPOLL_CTL_ADD, service->wakeUp, &wakeEvent) != 0)
+	{
+		freeService(service);
+		return NULL;
+	}
+
+	return service;
+}
+
+/**
+* @brief	Executar o ciclo de eventos na thread atual, at stopService ser chamada
+* @param	service	Servio
+* @return	Booleano para o resultado da funo (falso se o ciclo de eventos falhou)
+*/
+bool runService(Service* service)
+{
+	if (service == NULL)
+	{
+		return false;
+	}
+
+	struct epoll_event events[SERVICE_MAX_EVENTS];
+	bool failed = false;
+
+	while (!atomicLoad(&service->stop))
+	{
+		int count = epoll_wait(service->eventLoop, events, SERVICE_MAX_EVENTS, -1);
+		if (count < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			failed = true;
+			break;
+		}
+
+		for (int i = 0; i < count; i++)
+		{
+			if (events[i].data.ptr == NULL)
+			{
+				acceptConnections(service);
+				continue;
+			}
+			if (events[i].data.ptr == &service->wakeUp)
+			{
+				continue; // stopService: o ciclo termina a seguir
+			}
+
+			ServiceConnection* connection = (ServiceConnection*)events[i].data.ptr;
+			bool open = (events[i].events & (EPOLLERR | EPOLLHUP)) == 0 || (events[i].events & EPOLLIN) != 0;
+
+			if (open && (events[i].events & EPOLLOUT))
+			{
+				lockMutex(&connection->lock);
+				flushConnection(connection);
+				unlockMutex(&connection->lock);
+			}
+
+			if (open && (events[i].events & EPOLLIN))
+			{
+				open = readConnection(service, connection);
+			}
+
+			if (!open)
+			{
+				closeConnection(service, connection);
+			}
+		}
+	}
+
+	// esperar pelos pedidos em curso antes de fechar as ligaes
+	if (service->pool != NULL)
+	{
+		waitTaskGroup(service->pool, &service->tasks);
+	}
+
+	while (service->connections != NULL)
+	{
+		closeConnection(service, service->connections);
+	}
+
+	return !failed;
+}
+
+/**
+* @brief	Pedir ao ciclo de eventos para terminar (pode ser chamada de qualquer thread)
+* @param	service	Servio
+*/
+void stopService(Service* service)
+{
+	if (service == NULL)
+	{
+		return;
+	}
+
+	uint64_t one = 1;
+
+	atomicStore(&service->stop, 1);
+	if (write(service->wakeUp, &one, sizeof(one)) < 0)
+	{
+		// o contador j tem um aviso pendente, o ciclo vai acordar na mesma
+	}
+}
+
+/**
+* @brief	Libertar o servio, fechando o socket local (depois de runService terminar)
+* @param	service	Servio
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool freeService(Service* service)
+{
+	if (service == NULL)
+	{
+		return false;
+	}
+
+	if (service->listenSocket >= 0)
+	{
+		close(service->listenSocket);
+		unlink(service->socketPath);
+	}
+	if (service->eventLoop >= 0)
+	{
+		close(service->eventLoop);
+	}
+	if (service->wakeUp >= 0)
+	{
+		close(service->wakeUp);
+	}
+
+	free(service);
+
+	return true;
+}
+
+#pragma endregion
+
+#else
+
+#pragma region servio
+
+/**
+* @brief	O modo de servio usa epoll e sockets locais, que s existem em Linux
+* @return	NULL
+*/
+Service* createService(TaskPool* pool, char socketPath[])
+{
+	return NULL;
+}
+
+bool runService(Service* service)
+{
+	return false;
+}
+
+void stopService(Service* service)
+{
+}
+
+bool freeService(Service* service)
+{
+	return false;
+}
+
+#pragma endregion
+
+#endif
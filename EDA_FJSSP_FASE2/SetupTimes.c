@@ -0,0 +1,486 @@
+/**
+ * @brief	Ficheiro com as funes dos tempos de preparao das mquinas, dependentes da sequncia das operaes
+ * @file	setuptimes.c
+ * @author	Vnia Pereira
+ * @email	a19264@alunos.ipca.pt
+ * @date	2022
+ * @Disciplina Estruturas de Dados Avanadas
+ *
+ * -----------------
+ *
+ * Cada operao pertence a uma famlia (0, 1, 2, ...). Quando uma mquina passa de uma operao da famlia f
+ * para uma da famlia g, gasta o tempo de preparao da sua matriz na posio (f, g).
+ *
+ * Cada mquina tem a sua matriz, guardada de uma de duas formas:
+ *	- esparsa: conjunto de chaves f * famlias + g -> tempo, s com as transies que tm tempo;
+ *	- densa: array de famlias x famlias inteiros pequenos (unsigned short).
+ * A matriz comea esparsa e passa a densa quando o conjunto de chaves passa a ocupar mais memria do que o array
+ * (cerca de 1 / 16 das transies com tempo). As duas formas so consultadas em tempo constante.
+ * Transies sem tempo definido, e operaes sem famlia, no tm preparao.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "header.h"
+
+
+#pragma region matrizes de preparao
+
+/**
+* @brief	Criar os tempos de preparao, sem famlias atribudas nem matrizes
+* @param	numberOfFamilies	Quantidade de famlias de operaes
+* @return	Tempos de preparao criados (ou NULL se no houver memria)
+*/
+SetupTimes* createSetupTimes(int numberOfFamilies)
+{
+	if (numberOfFamilies <= 0)
+	{
+		return NULL;
+	}
+
+	SetupTimes* setups = (SetupTimes*)calloc(1, sizeof(SetupTimes));
+	if (setups == NULL) // se no houver memria para alocar
+	{
+		return NULL;
+	}
+
+	setups->numberOfFamilies = numberOfFamilies;
+	setups->capacity = 8;
+	setups->machines = (SetupMatrix*)malloc(setups->capacity * sizeof(SetupMatrix));
+	setups->positions = createKeySet(setups->capacity);
+	setups->families = createKeySet(64);
+
+	if (setups->machines == NULL || setups->positions == NULL || setups->families == NULL)
+	{
+		freeSetupTimes(setups);
+		return NULL;
+	}
+
+	return setups;
+}
+
+
+/**
+* @brief	Libertar os tempos de preparao da memria
+* @param	setups	Tempos de preparao
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool freeSetupTimes(SetupTimes* setups)
+{
+	if (setups == NULL)
+	{
+		return false;
+	}
+
+	for (int i = 0; i < setups->numberOfMachines; i++)
+	{
+		free(setups->machines[i].dense);
+		freeKeySet(setups->machines[i].sparse);
+	}
+
+	free(setups->machines);
+	freeKeySet(setups->positions);
+	freeKeySet(setups->families);
+	free(setups);
+
+	return true;
+}
+
+
+/**
+* @brief	Atribuir uma famlia a uma operao
+* @param	setups			Tempos de preparao
+* @param	operationID		Identificador da operao
+* @param	family			Famlia (de 0 a numberOfFamilies - 1)
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool setOperationFamily(SetupTimes* setups, int operationID, int family)
+{
+	if (setups == NULL || family < 0 || family >= setups->numberOfFamilies)
+	{
+		return false;
+	}
+
+	return setKeyValue(setups->families, operationID, family);
+}
+
+
+/**
+* @brief	Obter a famlia de uma operao
+* @param	setups			Tempos de preparao
+* @param	operationID		Identificador da operao
+* @return	Famlia (ou -1 se a operao no tiver famlia)
+*/
+int getOperationFamily(SetupTimes* setups, int operationID)
+{
+	if (setups == NULL)
+	{
+		return -1;
+	}
+
+	return getKeyValue(setups->families, operationID);
+}
+
+
+/**
+* @brief	Obter a matriz de preparao de uma mquina
+* @param	setups		Tempos de preparao
+* @param	machineID	Identificador da mquina
+* @param	create		Se a matriz deve ser criada (vazia e esparsa) quando no existir
+* @return	Matriz (ou NULL se no existir e no foi criada)
+*/
+SetupMatrix* getSetupMatrix(SetupTimes* setups, int machineID, bool create)
+{
+	if (setups == NULL)
+	{
+		return NULL;
+	}
+
+	int position = getKeyValue(setups->positions, machineID);
+	if (position >= 0)
+	{
+		return &setups->machines[position];
+	}
+
+	if (!create)
+	{
+		return NULL;
+	}
+
+	if (setups->numberOfMachines == setups->capacity)
+	{
+		SetupMatrix* machines = (SetupMatrix*)realloc(setups->machines, setups->capacity * 2 * sizeof(SetupMatrix));
+		if (machines == NULL) // se no houver memria para alocar
+		{
+			return NULL;
+		}
+
+		setups->machines = machines;
+		setups->capacity *= 2;
+	}
+
+	SetupMatrix* matrix = &setups->machines[setups->numberOfMachines];
+	matrix->machineID = machineID;
+	matrix->numberOfFamilies = setups->numberOfFamilies;
+	matrix->dense = NULL;
+	matrix->sparse = createKeySet(16);
+
+	if (matrix->sparse == NULL)
+	{
+		return NULL;
+	}
+
+	insertKey(setups->positions, machineID, setups->numberOfMachines++);
+
+	return matrix;
+}
+
+
+/**
+* @brief	Obter a memria ocupada pelo conjunto de chaves de uma matriz esparsa
+*/
+static long long getSparseMemory(KeySet* sparse)
+{
+	return (long long)sparse->capacity * (sizeof(long long) + sizeof(int) + sizeof(bool));
+}
+
+
+/**
+* @brief	Passar uma matriz esparsa para a forma densa
+* @param	matrix	Matriz
+* @return	Booleano para o resultado da funo (falso se no houver memria; a matriz continua esparsa)
+*/
+static bool convertToDense(SetupMatrix* matrix)
+{
+	int families = matrix->numberOfFamilies;
+	unsigned short* dense = (unsigned short*)calloc((size_t)families * families, sizeof(unsigned short));
+
+	if (dense == NULL) // se no houver memria para alocar
+	{
+		return false;
+	}
+
+	KeySet* sparse = matrix->sparse;
+	for (int i = 0; i < sparse->capacity; i++)
+	{
+		if (sparse->used[i])
+		{
+			dense[sparse->keys[i]] = (unsigned short)sparse->values[i];
+		}
+	}
+
+	freeKeySet(sparse);
+	matrix->sparse = NULL;
+	matrix->dense = dense;
+
+	return true;
+}
+
+
+/**
+* @brief	Definir o tempo de preparao de uma mquina ao passar de uma famlia para outra
+* @param	setups		Tempos de preparao
+* @param	machineID	Identificador da mquina
+* @param	fromFamily	Famlia da operao anterior
+* @param	toFamily	Famlia da operao seguinte
+* @param	time		Tempo de preparao (de 0 a SETUP_MAX_TIME)
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool setSetupTime(SetupTimes* setups, int machineID, int fromFamily, int toFamily, int time)
+{
+	if (setups == NULL || fromFamily < 0 || toFamily < 0 || fromFamily >= setups->numberOfFamilies || toFamily >= setups->numberOfFamilies
+		|| time < 0 || time > SETUP_MAX_TIME)
+	{
+		return false;
+	}
+
+	SetupMatrix* matrix = getSetupMatrix(setups, machineID, true);
+	if (matrix == NULL)
+	{
+		return false;
+	}
+
+	long long key = (long long)fromFamily * matrix->numberOfFamilies + toFamily;
+
+	if (matrix->dense != NULL)
+	{
+		matrix->dense[key] = (unsigned short)time;
+		return true;
+	}
+
+	if (!setKeyValue(matrix->sparse, key, time))
+	{
+		return false;
+	}
+
+	// a forma densa passa a ocupar menos memria
+	if (getSparseMemory(matrix->sparse) >= (long long)matrix->numberOfFamilies * matrix->numberOfFamilies * (long long)sizeof(unsigned short))
+	{
+		convertToDense(matrix);
+	}
+
+	return true;
+}
+
+
+/**
+* @brief	Obter o tempo de preparao numa matriz, em tempo constante
+* @param	matrix		Matriz (ou NULL se a mquina no tiver tempos de preparao)
+* @param	fromFamily	Famlia da operao anterior (-1 se no houver operao anterior ou no tiver famlia)
+* @param	toFamily	Famlia da operao seguinte (-1 se no tiver famlia)
+* @return	Tempo de preparao (0 se no estiver definido)
+*/
+int getSetupTime_AtMatrix(const SetupMatrix* matrix, int fromFamily, int toFamily)
+{
+	if (matrix == NULL || fromFamily < 0 || toFamily < 0 || fromFamily >= matrix->numberOfFamilies || toFamily >= matrix->numberOfFamilies)
+	{
+		return 0;
+	}
+
+	long long key = (long long)fromFamily * matrix->numberOfFamilies + toFamily;
+
+	if (matrix->dense != NULL)
+	{
+		return matrix->dense[key];
+	}
+
+	int time = getKeyValue(matrix->sparse, key);
+
+	return time > 0 ? time : 0;
+}
+
+
+/**
+* @brief	Obter o tempo de preparao de uma mquina ao passar de uma famlia para outra
+* @param	setups		Tempos de preparao
+* @param	machineID	Identificador da mquina
+* @param	fromFamily	Famlia da operao anterior
+* @param	toFamily	Famlia da operao seguinte
+* @return	Tempo de preparao (0 se no estiver definido)
+*/
+int getSetupTime(SetupTimes* setups, int machineID, int fromFamily, int toFamily)
+{
+	return getSetupTime_AtMatrix(getSetupMatrix(setups, machineID, false), fromFamily, toFamily);
+}
+
+
+/**
+* @brief	Obter a memria ocupada pelas matrizes de preparao
+* @param	setups	Tempos de preparao
+* @return	Quantidade de bytes
+*/
+long long getSetupTimesMemory(SetupTimes* setups)
+{
+	long long bytes = 0;
+
+	if (setups == NULL)
+	{
+		return 0;
+	}
+
+	for (int i = 0; i < setups->numberOfMachines; i++)
+	{
+		SetupMatrix* matrix = &setups->machines[i];
+
+		if (matrix->dense != NULL)
+		{
+			bytes += (long long)matrix->numberOfFamilies * matrix->numberOfFamilies * sizeof(unsigned short);
+		}
+		else
+		{
+			bytes += getSparseMemory(matrix->sparse);
+		}
+	}
+
+	return bytes;
+}
+
+#pragma endregion
+
+
+#pragma region ficheiros
+
+/**
+* @brief	Armazenar as famlias das operaes e os tempos de preparao em ficheiros binrios
+* @param	familiesFileName	Nome do ficheiro das famlias das operaes
+* @param	setupsFileName		Nome do ficheiro dos tempos de preparao
+* @param	setups				Tempos de preparao
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool writeSetupTimes(char familiesFileName[], char setupsFileName[], SetupTimes* setups)
+{
+	if (setups == NULL)
+	{
+		return false;
+	}
+
+	FILE* file = NULL;
+
+	if ((file = fopen(familiesFileName, "wb")) == NULL) // erro ao abrir o ficheiro
+	{
+		return false;
+	}
+
+	FileOperationFamily familyInFile;
+
+	for (int i = 0; i < setups->families->capacity; i++)
+	{
+		if (setups->families->used[i])
+		{
+			familyInFile.operationID = (int)setups->families->keys[i];
+			familyInFile.family = setups->families->values[i];
+
+			fwrite(&familyInFile, sizeof(FileOperationFamily), 1, file);
+		}
+	}
+
+	fclose(file);
+
+	if ((file = fopen(setupsFileName, "wb")) == NULL)
+	{
+		return false;
+	}
+
+	FileSetupTime currentInFile;
+
+	for (int i = 0; i < setups->numberOfMachines; i++)
+	{
+		SetupMatrix* matrix = &setups->machines[i];
+		int families = matrix->numberOfFamilies;
+
+		currentInFile.machineID = matrix->machineID;
+
+		if (matrix->dense != NULL)
+		{
+			for (long long k = 0; k < (long long)families * families; k++)
+			{
+				if (matrix->dense[k] != 0)
+				{
+					currentInFile.fromFamily = (int)(k / families);
+					currentInFile.toFamily = (int)(k % families);
+					currentInFile.time = matrix->dense[k];
+
+					fwrite(&currentInFile, sizeof(FileSetupTime), 1, file);
+				}
+			}
+		}
+		else
+		{
+			for (int k = 0; k < matrix->sparse->capacity; k++)
+			{
+				if (matrix->sparse->used[k] && matrix->sparse->values[k] != 0)
+				{
+					currentInFile.fromFamily = (int)(matrix->sparse->keys[k] / families);
+					currentInFile.toFamily = (int)(matrix->sparse->keys[k] % families);
+					currentInFile.time = matrix->sparse->values[k];
+
+					fwrite(&currentInFile, sizeof(FileSetupTime), 1, file);
+				}
+			}
+		}
+	}
+
+	fclose(file);
+
+	return true;
+}
+
+
+/**
+* @brief	Ler as famlias das operaes e os tempos de preparao de ficheiros binrios.
+*			A quantidade de famlias  a maior famlia encontrada nos dois ficheiros, mais um
+* @param	familiesFileName	Nome do ficheiro das famlias das operaes
+* @param	setupsFileName		Nome do ficheiro dos tempos de preparao
+* @return	Tempos de preparao (ou NULL se no foi possvel ler os ficheiros)
+*/
+SetupTimes* readSetupTimes(char familiesFileName[], char setupsFileName[])
+{
+	FILE* familiesFile = fopen(familiesFileName, "rb");
+	FILE* setupsFile = fopen(setupsFileName, "rb");
+
+	if (familiesFile == NULL || setupsFile == NULL) // erro ao abrir os ficheiros
+	{
+		if (familiesFile != NULL) fclose(familiesFile);
+		if (setupsFile != NULL) fclose(setupsFile);
+		return NULL;
+	}
+
+	// primeira passagem: quantidade de famlias
+	int numberOfFamilies = 0;
+	FileOperationFamily familyInFile;
+	FileSetupTime currentInFile;
+
+	while (fread(&familyInFile, sizeof(FileOperationFamily), 1, familiesFile))
+	{
+		if (familyInFile.family >= numberOfFamilies) numberOfFamilies = familyInFile.family + 1;
+	}
+	while (fread(&currentInFile, sizeof(FileSetupTime), 1, setupsFile))
+	{
+		if (currentInFile.fromFamily >= numberOfFamilies) numberOfFamilies = currentInFile.fromFamily + 1;
+		if (currentInFile.toFamily >= numberOfFamilies) numberOfFamilies = currentInFile.toFamily + 1;
+	}
+
+	SetupTimes* setups = createSetupTimes(numberOfFamilies > 0 ? numberOfFamilies : 1);
+
+	// segunda passagem: registos (os invlidos so ignorados)
+	rewind(familiesFile);
+	rewind(setupsFile);
+
+	while (setups != NULL && fread(&familyInFile, sizeof(FileOperationFamily), 1, familiesFile))
+	{
+		setOperationFamily(setups, familyInFile.operationID, familyInFile.family);
+	}
+	while (setups != NULL && fread(&currentInFile, sizeof(FileSetupTime), 1, setupsFile))
+	{
+		setSetupTime(setups, currentInFile.machineID, currentInFile.fromFamily, currentInFile.toFamily, currentInFile.time);
+	}
+
+	fclose(familiesFile);
+	fclose(setupsFile);
+
+	return setups;
+}
+
+#pragma endregion
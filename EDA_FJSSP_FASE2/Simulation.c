@@ -0,0 +1,711 @@
+/**
+ * @brief	Ficheiro com as funes da simulao por eventos discretos da execuo de um plano
+ * @file	simulation.c
+ * @author	Vnia Pereira
+ * @email	a19264@alunos.ipca.pt
+ * @date	2022
+ * @Disciplina Estruturas de Dados Avanadas
+ *
+ * -----------------
+ *
+ * A simulao repete um plano (mquina escolhida para cada operao e ordem das operaes em cada mquina)
+ * com tempos aleatrios,  volta do tempo de cada execuo, para estimar o fim do plano e os atrasos.
+ *
+ * O nico evento  o fim de uma operao. Os eventos ficam num monte radix: como o tempo da simulao nunca
+ * anda para trs, cada evento  guardado no balde do bit mais significativo em que difere do ltimo tempo retirado,
+ * e s o balde menor no vazio  redistribudo. Cada evento  movido, no mximo, 32 vezes.
+ *
+ * Cada mquina passa pelos estados:
+ *	MACHINE_WAITING -> MACHINE_BUSY		quando a operao seguinte da mquina pode comear (a anterior do trabalho j acabou)
+ *	MACHINE_BUSY -> MACHINE_WAITING		quando a operao acaba e a mquina ainda tem operaes
+ *	MACHINE_BUSY -> MACHINE_FINISHED	quando a operao acaba e era a ltima da mquina
+ * O progresso de cada trabalho  a posio da sua prxima operao.
+ *
+ * A simulao (s de leitura)  partilhada pelas threads; cada thread tem o seu estado, reutilizado entre repeties.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#include "header.h"
+
+
+#pragma region monte radix
+
+/**
+* @brief	Obter o balde de uma chave no monte radix (posio do bit mais significativo em que difere do ltimo tempo, mais um)
+* @param	key		Chave
+* @param	last	ltimo tempo retirado do monte
+* @return	Balde (0 se a chave for igual ao ltimo tempo)
+*/
+static int getRadixHeapBucket(unsigned int key, unsigned int last)
+{
+	unsigned int difference = key ^ last;
+
+	if (difference == 0)
+	{
+		return 0;
+	}
+
+#if defined(_MSC_VER)
+	unsigned long bit;
+	_BitScanReverse(&bit, difference);
+	return (int)bit + 1;
+#elif defined(__GNUC__)
+	return 32 - __builtin_clz(difference);
+#else
+	int bucket = 0;
+	while (difference != 0)
+	{
+		difference >>= 1;
+		bucket++;
+	}
+	return bucket;
+#endif
+}
+
+
+/**
+* @brief	Acrescentar um elemento a um balde do monte radix
+*/
+static bool appendRadixHeapBucket(RadixHeapBucket* bucket, unsigned int key, int value)
+{
+	if (bucket->count == bucket->capacity)
+	{
+		int capacity = bucket->capacity > 0 ? bucket->capacity * 2 : 16;
+		RadixHeapItem* items = (RadixHeapItem*)realloc(bucket->items, capacity * sizeof(RadixHeapItem));
+		if (items == NULL) // se no houver memria para alocar
+		{
+			return false;
+		}
+
+		bucket->items = items;
+		bucket->capacity = capacity;
+	}
+
+	bucket->items[bucket->count].key = key;
+	bucket->items[bucket->count].value = value;
+	bucket->count++;
+
+	return true;
+}
+
+
+/**
+* @brief	Iniciar um monte radix vazio
+* @param	heap	Apontador para o monte
+*/
+void initRadixHeap(RadixHeap* heap)
+{
+	memset(heap, 0, sizeof(RadixHeap));
+}
+
+
+/**
+* @brief	Esvaziar o monte radix, mantendo a memria dos baldes
+* @param	heap	Apontador para o monte
+*/
+void clearRadixHeap(RadixHeap* heap)
+{
+	for (int i = 0; i < RADIX_HEAP_BUCKETS; i++)
+	{
+		heap->buckets[i].count = 0;
+	}
+
+	heap->last = 0;
+	heap->count = 0;
+}
+
+
+/**
+* @brief	Inserir um elemento no monte radix
+* @param	heap	Apontador para o monte
+* @param	key		Chave (no pode ser menor que a ltima chave retirada)
+* @param	value	Valor
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool pushRadixHeap(RadixHeap* heap, unsigned int key, int value)
+{
+	if (key < heap->last)
+	{
+		return false;
+	}
+
+	if (!appendRadixHeapBucket(&heap->buckets[getRadixHeapBucket(key, heap->last)], key, value))
+	{
+		return false;
+	}
+
+	heap->count++;
+
+	return true;
+}
+
+
+/**
+* @brief	Retirar o elemento com a menor chave do monte radix
+* @param	heap	Apontador para o monte
+* @param	key		Apontador para a chave retirada
+* @param	value	Apontador para o valor retirado
+* @return	Booleano para o resultado da funo (falso se o monte estiver vazio)
+*/
+bool popRadixHeap(RadixHeap* heap, unsigned int* key, int* value)
+{
+	if (heap->count == 0)
+	{
+		return false;
+	}
+
+	if (heap->buckets[0].count == 0)
+	{
+		// redistribuir o primeiro balde no vazio,  volta da sua menor chave
+		int i = 1;
+		while (heap->buckets[i].count == 0)
+		{
+			i++;
+		}
+
+		RadixHeapBucket* bucket = &heap->buckets[i];
+		unsigned int minimum = bucket->items[0].key;
+
+		for (int k = 1; k < bucket->count; k++)
+		{
+			if (bucket->items[k].key < minimum)
+			{
+				minimum = bucket->items[k].key;
+			}
+		}
+
+		heap->last = minimum;
+
+		// todos os elementos vo para baldes menores que i, que esto vazios
+		for (int k = 0; k < bucket->count; k++)
+		{
+			if (!appendRadixHeapBucket(&heap->buckets[getRadixHeapBucket(bucket->items[k].key, minimum)], bucket->items[k].key, bucket->items[k].value))
+			{
+				return false;
+			}
+		}
+
+		bucket->count = 0;
+	}
+
+	RadixHeapBucket* first = &heap->buckets[0];
+	first->count--;
+	*key = first->items[first->count].key;
+	*value = first->items[first->count].value;
+	heap->count--;
+
+	return true;
+}
+
+
+/**
+* @brief	Libertar a memria dos baldes do monte radix
+* @param	heap	Apontador para o monte
+*/
+void freeRadixHeap(RadixHeap* heap)
+{
+	for (int i = 0; i < RADIX_HEAP_BUCKETS; i++)
+	{
+		free(heap->buckets[i].items);
+	}
+
+	initRadixHeap(heap);
+}
+
+#pragma endregion
+
+
+#pragma region preparar simulao
+
+/**
+* @brief	Comparar duas operaes da mesma mquina pelo incio planeado (para qsort)
+*/
+static int compareSequenceEntries(const void* first, const void* second)
+{
+	const long long a = *(const long long*)first;
+	const long long b = *(const long long*)second;
+
+	return (a > b) - (a < b);
+}
+
+
+/**
+* @brief	Preparar a simulao de um plano sobre a imagem compilada do problema
+* @param	snapshot		Imagem compilada do problema (tem de existir enquanto a simulao existir)
+* @param	alternatives	Alternativa escolhida para cada operao (ndice nas alternativas da imagem, pela posio da operao)
+* @param	starts			Incio planeado de cada operao (define a ordem das operaes em cada mquina)
+* @return	Simulao criada (ou NULL se o plano for invlido ou no houver memria)
+*/
+Simulation* createSimulation(ProblemSnapshot* snapshot, int alternatives[], int starts[])
+{
+	if (snapshot == NULL || alternatives == NULL || starts == NULL)
+	{
+		return NULL;
+	}
+
+	int numberOfOperations = snapshot->header->numberOfOperations;
+	int numberOfMachines = snapshot->header->numberOfMachines;
+
+	Simulation* simulation = (Simulation*)calloc(1, sizeof(Simulation));
+	long long* entries = (long long*)malloc((numberOfOperations > 0 ? numberOfOperations : 1) * sizeof(long long));
+
+	if (simulation == NULL || entries == NULL) // se no houver memria para alocar
+	{
+		free(simulation);
+		free(entries);
+		return NULL;
+	}
+
+	simulation->snapshot = snapshot;
+	simulation->numberOfOperations = numberOfOperations;
+	simulation->numberOfMachines = numberOfMachines;
+	simulation->numberOfJobs = snapshot->header->numberOfJobs;
+	simulation->operations = (SimulationOperation*)malloc((numberOfOperations > 0 ? numberOfOperations : 1) * sizeof(SimulationOperation));
+	simulation->machineSequenceStarts = (int*)calloc(numberOfMachines + 1, sizeof(int));
+	simulation->machineSequences = (int*)malloc((numberOfOperations > 0 ? numberOfOperations : 1) * sizeof(int));
+
+	if (simulation->operations == NULL || simulation->machineSequenceStarts == NULL || simulation->machineSequences == NULL)
+	{
+		free(entries);
+		freeSimulation(simulation);
+		return NULL;
+	}
+
+	for (int i = 0; i < numberOfOperations; i++)
+	{
+		int alternative = alternatives[i];
+
+		if (alternative < snapshot->operationAlternativeStarts[i] || alternative >= snapshot->operationAlternativeStarts[i + 1] || starts[i] < 0)
+		{
+			free(entries);
+			freeSimulation(simulation);
+			return NULL;
+		}
+
+		simulation->operations[i].machine = snapshot->alternativeMachines[alternative];
+		simulation->operations[i].job = snapshot->operationJobs[i];
+		simulation->operations[i].runtime = snapshot->alternativeRuntimes[alternative];
+		simulation->machineSequenceStarts[simulation->operations[i].machine + 1]++;
+
+		// mquina, incio planeado e posio da operao numa s chave, para ordenar tudo de uma vez
+		entries[i] = ((long long)simulation->operations[i].machine << 52) | ((long long)starts[i] << 21) | i;
+	}
+
+	for (int m = 0; m < numberOfMachines; m++)
+	{
+		simulation->machineSequenceStarts[m + 1] += simulation->machineSequenceStarts[m];
+	}
+
+	if (numberOfMachines < (1 << 11) && numberOfOperations < (1 << 21))
+	{
+		qsort(entries, numberOfOperations, sizeof(long long), compareSequenceEntries);
+
+		for (int i = 0; i < numberOfOperations; i++)
+		{
+			simulation->machineSequences[i] = (int)(entries[i] & ((1 << 21) - 1));
+		}
+	}
+	else // o plano no cabe na chave compacta, ordenao por insero em cada mquina
+	{
+		int* next = (int*)malloc((numberOfMachines > 0 ? numberOfMachines : 1) * sizeof(int));
+		if (next == NULL)
+		{
+			free(entries);
+			freeSimulation(simulation);
+			return NULL;
+		}
+
+		memcpy(next, simulation->machineSequenceStarts, numberOfMachines * sizeof(int));
+
+		for (int i = 0; i < numberOfOperations; i++)
+		{
+			int machine = simulation->operations[i].machine;
+			int k = next[machine]++;
+
+			while (k > simulation->machineSequenceStarts[machine] && starts[simulation->machineSequences[k - 1]] > starts[i])
+			{
+				simulation->machineSequences[k] = simulation->machineSequences[k - 1];
+				k--;
+			}
+
+			simulation->machineSequences[k] = i;
+		}
+
+		free(next);
+	}
+
+	free(entries);
+
+	return simulation;
+}
+
+
+/**
+* @brief	Libertar a simulao da memria (a imagem do problema no  libertada)
+* @param	simulation	Simulao
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool freeSimulation(Simulation* simulation)
+{
+	if (simulation == NULL)
+	{
+		return false;
+	}
+
+	free(simulation->operations);
+	free(simulation->machineSequenceStarts);
+	free(simulation->machineSequences);
+	free(simulation);
+
+	return true;
+}
+
+
+/**
+* @brief	Criar o estado de uma simulao (um por thread, reutilizado entre repeties)
+* @param	simulation	Simulao
+* @return	Estado criado (ou NULL se no houver memria)
+*/
+SimulationState* createSimulationState(Simulation* simulation)
+{
+	if (simulation == NULL)
+	{
+		return NULL;
+	}
+
+	SimulationState* state = (SimulationState*)malloc(sizeof(SimulationState));
+	if (state == NULL) // se no houver memria para alocar
+	{
+		return NULL;
+	}
+
+	state->machineStates = (MachineState*)malloc((simulation->numberOfMachines + 1) * sizeof(MachineState));
+	state->machineHeads = (int*)malloc((simulation->numberOfMachines + 1) * sizeof(int));
+	state->jobPositions = (int*)malloc((simulation->numberOfJobs + 1) * sizeof(int));
+	state->jobEnds = (int*)malloc((simulation->numberOfJobs + 1) * sizeof(int));
+	initRadixHeap(&state->events);
+
+	if (state->machineStates == NULL || state->machineHeads == NULL || state->jobPositions == NULL || state->jobEnds == NULL)
+	{
+		freeSimulationState(state);
+		return NULL;
+	}
+
+	return state;
+}
+
+
+/**
+* @brief	Libertar o estado de uma simulao da memria
+* @param	state	Estado
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool freeSimulationState(SimulationState* state)
+{
+	if (state == NULL)
+	{
+		return false;
+	}
+
+	free(state->machineStates);
+	free(state->machineHeads);
+	free(state->jobPositions);
+	free(state->jobEnds);
+	freeRadixHeap(&state->events);
+	free(state);
+
+	return true;
+}
+
+#pragma endregion
+
+
+#pragma region executar simulao
+
+/**
+* @brief	Gerar o prximo nmero aleatrio (xorshift64*)
+*/
+static unsigned int nextRandom(unsigned long long* random)
+{
+	*random ^= *random >> 12;
+	*random ^= *random << 25;
+	*random ^= *random >> 27;
+
+	return (unsigned int)((*random * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+
+/**
+* @brief	Obter o tempo de uma operao nesta repetio, uniforme em [tempo - variao, tempo + variao] (no mnimo 1)
+*/
+static int sampleRuntime(SimulationState* state, int runtime, int variation)
+{
+	int delta = (int)((long long)runtime * variation / 100);
+
+	if (delta <= 0)
+	{
+		return runtime;
+	}
+
+	int sample = runtime - delta + (int)(((unsigned long long)nextRandom(&state->random) * (unsigned int)(2 * delta + 1)) >> 32);
+
+	return sample > 0 ? sample : 1;
+}
+
+
+/**
+* @brief	Comear a operao seguinte de uma mquina, se a mquina estiver  espera e a operao anterior do trabalho j tiver acabado
+*/
+static bool tryStartMachine(Simulation* simulation, SimulationState* state, int machine, unsigned int time, int variation)
+{
+	if (state->machineStates[machine] != MACHINE_WAITING)
+	{
+		return true;
+	}
+
+	int operation = simulation->machineSequences[state->machineHeads[machine]];
+	SimulationOperation* current = &simulation->operations[operation];
+
+	if (simulation->snapshot->jobOperationStarts[current->job] + state->jobPositions[current->job] != operation)
+	{
+		return true; // a operao anterior do trabalho ainda no acabou
+	}
+
+	// a primeira operao de um trabalho no comea antes da data de disponibilidade
+	if (state->jobPositions[current->job] == 0 && (unsigned int)simulation->snapshot->jobReleaseDates[current->job] > time)
+	{
+		time = (unsigned int)simulation->snapshot->jobReleaseDates[current->job];
+	}
+
+	state->machineStates[machine] = MACHINE_BUSY;
+
+	return pushRadixHeap(&state->events, time + (unsigned int)sampleRuntime(state, current->runtime, variation), operation);
+}
+
+
+/**
+* @brief	Executar uma repetio da simulao
+* @param	simulation	Simulao
+* @param	state		Estado (reutilizado entre repeties)
+* @param	config		Configurao (variao dos tempos, semente e datas de entrega)
+* @param	replication	Nmero da repetio (repeties diferentes usam nmeros aleatrios diferentes)
+* @param	result		Apontador para o resultado da repetio
+* @return	Booleano para o resultado da funo (falso se o plano bloquear, por a ordem de uma mquina contrariar a ordem de um trabalho)
+*/
+bool runSimulation(Simulation* simulation, SimulationState* state, SimulationConfig* config, long long replication, SimulationResult* result)
+{
+	if (simulation == NULL || state == NULL || config == NULL || result == NULL)
+	{
+		return false;
+	}
+
+	const int* jobOperationStarts = simulation->snapshot->jobOperationStarts;
+	int variation = config->variation;
+	int completed = 0;
+	unsigned int time = 0;
+	int operation;
+
+	state->random = (config->seed ^ ((unsigned long long)(replication + 1) * 0x9E3779B97F4A7C15ull)) | 1;
+	clearRadixHeap(&state->events);
+	memset(state->jobPositions, 0, simulation->numberOfJobs * sizeof(int));
+	memset(state->jobEnds, 0, simulation->numberOfJobs * sizeof(int));
+
+	for (int m = 0; m < simulation->numberOfMachines; m++)
+	{
+		state->machineHeads[m] = simulation->machineSequenceStarts[m];
+		state->machineStates[m] = state->machineHeads[m] < simulation->machineSequenceStarts[m + 1] ? MACHINE_WAITING : MACHINE_FINISHED;
+
+		if (!tryStartMachine(simulation, state, m, 0, variation))
+		{
+			return false;
+		}
+	}
+
+	while (popRadixHeap(&state->events, &time, &operation))
+	{
+		SimulationOperation* current = &simulation->operations[operation];
+		int machine = current->machine;
+		int job = current->job;
+
+		completed++;
+
+		// a operao acabou: o trabalho avana e a mquina passa  operao seguinte
+		state->jobPositions[job]++;
+		state->jobEnds[job] = (int)time;
+
+		state->machineHeads[machine]++;
+		state->machineStates[machine] = state->machineHeads[machine] < simulation->machineSequenceStarts[machine + 1] ? MACHINE_WAITING : MACHINE_FINISHED;
+
+		if (!tryStartMachine(simulation, state, machine, time, variation))
+		{
+			return false;
+		}
+
+		int next = jobOperationStarts[job] + state->jobPositions[job];
+		if (next < jobOperationStarts[job + 1] && simulation->operations[next].machine != machine)
+		{
+			if (!tryStartMachine(simulation, state, simulation->operations[next].machine, time, variation))
+			{
+				return false;
+			}
+		}
+	}
+
+	result->events = completed;
+	result->makespan = (int)time;
+	result->weightedTardiness = 0;
+
+	// atraso ponderado, com as datas de entrega da configurao ou, se no houver, as dos trabalhos
+	const int* dueDates = config->dueDates != NULL ? config->dueDates : simulation->snapshot->jobDueDates;
+
+	for (int j = 0; j < simulation->numberOfJobs; j++)
+	{
+		if (state->jobEnds[j] > dueDates[j])
+		{
+			result->weightedTardiness += (long long)simulation->snapshot->jobWeights[j] * (state->jobEnds[j] - dueDates[j]);
+		}
+	}
+
+	return completed == simulation->numberOfOperations;
+}
+
+#pragma endregion
+
+
+#pragma region repeties de Monte Carlo em paralelo
+
+/**
+* @brief	Estrutura de dados para partilhar as repeties de Monte Carlo entre as threads
+*/
+typedef struct MonteCarloRun
+{
+	Simulation* simulation;
+	SimulationConfig* config;
+	int* makespans;
+	long long* tardiness;
+	long long* events;
+	volatile long failed; // repeties em que o plano bloqueou (ou faltou memria)
+} MonteCarloRun;
+
+
+/**
+* @brief	Executar um intervalo de repeties, com um s estado
+*/
+static void runReplications(int first, int last, void* argument)
+{
+	MonteCarloRun* run = (MonteCarloRun*)argument;
+	SimulationState* state = createSimulationState(run->simulation);
+
+	if (state == NULL)
+	{
+		atomicAdd(&run->failed, last - first);
+		return;
+	}
+
+	for (int i = first; i < last; i++)
+	{
+		SimulationResult result;
+
+		if (!runSimulation(run->simulation, state, run->config, i, &result))
+		{
+			atomicAdd(&run->failed, 1);
+			result.makespan = 0;
+			result.weightedTardiness = 0;
+			result.events = 0;
+		}
+
+		run->makespans[i] = result.makespan;
+		run->tardiness[i] = result.weightedTardiness;
+		run->events[i] = result.events;
+	}
+
+	freeSimulationState(state);
+}
+
+
+/**
+* @brief	Executar vrias repeties da simulao em paralelo e resumir os resultados
+* @param	pool			Conjunto de threads (ou NULL para usar s a thread atual)
+* @param	simulation		Simulao
+* @param	config			Configurao (variao dos tempos, semente e datas de entrega)
+* @param	replications	Quantidade de repeties
+* @param	makespans		Array para o fim do plano de cada repetio (ou NULL se no for necessrio)
+* @param	summary			Apontador para o resumo (mdia, desvio padro, mnimo e mximo do fim do plano, e mdia do atraso ponderado)
+* @return	Booleano para o resultado da funo (falso se alguma repetio falhar)
+*/
+bool runMonteCarlo_Parallel(TaskPool* pool, Simulation* simulation, SimulationConfig* config, int replications, int makespans[], MonteCarloSummary* summary)
+{
+	if (simulation == NULL || config == NULL || summary == NULL || replications <= 0)
+	{
+		return false;
+	}
+
+	MonteCarloRun run;
+	run.simulation = simulation;
+	run.config = config;
+	run.makespans = makespans != NULL ? makespans : (int*)malloc(replications * sizeof(int));
+	run.tardiness = (long long*)malloc(replications * sizeof(long long));
+	run.events = (long long*)malloc(replications * sizeof(long long));
+	run.failed = 0;
+
+	if (run.makespans == NULL || run.tardiness == NULL || run.events == NULL) // se no houver memria para alocar
+	{
+		if (makespans == NULL)
+		{
+			free(run.makespans);
+		}
+		free(run.tardiness);
+		free(run.events);
+		return false;
+	}
+
+	parallelFor(pool, 0, replications, 0, runReplications, &run);
+
+	double sum = 0;
+	double sumOfSquares = 0;
+	double tardiness = 0;
+
+	summary->replications = replications;
+	summary->minMakespan = run.makespans[0];
+	summary->maxMakespan = run.makespans[0];
+	summary->events = 0;
+
+	for (int i = 0; i < replications; i++)
+	{
+		sum += run.makespans[i];
+		sumOfSquares += (double)run.makespans[i] * run.makespans[i];
+		tardiness += (double)run.tardiness[i];
+		summary->events += run.events[i];
+
+		if (run.makespans[i] < summary->minMakespan)
+		{
+			summary->minMakespan = run.makespans[i];
+		}
+		if (run.makespans[i] > summary->maxMakespan)
+		{
+			summary->maxMakespan = run.makespans[i];
+		}
+	}
+
+	summary->meanMakespan = sum / replications;
+	summary->stdDevMakespan = sqrt(fmax(0, sumOfSquares / replications - summary->meanMakespan * summary->meanMakespan));
+	summary->meanWeightedTardiness = tardiness / replications;
+
+	if (makespans == NULL)
+	{
+		free(run.makespans);
+	}
+	free(run.tardiness);
+	free(run.events);
+
+	return run.failed == 0;
+}
+
+#pragma endregion
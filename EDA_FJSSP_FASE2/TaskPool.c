@@ -0,0 +1,530 @@
+/**
+ * @brief	Ficheiro com as funes do conjunto de threads com roubo de tarefas (work stealing)
+ * @file	taskpool.c
+ * @author	Vnia Pereira
+ * @email	a19264@alunos.ipca.pt
+ * @date	2022
+ * @Disciplina Estruturas de Dados Avanadas
+ *
+ * -----------------
+ *
+ * Cada thread tem a sua fila dupla de tarefas: retira as suas tarefas do fim (a mais recente primeiro)
+ * e, quando fica sem tarefas, rouba do incio da fila de outra thread (a mais antiga, normalmente a maior).
+ * As threads que no pertencem ao conjunto usam uma fila extra, a ltima do array.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "header.h"
+
+
+// conjunto e fila da thread atual (-1 se a thread no pertencer a nenhum conjunto)
+static THREAD_LOCAL TaskPool* currentPool = NULL;
+static THREAD_LOCAL int currentWorker = -1;
+
+/**
+ * @brief	Argumentos de cada thread do conjunto
+ */
+typedef struct TaskWorkerStart
+{
+	TaskPool* pool;
+	int index;
+} TaskWorkerStart;
+
+/**
+ * @brief	Estrutura de dados partilhada pelas tarefas de um ciclo paralelo
+ */
+typedef struct ParallelFor
+{
+	TaskPool* pool;
+	TaskGroup* group;
+	RangeFunction function;
+	void* argument;
+	int grainSize;
+	ParallelForRange* ranges; // intervalos criados pelas divises
+	volatile long numberOfRanges;
+} ParallelFor;
+
+
+#pragma region filas de tarefas
+
+/**
+* @brief	Iniciar uma fila dupla de tarefas vazia
+* @param	deque	Fila de tarefas
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+static bool initTaskDeque(TaskDeque* deque)
+{
+	deque->capacity = TASK_DEQUE_CAPACITY;
+	deque->tasks = (Task*)malloc(deque->capacity * sizeof(Task));
+	deque->top = 0;
+	deque->bottom = 0;
+	initMutex(&deque->lock.mutex);
+
+	return deque->tasks != NULL;
+}
+
+
+/**
+* @brief	Inserir uma tarefa no fim da fila (usado pela dona da fila), aumentando a fila se estiver cheia
+* @param	deque	Fila de tarefas
+* @param	task	Tarefa
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+static bool pushTask(TaskDeque* deque, Task task)
+{
+	lockMutex(&deque->lock.mutex);
+
+	if (deque->bottom - deque->top == deque->capacity) // fila cheia, duplicar a capacidade do buffer circular
+	{
+		Task* tasks = (Task*)malloc(deque->capacity * 2 * sizeof(Task));
+		if (tasks == NULL)
+		{
+			unlockMutex(&deque->lock.mutex);
+			return false;
+		}
+
+		for (int i = deque->top; i < deque->bottom; i++)
+		{
+			tasks[i % (deque->capacity * 2)] = deque->tasks[i % deque->capacity];
+		}
+
+		free(deque->tasks);
+		deque->tasks = tasks;
+		deque->capacity *= 2;
+	}
+
+	deque->tasks[deque->bottom % deque->capacity] = task;
+	deque->bottom++;
+
+	unlockMutex(&deque->lock.mutex);
+
+	return true;
+}
+
+
+/**
+* @brief	Retirar uma tarefa da fila, do fim (pela dona da fila) ou do incio (por outra thread, roubo)
+* @param	deque	Fila de tarefas
+* @param	steal	Se a tarefa  roubada por outra thread
+* @param	task	Apontador para a tarefa retirada
+* @return	Booleano para o resultado da funo (falso se a fila estiver vazia)
+*/
+static bool takeTask(TaskDeque* deque, bool steal, Task* task)
+{
+	lockMutex(&deque->lock.mutex);
+
+	bool taken = deque->bottom > deque->top;
+
+	if (taken)
+	{
+		if (steal)
+		{
+			*task = deque->tasks[deque->top % deque->capacity];
+			deque->top++;
+		}
+		else
+		{
+			deque->bottom--;
+			*task = deque->tasks[deque->bottom % deque->capacity];
+		}
+
+		// manter os ndices pequenos, para no ultrapassarem o limite do int
+		if (deque->top == deque->bottom)
+		{
+			deque->top = 0;
+			deque->bottom = 0;
+		}
+	}
+
+	unlockMutex(&deque->lock.mutex);
+
+	return taken;
+}
+
+#pragma endregion
+
+
+#pragma region execuo de tarefas
+
+/**
+* @brief	Obter o ndice da fila usada pela thread atual
+* @param	pool	Conjunto de threads
+* @return	ndice da fila
+*/
+static int getCurrentDeque(TaskPool* pool)
+{
+	// as threads fora do conjunto partilham a ltima fila
+	return currentPool == pool ? currentWorker : pool->numberOfWorkers;
+}
+
+
+/**
+* @brief	Procurar uma tarefa: primeiro na fila prpria, depois roubando das outras filas
+* @param	pool	Conjunto de threads
+* @param	self	ndice da fila da thread atual
+* @param	task	Apontador para a tarefa encontrada
+* @return	Booleano para o resultado da funo (se encontrou ou no)
+*/
+static bool findTask(TaskPool* pool, int self, Task* task)
+{
+	bool found = takeTask(&pool->deques[self], false, task);
+
+	// comear o roubo numa fila diferente para cada thread, para as threads no disputarem a mesma vtima
+	for (int i = 1; !found && i <= pool->numberOfWorkers; i++)
+	{
+		int victim = (self + i) % (pool->numberOfWorkers + 1);
+		found = takeTask(&pool->deques[victim], true, task);
+	}
+
+	if (found)
+	{
+		atomicAdd(&pool->queuedTasks, -1);
+	}
+
+	return found;
+}
+
+
+/**
+* @brief	Executar uma tarefa e avisar o seu grupo que terminou
+* @param	task	Tarefa
+*/
+static void runTask(Task* task)
+{
+	task->function(task->argument);
+
+	if (task->group != NULL)
+	{
+		atomicAdd(&task->group->pending, -1);
+	}
+}
+
+
+/**
+* @brief	Ciclo de cada thread do conjunto: executar tarefas, ou dormir enquanto no houver nenhuma
+* @param	data	Argumentos da thread (TaskWorkerStart)
+*/
+static void runTaskWorker(void* data)
+{
+	TaskWorkerStart start = *(TaskWorkerStart*)data;
+	TaskPool* pool = start.pool;
+	Task task;
+
+	free(data);
+
+	currentPool = pool;
+	currentWorker = start.index;
+
+	while (!atomicLoad(&pool->stop))
+	{
+		if (findTask(pool, currentWorker, &task))
+		{
+			runTask(&task);
+			continue;
+		}
+
+		lockMutex(&pool->sleepLock);
+
+		// anunciar que vai dormir antes de confirmar que no h tarefas, para que spawnTask no perca o aviso
+		atomicAdd(&pool->sleepingWorkers, 1);
+		if (atomicLoad(&pool->queuedTasks) == 0 && !atomicLoad(&pool->stop))
+		{
+			waitCondition(&pool->wakeUp, &pool->sleepLock);
+		}
+		atomicAdd(&pool->sleepingWorkers, -1);
+
+		unlockMutex(&pool->sleepLock);
+	}
+
+	currentPool = NULL;
+	currentWorker = -1;
+}
+
+#pragma endregion
+
+
+#pragma region conjunto de threads
+
+/**
+* @brief	Criar um conjunto de threads
+* @param	numberOfWorkers		Quantidade de threads (0 para usar todos os processadores)
+* @return	Conjunto de threads criado (ou NULL se falhou)
+*/
+TaskPool* createTaskPool(int numberOfWorkers)
+{
+	if (numberOfWorkers <= 0)
+	{
+		numberOfWorkers = getNumberOfProcessors();
+	}
+
+	TaskPool* pool = (TaskPool*)malloc(sizeof(TaskPool));
+	if (pool == NULL) // se no houver memria para alocar
+	{
+		return NULL;
+	}
+
+	pool->numberOfWorkers = numberOfWorkers;
+	pool->stop = 0;
+	pool->queuedTasks = 0;
+	pool->sleepingWorkers = 0;
+	pool->deques = (TaskDeque*)malloc((numberOfWorkers + 1) * sizeof(TaskDeque));
+	pool->threads = (Thread*)malloc(numberOfWorkers * sizeof(Thread));
+
+	if (pool->deques == NULL || pool->threads == NULL)
+	{
+		free(pool->deques);
+		free(pool->threads);
+		free(pool);
+		return NULL;
+	}
+
+	initMutex(&pool->sleepLock);
+	initCondition(&pool->wakeUp);
+
+	for (int i = 0; i <= numberOfWorkers; i++)
+	{
+		initTaskDeque(&pool->deques[i]);
+	}
+
+	pool->numberOfStarted = 0;
+
+	for (int i = 0; i < numberOfWorkers; i++)
+	{
+		TaskWorkerStart* start = (TaskWorkerStart*)malloc(sizeof(TaskWorkerStart));
+		if (start == NULL)
+		{
+			break;
+		}
+
+		start->pool = pool;
+		start->index = i;
+
+		if (!createThread(&pool->threads[i], runTaskWorker, start))
+		{
+			free(start);
+			break;
+		}
+
+		pool->numberOfStarted++;
+	}
+
+	return pool;
+}
+
+
+/**
+* @brief	Parar as threads do conjunto e libert-lo da memria.
+*			As tarefas que ainda estejam nas filas no so executadas
+* @param	pool	Conjunto de threads
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool freeTaskPool(TaskPool* pool)
+{
+	if (pool == NULL)
+	{
+		return false;
+	}
+
+	lockMutex(&pool->sleepLock);
+	atomicStore(&pool->stop, 1);
+	broadcastCondition(&pool->wakeUp);
+	unlockMutex(&pool->sleepLock);
+
+	for (int i = 0; i < pool->numberOfStarted; i++)
+	{
+		joinThread(&pool->threads[i]);
+	}
+
+	for (int i = 0; i <= pool->numberOfWorkers; i++)
+	{
+		free(pool->deques[i].tasks);
+		destroyMutex(&pool->deques[i].lock.mutex);
+	}
+
+	destroyMutex(&pool->sleepLock);
+	destroyCondition(&pool->wakeUp);
+	free(pool->deques);
+	free(pool->threads);
+	free(pool);
+
+	return true;
+}
+
+
+/**
+* @brief	Iniciar um grupo de tarefas vazio
+* @param	group	Grupo de tarefas
+*/
+void initTaskGroup(TaskGroup* group)
+{
+	group->pending = 0;
+}
+
+
+/**
+* @brief	Criar uma tarefa num grupo, para ser executada por qualquer thread do conjunto (fork)
+* @param	pool		Conjunto de threads
+* @param	group		Grupo de tarefas
+* @param	function	Funo da tarefa
+* @param	argument	Argumento passado  funo
+* @return	Booleano para o resultado da funo (se foi criada ou executada logo)
+*/
+bool spawnTask(TaskPool* pool, TaskGroup* group, TaskFunction function, void* argument)
+{
+	if (pool == NULL || function == NULL)
+	{
+		return false;
+	}
+
+	Task task;
+	task.function = function;
+	task.argument = argument;
+	task.group = group;
+
+	if (group != NULL)
+	{
+		atomicAdd(&group->pending, 1);
+	}
+
+	if (!pushTask(&pool->deques[getCurrentDeque(pool)], task)) // sem memria para a fila, executa j
+	{
+		runTask(&task);
+		return true;
+	}
+
+	atomicAdd(&pool->queuedTasks, 1);
+
+	if (atomicLoad(&pool->sleepingWorkers) > 0)
+	{
+		lockMutex(&pool->sleepLock);
+		broadcastCondition(&pool->wakeUp);
+		unlockMutex(&pool->sleepLock);
+	}
+
+	return true;
+}
+
+
+/**
+* @brief	Esperar que todas as tarefas de um grupo terminem (join).
+*			Enquanto espera, a thread atual executa tarefas em vez de ficar bloqueada
+* @param	pool	Conjunto de threads
+* @param	group	Grupo de tarefas
+*/
+void waitTaskGroup(TaskPool* pool, TaskGroup* group)
+{
+	int self = getCurrentDeque(pool);
+	Task task;
+
+	while (atomicLoad(&group->pending) > 0)
+	{
+		if (findTask(pool, self, &task))
+		{
+			runTask(&task);
+		}
+		else
+		{
+			yieldThread();
+		}
+	}
+}
+
+#pragma endregion
+
+
+#pragma region ciclos paralelos
+
+/**
+* @brief	Tarefa de um ciclo paralelo: divide o intervalo ao meio, criando uma tarefa para a segunda metade,
+*			at o intervalo ter no mximo grainSize elementos
+* @param	data	Intervalo (ParallelForRange)
+*/
+static void runParallelForRange(void* data)
+{
+	ParallelForRange* range = (ParallelForRange*)data;
+	ParallelFor* loop = (ParallelFor*)range->loop;
+	int first = range->first;
+	int last = range->last;
+
+	while (last - first > loop->grainSize)
+	{
+		int middle = first + (last - first) / 2;
+		ParallelForRange* half = &loop->ranges[atomicAdd(&loop->numberOfRanges, 1) - 1];
+
+		half->loop = loop;
+		half->first = middle;
+		half->last = last;
+		spawnTask(loop->pool, loop->group, runParallelForRange, half);
+
+		last = middle;
+	}
+
+	loop->function(first, last, loop->argument);
+}
+
+
+/**
+* @brief	Executar uma funo sobre o intervalo [first, last[ em paralelo, dividido em partes de at grainSize ndices.
+*			A funo recebe cada parte como (incio, fim, argumento) e termina quando todas as partes forem executadas
+* @param	pool		Conjunto de threads
+* @param	first		Primeiro ndice
+* @param	last		ndice a seguir ao ltimo
+* @param	grainSize	Quantidade mxima de ndices por parte (0 para dividir automaticamente)
+* @param	function	Funo executada para cada parte
+* @param	argument	Argumento passado  funo
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool parallelFor(TaskPool* pool, int first, int last, int grainSize, RangeFunction function, void* argument)
+{
+	if (function == NULL || last <= first)
+	{
+		return false;
+	}
+
+	if (pool == NULL) // sem conjunto de threads, executa tudo na thread atual
+	{
+		function(first, last, argument);
+		return true;
+	}
+
+	if (grainSize <= 0) // cerca de 8 partes por thread, para equilibrar a carga
+	{
+		grainSize = (last - first) / ((pool->numberOfWorkers + 1) * 8) + 1;
+	}
+
+	// cada diviso cria um intervalo, e cada intervalo final tem mais de metade de grainSize ndices
+	int maxRanges = 2 * ((last - first) / grainSize) + 2;
+
+	TaskGroup group;
+	ParallelFor loop;
+
+	initTaskGroup(&group);
+	loop.pool = pool;
+	loop.group = &group;
+	loop.function = function;
+	loop.argument = argument;
+	loop.grainSize = grainSize;
+	loop.numberOfRanges = 1;
+	loop.ranges = (ParallelForRange*)malloc(maxRanges * sizeof(ParallelForRange));
+
+	if (loop.ranges == NULL)
+	{
+		function(first, last, argument);
+		return true;
+	}
+
+	loop.ranges[0].loop = &loop;
+	loop.ranges[0].first = first;
+	loop.ranges[0].last = last;
+
+	runParallelForRange(&loop.ranges[0]);
+	waitTaskGroup(pool, &group);
+
+	free(loop.ranges);
+
+	return true;
+}
+
+#pragma endregion
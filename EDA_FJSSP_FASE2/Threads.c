@@ -0,0 +1,354 @@
+/**
+ * @brief	Ficheiro com as primitivas de concorrncia (threads, excluso mtua e operaes atmicas)
+ * @file	threads.c
+ * @author	Vnia Pereira
+ * @email	a19264@alunos.ipca.pt
+ * @date	2022
+ * @Disciplina Estruturas de Dados Avanadas
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <time.h>
+#include "header.h"
+
+
+/**
+ * @brief	Argumentos passados  funo de arranque de cada thread
+ */
+typedef struct ThreadStart
+{
+	void (*function)(void*);
+	void* argument;
+} ThreadStart;
+
+
+#pragma region threads
+
+#ifdef _WIN32
+static DWORD WINAPI runThread(LPVOID data)
+#else
+static void* runThread(void* data)
+#endif
+{
+	ThreadStart start = *(ThreadStart*)data;
+	free(data);
+
+	start.function(start.argument);
+
+	return 0;
+}
+
+
+/**
+* @brief	Criar e iniciar uma nova thread
+* @param	thread		Apontador para a thread a ser criada
+* @param	function	Funo executada pela thread
+* @param	argument	Argumento passado  funo
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool createThread(Thread* thread, void (*function)(void*), void* argument)
+{
+	ThreadStart* start = (ThreadStart*)malloc(sizeof(ThreadStart));
+	if (start == NULL) // se no houver memria para alocar
+	{
+		return false;
+	}
+
+	start->function = function;
+	start->argument = argument;
+
+#ifdef _WIN32
+	*thread = CreateThread(NULL, 0, runThread, start, 0, NULL);
+	if (*thread == NULL)
+#else
+	if (pthread_create(thread, NULL, runThread, start) != 0)
+#endif
+	{
+		free(start);
+		return false;
+	}
+
+	return true;
+}
+
+
+/**
+* @brief	Esperar que uma thread termine
+* @param	thread	Apontador para a thread
+* @return	Booleano para o resultado da funo (se funcionou ou no)
+*/
+bool joinThread(Thread* thread)
+{
+#ifdef _WIN32
+	bool joined = WaitForSingleObject(*thread, INFINITE) == WAIT_OBJECT_0;
+	CloseHandle(*thread);
+	return joined;
+#else
+	return pthread_join(*thread, NULL) == 0;
+#endif
+}
+
+
+/**
+* @brief	Obter o nmero de processadores lgicos disponveis
+* @return	Nmero de processadores (pelo menos 1)
+*/
+int getNumberOfProcessors()
+{
+#ifdef _WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	int processors = (int)info.dwNumberOfProcessors;
+#else
+	int processors = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+
+	return processors > 0 ? processors : 1;
+}
+
+
+/**
+* @brief	Ceder o processador a outra thread
+*/
+void yieldThread()
+{
+#ifdef _WIN32
+	SwitchToThread();
+#else
+	sched_yield();
+#endif
+}
+
+
+/**
+* @brief	Obter o instante atual em microssegundos (relgio montono, s serve para medir intervalos)
+* @return	Instante atual em microssegundos
+*/
+long long getTimeMicroseconds()
+{
+#ifdef _WIN32
+	LARGE_INTEGER frequency, now;
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&now);
+	return (long long)(now.QuadPart / frequency.QuadPart) * 1000000 + (long long)(now.QuadPart % frequency.QuadPart) * 1000000 / frequency.QuadPart;
+#else
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (long long)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+#endif
+}
+
+#pragma endregion
+
+
+#pragma region excluso mtua
+
+/**
+* @brief	Iniciar um mutex
+* @param	mutex	Apontador para o mutex
+*/
+void initMutex(Mutex* mutex)
+{
+#ifdef _WIN32
+	InitializeSRWLock(mutex);
+#else
+	pthread_mutex_init(mutex, NULL);
+#endif
+}
+
+
+/**
+* @brief	Bloquear um mutex (espera se estiver ocupado)
+* @param	mutex	Apontador para o mutex
+*/
+void lockMutex(Mutex* mutex)
+{
+#ifdef _WIN32
+	AcquireSRWLockExclusive(mutex);
+#else
+	pthread_mutex_lock(mutex);
+#endif
+}
+
+
+/**
+* @brief	Libertar um mutex
+* @param	mutex	Apontador para o mutex
+*/
+void unlockMutex(Mutex* mutex)
+{
+#ifdef _WIN32
+	ReleaseSRWLockExclusive(mutex);
+#else
+	pthread_mutex_unlock(mutex);
+#endif
+}
+
+
+/**
+* @brief	Destruir um mutex
+* @param	mutex	Apontador para o mutex
+*/
+void destroyMutex(Mutex* mutex)
+{
+#ifndef _WIN32
+	pthread_mutex_destroy(mutex);
+#endif
+}
+
+
+/**
+* @brief	Iniciar uma varivel de condio
+* @param	condition	Apontador para a varivel de condio
+*/
+void initCondition(Condition* condition)
+{
+#ifdef _WIN32
+	InitializeConditionVariable(condition);
+#else
+	pthread_cond_init(condition, NULL);
+#endif
+}
+
+
+/**
+* @brief	Esperar por uma varivel de condio, libertando o mutex enquanto espera
+* @param	condition	Apontador para a varivel de condio
+* @param	mutex		Apontador para o mutex (bloqueado por quem chama)
+*/
+void waitCondition(Condition* condition, Mutex* mutex)
+{
+#ifdef _WIN32
+	SleepConditionVariableSRW(condition, mutex, INFINITE, 0);
+#else
+	pthread_cond_wait(condition, mutex);
+#endif
+}
+
+
+/**
+* @brief	Acordar todas as threads  espera de uma varivel de condio
+* @param	condition	Apontador para a varivel de condio
+*/
+void broadcastCondition(Condition* condition)
+{
+#ifdef _WIN32
+	WakeAllConditionVariable(condition);
+#else
+	pthread_cond_broadcast(condition);
+#endif
+}
+
+
+/**
+* @brief	Destruir uma varivel de condio
+* @param	condition	Apontador para a varivel de condio
+*/
+void destroyCondition(Condition* condition)
+{
+#ifndef _WIN32
+	pthread_cond_destroy(condition);
+#endif
+}
+
+#pragma endregion
+
+
+#pragma region operaes atmicas
+
+/**
+* @brief	Ler um valor de forma atmica (com barreira de memria completa)
+* @param	value	Apontador para o valor
+* @return	Valor lido
+*/
+long atomicLoad(volatile long* value)
+{
+#ifdef _WIN32
+	return InterlockedCompareExchange(value, 0, 0);
+#else
+	return __atomic_load_n(value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+
+/**
+* @brief	Escrever um valor de forma atmica (com barreira de memria completa)
+* @param	value		Apontador para o valor
+* @param	newValue	Novo valor
+*/
+void atomicStore(volatile long* value, long newValue)
+{
+#ifdef _WIN32
+	InterlockedExchange(value, newValue);
+#else
+	__atomic_store_n(value, newValue, __ATOMIC_SEQ_CST);
+#endif
+}
+
+
+/**
+* @brief	Somar a um valor de forma atmica
+* @param	value	Apontador para o valor
+* @param	amount	Quantidade a somar
+* @return	Valor depois da soma
+*/
+long atomicAdd(volatile long* value, long amount)
+{
+#ifdef _WIN32
+	return InterlockedExchangeAdd(value, amount) + amount;
+#else
+	return __atomic_add_fetch(value, amount, __ATOMIC_SEQ_CST);
+#endif
+}
+
+
+/**
+* @brief	Substituir um valor de forma atmica, apenas se ainda tiver o valor esperado
+* @param	value		Apontador para o valor
+* @param	expected	Valor esperado
+* @param	desired		Novo valor
+* @return	Booleano para o resultado da funo (se substituiu ou no)
+*/
+bool atomicCompareExchange(volatile long* value, long expected, long desired)
+{
+#ifdef _WIN32
+	return InterlockedCompareExchange(value, desired, expected) == expected;
+#else
+	return __atomic_compare_exchange_n(value, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+#endif
+}
+
+
+/**
+* @brief	Ler um apontador de forma atmica
+* @param	pointer		Apontador para o apontador
+* @return	Apontador lido
+*/
+void* atomicLoadPointer(void* volatile* pointer)
+{
+#ifdef _WIN32
+	return InterlockedCompareExchangePointer(pointer, NULL, NULL);
+#else
+	return __atomic_load_n(pointer, __ATOMIC_SEQ_CST);
+#endif
+}
+
+
+/**
+* @brief	Substituir um apontador de forma atmica
+* @param	pointer		Apontador para o apontador
+* @param	newPointer	Novo apontador
+* @return	Apontador anterior
+*/
+void* atomicExchangePointer(void* volatile* pointer, void* newPointer)
+{
+#ifdef _WIN32
+	return InterlockedExchangePointer(pointer, newPointer);
+#else
+	return __atomic_exchange_n(pointer, newPointer, __ATOMIC_SEQ_CST);
+#endif
+}
+
+#pragma endregion
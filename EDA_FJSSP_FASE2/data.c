@@ -37,6 +37,8 @@ Job* loadJobs(Job* jobs)
 	jobs = insertJobAtStart(jobs, job);
 	job = newJob(8);
 	jobs = insertJobAtStart(jobs, job);
+
+	return jobs;
 }
 
 
@@ -64,6 +66,8 @@ Machine* loadMachines(Machine* machines)
 	machines = insertMachineAtStart(machines, machine);
 	machine = newMachine(8, false);
 	machines = insertMachineAtStart(machines, machine);
+
+	return machines;
 }
 
 
@@ -159,6 +163,8 @@ Operation* loadOperations(Operation* operations)
 	operations = insertOperation_AtStart(operations, operation);
 	operation = newOperation(38, 8);
 	operations = insertOperation_AtStart(operations, operation);
+
+	return operations;
 }
 
 
@@ -21,6 +21,25 @@
 #define NUMBER_MACHINES 8
 #define MAX_TIME 18
 
+/**
+ * @brief	Valores por omisso dos trabalhos e parmetros das regras de despacho
+ */
+#define JOB_NO_DUE_DATE 2147483647 // trabalho sem data de entrega (nunca est atrasado)
+#define ATC_LOOKAHEAD 2.0 // parmetro k da regra ATC (quanto maior, mais cedo a folga comea a contar)
+
+/**
+ * @brief	Limite dos tempos de preparao das mquinas
+ */
+#define SETUP_MAX_TIME 65535 // os tempos de preparao so guardados em unsigned short
+
+/**
+ * @brief	Limites para as estatsticas e redistribuio da tabela hash
+ */
+#define HASH_TABLE_HISTOGRAM_SIZE 8 // a ltima classe do histograma agrupa as listas com 7 ou mais elementos
+#define HASH_TABLE_MIN_CHAIN 2 // listas at este tamanho nunca so consideradas degeneradas
+#define HASH_TABLE_MAX_CHAIN_RATIO 3.0f // razo mxima entre a maior lista e o fator de carga
+#define HASH_TABLE_REHASH_ATTEMPTS 8 // sementes experimentadas em cada redistribuio
+
  /**
   * @brief	Nomes para os ficheiros onde os dados so armazenados
   */
@@ -28,6 +47,162 @@
 #define MACHINES_FILENAME_BINARY "machines.bin"
 #define OPERATIONS_FILENAME_BINARY "operations.bin"
 #define EXECUTIONS_FILENAME_BINARY "executions.bin"
+#define CALENDARS_FILENAME_BINARY "calendars.bin"
+#define FAMILIES_FILENAME_BINARY "families.bin"
+#define SETUPS_FILENAME_BINARY "setups.bin"
+#define EXECUTIONS_FILENAME_COLUMNAR "executions.col"
+#define PROBLEM_SNAPSHOT_FILENAME "problem.snap"
+#define GANTT_FILENAME_BINARY "schedule.gantt"
+#define GANTT_FILENAME_CSV "schedule.csv"
+#define GANTT_FILENAME_JSON "schedule.json"
+#define MODEL_FILENAME_TEXT "model.tsv"
+
+/**
+ * @brief	Formato do ficheiro de execues comprimido por colunas
+ */
+#define COLUMNAR_MAGIC 0x58454A46 // "FJEX"
+#define COLUMNAR_VERSION 1
+#define COLUMNAR_BLOCK_SIZE 1024 // execues por bloco (no mximo 65535)
+#define PROBLEM_SNAPSHOT_MAGIC 0x50534A46 // "FJSP"
+#define PROBLEM_SNAPSHOT_VERSION 2
+#define GANTT_MAGIC 0x544E4147 // "GANT"
+#define GANTT_VERSION 1
+#define JOBS_FILE_MAGIC 0x424F4A46 // "FJOB"
+#define JOBS_FILE_VERSION 2 // a verso 1 no tinha cabealho e cada registo era s o identificador do trabalho
+#define GANTT_BUFFER_SIZE (1 << 20) // bytes acumulados em memria antes de cada escrita no ficheiro
+
+/**
+ * @brief	Limites relativos  concorrncia
+ */
+#define MAX_MODEL_READERS 64 // quantidade mxima de threads leitoras registadas em simultneo
+#define CONCURRENT_TABLE_STRIPES 256 // quantidade de mutexes da tabela hash concorrente (potncia de 2)
+#define CACHE_LINE_SIZE 64
+#define PARALLEL_LOADER_MIN_RECORDS 65536 // quantidade mnima de registos lidos por cada thread
+#define TASK_DEQUE_CAPACITY 256 // capacidade inicial da fila de tarefas de cada thread
+#define CURSOR_BATCH_SIZE 4096 // registos lidos de cada vez pelo cursor sobre ficheiros
+#define RADIX_SORT_PARALLEL_MIN_RECORDS 65536 // abaixo disto a ordenao  feita numa s thread
+#define MODEL_TEXT_CHUNK_SIZE (4 << 20) // bytes do ficheiro de texto do modelo lidos por cada tarefa
+
+/**
+ * @brief	Limites da reparao do plano em tempo real
+ */
+#define ONLINE_REPAIR_WINDOW 1000 // unidades de tempo, depois de um espao livre, em que as operaes podem ser antecipadas
+#define ONLINE_MAX_REPAIR_MOVES 256 // antecipaes feitas, no mximo, por cada evento
+#define RADIX_HEAP_BUCKETS 33 // um balde por bit das chaves de 32 bits, mais o balde das chaves iguais  ltima retirada
+
+/**
+ * @brief	Limites do modo de servio
+ */
+#define SERVICE_SOCKET_PATH "/tmp/fjssp.sock"
+#define SERVICE_HEADER_SIZE 12 // tamanho, identificador do pedido, tipo do pedido (ou estado da resposta)
+#define SERVICE_MAX_REQUEST_SIZE (16 << 20) // bytes de um pedido, no mximo (pedidos maiores fecham a ligao)
+#define SERVICE_READ_SIZE 65536 // bytes lidos de cada vez de uma ligao
+#define SERVICE_MAX_EVENTS 64 // eventos tratados em cada espera do ciclo de eventos
+#define SERVICE_LATENCY_BUCKETS 32 // classes do histograma de latncia (potncias de 2 em microssegundos)
+#define SERVICE_JOB_EXECUTIONS 64 // execues escolhidas guardadas na pilha ao responder sobre um trabalho
+
+/**
+ * @brief	Limites da cache de consultas
+ */
+#define QUERY_CACHE_DEFAULT_BYTES (1 << 20) // memria das entradas da cache, por omisso
+#define QUERY_CACHE_INITIAL_ENTRIES 64 // capacidade inicial do array de entradas (cresce quando  preciso)
+#define QUERY_VERSION_SLOTS 4096 // contadores de verso de cada cache, para trabalhos e para operaes (potncia de 2)
+
+#pragma endregion
+
+
+#pragma region primitivas de concorrncia
+
+/**
+ * @brief	Tipos dependentes do sistema operativo para threads, mutexes e variveis de condio
+ */
+#ifdef _WIN32
+#include <windows.h>
+typedef HANDLE Thread;
+typedef SRWLOCK Mutex;
+typedef CONDITION_VARIABLE Condition;
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+typedef pthread_t Thread;
+typedef pthread_mutex_t Mutex;
+typedef pthread_cond_t Condition;
+#endif
+
+#ifdef _MSC_VER
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL _Thread_local
+#endif
+
+/**
+ * @brief	Mutex ocupando uma linha de cache inteira, para que threads em mutexes vizinhos no disputem a mesma linha
+ */
+typedef union PaddedMutex
+{
+	Mutex mutex;
+	char padding[CACHE_LINE_SIZE];
+} PaddedMutex;
+
+typedef void (*TaskFunction)(void* argument);
+typedef void (*RangeFunction)(int first, int last, void* argument);
+
+/**
+ * @brief	Estrutura de dados para representar um grupo de tarefas, que podem ser esperadas em conjunto
+ */
+typedef struct TaskGroup
+{
+	volatile long pending; // tarefas criadas que ainda no terminaram
+} TaskGroup;
+
+/**
+ * @brief	Estrutura de dados para representar uma tarefa
+ */
+typedef struct Task
+{
+	TaskFunction function;
+	void* argument;
+	TaskGroup* group;
+} Task;
+
+/**
+ * @brief	Estrutura de dados para representar a fila dupla de tarefas de uma thread (buffer circular)
+ */
+typedef struct TaskDeque
+{
+	Task* tasks;
+	int capacity;
+	int top; // incio da fila, onde as outras threads roubam
+	int bottom; // fim da fila, onde a dona insere e retira
+	PaddedMutex lock;
+} TaskDeque;
+
+/**
+ * @brief	Estrutura de dados para representar um conjunto de threads com roubo de tarefas
+ */
+typedef struct TaskPool
+{
+	int numberOfWorkers;
+	int numberOfStarted; // threads efetivamente criadas
+	TaskDeque* deques; // uma fila por thread, mais uma para as threads fora do conjunto
+	Thread* threads;
+	Mutex sleepLock;
+	Condition wakeUp;
+	volatile long queuedTasks;
+	volatile long sleepingWorkers;
+	volatile long stop;
+} TaskPool;
+
+/**
+ * @brief	Estrutura de dados para representar um intervalo de ndices de um ciclo paralelo
+ */
+typedef struct ParallelForRange
+{
+	void* loop;
+	int first;
+	int last;
+} ParallelForRange;
 
 #pragma endregion
 
@@ -40,6 +215,9 @@
 typedef struct Job
 {
 	int id;
+	int releaseDate; // instante a partir do qual a primeira operao pode comear
+	int dueDate; // instante at ao qual o trabalho deve estar acabado (JOB_NO_DUE_DATE se no tiver)
+	int weight; // peso do trabalho no atraso ponderado
 	struct Job* next;
 } Job;
 
@@ -89,23 +267,646 @@ extern Execution* executions; // lista de execu
 typedef struct {
 	Execution* start; // apontador para o primeiro elemento de cada posio da tabela
 	int numberOfExecutions; // quantidade de execues de cada posio da tabela
+	unsigned int hashSeed; // semente da funo de hash da tabela (igual em todas as posies da mesma tabela)
 } ExecutionNode;
 
 // tabela hash para armazenar as execues e fazer buscas de forma mais eficiente,
 //  um array de apontadores para listas de execues
 extern ExecutionNode* executionsTable[HASH_TABLE_SIZE];
 
+/**
+ * @brief	Estrutura de dados para representar as estatsticas de ocupao da tabela hash das execues
+ */
+typedef struct ExecutionsTableStats
+{
+	int numberOfBuckets;
+	int numberOfExecutions;
+	int emptyBuckets;
+	int maxChainLength;
+	int histogram[HASH_TABLE_HISTOGRAM_SIZE]; // quantidade de posies por tamanho de lista
+	int driftedBuckets; // posies cujo numberOfExecutions estava diferente do tamanho real
+	float loadFactor;
+	float meanChainLength; // mdia do tamanho das listas no vazias
+	float successfulLookupCost; // mdia de execues visitadas numa pesquisa com sucesso
+	float unsuccessfulLookupCost; // mdia de execues visitadas numa pesquisa sem sucesso
+	bool rehashed; // se as execues foram redistribudas
+} ExecutionsTableStats;
+
+/**
+ * @brief	Estrutura de dados para representar o tempo mnimo e mximo para completar um trabalho
+ */
+typedef struct JobTimes
+{
+	int jobID;
+	int minTime;
+	int maxTime;
+} JobTimes;
+
+/**
+ * @brief	Estrutura de dados para representar um conjunto de chaves inteiras, cada uma com um valor associado (em memria)
+ */
+typedef struct KeySet
+{
+	long long* keys;
+	int* values;
+	bool* used; // se cada posio est ocupada
+	int capacity; // potncia de 2
+	int numberOfKeys;
+} KeySet;
+
+/**
+ * @brief	Estrutura de dados para representar o mapeamento entre identificadores externos e ndices densos 0..n-1 (em memria)
+ */
+typedef struct IdMap
+{
+	KeySet* denseIds; // identificador externo -> ndice denso
+	int* externalIds; // ndice denso -> identificador externo
+	int numberOfIds;
+	int capacity;
+} IdMap;
+
+// chave nica de uma execuo, composta pelo identificador da operao e da mquina
+// (o deslocamento  feito sem sinal, para identificadores negativos no terem comportamento indefinido)
+#define EXECUTION_KEY(operationID, machineID) ((long long)(((unsigned long long)(unsigned int)(operationID) << 32) | (unsigned int)(machineID)))
+
+/**
+ * @brief	Estrutura de dados para representar a tabela hash das execues com acesso concorrente (em memria)
+ */
+typedef struct ConcurrentExecutionsTable
+{
+	ExecutionNode* buckets; // posies da tabela (quantidade potncia de 2)
+	int numberOfBuckets;
+	volatile long numberOfExecutions;
+	PaddedMutex locks[CONCURRENT_TABLE_STRIPES]; // cada posio  protegida pelo mutex (posio % CONCURRENT_TABLE_STRIPES)
+} ConcurrentExecutionsTable;
+
+/**
+ * @brief	Estrutura de dados para representar uma alternativa de uma mquina (operao que pode executar e o seu tempo)
+ */
+typedef struct MachineAlternative
+{
+	int operationID;
+	int runtime;
+} MachineAlternative;
+
+/**
+ * @brief	Estrutura de dados para representar as alternativas de uma mquina, ordenadas pelo tempo (em memria)
+ */
+typedef struct MachineAlternatives
+{
+	int machineID;
+	MachineAlternative* alternatives; // array contguo, a primeira alternativa  a mais rpida
+	int count;
+	int capacity;
+} MachineAlternatives;
+
+/**
+ * @brief	Estrutura de dados para representar o ndice das execues agrupadas por mquina (em memria)
+ */
+typedef struct MachineIndex
+{
+	MachineAlternatives* machines;
+	int numberOfMachines;
+	int capacity;
+	KeySet* slots; // identificador da mquina -> posio no array de mquinas
+} MachineIndex;
+
+/**
+ * @brief	Estrutura de dados para representar as mquinas elegveis de cada operao como conjuntos de bits (em memria).
+ *			Os tempos de cada operao ficam num array denso, pela ordem dos bits das suas mquinas
+ */
+typedef struct EligibilityTable
+{
+	int numberOfMachines;
+	int numberOfOperations;
+	int numberOfWords; // palavras de 64 bits por operao
+	int* machineIDs; // posio -> identificador da mquina
+	int* operationIDs; // posio -> identificador da operao
+	KeySet* machinePositions; // identificador da mquina -> posio
+	KeySet* operationPositions; // identificador da operao -> posio
+	unsigned long long* bits; // numberOfWords palavras por operao, um bit por mquina
+	int* runtimeStarts; // incio dos tempos de cada operao (numberOfOperations + 1 posies)
+	int* runtimes;
+} EligibilityTable;
+
+/**
+ * @brief	Tipos de intervalo do calendrio de uma mquina
+ */
+typedef enum CalendarIntervalType
+{
+	INTERVAL_DOWNTIME, // paragem (manuteno, fora de turno, avaria)
+	INTERVAL_RESERVATION // reservada para uma operao
+} CalendarIntervalType;
+
+/**
+ * @brief	Estrutura de dados para representar um intervalo [incio, fim) em que uma mquina no est livre
+ */
+typedef struct CalendarInterval
+{
+	int start;
+	int end;
+	CalendarIntervalType type;
+	int operationID; // operao da reserva (-1 nas paragens)
+} CalendarInterval;
+
+/**
+ * @brief	Estrutura de dados para representar um intervalo do calendrio de uma mquina, como n de uma rvore AVL (em memria)
+ */
+typedef struct CalendarNode
+{
+	CalendarInterval interval;
+	int gapBefore; // tempo livre desde o fim do intervalo anterior (INT_MAX no primeiro)
+	int maxGap; // maior folga da subrvore
+	int height;
+	struct CalendarNode* left;
+	struct CalendarNode* right;
+} CalendarNode;
+
+/**
+ * @brief	Estrutura de dados para representar o calendrio de uma mquina (em memria)
+ */
+typedef struct MachineCalendar
+{
+	int machineID;
+	CalendarNode* root; // rvore AVL dos intervalos, ordenada pelo incio, sem sobreposies
+	int count;
+} MachineCalendar;
+
+/**
+ * @brief	Estrutura de dados para representar os calendrios de todas as mquinas (em memria)
+ */
+typedef struct MachineCalendars
+{
+	MachineCalendar* machines;
+	int numberOfMachines;
+	int capacity;
+	KeySet* positions; // identificador da mquina -> posio no array de calendrios
+} MachineCalendars;
+
+/**
+ * @brief	Estrutura de dados para representar uma operao escalonada no plano em tempo real (em memria)
+ */
+typedef struct ScheduledOperation
+{
+	int operationID;
+	int jobID;
+	int machineID;
+	int start;
+	int end;
+	int jobPrevious; // posio da operao anterior do mesmo trabalho (-1 se for a primeira)
+	int jobNext; // posio da operao seguinte do mesmo trabalho (-1 se for a ltima)
+	bool isActive; // falso depois de o trabalho ser removido
+} ScheduledOperation;
+
+/**
+ * @brief	Estrutura de dados para representar a matriz de tempos de preparao de uma mquina, por famlias (em memria)
+ */
+typedef struct SetupMatrix
+{
+	int machineID;
+	int numberOfFamilies;
+	unsigned short* dense; // famlias x famlias tempos (NULL enquanto a matriz  esparsa)
+	KeySet* sparse; // anterior * famlias + seguinte -> tempo (NULL depois de a matriz passar a densa)
+} SetupMatrix;
+
+/**
+ * @brief	Estrutura de dados para representar os tempos de preparao de todas as mquinas (em memria)
+ */
+typedef struct SetupTimes
+{
+	int numberOfFamilies;
+	SetupMatrix* machines;
+	int numberOfMachines;
+	int capacity;
+	KeySet* positions; // identificador da mquina -> posio no array de matrizes
+	KeySet* families; // identificador da operao -> famlia
+} SetupTimes;
+
+/**
+ * @brief	Estrutura de dados para representar um trabalho do plano em tempo real (em memria)
+ */
+typedef struct OnlineJob
+{
+	int jobID;
+	int lastOperation; // posio da ltima operao do trabalho (-1 se no tiver ou foi removido)
+	int releaseDate;
+	int dueDate;
+	int weight;
+} OnlineJob;
+
+/**
+ * @brief	Estrutura de dados para representar o plano em tempo real, alterado a cada evento (em memria)
+ */
+typedef struct OnlineSchedule
+{
+	ScheduledOperation* operations;
+	int count;
+	int capacity;
+	KeySet* positions; // identificador da operao -> posio no array de operaes
+	OnlineJob* jobs;
+	int numberOfJobs;
+	int jobsCapacity;
+	KeySet* jobPositions; // identificador do trabalho -> posio no array de trabalhos
+	long long weightedTardiness; // atraso ponderado do plano, mantido a cada alterao
+	MachineCalendars* calendars; // reservas das operaes e paragens das mquinas
+} OnlineSchedule;
+
+/**
+ * @brief	Estados de uma mquina durante a simulao
+ */
+typedef enum MachineState
+{
+	MACHINE_WAITING, //  espera que a operao anterior do trabalho da sua prxima operao acabe
+	MACHINE_BUSY,
+	MACHINE_FINISHED // j executou todas as suas operaes
+} MachineState;
+
+/**
+ * @brief	Estrutura de dados para representar um elemento do monte radix (em memria)
+ */
+typedef struct RadixHeapItem
+{
+	unsigned int key;
+	int value;
+} RadixHeapItem;
+
+/**
+ * @brief	Estrutura de dados para representar um balde do monte radix (em memria)
+ */
+typedef struct RadixHeapBucket
+{
+	RadixHeapItem* items;
+	int count;
+	int capacity;
+} RadixHeapBucket;
+
+/**
+ * @brief	Estrutura de dados para representar um monte radix: fila de prioridade para chaves inteiras que nunca diminuem (em memria)
+ */
+typedef struct RadixHeap
+{
+	RadixHeapBucket buckets[RADIX_HEAP_BUCKETS];
+	unsigned int last; // ltima chave retirada
+	int count;
+} RadixHeap;
+
+/**
+ * @brief	Estrutura de dados para representar uma operao do plano simulado (mquina escolhida e tempo planeado)
+ */
+typedef struct SimulationOperation
+{
+	int machine; // posio da mquina na imagem do problema
+	int job; // posio do trabalho na imagem do problema
+	int runtime;
+} SimulationOperation;
+
+/**
+ * @brief	Estrutura de dados para representar a simulao de um plano (s de leitura, partilhada entre threads)
+ */
+typedef struct Simulation
+{
+	const struct ProblemSnapshot* snapshot;
+	int numberOfOperations;
+	int numberOfMachines;
+	int numberOfJobs;
+	SimulationOperation* operations; // pela posio da operao na imagem do problema
+	int* machineSequenceStarts; // operaes da mquina m: machineSequences[machineSequenceStarts[m] .. machineSequenceStarts[m + 1]]
+	int* machineSequences; // operaes de cada mquina, pelo incio planeado
+} Simulation;
+
+/**
+ * @brief	Estrutura de dados para representar o estado de uma repetio da simulao (um por thread)
+ */
+typedef struct SimulationState
+{
+	MachineState* machineStates;
+	int* machineHeads; // posio da prxima operao de cada mquina em machineSequences
+	int* jobPositions; // quantidade de operaes j acabadas de cada trabalho
+	int* jobEnds;
+	RadixHeap events; // fim das operaes em execuo
+	unsigned long long random;
+} SimulationState;
+
+/**
+ * @brief	Estrutura de dados para representar a configurao das repeties da simulao
+ */
+typedef struct SimulationConfig
+{
+	int variation; // percentagem de variao dos tempos  volta do tempo de cada execuo (0 para tempos fixos)
+	unsigned long long seed;
+	const int* dueDates; // data de entrega de cada trabalho, pela posio na imagem do problema (NULL para usar as dos trabalhos)
+} SimulationConfig;
+
+/**
+ * @brief	Estrutura de dados para representar o resultado de uma repetio da simulao
+ */
+typedef struct SimulationResult
+{
+	int makespan;
+	long long weightedTardiness;
+	long long events;
+} SimulationResult;
+
+/**
+ * @brief	Estrutura de dados para representar o resumo das repeties de Monte Carlo
+ */
+typedef struct MonteCarloSummary
+{
+	int replications;
+	double meanMakespan;
+	double stdDevMakespan;
+	int minMakespan;
+	int maxMakespan;
+	double meanWeightedTardiness;
+	long long events;
+} MonteCarloSummary;
+
+/**
+ * @brief	Estrutura de dados para representar os objetivos de um plano (todos a minimizar)
+ */
+typedef struct ObjectiveVector
+{
+	int makespan; // fim do plano
+	long long totalWorkload; // soma dos tempos das alternativas escolhidas
+	int maxMachineWorkload; // carga da mquina mais carregada
+} ObjectiveVector;
+
+/**
+ * @brief	Regras de despacho para construir um plano
+ */
+typedef enum DispatchRule
+{
+	DISPATCH_EDD, // menor data de entrega primeiro
+	DISPATCH_ATC // custo aparente do atraso (peso, tempo e folga at  data de entrega)
+} DispatchRule;
+
+/**
+ * @brief	Estrutura de dados para avaliar os objetivos de um plano sobre a imagem do problema,  medida que o plano muda
+ */
+typedef struct AssignmentEvaluator
+{
+	const struct ProblemSnapshot* snapshot;
+	int* alternatives; // alternativa escolhida para cada operao (ndice nas alternativas da imagem)
+	int* sequence; // sequncia de trabalhos: a k-sima ocorrncia do trabalho j representa a sua k-sima operao
+	int* machineWorkloads;
+	int* workloadTree; // rvore de segmentos com a maior carga (a raiz est na posio 1)
+	int treeLeaves;
+	long long totalWorkload;
+	int makespan;
+	long long weightedTardiness; // atualizado com o fim de cada trabalho
+	bool makespanIsValid; // falso at o plano ser descodificado por inteiro; depois, cada mudana s recalcula as operaes afetadas
+	int* operationEnds; // fim de cada operao, no ltimo clculo do plano
+	int* sequenceOperations; // operao de cada posio da sequncia, e posio de cada operao na sequncia
+	int* sequencePositions;
+	int* pendingOperations; // fila (por posio na sequncia) das operaes a recalcular depois de uma mudana
+	bool* isPending;
+	int numberOfPending;
+	int* jobEndTree; // rvore de segmentos com o maior fim de um trabalho (o fim do plano est na posio 1)
+	int jobLeaves;
+	int* jobReady; // auxiliares para calcular o fim do plano
+	int* jobPositions;
+	int* machineReady;
+	int* machineFirst; // primeira e ltima operao de cada mquina, no ltimo clculo do plano
+	int* machineLast;
+	int* machinePrevious; // operao anterior e seguinte na mesma mquina, no ltimo clculo do plano (-1 se no houver)
+	int* machineNext;
+	SetupTimes* setups; // tempos de preparao usados no clculo do plano (NULL se no forem usados)
+	int* machineSetups; // posio da matriz de preparao de cada mquina em setups->machines (-1 se no tiver)
+	int* operationFamilies; // famlia de cada operao, pela posio (-1 se no tiver)
+	long long totalSetupTime;
+} AssignmentEvaluator;
+
+/**
+ * @brief	Estrutura de dados para representar um plano guardado no arquivo de Pareto
+ */
+typedef struct ParetoMember
+{
+	ObjectiveVector objectives;
+	int* alternatives;
+	int* sequence; // no mesmo bloco de memria que alternatives
+} ParetoMember;
+
+/**
+ * @brief	Estrutura de dados para representar o arquivo de Pareto (planos no dominados, ordenados pelos objetivos)
+ */
+typedef struct ParetoArchive
+{
+	ParetoMember* members;
+	int count;
+	int capacity;
+	int numberOfOperations; // tamanho de cada plano guardado
+} ParetoArchive;
+
+/**
+ * @brief	Formatos de exportao do plano para diagramas de Gantt
+ */
+typedef enum ScheduleExportFormat
+{
+	EXPORT_BINARY, // cabealho e registos de 5 inteiros de 32 bits em little-endian
+	EXPORT_CSV, // uma linha por operao: job,operation,machine,start,end
+	EXPORT_JSON // array de objetos, um por linha
+} ScheduleExportFormat;
+
+/**
+ * @brief	Estrutura de dados para exportar um plano, operao a operao, com escrita em blocos grandes (em memria)
+ */
+typedef struct ScheduleExporter
+{
+	FILE* file;
+	ScheduleExportFormat format;
+	char* buffer; // GANTT_BUFFER_SIZE bytes, escritos no ficheiro quando ficam cheios
+	int used;
+	long long count; // operaes exportadas
+	bool failed; // verdadeiro depois de uma escrita falhar
+} ScheduleExporter;
+
+/**
+ * @brief	Estrutura de dados para representar um n de uma rvore AVL persistente (nunca  alterado depois de criado)
+ */
+typedef struct PersistentNode
+{
+	long long key;
+	int value;
+	int height;
+	volatile long references; // quantidade de pais e razes que referenciam o n
+	struct PersistentNode* left;
+	struct PersistentNode* right;
+} PersistentNode;
+
+/**
+ * @brief	Estrutura de dados para representar um cenrio de planeamento, que partilha estrutura com os cenrios de onde foi copiado
+ */
+typedef struct Scenario
+{
+	PersistentNode* jobs; // chave: identificador do trabalho
+	PersistentNode* operations; // chave: identificador da operao, valor: trabalho
+	PersistentNode* executions; // chave: EXECUTION_KEY(operao, mquina), valor: tempo
+	int numberOfJobs;
+	int numberOfOperations;
+	int numberOfExecutions;
+} Scenario;
+
+/**
+ * @brief	Estrutura de dados para representar uma verso completa do modelo (trabalhos, mquinas, operaes e execues).
+ *			Uma verso publicada nunca  alterada, as alteraes so feitas numa cpia que depois  publicada
+ */
+typedef struct Model
+{
+	Job* jobs;
+	Machine* machines;
+	Operation* operations;
+	ExecutionNode* executionsTable[HASH_TABLE_SIZE];
+	long version; // nmero da verso, incrementado em cada publicao
+} Model;
+
+/**
+ * @brief	Tipos de pedidos do modo de servio
+ */
+typedef enum ServiceRequestType
+{
+	SERVICE_PING,
+	SERVICE_SEARCH_EXECUTION,
+	SERVICE_MIN_JOB_TIME,
+	SERVICE_MAX_JOB_TIME,
+	SERVICE_APPLY_BATCH,
+	SERVICE_SCHEDULE,
+	SERVICE_STATS,
+	SERVICE_REQUEST_TYPES // quantidade de tipos de pedidos
+} ServiceRequestType;
+
+/**
+ * @brief	Estados das respostas do modo de servio
+ */
+typedef enum ServiceStatus
+{
+	SERVICE_OK,
+	SERVICE_NOT_FOUND,
+	SERVICE_BAD_REQUEST, // tipo desconhecido, dados com o tamanho errado ou plano pedido para um modelo com operaes sem execues
+	SERVICE_FAILED // sem memria ou sem modelo publicado
+} ServiceStatus;
+
+/**
+ * @brief	Estrutura de dados com as mtricas de latncia de um tipo de pedido (atualizadas de forma atmica)
+ */
+typedef struct ServiceLatency
+{
+	volatile long requests;
+	volatile long totalMicroseconds;
+	volatile long maxMicroseconds;
+	volatile long histogram[SERVICE_LATENCY_BUCKETS]; // a classe b conta os pedidos com menos de 2^b microssegundos
+} ServiceLatency;
+
+/**
+ * @brief	Estrutura de dados para representar o modo de servio, que responde a pedidos sobre o modelo publicado
+ */
+typedef struct Service
+{
+	int listenSocket;
+	int eventLoop; // descritor do epoll
+	int wakeUp; // descritor usado para acordar o ciclo de eventos ao parar
+	TaskPool* pool; // threads que executam os pedidos (NULL para os executar no ciclo de eventos)
+	TaskGroup tasks;
+	volatile long stop;
+	struct ServiceConnection* connections; // ligaes abertas (s usadas pelo ciclo de eventos)
+	volatile long acceptedConnections;
+	volatile long protocolErrors;
+	ServiceLatency latencies[SERVICE_REQUEST_TYPES];
+	char socketPath[108];
+} Service;
+
+/**
+ * @brief	Tipos de consultas guardadas na cache de consultas
+ */
+typedef enum QueryType
+{
+	QUERY_MIN_JOB_TIME,
+	QUERY_MAX_JOB_TIME,
+	QUERY_AVERAGE_OPERATION_TIME
+} QueryType;
+
+/**
+ * @brief	Estrutura de dados para representar uma operao de que depende um resultado da cache, com a verso usada no clculo
+ */
+typedef struct QueryDependency
+{
+	int operationID;
+	int version;
+} QueryDependency;
+
+/**
+ * @brief	Estrutura de dados para representar uma entrada da cache de consultas (em memria)
+ */
+typedef struct QueryCacheEntry
+{
+	long long key; // tipo da consulta e argumento
+	int version; // verso do trabalho (ou da operao) quando o resultado foi calculado
+	double result;
+	long long computeMicroseconds; // tempo que o clculo demorou, evitado em cada acerto
+	QueryDependency* dependencies; // operaes do trabalho (s nas consultas sobre trabalhos)
+	int numberOfDependencies;
+	int newer; // entrada usada a seguir a esta (ou a prxima entrada livre)
+	int older; // entrada usada antes desta
+} QueryCacheEntry;
+
+/**
+ * @brief	Estrutura de dados com as estatsticas da cache de consultas
+ */
+typedef struct QueryCacheStats
+{
+	long long hits;
+	long long misses; // inclui as entradas desatualizadas
+	long long staleEntries; // entradas encontradas mas calculadas com verses antigas
+	long long evictions; // entradas removidas por falta de memria
+	int numberOfEntries;
+	long long bytes;
+	long long maxBytes;
+	long long computeMicroseconds; // tempo gasto nos clculos
+	long long savedMicroseconds; // tempo de clculo evitado pelos acertos
+	float hitRate;
+} QueryCacheStats;
+
+/**
+ * @brief	Estrutura de dados para representar a cache de consultas, com remoo da entrada usada h mais tempo (LRU)
+ */
+typedef struct QueryCache
+{
+	QueryCacheEntry* entries;
+	int capacity;
+	int firstFree; // lista das posies livres do array de entradas
+	int newest; // entrada usada mais recentemente
+	int oldest; // entrada usada h mais tempo, a primeira a ser removida
+	KeySet* index; // chave da consulta -> posio no array de entradas
+	long long maxBytes;
+	QueryCacheStats stats;
+	volatile long* jobVersions; // contadores de verso, pela posio calculada a partir do identificador
+	volatile long* operationVersions;
+	struct QueryCache* volatile nextCache; // prxima cache registada para receber as alteraes
+} QueryCache;
+
 #pragma endregion
 
 
 #pragma region estruturas de dados em ficheiros
 
+/**
+ * @brief	Estrutura de dados para o cabealho do ficheiro da lista de trabalhos
+ */
+typedef struct JobFileHeader
+{
+	int magic; // JOBS_FILE_MAGIC
+	int version; // JOBS_FILE_VERSION
+	int recordSize; // sizeof(JobFile)
+} JobFileHeader;
+
 /**
  * @brief	Estrutura de dados para armazenar em ficheiro a lista de trabalhos
  */
 typedef struct JobFile
 {
 	int id;
+	int releaseDate;
+	int dueDate;
+	int weight;
 } JobFile;
 
 /**
@@ -136,6 +937,178 @@ typedef struct FileExecution
 	int runtime; // unidades de tempo necessrias para a execuo da operao
 } FileExecution;
 
+/**
+ * @brief	Estrutura de dados para armazenar em ficheiro os intervalos dos calendrios das mquinas
+ */
+typedef struct FileCalendarInterval
+{
+	int machineID;
+	int start;
+	int end;
+	int type; // CalendarIntervalType
+	int operationID;
+} FileCalendarInterval;
+
+/**
+ * @brief	Estrutura de dados para armazenar em ficheiro a famlia de cada operao
+ */
+typedef struct FileOperationFamily
+{
+	int operationID;
+	int family;
+} FileOperationFamily;
+
+/**
+ * @brief	Estrutura de dados para armazenar em ficheiro os tempos de preparao das mquinas
+ */
+typedef struct FileSetupTime
+{
+	int machineID;
+	int fromFamily;
+	int toFamily;
+	int time;
+} FileSetupTime;
+
+/**
+ * @brief	Estrutura de dados para representar uma operao do plano exportado para diagramas de Gantt (em ficheiro)
+ */
+typedef struct FileScheduleEntry
+{
+	int jobID;
+	int operationID;
+	int machineID;
+	int start;
+	int end;
+} FileScheduleEntry;
+
+/**
+ * @brief	Filtros aplicados na leitura das execues de um ficheiro
+ */
+typedef enum ExecutionFilter
+{
+	FILTER_NONE,
+	FILTER_BY_OPERATION,
+	FILTER_BY_MACHINE
+} ExecutionFilter;
+
+/**
+ * @brief	Estrutura de dados para percorrer as execues de um ficheiro binrio em blocos
+ */
+typedef struct ExecutionCursor
+{
+	FILE* file;
+	FileExecution* batch; // registos lidos do ficheiro (j filtrados)
+	int batchSize;
+	int count; // registos do bloco atual ainda por entregar com nextExecution
+	int position;
+	ExecutionFilter filter;
+	int filterID;
+	bool finished;
+} ExecutionCursor;
+
+/**
+ * @brief	Estrutura de dados para representar a quantidade, soma, mnimo e mximo de tempos de execuo
+ */
+typedef struct ExecutionAggregate
+{
+	int count;
+	long long sum;
+	int min;
+	int max;
+} ExecutionAggregate;
+
+/**
+ * @brief	Tipos de alterao de um lote de alteraes s execues
+ */
+typedef enum ExecutionChangeType
+{
+	CHANGE_INSERT,
+	CHANGE_UPDATE,
+	CHANGE_DELETE,
+	CHANGE_DELETE_OPERATION // remove todas as execues da operao
+} ExecutionChangeType;
+
+/**
+ * @brief	Estrutura de dados para representar uma alterao de um lote de alteraes s execues
+ */
+typedef struct ExecutionChange
+{
+	ExecutionChangeType type;
+	int operationID;
+	int machineID;
+	int runtime; // usado nas inseres e atualizaes
+} ExecutionChange;
+
+/**
+ * @brief	Estrutura de dados para representar o resultado de um lote de alteraes s execues
+ */
+typedef struct ExecutionBatchResult
+{
+	int inserted;
+	int updated;
+	int deleted;
+	int failed; // alteraes que no foram aplicadas (execuo inexistente ou repetida)
+} ExecutionBatchResult;
+
+/**
+ * @brief	Cabealho da imagem compilada do problema, no incio do bloco (em memria e em ficheiro).
+ *			As posies dos arrays so distncias em bytes ao incio do bloco, mltiplas de CACHE_LINE_SIZE
+ */
+typedef struct ProblemSnapshotHeader
+{
+	unsigned int magic;
+	unsigned int version;
+	long long size; // tamanho total do bloco em bytes
+	int numberOfJobs;
+	int numberOfOperations;
+	int numberOfAlternatives;
+	int numberOfMachines;
+	long long totalMinWorkload; // soma do tempo mnimo de todas as operaes
+	long long makespanLowerBound; // maior tempo mnimo de um trabalho
+	long long jobIDsOffset;
+	long long jobOperationStartsOffset;
+	long long operationIDsOffset;
+	long long operationJobsOffset;
+	long long operationAlternativeStartsOffset;
+	long long alternativeMachinesOffset;
+	long long alternativeRuntimesOffset;
+	long long machineIDsOffset;
+	long long operationMinRuntimesOffset;
+	long long operationMaxRuntimesOffset;
+	long long jobMinTimesOffset;
+	long long jobMaxTimesOffset;
+	long long jobReleaseDatesOffset;
+	long long jobDueDatesOffset;
+	long long jobWeightsOffset;
+} ProblemSnapshotHeader;
+
+/**
+ * @brief	Estrutura de dados para aceder a uma imagem compilada do problema (s de leitura).
+ *			Os apontadores apontam para dentro do bloco e so calculados ao compilar ou abrir a imagem
+ */
+typedef struct ProblemSnapshot
+{
+	const ProblemSnapshotHeader* header;
+	const int* jobIDs; // identificador de cada trabalho (por ordem crescente)
+	const int* jobOperationStarts; // operaes do trabalho j: [jobOperationStarts[j], jobOperationStarts[j + 1])
+	const int* operationIDs;
+	const int* operationJobs; // posio do trabalho de cada operao
+	const int* operationAlternativeStarts; // alternativas da operao o: [operationAlternativeStarts[o], operationAlternativeStarts[o + 1])
+	const int* alternativeMachines; // posio da mquina de cada alternativa
+	const int* alternativeRuntimes;
+	const int* machineIDs; // identificador de cada mquina (por ordem crescente)
+	const int* operationMinRuntimes;
+	const int* operationMaxRuntimes;
+	const int* jobMinTimes;
+	const int* jobMaxTimes;
+	const int* jobReleaseDates;
+	const int* jobDueDates; // JOB_NO_DUE_DATE se o trabalho no tiver data de entrega
+	const int* jobWeights;
+	void* block; // bloco contguo com o cabealho e todos os arrays
+	long long size;
+	bool isMapped; // se o bloco  uma projeo do ficheiro em memria
+} ProblemSnapshot;
+
 #pragma endregion
 
 
@@ -146,12 +1119,19 @@ typedef struct FileExecution
  */
 
 Job* newJob(int id);
+Job* newJob_WithDates(int id, int releaseDate, int dueDate, int weight);
+bool updateJobDates(Job* head, int id, int releaseDate, int dueDate, int weight);
 Job* insertJobAtStart(Job* head, Job* new);
 bool deleteJob(Job** head, int id);
+bool writeJobsFileHeader(FILE* file);
+int readJobsFileHeader(FILE* file);
+bool readJobRecord(FILE* file, int recordSize, JobFile* record);
 bool writeJobs(char* fileName, Job* h);
 Job* readJobs(char* fileName);
 void displayJob(Job* head);
 bool searchJob(Job* head, int id);
+Job* copyJobs(Job* head);
+bool freeJobs(Job* head);
 
 /**
  * @brief	Sobre mquinas
@@ -162,6 +1142,8 @@ bool writeMachines(char* fileName, Machine* head);
 Machine* readMachine(char* fileName);
 bool displayMachines(Machine* head);
 bool searchMachine(Machine* head, int id);
+Machine* copyMachines(Machine* head);
+bool freeMachines(Machine* head);
 
 /**
  * @brief	Sobre operaes
@@ -178,7 +1160,12 @@ bool searchOperation_ByJob(Operation* head, int jobID);
 Operation* getOperation(Operation* head, int id);
 int getMinTimeToCompleteJob(Operation* operations, Execution* executions, int jobID, Execution** minExecutions);
 int getMaxTimeToCompleteJob(Operation* operations, Execution* executions, int jobID, Execution** maxExecutions);
+int getMinTimeToCompleteJob_ToArray(Operation* operations, Execution* executions, int jobID, FileExecution minExecutions[], int capacity, int* numberOfChosen);
+int getMaxTimeToCompleteJob_ToArray(Operation* operations, Execution* executions, int jobID, FileExecution maxExecutions[], int capacity, int* numberOfChosen);
 float getAverageTimeToCompleteOperation(Execution* head, int operationID);
+int getTimesToCompleteJobs_Parallel(TaskPool* pool, Job* jobs, Operation* operations, ExecutionNode* table[], JobTimes* times, int capacity);
+Operation* copyOperations(Operation* head);
+bool freeOperations(Operation* head);
 
 /**
  * @brief	Sobre execues com listas
@@ -194,7 +1181,10 @@ bool displayExecutions(Execution* head);
 Execution* searchExecution(Execution* head, int operationID, int machineID);
 Execution* searchExecutionByOperation(Execution* head, int operationID);
 Execution* sortExecutionsByOperation(Execution* head);
+Execution* mergeSortExecutions(Execution* head);
 Execution* getLastExecution(Execution* head);
+Execution* copyExecutions(Execution* head);
+bool freeExecutions(Execution* head);
 
 /**
  * @brief	Sobre execues com tabela hash
@@ -203,6 +1193,8 @@ Execution* getLastExecution(Execution* head);
 ExecutionNode** createExecutionsTable(ExecutionNode* table[]);
 ExecutionNode* createExecutionNode();
 int generateHash(int id);
+int generateHash_WithSeed(int operationID, unsigned int seed);
+int generateHash_AtTable(ExecutionNode* table[], int operationID);
 ExecutionNode** insertExecution_AtTable(ExecutionNode* table[], Execution* new);
 bool updateRuntime_ByOperation_AtTable(ExecutionNode** table[], int operationID, int machineID, int runtime);
 bool deleteExecutions_ByOperation_AtTable(ExecutionNode** table[], int operationID);
@@ -211,6 +1203,340 @@ ExecutionNode** readExecutions_AtTable(char fileName[], ExecutionNode* tableee[]
 bool displayExecutions_AtTable(ExecutionNode* table[]);
 Execution* searchExecution_AtTable(ExecutionNode* table[], int operationID, int machineID);
 //ExecutionNode** free_Execution_Table(ExecutionNode* table[]);
+bool getExecutionsTableStats(ExecutionNode* table[], ExecutionsTableStats* stats);
+bool displayExecutionsTableStats(ExecutionsTableStats* stats);
+bool rehashExecutionsTable(ExecutionNode* table[], unsigned int seed);
+bool checkExecutionsTable(ExecutionNode* table[], float maxChainRatio, ExecutionsTableStats* stats);
+bool copyExecutionsTable(ExecutionNode* source[], ExecutionNode* destination[]);
+bool freeExecutionsTable(ExecutionNode* table[]);
+
+/**
+ * @brief	Sobre execues em ficheiro comprimido por colunas
+ */
+bool writeExecutions_Columnar(char fileName[], ExecutionNode* table[]);
+bool writeFileExecutions_Columnar(char fileName[], FileExecution* records, int count);
+FileExecution* readFileExecutions_Columnar(char fileName[], int* count);
+int readExecutions_Columnar_AtTable(char fileName[], ExecutionNode* table[]);
+
+/**
+ * @brief	Sobre leitura de execues de ficheiro em blocos
+ */
+ExecutionCursor* openExecutionCursor(char fileName[], ExecutionFilter filter, int filterID, int batchSize);
+int nextExecutionBatch(ExecutionCursor* cursor, FileExecution** records);
+bool nextExecution(ExecutionCursor* cursor, FileExecution* record);
+bool closeExecutionCursor(ExecutionCursor* cursor);
+bool aggregateExecutions_File(char fileName[], ExecutionFilter filter, int filterID, ExecutionAggregate* aggregate);
+int aggregateExecutions_ByGroup_File(char fileName[], ExecutionFilter groupBy, int ids[], ExecutionAggregate aggregates[], int capacity);
+float getAverageTimeToCompleteOperation_File(char fileName[], int operationID);
+
+/**
+ * @brief	Sobre execues com tabela hash concorrente
+ */
+ConcurrentExecutionsTable* createConcurrentExecutionsTable(int expectedExecutions);
+bool insertExecution_AtConcurrentTable(ConcurrentExecutionsTable* table, Execution* new);
+bool updateRuntime_AtConcurrentTable(ConcurrentExecutionsTable* table, int operationID, int machineID, int runtime);
+int deleteExecutions_ByOperation_AtConcurrentTable(ConcurrentExecutionsTable* table, int operationID);
+bool searchExecution_AtConcurrentTable(ConcurrentExecutionsTable* table, int operationID, int machineID, Execution* result);
+int moveExecutions_ToTable(ConcurrentExecutionsTable* concurrent, ExecutionNode* table[]);
+bool freeConcurrentExecutionsTable(ConcurrentExecutionsTable* table);
+
+/**
+ * @brief	Sobre ndice de execues por mquina
+ */
+MachineIndex* createMachineIndex();
+MachineIndex* buildMachineIndex(ExecutionNode* table[]);
+bool insertExecution_AtMachineIndex(MachineIndex* index, int operationID, int machineID, int runtime);
+bool deleteExecution_AtMachineIndex(MachineIndex* index, int operationID, int machineID);
+bool updateRuntime_AtMachineIndex(MachineIndex* index, int operationID, int machineID, int runtime);
+MachineAlternative* getAlternatives_ByMachine(MachineIndex* index, int machineID, int* count);
+bool getFastestOperation_ByMachine(MachineIndex* index, int machineID, MachineAlternative* result);
+bool getFastestEligibleOperation_ByMachine(MachineIndex* index, int machineID, KeySet* eligible, MachineAlternative* result);
+bool freeMachineIndex(MachineIndex* index);
+bool insertExecution_Indexed(ExecutionNode* table[], MachineIndex* index, Execution* new);
+bool updateRuntime_Indexed(ExecutionNode* table[], MachineIndex* index, int operationID, int machineID, int runtime);
+bool deleteExecutions_ByOperation_Indexed(ExecutionNode* table[], MachineIndex* index, int operationID);
+
+/**
+ * @brief	Sobre mquinas elegveis de cada operao
+ */
+EligibilityTable* buildEligibilityTable(Operation* operations, Machine* machines, ExecutionNode* executions[]);
+bool freeEligibilityTable(EligibilityTable* table);
+int getRuntimeIndex(EligibilityTable* table, int operation, int machine);
+bool isMachineEligible(EligibilityTable* table, int operationID, int machineID);
+int getRuntime_AtEligibilityTable(EligibilityTable* table, int operationID, int machineID);
+bool updateRuntime_AtEligibilityTable(EligibilityTable* table, int operationID, int machineID, int runtime);
+int countEligibleMachines(EligibilityTable* table, int operationID);
+int getEligibleMachines(EligibilityTable* table, int operationID, int machineIDs[], int capacity);
+int getOperations_EligibleOnAllMachines(EligibilityTable* table, int machineIDs[], int numberOfMachines, int operationIDs[], int capacity);
+int getMachines_ForAnyOperation(EligibilityTable* table, int operationIDs[], int numberOfOperations, int machineIDs[], int capacity);
+
+/**
+ * @brief	Sobre ordenao de execues
+ */
+bool radixSortExecutions(FileExecution* records, int count);
+bool radixSortExecutions_Parallel(TaskPool* pool, FileExecution* records, int count);
+
+/**
+ * @brief	Sobre conjuntos de chaves
+ */
+KeySet* createKeySet(int expectedKeys);
+bool insertKey(KeySet* set, long long key, int value);
+bool setKeyValue(KeySet* set, long long key, int value);
+int getKeyValue(KeySet* set, long long key);
+bool searchKey(KeySet* set, long long key);
+bool removeKey(KeySet* set, long long key);
+bool freeKeySet(KeySet* set);
+
+/**
+ * @brief	Sobre mapeamento de identificadores para ndices densos
+ */
+IdMap* createIdMap(int expectedIds);
+int addExternalId(IdMap* map, int externalId, bool* isNew);
+int getDenseId(IdMap* map, int externalId);
+bool getExternalId(IdMap* map, int denseId, int* externalId);
+bool freeIdMap(IdMap* map);
+Job* readJobs_Dense(char fileName[], IdMap* jobsMap);
+Machine* readMachines_Dense(char fileName[], IdMap* machinesMap);
+Operation* readOperations_Dense(char fileName[], IdMap* operationsMap, IdMap* jobsMap);
+int readExecutions_Dense_AtTable(char fileName[], ExecutionNode* table[], IdMap* operationsMap, IdMap* machinesMap);
+bool writeJobs_Dense(char fileName[], Job* head, IdMap* jobsMap);
+bool writeMachines_Dense(char fileName[], Machine* head, IdMap* machinesMap);
+bool writeOperations_Dense(char fileName[], Operation* head, IdMap* operationsMap, IdMap* jobsMap);
+bool writeExecutions_Dense_AtTable(char fileName[], ExecutionNode* table[], IdMap* operationsMap, IdMap* machinesMap);
+
+/**
+ * @brief	Sobre calendrios das mquinas
+ */
+MachineCalendars* createMachineCalendars();
+MachineCalendar* getMachineCalendar(MachineCalendars* calendars, int machineID, bool create);
+bool addDowntime(MachineCalendars* calendars, int machineID, int start, int end);
+bool addReservation(MachineCalendars* calendars, int machineID, int operationID, int start, int end);
+bool removeCalendarInterval(MachineCalendars* calendars, int machineID, int start);
+bool isMachineAvailable(MachineCalendars* calendars, int machineID, int start, int end);
+int getEarliestStart(MachineCalendars* calendars, int machineID, int time, int duration);
+CalendarInterval* getNextCalendarInterval(MachineCalendars* calendars, int machineID, int time);
+bool freeMachineCalendars(MachineCalendars* calendars);
+bool writeMachineCalendars(char fileName[], MachineCalendars* calendars);
+MachineCalendars* readMachineCalendars(char fileName[]);
+
+/**
+ * @brief	Sobre tempos de preparao das mquinas
+ */
+SetupTimes* createSetupTimes(int numberOfFamilies);
+bool freeSetupTimes(SetupTimes* setups);
+bool setOperationFamily(SetupTimes* setups, int operationID, int family);
+int getOperationFamily(SetupTimes* setups, int operationID);
+SetupMatrix* getSetupMatrix(SetupTimes* setups, int machineID, bool create);
+bool setSetupTime(SetupTimes* setups, int machineID, int fromFamily, int toFamily, int time);
+int getSetupTime_AtMatrix(const SetupMatrix* matrix, int fromFamily, int toFamily);
+int getSetupTime(SetupTimes* setups, int machineID, int fromFamily, int toFamily);
+long long getSetupTimesMemory(SetupTimes* setups);
+bool writeSetupTimes(char familiesFileName[], char setupsFileName[], SetupTimes* setups);
+SetupTimes* readSetupTimes(char familiesFileName[], char setupsFileName[]);
+
+/**
+ * @brief	Sobre o plano em tempo real
+ */
+OnlineSchedule* createOnlineSchedule();
+bool freeOnlineSchedule(OnlineSchedule* schedule);
+int scheduleOperation_Online(OnlineSchedule* schedule, int operationID, int jobID, FileExecution alternatives[], int count);
+int scheduleOperation_AtTable_Online(OnlineSchedule* schedule, ExecutionNode* table[], int operationID, int jobID);
+int removeJob_Online(OnlineSchedule* schedule, int jobID);
+int updateRuntime_Online(OnlineSchedule* schedule, int operationID, int runtime);
+int setJobDates_Online(OnlineSchedule* schedule, int jobID, int releaseDate, int dueDate, int weight);
+bool getScheduledOperation_Online(OnlineSchedule* schedule, int operationID, ScheduledOperation* result);
+int getMakespan_Online(OnlineSchedule* schedule);
+long long getWeightedTardiness_Online(OnlineSchedule* schedule);
+bool checkOnlineSchedule(OnlineSchedule* schedule);
+
+/**
+ * @brief	Sobre a simulao por eventos discretos
+ */
+void initRadixHeap(RadixHeap* heap);
+void clearRadixHeap(RadixHeap* heap);
+bool pushRadixHeap(RadixHeap* heap, unsigned int key, int value);
+bool popRadixHeap(RadixHeap* heap, unsigned int* key, int* value);
+void freeRadixHeap(RadixHeap* heap);
+Simulation* createSimulation(ProblemSnapshot* snapshot, int alternatives[], int starts[]);
+bool freeSimulation(Simulation* simulation);
+SimulationState* createSimulationState(Simulation* simulation);
+bool freeSimulationState(SimulationState* state);
+bool runSimulation(Simulation* simulation, SimulationState* state, SimulationConfig* config, long long replication, SimulationResult* result);
+bool runMonteCarlo_Parallel(TaskPool* pool, Simulation* simulation, SimulationConfig* config, int replications, int makespans[], MonteCarloSummary* summary);
+
+/**
+ * @brief	Sobre os objetivos do escalonamento e a frente de Pareto
+ */
+bool dominates(ObjectiveVector* first, ObjectiveVector* second);
+AssignmentEvaluator* createAssignmentEvaluator(ProblemSnapshot* snapshot);
+bool freeAssignmentEvaluator(AssignmentEvaluator* evaluator);
+bool setAlternative_AtEvaluator(AssignmentEvaluator* evaluator, int operation, int alternative);
+bool setSequence_AtEvaluator(AssignmentEvaluator* evaluator, int sequence[]);
+bool swapSequence_AtEvaluator(AssignmentEvaluator* evaluator, int first, int second);
+int decodeSchedule_AtEvaluator(AssignmentEvaluator* evaluator, int starts[]);
+bool getObjectives_AtEvaluator(AssignmentEvaluator* evaluator, ObjectiveVector* objectives);
+long long getWeightedTardiness_AtEvaluator(AssignmentEvaluator* evaluator);
+bool attachSetupTimes_AtEvaluator(AssignmentEvaluator* evaluator, SetupTimes* setups);
+long long getTotalSetupTime_AtEvaluator(AssignmentEvaluator* evaluator);
+long long getSetupDelta_Swap_AtEvaluator(AssignmentEvaluator* evaluator, int operation);
+long long getSetupDelta_Move_AtEvaluator(AssignmentEvaluator* evaluator, int operation, int alternative, int afterOperation);
+bool buildDispatchSchedule_AtEvaluator(AssignmentEvaluator* evaluator, DispatchRule rule, double lookahead);
+ParetoArchive* createParetoArchive(int numberOfOperations);
+bool insertParetoArchive(ParetoArchive* archive, ObjectiveVector* objectives, int alternatives[], int sequence[]);
+bool freeParetoArchive(ParetoArchive* archive);
+ParetoArchive* solveParetoFront(ProblemSnapshot* snapshot, int iterations, unsigned long long seed);
+
+/**
+ * @brief	Sobre a exportao do plano para diagramas de Gantt
+ */
+ScheduleExporter* createScheduleExporter(char fileName[], ScheduleExportFormat format);
+bool writeScheduleEntry(ScheduleExporter* exporter, int jobID, int operationID, int machineID, int start, int end);
+bool closeScheduleExporter(ScheduleExporter* exporter);
+bool exportOnlineSchedule(OnlineSchedule* schedule, char fileName[], ScheduleExportFormat format);
+bool exportEvaluatorSchedule(AssignmentEvaluator* evaluator, char fileName[], ScheduleExportFormat format);
+FileScheduleEntry* readScheduleEntries_Binary(char fileName[], long long* count);
+
+/**
+ * @brief	Sobre alteraes em lote
+ */
+bool applyExecutionChanges_AtTable(ExecutionNode* table[], ExecutionChange changes[], int count, ExecutionBatchResult* result);
+int updateRuntimes_Batch_AtTable(ExecutionNode* table[], FileExecution records[], int count);
+int insertOperations_Batch(Operation** head, FileOperation operations[], int count);
+int deleteOperations_Batch(Operation** head, int operationIDs[], int count);
+
+/**
+ * @brief	Sobre cenrios de planeamento
+ */
+Scenario* createScenario();
+Scenario* createScenario_FromModel(Job* jobs, Operation* operations, ExecutionNode* executions[]);
+Scenario* forkScenario(Scenario* scenario);
+bool freeScenario(Scenario* scenario);
+bool insertJob_AtScenario(Scenario* scenario, int jobID);
+bool insertOperation_AtScenario(Scenario* scenario, int operationID, int jobID);
+bool insertExecution_AtScenario(Scenario* scenario, int operationID, int machineID, int runtime);
+bool updateRuntime_AtScenario(Scenario* scenario, int operationID, int machineID, int runtime);
+bool deleteExecution_AtScenario(Scenario* scenario, int operationID, int machineID);
+bool deleteOperation_AtScenario(Scenario* scenario, int operationID);
+int deleteMachine_AtScenario(Scenario* scenario, int machineID);
+int getRuntime_AtScenario(Scenario* scenario, int operationID, int machineID);
+int getMinTimeToCompleteJob_AtScenario(Scenario* scenario, int jobID);
+int getMaxTimeToCompleteJob_AtScenario(Scenario* scenario, int jobID);
+
+/**
+ * @brief	Sobre a imagem compilada do problema
+ */
+ProblemSnapshot* compileProblemSnapshot(Job* jobs, Machine* machines, Operation* operations, ExecutionNode* executions[]);
+bool writeProblemSnapshot(char fileName[], ProblemSnapshot* snapshot);
+ProblemSnapshot* openProblemSnapshot(char fileName[]);
+bool closeProblemSnapshot(ProblemSnapshot* snapshot);
+int getJobIndex_AtSnapshot(ProblemSnapshot* snapshot, int jobID);
+int getMinTimeToCompleteJob_AtSnapshot(ProblemSnapshot* snapshot, int jobID);
+int getMaxTimeToCompleteJob_AtSnapshot(ProblemSnapshot* snapshot, int jobID);
+int getMinAlternatives_AtSnapshot(ProblemSnapshot* snapshot, int jobID, int alternatives[], int capacity);
+int getMaxAlternatives_AtSnapshot(ProblemSnapshot* snapshot, int jobID, int alternatives[], int capacity);
+int countOperationsWithoutAlternatives_AtSnapshot(ProblemSnapshot* snapshot);
+
+/**
+ * @brief	Sobre leitura de ficheiros em paralelo
+ */
+long long getFileSize(char fileName[]);
+void* readRecords_Parallel(char fileName[], size_t recordSize, int numberOfThreads, int* numberOfRecords);
+void* readRecords_Parallel_AtOffset(char fileName[], long long offset, size_t recordSize, int numberOfThreads, int* numberOfRecords);
+Job* readJobs_Parallel(char fileName[], int numberOfThreads);
+Machine* readMachines_Parallel(char fileName[], int numberOfThreads);
+Operation* readOperations_Parallel(char fileName[], int numberOfThreads);
+int readExecutions_AtTable_Parallel(char fileName[], ExecutionNode* table[], int numberOfThreads);
+
+/**
+ * @brief	Sobre a exportao e importao do modelo em texto
+ */
+bool writeModelText(char fileName[], Job* jobs, Machine* machines, Operation* operations, ExecutionNode* table[]);
+long long readModelText(TaskPool* pool, char fileName[], Job** jobs, Machine** machines, Operation** operations, ExecutionNode* table[]);
+bool dumpModel_Text(Model* model, char fileName[]);
+Model* loadModel_Text(TaskPool* pool, char fileName[]);
+
+/**
+ * @brief	Sobre primitivas de concorrncia
+ */
+bool createThread(Thread* thread, void (*function)(void*), void* argument);
+bool joinThread(Thread* thread);
+int getNumberOfProcessors();
+void yieldThread();
+long long getTimeMicroseconds();
+void initMutex(Mutex* mutex);
+void lockMutex(Mutex* mutex);
+void unlockMutex(Mutex* mutex);
+void destroyMutex(Mutex* mutex);
+void initCondition(Condition* condition);
+void waitCondition(Condition* condition, Mutex* mutex);
+void broadcastCondition(Condition* condition);
+void destroyCondition(Condition* condition);
+long atomicLoad(volatile long* value);
+void atomicStore(volatile long* value, long newValue);
+long atomicAdd(volatile long* value, long amount);
+bool atomicCompareExchange(volatile long* value, long expected, long desired);
+void* atomicLoadPointer(void* volatile* pointer);
+void* atomicExchangePointer(void* volatile* pointer, void* newPointer);
+
+/**
+ * @brief	Sobre o conjunto de threads com roubo de tarefas
+ */
+TaskPool* createTaskPool(int numberOfWorkers);
+bool freeTaskPool(TaskPool* pool);
+void initTaskGroup(TaskGroup* group);
+bool spawnTask(TaskPool* pool, TaskGroup* group, TaskFunction function, void* argument);
+void waitTaskGroup(TaskPool* pool, TaskGroup* group);
+bool parallelFor(TaskPool* pool, int first, int last, int grainSize, RangeFunction function, void* argument);
+
+/**
+ * @brief	Sobre verses do modelo partilhadas entre threads
+ */
+Model* newModel(Job* jobs, Machine* machines, Operation* operations, ExecutionNode* table[]);
+Model* copyModel(Model* model);
+bool freeModel(Model* model);
+bool startModel(Model* model);
+bool stopModel();
+int registerModelReader();
+void unregisterModelReader(int reader);
+Model* beginModelRead(int reader);
+void endModelRead(int reader);
+Model* beginModelUpdate();
+bool publishModelUpdate(Model* draft);
+void cancelModelUpdate(Model* draft);
+int reclaimModels();
+Execution* searchExecution_AtModel(Model* model, int operationID, int machineID);
+int getMinTimeToCompleteJob_AtModel(Model* model, int jobID, Execution** minExecutions);
+int getMaxTimeToCompleteJob_AtModel(Model* model, int jobID, Execution** maxExecutions);
+int getMinTimeToCompleteJob_AtModel_ToArray(Model* model, int jobID, FileExecution minExecutions[], int capacity, int* numberOfChosen);
+int getMaxTimeToCompleteJob_AtModel_ToArray(Model* model, int jobID, FileExecution maxExecutions[], int capacity, int* numberOfChosen);
+bool displayModel(Model* model);
+bool writeModel(Model* model);
+
+/**
+ * @brief	Sobre o modo de servio
+ */
+Service* createService(TaskPool* pool, char socketPath[]);
+bool runService(Service* service);
+void stopService(Service* service);
+bool freeService(Service* service);
+bool getServiceLatency(Service* service, ServiceRequestType type, ServiceLatency* result);
+int getServiceLatencyPercentile(ServiceLatency* latency, double percentile);
+
+/**
+ * @brief	Sobre a cache de consultas
+ */
+void bumpJobVersion(int jobID);
+void bumpOperationVersion(int operationID);
+int getJobVersion(QueryCache* cache, int jobID);
+int getOperationVersion(QueryCache* cache, int operationID);
+QueryCache* createQueryCache(long long maxBytes);
+bool clearQueryCache(QueryCache* cache);
+bool freeQueryCache(QueryCache* cache);
+int getMinTimeToCompleteJob_Cached(QueryCache* cache, Operation* operations, Execution* executions, int jobID);
+int getMaxTimeToCompleteJob_Cached(QueryCache* cache, Operation* operations, Execution* executions, int jobID);
+float getAverageTimeToCompleteOperation_Cached(QueryCache* cache, Execution* executions, int operationID);
+bool getQueryCacheStats(QueryCache* cache, QueryCacheStats* stats);
+bool displayQueryCacheStats(QueryCacheStats* stats);
 
 /**
  * @brief	Carregar dados para as estruturas em memria